@@ -0,0 +1,546 @@
+// Micro-benchmarks for the hot paths between the wire and user code: REST response parsing,
+// order serialization, request path/query building and websocket frame dispatch.
+//
+//   alpaca_benchmarks [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>] ...
+//
+// Response parsers and request builders are internal to the clients, so they are measured
+// through the public client calls against an in-memory transport that hands back a canned
+// page from corpus.hpp; copying the body into the response is part of the measured work, as
+// it is with a real transport. "bytes_per_second" is payload throughput and "allocs/op"
+// counts global operator new calls per iteration.
+//
+// Parsers are covered by shape rather than one benchmark per endpoint. The ~100 parse_*
+// functions reduce to a few payload shapes, each measured once at a small and a large size:
+// symbol-keyed arrays (bars, trades, quotes), symbol-keyed objects (latest quotes,
+// snapshots, orderbooks), top-level object arrays (orders, positions, assets, broker
+// accounts), deeply nested objects (option chain, account, corporate actions) and
+// string-heavy bodies (news). Other endpoints reuse the same simdjson helpers on one of these
+// shapes, and most are called once per session, so they are left out.
+
+#include "corpus.hpp"
+
+#include "alpaca/broker/client.hpp"
+#include "alpaca/core/http_transport.hpp"
+#include "alpaca/core/thread.hpp"
+#include "alpaca/data/bar_store.hpp"
+#include "alpaca/data/client.hpp"
+#include "alpaca/data/covariance.hpp"
+#include "alpaca/data/live/crypto.hpp"
+#include "alpaca/data/live/market_data_bus.hpp"
+#include "alpaca/data/live/stock.hpp"
+#include "alpaca/data/snapshot_sweep.hpp"
+#include "alpaca/trading/client.hpp"
+#include "alpaca/trading/order_serialization.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+std::atomic<std::uint64_t> allocations{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC flags free() on memory from a replaced operator new once these are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+using namespace alpaca;
+
+namespace {
+
+// Returns the same response to every request and remembers the length of the last URL, which
+// also keeps the request building from being optimised away.
+class FixedTransport final : public core::IHttpTransport {
+  public:
+    explicit FixedTransport(std::string body) : body_(std::move(body)) {}
+
+    core::HttpResponse send(const core::HttpRequest &request) override {
+        url_size_ = request.url.size();
+        return {200, {}, body_};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return body_.size(); }
+    [[nodiscard]] std::size_t url_size() const noexcept { return url_size_; }
+
+  private:
+    std::string body_;
+    std::size_t url_size_{0};
+};
+
+core::ClientConfig config() { return core::ClientConfig::WithPaperKeys("key", "secret"); }
+
+// Runs fn once per iteration and reports throughput over bytes and allocations per call.
+template <typename Fn> void measure(benchmark::State &state, std::size_t bytes, Fn &&fn) {
+    const std::uint64_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        auto result = fn();
+        benchmark::DoNotOptimize(result);
+    }
+    const std::uint64_t after = allocations.load(std::memory_order_relaxed);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(bytes));
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(after - before),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+template <typename Client, typename Call>
+void client_benchmark(benchmark::State &state, std::string body, Call call) {
+    auto transport = std::make_shared<FixedTransport>(std::move(body));
+    const Client client(config(), transport);
+    measure(state, transport->size(), [&] { return call(client); });
+}
+
+// Same call against an empty page; throughput is over the built URL instead of the body.
+template <typename Client, typename Call>
+void request_benchmark(benchmark::State &state, std::string empty_page, Call call) {
+    auto transport = std::make_shared<FixedTransport>(std::move(empty_page));
+    const Client client(config(), transport);
+    benchmark::DoNotOptimize(call(client));
+    measure(state, transport->url_size(), [&] { return call(client); });
+}
+
+// --- Market data responses ------------------------------------------------------------------
+
+void BM_ParseStockBars(benchmark::State &state) {
+    data::StockBarsRequest request;
+    request.symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::stock_bars(5, static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_stock_bars(request); });
+}
+BENCHMARK(BM_ParseStockBars)->Arg(200)->Arg(2000);
+
+void BM_ParseStockTrades(benchmark::State &state) {
+    data::StockTradesRequest request;
+    request.symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::stock_trades(5, static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_stock_trades(request); });
+}
+BENCHMARK(BM_ParseStockTrades)->Arg(200)->Arg(2000);
+
+void BM_ParseStockQuotes(benchmark::State &state) {
+    data::StockQuotesRequest request;
+    request.symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::stock_quotes(5, static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_stock_quotes(request); });
+}
+BENCHMARK(BM_ParseStockQuotes)->Arg(200)->Arg(2000);
+
+void BM_ParseStockLatestQuotes(benchmark::State &state) {
+    data::StockLatestQuoteRequest request;
+    request.symbols = {"AAPL", "MSFT"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::stock_latest_quotes(static_cast<std::size_t>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_stock_latest_quotes(request); });
+}
+BENCHMARK(BM_ParseStockLatestQuotes)->Arg(10)->Arg(1000);
+
+void BM_ParseStockSnapshots(benchmark::State &state) {
+    data::StockSnapshotRequest request;
+    request.symbols = {"AAPL", "MSFT"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::stock_snapshots(static_cast<std::size_t>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_stock_snapshots(request); });
+}
+BENCHMARK(BM_ParseStockSnapshots)->Arg(10)->Arg(500);
+
+// Answers each snapshot chunk with a full 500-symbol page after a simulated round trip. Unlike
+// FixedTransport it is safe for the sweep's concurrent send() calls.
+class DelayedSnapshotTransport final : public core::IHttpTransport {
+  public:
+    explicit DelayedSnapshotTransport(std::chrono::milliseconds round_trip)
+        : body_(bench::corpus::stock_snapshots(500)), round_trip_(round_trip) {}
+
+    core::HttpResponse send(const core::HttpRequest &) override {
+        std::this_thread::sleep_for(round_trip_);
+        return {200, {}, body_};
+    }
+
+  private:
+    std::string body_;
+    std::chrono::milliseconds round_trip_;
+};
+
+// Whole-universe sweep: range(0) symbols in 500-symbol chunks, 8 requests in flight, each
+// taking range(1) ms on the "network".
+void BM_SnapshotSweep(benchmark::State &state) {
+    auto transport =
+        std::make_shared<DelayedSnapshotTransport>(std::chrono::milliseconds(state.range(1)));
+    const data::DataClient client(config(), transport);
+    std::vector<std::string> universe;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        universe.push_back("S" + std::to_string(i));
+    }
+    for (auto _ : state) {
+        auto table = data::sweep_stock_snapshots(client, universe);
+        benchmark::DoNotOptimize(table);
+    }
+}
+BENCHMARK(BM_SnapshotSweep)
+    ->Args({10'000, 0})
+    ->Args({10'000, 50})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_ParseCryptoOrderbooks(benchmark::State &state) {
+    data::CryptoLatestOrderbookRequest request;
+    request.symbols = {"BTC/USD", "ETH/USD"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::crypto_orderbooks(4, static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) {
+            return client.get_crypto_latest_orderbooks(request);
+        });
+}
+BENCHMARK(BM_ParseCryptoOrderbooks)->Arg(20)->Arg(500);
+
+void BM_ParseOptionChain(benchmark::State &state) {
+    data::OptionChainRequest request;
+    request.underlying_symbol = "AAPL";
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::option_chain(8, static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_option_chain(request); });
+}
+BENCHMARK(BM_ParseOptionChain)->Arg(10)->Arg(60);
+
+void BM_ParseNews(benchmark::State &state) {
+    data::NewsRequest request;
+    request.symbols = std::string("AAPL,MSFT");
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::news(50, static_cast<std::size_t>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_news(request); });
+}
+BENCHMARK(BM_ParseNews)->Arg(0)->Arg(4096);
+
+void BM_ParseCorporateActions(benchmark::State &state) {
+    data::CorporateActionsRequest request;
+    request.symbols = std::vector<std::string>{"AAPL", "MSFT"};
+    client_benchmark<data::DataClient>(
+        state, bench::corpus::corporate_actions(static_cast<int>(state.range(0))),
+        [&](const data::DataClient &client) { return client.get_corporate_actions(request); });
+}
+BENCHMARK(BM_ParseCorporateActions)->Arg(500);
+
+// --- Trading and broker responses -----------------------------------------------------------
+
+void BM_ParseOrders(benchmark::State &state) {
+    client_benchmark<trading::TradingClient>(
+        state, bench::corpus::orders(static_cast<int>(state.range(0))),
+        [](const trading::TradingClient &client) {
+            return client.list_orders(trading::GetOrdersRequest{});
+        });
+}
+BENCHMARK(BM_ParseOrders)->Arg(1)->Arg(500);
+
+void BM_ParsePositions(benchmark::State &state) {
+    client_benchmark<trading::TradingClient>(
+        state, bench::corpus::positions(static_cast<std::size_t>(state.range(0))),
+        [](const trading::TradingClient &client) { return client.list_positions(); });
+}
+BENCHMARK(BM_ParsePositions)->Arg(10)->Arg(500);
+
+void BM_ParseAssets(benchmark::State &state) {
+    client_benchmark<trading::TradingClient>(
+        state, bench::corpus::assets(static_cast<std::size_t>(state.range(0))),
+        [](const trading::TradingClient &client) { return client.list_assets({}); });
+}
+BENCHMARK(BM_ParseAssets)->Arg(100)->Arg(12000);
+
+void BM_ParseAccount(benchmark::State &state) {
+    client_benchmark<trading::TradingClient>(
+        state, bench::corpus::trading_account(),
+        [](const trading::TradingClient &client) { return client.get_account(); });
+}
+BENCHMARK(BM_ParseAccount);
+
+void BM_ParseBrokerAccounts(benchmark::State &state) {
+    client_benchmark<broker::BrokerClient>(
+        state, bench::corpus::broker_accounts(static_cast<int>(state.range(0))),
+        [](const broker::BrokerClient &client) { return client.list_accounts(); });
+}
+BENCHMARK(BM_ParseBrokerAccounts)->Arg(1)->Arg(200);
+
+// --- Order serialization --------------------------------------------------------------------
+
+void BM_SerializeMarketOrder(benchmark::State &state) {
+    trading::MarketOrderRequest request;
+    request.symbol = "AAPL";
+    request.qty = 10;
+    request.side = trading::OrderSide::Buy;
+    request.time_in_force = trading::TimeInForce::Day;
+    const std::size_t bytes = trading::serialize_order_request(request).size();
+    measure(state, bytes, [&] { return trading::serialize_order_request(request); });
+}
+BENCHMARK(BM_SerializeMarketOrder);
+
+void BM_SerializeBracketOrder(benchmark::State &state) {
+    trading::LimitOrderRequest request;
+    request.symbol = "AAPL";
+    request.qty = 25;
+    request.side = trading::OrderSide::Buy;
+    request.time_in_force = trading::TimeInForce::Gtc;
+    request.limit_price = 189.37;
+    request.order_class = trading::OrderClass::Bracket;
+    request.client_order_id = "eb9e2aaa-f71a-4f51-b5b4-52a6c5659c37";
+    request.take_profit = trading::TakeProfitRequest{195.5};
+    request.stop_loss = trading::StopLossRequest{185.0, 184.5};
+    const std::size_t bytes = trading::serialize_order_request(request).size();
+    measure(state, bytes, [&] { return trading::serialize_order_request(request); });
+}
+BENCHMARK(BM_SerializeBracketOrder);
+
+// --- Request building -----------------------------------------------------------------------
+// An empty page keeps parsing negligible, leaving path/query building, header assembly and
+// the transport round trip.
+
+void BM_BuildStockBarsQuery(benchmark::State &state) {
+    data::StockBarsRequest request;
+    request.symbols = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL", "META", "TSLA", "AMD"};
+    request.timeframe = data::TimeFrame::Minute();
+    request.start = "2024-03-01T14:30:00Z";
+    request.end = "2024-03-01T21:00:00Z";
+    request.limit = 10000;
+    request.sort = common::Sort::Asc;
+    request.adjustment = data::Adjustment::All;
+    request.feed = data::DataFeed::Sip;
+    request.page_token = "QUFQTHxNfDIwMjQtMDMtMDFUMTQ6MzA6MDAuMDAwMDAwMDAwWg==";
+    request_benchmark<data::DataClient>(
+        state, R"({"bars":{},"next_page_token":null})",
+        [&](const data::DataClient &client) { return client.get_stock_bars(request); });
+}
+BENCHMARK(BM_BuildStockBarsQuery);
+
+void BM_BuildOptionChainPath(benchmark::State &state) {
+    data::OptionChainRequest request;
+    request.underlying_symbol = "AAPL";
+    request.feed = data::OptionsFeed::Opra;
+    request.type = trading::ContractType::Call;
+    request.strike_price_gte = 150.0;
+    request.strike_price_lte = 250.0;
+    request.expiration_date_gte = "2024-03-01";
+    request.expiration_date_lte = "2024-06-21";
+    request.limit = 1000;
+    request_benchmark<data::DataClient>(
+        state, R"({"snapshots":{},"next_page_token":null})",
+        [&](const data::DataClient &client) { return client.get_option_chain(request); });
+}
+BENCHMARK(BM_BuildOptionChainPath);
+
+void BM_BuildNewsPath(benchmark::State &state) {
+    data::NewsRequest request;
+    request.start = "2024-03-01T00:00:00Z";
+    request.end = "2024-03-02T00:00:00Z";
+    request.sort = "desc";
+    request.symbols = std::string("AAPL,MSFT,NVDA,AMZN,GOOGL");
+    request.limit = 50;
+    request.include_content = true;
+    request.exclude_contentless = true;
+    request_benchmark<data::DataClient>(
+        state, R"({"news":[],"next_page_token":null})",
+        [&](const data::DataClient &client) { return client.get_news(request); });
+}
+BENCHMARK(BM_BuildNewsPath);
+
+void BM_BuildOrdersQuery(benchmark::State &state) {
+    trading::GetOrdersRequest request;
+    request.status = "closed";
+    request.symbols = "AAPL,MSFT,NVDA";
+    request.limit = 500;
+    request.after = "2024-03-01T00:00:00Z";
+    request.until = "2024-03-02T00:00:00Z";
+    request.direction = "desc";
+    request.nested = true;
+    request_benchmark<trading::TradingClient>(
+        state, "[]",
+        [&](const trading::TradingClient &client) { return client.list_orders(request); });
+}
+BENCHMARK(BM_BuildOrdersQuery);
+
+void BM_BuildListAccountsQuery(benchmark::State &state) {
+    broker::ListAccountsRequest request;
+    request.query = "john";
+    request.created_after = "2024-01-01T00:00:00Z";
+    request.status = std::vector<trading::AccountStatus>{trading::AccountStatus::Active};
+    request.sort = "DESC";
+    request_benchmark<broker::BrokerClient>(
+        state, "[]",
+        [&](const broker::BrokerClient &client) { return client.list_accounts(request); });
+}
+BENCHMARK(BM_BuildListAccountsQuery);
+
+// --- Stream dispatch ------------------------------------------------------------------------
+
+class StockProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::dispatch_message_impl;
+    using StockDataStream::StockDataStream;
+};
+
+class CryptoProbe : public data::live::CryptoDataStream {
+  public:
+    using CryptoDataStream::CryptoDataStream;
+    using CryptoDataStream::dispatch_message_impl;
+};
+
+template <typename Stream>
+void dispatch_benchmark(benchmark::State &state, Stream &stream, const std::string &frame) {
+    const std::uint64_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        stream.dispatch_message_impl(frame);
+    }
+    const std::uint64_t after = allocations.load(std::memory_order_relaxed);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(frame.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(after - before),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+void BM_DispatchStockFrame(benchmark::State &state) {
+    StockProbe stream("key", "secret");
+    std::uint64_t delivered = 0;
+    stream.subscribe_trades([&](const data::Trade &) { ++delivered; }, {"*"});
+    stream.subscribe_quotes([&](const data::Quote &) { ++delivered; }, {"*"});
+    dispatch_benchmark(state, stream, bench::corpus::stock_stream_frame(
+                                          static_cast<int>(state.range(0))));
+    benchmark::DoNotOptimize(delivered);
+}
+BENCHMARK(BM_DispatchStockFrame)->Arg(1)->Arg(100);
+
+void BM_DispatchCryptoFrame(benchmark::State &state) {
+    CryptoProbe stream("key", "secret");
+    std::uint64_t delivered = 0;
+    stream.subscribe_trades([&](const data::Trade &) { ++delivered; }, {"*"});
+    stream.subscribe_orderbooks([&](const data::Orderbook &) { ++delivered; }, {"*"});
+    dispatch_benchmark(state, stream, bench::corpus::crypto_stream_frame(
+                                          static_cast<int>(state.range(0))));
+    benchmark::DoNotOptimize(delivered);
+}
+BENCHMARK(BM_DispatchCryptoFrame)->Arg(1)->Arg(100);
+
+// --- Shared-memory market data bus ---------------------------------------------------------
+
+void BM_BusPublish(benchmark::State &state) {
+    data::live::MarketDataBusPublisher publisher("alpaca_bench_bus");
+    const data::live::BusEvent event = data::live::to_bus_event(data::Trade{
+        "AAPL", "2024-03-01T14:30:00.123456789Z", 190.5, 100, "V", "52983525029461", {}, "C"});
+    measure(state, sizeof(event), [&] { return publisher.publish(event); });
+}
+BENCHMARK(BM_BusPublish);
+
+// Publisher on the benchmark thread, subscriber spinning on another (pin both for stable
+// numbers): reports the publish-to-read latency percentiles the subscriber observed.
+void BM_BusCrossThreadLatency(benchmark::State &state) {
+    if (std::thread::hardware_concurrency() < 2) {
+        state.SkipWithError("needs two cores for the spinning reader");
+        return;
+    }
+    data::live::MarketDataBusPublisher publisher("alpaca_bench_bus");
+    data::live::MarketDataBusSubscriber subscriber("alpaca_bench_bus");
+    subscriber.enable_latency_stats();
+    std::atomic<bool> running{true};
+    std::atomic<std::uint64_t> seen{0};
+    std::thread reader([&] {
+        data::live::BusEvent event;
+        while (running.load(std::memory_order_relaxed)) {
+            if (subscriber.poll(event)) {
+                seen.store(event.sequence, std::memory_order_release);
+            }
+        }
+    });
+    const data::live::BusEvent event = data::live::to_bus_event(
+        data::Trade{"AAPL", "2024-03-01T14:30:00Z", 190.5, 100, "V", "1", {}, "C"});
+    for (auto _ : state) {
+        const std::uint64_t sequence = publisher.publish(event);
+        while (seen.load(std::memory_order_acquire) < sequence) {
+            core::cpu_relax();
+        }
+    }
+    running = false;
+    reader.join();
+    const auto summary = subscriber.latency_stats()->summary();
+    state.counters["p50_ns"] = static_cast<double>(summary.p50);
+    state.counters["p99_ns"] = static_cast<double>(summary.p99);
+    state.counters["lost"] = static_cast<double>(subscriber.lost());
+}
+BENCHMARK(BM_BusCrossThreadLatency)->UseRealTime();
+
+// --- Rolling bar store -----------------------------------------------------------------------
+
+// One minute close across a universe of state.range(0) symbols with full rings.
+void BM_BarStoreUpdateAll(benchmark::State &state) {
+    data::BarStore store;
+    const auto symbols = static_cast<std::size_t>(state.range(0));
+    for (std::size_t i = 0; i < symbols; ++i) {
+        store.symbol_id("S" + std::to_string(i));
+    }
+    auto batch = store.make_batch(0);
+    for (std::size_t i = 0; i < symbols; ++i) {
+        const double price = 100.0 + static_cast<double>(i % 97);
+        batch.open[i] = price;
+        batch.high[i] = price + 0.5;
+        batch.low[i] = price - 0.5;
+        batch.close[i] = price + 0.1;
+        batch.volume[i] = 1000.0;
+    }
+    for (std::size_t minute = 0; minute < store.capacity(); ++minute) {
+        ++batch.timestamp_ns;
+        store.update_all(batch);
+    }
+    measure(state, symbols * 6 * sizeof(double), [&] {
+        ++batch.timestamp_ns;
+        return store.update_all(batch);
+    });
+}
+BENCHMARK(BM_BarStoreUpdateAll)->Arg(500)->Arg(8000);
+
+// One observation into a full window across state.range(0) symbols (the rank-two update).
+void BM_CovarianceUpdate(benchmark::State &state) {
+    const auto symbols = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> universe;
+    for (std::size_t i = 0; i < symbols; ++i) {
+        universe.push_back("S" + std::to_string(i));
+    }
+    data::CovarianceOptions options;
+    options.mode = data::CovarianceOptions::Mode::Window;
+    options.window = 16;
+    data::CovarianceEngine engine(universe, options);
+    std::vector<double> returns(symbols);
+    for (std::size_t t = 0; t < options.window; ++t) {
+        for (std::size_t i = 0; i < symbols; ++i) {
+            returns[i] = 0.001 * static_cast<double>((i * 7 + t * 13) % 11) - 0.005;
+        }
+        engine.update(returns);
+    }
+    measure(state, symbols * symbols / 2 * sizeof(double), [&] {
+        engine.update(returns);
+        return engine.observations();
+    });
+}
+BENCHMARK(BM_CovarianceUpdate)->Arg(500)->Arg(3000)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
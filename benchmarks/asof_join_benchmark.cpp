@@ -0,0 +1,188 @@
+// As-of join throughput on a synthetic full session for one liquid symbol, shaped like a busy
+// SIP day: 6.5 hours, about 5 million quotes and 600 thousand trades, both bursty.
+//
+//   alpaca_asof_join_benchmark [quotes] [trades]
+
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/asof_join.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+
+struct Session {
+    std::vector<std::int64_t> quote_ns;
+    std::vector<double> bid;
+    std::vector<double> ask;
+    std::vector<double> bid_size;
+    std::vector<double> ask_size;
+    std::vector<std::int64_t> trade_ns;
+    std::vector<double> price;
+    std::vector<double> size;
+};
+
+// Arrival times with the U-shaped intraday intensity of a liquid name, sorted.
+std::vector<std::int64_t> arrivals(std::size_t count, std::int64_t open_ns, std::int64_t length_ns,
+                                   std::mt19937_64 &rng) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::int64_t> times;
+    times.reserve(count);
+    while (times.size() < count) {
+        const double x = uniform(rng);
+        if (uniform(rng) * 2.0 <= 0.5 + 6.0 * (x - 0.5) * (x - 0.5)) {
+            const auto offset = static_cast<std::int64_t>(x * static_cast<double>(length_ns));
+            times.push_back(open_ns + offset);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+Session make_session(std::size_t quotes, std::size_t trades) {
+    std::mt19937_64 rng(42);
+    const std::int64_t open_ns = core::days_from_civil(2024, 1, 2) * 86'400'000'000'000 +
+                                 (14 * 3600 + 30 * 60) * 1'000'000'000LL;
+    const std::int64_t length_ns = 390LL * 60 * 1'000'000'000;
+
+    Session session;
+    session.quote_ns = arrivals(quotes, open_ns, length_ns, rng);
+    session.trade_ns = arrivals(trades, open_ns, length_ns, rng);
+    std::normal_distribution<double> step(0.0, 0.002);
+    std::uniform_int_distribution<int> lots(1, 5);
+    double mid = 185.0;
+    for (std::size_t i = 0; i < quotes; ++i) {
+        mid += step(rng);
+        session.bid.push_back(mid - 0.005);
+        session.ask.push_back(mid + 0.005);
+        session.bid_size.push_back(100.0 * lots(rng));
+        session.ask_size.push_back(100.0 * lots(rng));
+    }
+    for (std::size_t i = 0; i < trades; ++i) {
+        session.price.push_back(mid);
+        session.size.push_back(100.0 * lots(rng));
+    }
+    return session;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Columnar pages of `page` rows from each side, fed from whichever is behind, as the REST
+// driver does.
+void run_columnar(const Session &session, std::size_t page) {
+    std::size_t joined = 0;
+    std::size_t with_quote = 0;
+    data::AsOfJoiner joiner([&](const data::TradeQuoteColumns &batch) {
+        joined += batch.size_rows();
+        for (const auto ns : batch.quote_ns) {
+            with_quote += ns != 0;
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t q = 0;
+    std::size_t t = 0;
+    while (q < session.quote_ns.size() || t < session.trade_ns.size()) {
+        const bool quotes_behind =
+            t >= session.trade_ns.size() ||
+            (q < session.quote_ns.size() && session.quote_ns[q] <= session.trade_ns[t]);
+        if (quotes_behind) {
+            const std::size_t n = std::min(page, session.quote_ns.size() - q);
+            joiner.add_quotes("AAPL", std::span(session.quote_ns).subspan(q, n),
+                              std::span(session.bid).subspan(q, n),
+                              std::span(session.bid_size).subspan(q, n),
+                              std::span(session.ask).subspan(q, n),
+                              std::span(session.ask_size).subspan(q, n));
+            q += n;
+        } else {
+            const std::size_t n = std::min(page, session.trade_ns.size() - t);
+            joiner.add_trades("AAPL", std::span(session.trade_ns).subspan(t, n),
+                              std::span(session.price).subspan(t, n),
+                              std::span(session.size).subspan(t, n));
+            t += n;
+        }
+    }
+    joiner.finish();
+    const double elapsed = seconds_since(start);
+
+    const double rows = static_cast<double>(session.quote_ns.size() + session.trade_ns.size());
+    std::cout << "columnar:  " << joined << " trades joined (" << with_quote << " with quote) in "
+              << elapsed * 1e3 << " ms, " << rows / elapsed / 1e6 << " M rows/s\n";
+}
+
+// Response pages with RFC 3339 timestamps, as returned by DataClient; one hour of the session
+// to keep the string footprint small.
+void run_responses(const Session &session, std::size_t page) {
+    const std::int64_t until = session.quote_ns.front() + 3600LL * 1'000'000'000;
+    std::vector<data::StockQuotesResponse> quote_pages;
+    std::vector<data::StockTradesResponse> trade_pages;
+    for (std::size_t i = 0; i < session.quote_ns.size() && session.quote_ns[i] < until; ++i) {
+        if (i % page == 0) {
+            quote_pages.emplace_back();
+        }
+        data::Quote quote;
+        quote.symbol = "AAPL";
+        quote.timestamp = core::format_timestamp_ns(session.quote_ns[i]);
+        quote.bid_price = session.bid[i];
+        quote.ask_price = session.ask[i];
+        quote_pages.back().quotes.push_back(std::move(quote));
+    }
+    for (std::size_t i = 0; i < session.trade_ns.size() && session.trade_ns[i] < until; ++i) {
+        if (i % page == 0) {
+            trade_pages.emplace_back();
+        }
+        data::Trade trade;
+        trade.symbol = "AAPL";
+        trade.timestamp = core::format_timestamp_ns(session.trade_ns[i]);
+        trade.price = session.price[i];
+        trade.size = session.size[i];
+        trade_pages.back().trades.push_back(std::move(trade));
+    }
+
+    std::size_t joined = 0;
+    data::AsOfJoiner joiner(
+        [&](const data::TradeQuoteColumns &batch) { joined += batch.size_rows(); });
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t q = 0;
+    std::size_t t = 0;
+    std::size_t rows = 0;
+    while (q < quote_pages.size() || t < trade_pages.size()) {
+        const bool quotes_behind =
+            t >= trade_pages.size() ||
+            (q < quote_pages.size() &&
+             quote_pages[q].quotes.back().timestamp <= trade_pages[t].trades.back().timestamp);
+        if (quotes_behind) {
+            rows += quote_pages[q].quotes.size();
+            joiner.add_quotes(quote_pages[q++]);
+        } else {
+            rows += trade_pages[t].trades.size();
+            joiner.add_trades(trade_pages[t++]);
+        }
+    }
+    joiner.finish();
+    const double elapsed = seconds_since(start);
+    std::cout << "responses: " << joined << " trades joined in " << elapsed * 1e3 << " ms, "
+              << static_cast<double>(rows) / elapsed / 1e6 << " M rows/s (incl. timestamp parse)\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const std::size_t quotes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5'000'000;
+    const std::size_t trades = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 600'000;
+    const auto session = make_session(quotes, trades);
+    run_columnar(session, 10'000);
+    run_responses(session, 10'000);
+    return 0;
+}
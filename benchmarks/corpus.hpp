@@ -0,0 +1,433 @@
+#pragma once
+
+// Deterministic payload corpus for the parsing benchmarks. Every page mirrors the shape of a
+// recorded API response (field order, string-encoded decimals, RFC 3339 timestamps with
+// nanoseconds, null optionals) at a realistic page size, so parse throughput is representative
+// without shipping megabytes of fixtures.
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace alpaca::bench::corpus {
+
+inline constexpr const char *kSymbols[] = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL",
+                                           "META", "TSLA", "AMD",  "NFLX", "SPY"};
+inline constexpr std::size_t kSymbolCount = sizeof(kSymbols) / sizeof(kSymbols[0]);
+
+namespace detail {
+
+template <typename... Args> void appendf(std::string &out, const char *format, Args... args) {
+    const auto offset = out.size();
+    const auto n = static_cast<std::size_t>(std::snprintf(nullptr, 0, format, args...));
+    out.resize(offset + n + 1);
+    std::snprintf(out.data() + offset, n + 1, format, args...);
+    out.resize(offset + n);
+}
+
+inline void timestamp(std::string &out, int i) {
+    appendf(out, "\"2024-03-%02dT%02d:%02d:%02d.%09dZ\"", 1 + i / 86400 % 28, i / 3600 % 24,
+            i / 60 % 60, i % 60, (i * 7919) % 1000000000);
+}
+
+inline double price(int i) { return 100.0 + (i * 37 % 1000) / 100.0; }
+
+} // namespace detail
+
+// {"bars":{"AAPL":[...],...},"next_page_token":...} with per_symbol bars for each symbol.
+inline std::string stock_bars(std::size_t symbols, int per_symbol) {
+    using namespace detail;
+    std::string out = R"({"bars":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        appendf(out, R"(%s"%s":[)", s ? "," : "", kSymbols[s % kSymbolCount]);
+        for (int i = 0; i < per_symbol; ++i) {
+            const double o = price(i);
+            out += i ? ",{\"t\":" : "{\"t\":";
+            timestamp(out, i * 60);
+            appendf(out, R"(,"o":%.2f,"h":%.2f,"l":%.2f,"c":%.2f,"v":%d,"n":%d,"vw":%.6f})", o,
+                    o + 0.35, o - 0.21, o + 0.08, 1200 + i * 13 % 5000, 15 + i % 90,
+                    o + 0.041234);
+        }
+        out += ']';
+    }
+    out += R"(},"next_page_token":"QUFQTHxNfDIwMjQtMDMtMDFUMTQ6MzA6MDAuMDAwMDAwMDAwWg=="})";
+    return out;
+}
+
+inline std::string stock_trades(std::size_t symbols, int per_symbol) {
+    using namespace detail;
+    std::string out = R"({"trades":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        appendf(out, R"(%s"%s":[)", s ? "," : "", kSymbols[s % kSymbolCount]);
+        for (int i = 0; i < per_symbol; ++i) {
+            out += i ? ",{\"t\":" : "{\"t\":";
+            timestamp(out, i);
+            appendf(out, R"(,"x":"%c","p":%.4f,"s":%d,"c":["@","I"],"i":%lld,"z":"C"})",
+                    "VPQKZD"[i % 6], price(i), 1 + i * 7 % 400, 52983525029461LL + i);
+        }
+        out += ']';
+    }
+    out += R"(},"next_page_token":"QUFQTHwyMDI0LTAzLTAxVDE0OjMwOjAwWnxWfDU1MjE="})";
+    return out;
+}
+
+inline std::string stock_quotes(std::size_t symbols, int per_symbol) {
+    using namespace detail;
+    std::string out = R"({"quotes":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        appendf(out, R"(%s"%s":[)", s ? "," : "", kSymbols[s % kSymbolCount]);
+        for (int i = 0; i < per_symbol; ++i) {
+            const double bid = price(i);
+            out += i ? ",{\"t\":" : "{\"t\":";
+            timestamp(out, i);
+            appendf(out,
+                    R"(,"bx":"%c","bp":%.2f,"bs":%d,"ax":"%c","ap":%.2f,"as":%d,"c":["R"],)"
+                    R"("z":"C"})",
+                    "QPKV"[i % 4], bid, 1 + i % 9, "ZVQP"[i % 4], bid + 0.02, 1 + i % 5);
+        }
+        out += ']';
+    }
+    out += R"(},"next_page_token":null})";
+    return out;
+}
+
+// {"quotes":{"AAPL":{...},...}}: one latest quote per symbol, as polled by dashboards.
+inline std::string stock_latest_quotes(std::size_t symbols) {
+    using namespace detail;
+    std::string out = R"({"quotes":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        const int i = static_cast<int>(s);
+        appendf(out, R"(%s"%s%zu":{"t":)", s ? "," : "", kSymbols[s % kSymbolCount],
+                s / kSymbolCount);
+        timestamp(out, i);
+        appendf(out,
+                R"(,"bx":"%c","bp":%.2f,"bs":%d,"ax":"%c","ap":%.2f,"as":%d,"c":["R"],)"
+                R"("z":"C"})",
+                "QPKV"[i % 4], price(i), 1 + i % 9, "ZVQP"[i % 4], price(i) + 0.02, 1 + i % 5);
+    }
+    out += "}}";
+    return out;
+}
+
+inline std::string stock_snapshots(std::size_t symbols) {
+    using namespace detail;
+    std::string out = R"({"snapshots":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        const int i = static_cast<int>(s);
+        const double p = price(i);
+        appendf(out, R"(%s"%s%zu":{"latestTrade":{"t":)", s ? "," : "",
+                kSymbols[s % kSymbolCount], s / kSymbolCount);
+        timestamp(out, i);
+        appendf(out, R"(,"x":"V","p":%.2f,"s":100,"c":["@"],"i":%d,"z":"C"},"latestQuote":{"t":)",
+                p, 9000 + i);
+        timestamp(out, i);
+        appendf(out,
+                R"(,"bx":"V","bp":%.2f,"bs":2,"ax":"V","ap":%.2f,"as":3,"c":["R"],"z":"C"},)"
+                R"("minuteBar":{"t":"2024-03-01T20:59:00Z","o":%.2f,"h":%.2f,"l":%.2f,)"
+                R"("c":%.2f,"v":18211,"n":402,"vw":%.4f},)"
+                R"("dailyBar":{"t":"2024-03-01T05:00:00Z","o":%.2f,"h":%.2f,"l":%.2f,)"
+                R"("c":%.2f,"v":5842213,"n":88213,"vw":%.4f},)"
+                R"("prevDailyBar":{"t":"2024-02-29T05:00:00Z","o":%.2f,"h":%.2f,"l":%.2f,)"
+                R"("c":%.2f,"v":6120442,"n":90112,"vw":%.4f}})",
+                p - 0.01, p + 0.01, p, p + 0.05, p - 0.03, p, p + 0.02, p - 1.2, p + 1.4, p - 1.5,
+                p, p - 0.1, p - 2.0, p - 0.5, p - 3.1, p - 1.2, p - 1.8);
+    }
+    out += "}}";
+    return out;
+}
+
+inline std::string crypto_orderbooks(std::size_t symbols, int depth) {
+    using namespace detail;
+    std::string out = R"({"orderbooks":{)";
+    for (std::size_t s = 0; s < symbols; ++s) {
+        appendf(out, R"(%s"%s/USD":{"t":)", s ? "," : "", kSymbols[s % kSymbolCount]);
+        detail::timestamp(out, static_cast<int>(s));
+        for (const char *side : {",\"b\":[", "],\"a\":["}) {
+            out += side;
+            for (int i = 0; i < depth; ++i) {
+                const double offset = side[2] == 'b' ? -i * 0.5 : i * 0.5;
+                appendf(out, R"(%s{"p":%.1f,"s":%.8f})", i ? "," : "", 62000.0 + offset,
+                        0.01 + i * 0.0371);
+            }
+        }
+        out += R"(],"r":false})";
+    }
+    out += "}}";
+    return out;
+}
+
+// One options chain page: calls and puts across strikes and expirations with greeks.
+inline std::string option_chain(int expirations, int strikes) {
+    using namespace detail;
+    std::string out = R"({"snapshots":{)";
+    bool first = true;
+    for (int e = 0; e < expirations; ++e) {
+        for (int k = 0; k < strikes; ++k) {
+            for (const char side : {'C', 'P'}) {
+                const int strike = 150 + k * 5;
+                const double moneyness = k * 0.9 / strikes;
+                const double delta = side == 'C' ? 0.95 - moneyness : -0.05 - moneyness;
+                appendf(out, R"(%s"AAPL24%02d%02d%c%08d":{"latestQuote":{"t":)", first ? "" : ",",
+                        3 + e / 4, 1 + e % 4 * 7, side, strike * 1000);
+                first = false;
+                timestamp(out, k);
+                appendf(out,
+                        R"(,"ax":"C","ap":%.2f,"as":12,"bx":"X","bp":%.2f,"bs":40,"c":"A"},)"
+                        R"("latestTrade":{"t":)",
+                        2.5 + k * 0.1, 2.4 + k * 0.1);
+                timestamp(out, k + 30);
+                appendf(out,
+                        R"(,"x":"C","p":%.2f,"s":3,"c":"I"},"impliedVolatility":%.6f,)"
+                        R"("greeks":{"delta":%.6f,"gamma":%.6f,"theta":%.6f,"vega":%.6f,)"
+                        R"("rho":%.6f}})",
+                        2.45 + k * 0.1, 0.21 + k * 0.003, delta, 0.031 - k * 0.0004,
+                        -0.08 - e * 0.01, 0.12 + e * 0.02, 0.01 * (side == 'C' ? 1 : -1));
+            }
+        }
+    }
+    out += R"(},"next_page_token":"QUFQTDI0MDQxOUMwMDIwMDAwMA=="})";
+    return out;
+}
+
+inline std::string news(int articles, std::size_t content_bytes) {
+    using namespace detail;
+    const std::string content(content_bytes, 'x');
+    std::string out = R"({"news":[)";
+    for (int i = 0; i < articles; ++i) {
+        appendf(out,
+                R"(%s{"id":%d,"headline":"%s shares rise after quarterly results beat )"
+                R"(estimates","author":"Benzinga Newsdesk","created_at":)",
+                i ? "," : "", 37521000 + i, kSymbols[static_cast<std::size_t>(i) % kSymbolCount]);
+        timestamp(out, i * 300);
+        out += R"(,"updated_at":)";
+        timestamp(out, i * 300 + 45);
+        appendf(out,
+                R"(,"summary":"Revenue of $%d.%d billion topped consensus; guidance )"
+                R"(raised for the full year.","content":"<p>%s</p>","images":[)"
+                R"({"size":"large",)"
+                R"("url":"https://cdn.benzinga.com/files/images/story/%d/lg.jpg"},)"
+                R"({"size":"small",)"
+                R"("url":"https://cdn.benzinga.com/files/images/story/%d/sm.jpg"},)"
+                R"({"size":"thumb",)"
+                R"("url":"https://cdn.benzinga.com/files/images/story/%d/th.jpg"}],)"
+                R"("symbols":["%s","%s"],"source":"benzinga",)"
+                R"("url":"https://www.benzinga.com/news/earnings/24/03/%d"})",
+                80 + i % 40, i % 10, content.c_str(), i, i, i,
+                kSymbols[static_cast<std::size_t>(i) % kSymbolCount],
+                kSymbols[static_cast<std::size_t>(i + 1) % kSymbolCount], 37521000 + i);
+    }
+    out += R"(],"next_page_token":"MTcwOTMwNTIwMDAwMDAwMDAwMHwzNzUyMTAwMA=="})";
+    return out;
+}
+
+inline std::string corporate_actions(int per_group) {
+    using namespace detail;
+    std::string out = R"({"cash_dividends":[)";
+    for (int i = 0; i < per_group; ++i) {
+        appendf(out,
+                R"(%s{"id":"0c1b%04d-2f5e-4d9a-9a31-6d1f2c7e%04d","symbol":"%s",)"
+                R"("cusip":"0378331%02d","rate":%.4f,"special":false,"foreign":false,)"
+                R"("process_date":"2024-02-%02d","ex_date":"2024-02-%02d",)"
+                R"("record_date":"2024-02-%02d","payable_date":"2024-02-%02d"})",
+                i ? "," : "", i, i, kSymbols[static_cast<std::size_t>(i) % kSymbolCount], i % 100,
+                0.24 + i % 10 * 0.01, 1 + i % 27, 1 + i % 27, 2 + i % 26, 1 + i % 27);
+    }
+    out += R"(],"forward_splits":[)";
+    for (int i = 0; i < per_group; ++i) {
+        appendf(out,
+                R"(%s{"id":"5a8e%04d-77c3-4b1e-8f60-1e9b3a4d%04d","symbol":"%s",)"
+                R"("cusip":"67066G1%02d","new_rate":%d,"old_rate":1,)"
+                R"("process_date":"2024-06-%02d","ex_date":"2024-06-%02d",)"
+                R"("record_date":"2024-06-%02d","payable_date":"2024-06-%02d",)"
+                R"("due_bill_redemption_date":"2024-06-%02d"})",
+                i ? "," : "", i, i, kSymbols[static_cast<std::size_t>(i) % kSymbolCount], i % 100,
+                2 + i % 9, 1 + i % 27, 1 + i % 27, 1 + i % 27, 1 + i % 27, 2 + i % 26);
+    }
+    out += R"(],"next_page_token":null})";
+    return out;
+}
+
+inline std::string order_object(int i) {
+    using namespace detail;
+    std::string out;
+    appendf(out,
+            R"({"id":"61e69015-8549-4bfd-b9c3-01e75843%04d",)"
+            R"("client_order_id":"eb9e2aaa-f71a-4f51-b5b4-52a6c565%04d",)"
+            R"("created_at":"2024-03-01T14:30:%02d.164532Z",)"
+            R"("updated_at":"2024-03-01T14:30:%02d.312788Z",)"
+            R"("submitted_at":"2024-03-01T14:30:%02d.160123Z",)"
+            R"("filled_at":"2024-03-01T14:30:%02d.301457Z","expired_at":null,)"
+            R"("canceled_at":null,"failed_at":null,"replaced_at":null,"replaced_by":null,)"
+            R"("replaces":null,"asset_id":"b0b6dd9d-8b9b-48a9-ba46-b9d54906%04d",)"
+            R"("symbol":"%s","asset_class":"us_equity","notional":null,"qty":"%d",)"
+            R"("filled_qty":"%d","filled_avg_price":"%.2f","order_class":"",)"
+            R"("order_type":"%s","type":"%s","side":"%s","time_in_force":"day",)"
+            R"("limit_price":%s,"stop_price":null,"status":"filled","extended_hours":false,)"
+            R"("legs":null,"trail_percent":null,"trail_price":null,"hwm":null,)"
+            R"("subtag":null,"source":null})",
+            i % 10000, i % 10000, i % 60, i % 60, i % 60, i % 60, i % 10000,
+            kSymbols[static_cast<std::size_t>(i) % kSymbolCount], 1 + i % 500, 1 + i % 500,
+            detail::price(i), i % 3 ? "limit" : "market", i % 3 ? "limit" : "market",
+            i % 2 ? "sell" : "buy", i % 3 ? "\"189.50\"" : "null");
+    return out;
+}
+
+inline std::string orders(int count) {
+    std::string out = "[";
+    for (int i = 0; i < count; ++i) {
+        if (i) {
+            out += ',';
+        }
+        out += order_object(i);
+    }
+    out += ']';
+    return out;
+}
+
+inline std::string positions(std::size_t count) {
+    using namespace detail;
+    std::string out = "[";
+    for (std::size_t s = 0; s < count; ++s) {
+        const int i = static_cast<int>(s);
+        const double avg = price(i);
+        const double cur = avg * 1.031;
+        const int qty = 10 + i * 17 % 900;
+        appendf(out,
+                R"(%s{"asset_id":"904837e3-3b76-47ec-b432-046db621%04d","symbol":"%s%zu",)"
+                R"("exchange":"NASDAQ","asset_class":"us_equity","asset_marginable":true,)"
+                R"("qty":"%d","avg_entry_price":"%.4f","side":"long","market_value":"%.2f",)"
+                R"("cost_basis":"%.2f","unrealized_pl":"%.2f","unrealized_plpc":"0.031",)"
+                R"("unrealized_intraday_pl":"%.2f","unrealized_intraday_plpc":"0.0042",)"
+                R"("current_price":"%.2f","lastday_price":"%.2f","change_today":"0.0042",)"
+                R"("qty_available":"%d"})",
+                s ? "," : "", i, kSymbols[s % kSymbolCount], s / kSymbolCount, qty, avg,
+                cur * qty, avg * qty, (cur - avg) * qty, cur * 0.0042 * qty, cur, cur / 1.0042,
+                qty);
+    }
+    out += ']';
+    return out;
+}
+
+// /v2/assets: the full tradable universe is ~12k entries and is fetched at start-up.
+inline std::string assets(std::size_t count) {
+    using namespace detail;
+    std::string out = "[";
+    for (std::size_t s = 0; s < count; ++s) {
+        const int i = static_cast<int>(s);
+        appendf(out,
+                R"(%s{"id":"b0b6dd9d-8b9b-48a9-ba46-b9d54906%04d","class":"us_equity",)"
+                R"("exchange":"%s","symbol":"%s%zu","name":"%s %zu Inc. Common Stock",)"
+                R"("status":"active","tradable":true,"marginable":%s,"shortable":%s,)"
+                R"("easy_to_borrow":%s,"fractionable":true,)"
+                R"("maintenance_margin_requirement":%d,"attributes":[]})",
+                s ? "," : "", i % 10000, i % 3 ? "NASDAQ" : "NYSE", kSymbols[s % kSymbolCount],
+                s / kSymbolCount, kSymbols[s % kSymbolCount], s / kSymbolCount,
+                i % 5 ? "true" : "false", i % 4 ? "true" : "false", i % 4 ? "true" : "false",
+                i % 5 ? 30 : 100);
+    }
+    out += ']';
+    return out;
+}
+
+inline std::string trading_account() {
+    return R"({"id":"904837e3-3b76-47ec-b432-046db621571b","admin_configurations":{},)"
+           R"("user_configurations":null,"account_number":"PA3K2BGM4C2F","status":"ACTIVE",)"
+           R"("crypto_status":"ACTIVE","options_approved_level":2,"options_trading_level":2,)"
+           R"("currency":"USD","buying_power":"261877.64","regt_buying_power":"261877.64",)"
+           R"("daytrading_buying_power":"0","effective_buying_power":"261877.64",)"
+           R"("non_marginable_buying_power":"130938.82","options_buying_power":"130938.82",)"
+           R"("bod_dtbp":"0","cash":"130938.82","accrued_fees":"0","pending_transfer_in":"0",)"
+           R"("portfolio_value":"130938.82","pattern_day_trader":false,)"
+           R"("trading_blocked":false,"transfers_blocked":false,"account_blocked":false,)"
+           R"("created_at":"2023-11-06T19:55:41.181437Z","trade_suspended_by_user":false,)"
+           R"("multiplier":"2","shorting_enabled":true,"equity":"130938.82",)"
+           R"("last_equity":"130412.77","long_market_value":"0","short_market_value":"0",)"
+           R"("position_market_value":"0","initial_margin":"0","maintenance_margin":"0",)"
+           R"("last_maintenance_margin":"0","sma":"131002.15","daytrade_count":0,)"
+           R"("balance_asof":"2024-02-29","crypto_tier":1,"intraday_adjustments":"0",)"
+           R"("pending_reg_taf_fees":"0"})";
+}
+
+inline std::string broker_accounts(int count) {
+    using namespace detail;
+    std::string out = "[";
+    for (int i = 0; i < count; ++i) {
+        appendf(out,
+                R"(%s{"id":"b9b19618-22dd-4e80-8432-fc9e1ba0%04d","account_number":"9%08d",)"
+                R"("status":"ACTIVE","crypto_status":"INACTIVE","currency":"USD",)"
+                R"("last_equity":"%d.%02d","created_at":"2024-01-%02dT17:09:%02d.155364Z",)"
+                R"("account_type":"trading","account_sub_type":null,)"
+                R"("contact":{"email_address":"user%d@example.com","phone_number":)"
+                R"("555-666-%04d","street_address":["20 N San Mateo Dr"],"unit":"Apt 1A",)"
+                R"("city":"San Mateo","state":"CA","postal_code":"94401","country":"USA"},)"
+                R"("identity":{"given_name":"John","middle_name":null,"family_name":"Doe",)"
+                R"("date_of_birth":"1990-01-01","tax_id_type":"USA_SSN",)"
+                R"("country_of_citizenship":"USA","country_of_birth":"USA",)"
+                R"("country_of_tax_residence":"USA","funding_source":["employment_income"],)"
+                R"("annual_income_min":"30000","annual_income_max":"50000"},)"
+                R"("disclosures":{"is_control_person":false,)"
+                R"("is_affiliated_exchange_or_finra":false,"is_politically_exposed":false,)"
+                R"("immediate_family_exposed":false,"employment_status":"employed",)"
+                R"("employer_name":"Acme Corp","employer_address":"1 Main St",)"
+                R"("employment_position":"Engineer"},)"
+                R"("agreements":[{"agreement":"margin_agreement",)"
+                R"("signed_at":"2024-01-%02dT17:09:00Z","ip_address":"127.0.0.1",)"
+                R"("revision":"16.2021.05"},{"agreement":"account_agreement",)"
+                R"("signed_at":"2024-01-%02dT17:09:00Z","ip_address":"127.0.0.1",)"
+                R"("revision":"16.2021.05"},{"agreement":"customer_agreement",)"
+                R"("signed_at":"2024-01-%02dT17:09:00Z","ip_address":"127.0.0.1",)"
+                R"("revision":"16.2021.05"}],"documents":[]})",
+                i ? "," : "", i % 10000, 10000 + i, 1000 + i * 37 % 90000, i % 100, 1 + i % 28,
+                i % 60, i, i % 10000, 1 + i % 28, 1 + i % 28, 1 + i % 28);
+    }
+    out += ']';
+    return out;
+}
+
+// Websocket frames: arrays of stream messages as the market data endpoints batch them.
+inline std::string stock_stream_frame(int messages) {
+    using namespace detail;
+    std::string out = "[";
+    for (int i = 0; i < messages; ++i) {
+        const char *symbol = kSymbols[static_cast<std::size_t>(i) % kSymbolCount];
+        const double p = price(i);
+        out += i ? "," : "";
+        if (i % 5 == 0) {
+            appendf(out, R"({"T":"t","S":"%s","i":%d,"x":"V","p":%.2f,"s":%d,"c":["@"],"z":"C",)"
+                         R"("t":)",
+                    symbol, 96921 + i, p, 1 + i % 300);
+        } else {
+            appendf(out, R"({"T":"q","S":"%s","bx":"V","bp":%.2f,"bs":%d,"ax":"V","ap":%.2f,)"
+                         R"("as":%d,"c":["R"],"z":"C","t":)",
+                    symbol, p, 1 + i % 9, p + 0.02, 1 + i % 7);
+        }
+        timestamp(out, i);
+        out += '}';
+    }
+    out += ']';
+    return out;
+}
+
+inline std::string crypto_stream_frame(int messages) {
+    using namespace detail;
+    std::string out = "[";
+    for (int i = 0; i < messages; ++i) {
+        const char *symbol = kSymbols[static_cast<std::size_t>(i) % kSymbolCount];
+        const double p = 62000.0 + i % 100;
+        out += i ? "," : "";
+        if (i % 4 == 0) {
+            appendf(out, R"({"T":"o","S":"%s/USD","b":[{"p":%.1f,"s":0.5},{"p":%.1f,"s":1.25}],)"
+                         R"("a":[{"p":%.1f,"s":0.75}],"r":false,"t":)",
+                    symbol, p, p - 0.5, p + 0.5);
+        } else {
+            appendf(out, R"({"T":"t","S":"%s/USD","p":%.1f,"s":%.8f,"tks":"%c","i":%d,"t":)",
+                    symbol, p, 0.001 + i * 0.0003, i % 2 ? 'B' : 'S', 31200 + i);
+        }
+        timestamp(out, i);
+        out += '}';
+    }
+    out += ']';
+    return out;
+}
+
+} // namespace alpaca::bench::corpus
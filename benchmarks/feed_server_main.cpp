@@ -0,0 +1,32 @@
+// Standalone synthetic market data feed for pointing any client at a local endpoint.
+//
+//   alpaca_feed_server [port=8443] [msgs/s per connection, 0 = unthrottled] [symbols=100]
+//
+// Stock clients connect to wss://127.0.0.1:<port>/v2/iex, crypto clients to
+// wss://127.0.0.1:<port>/v1beta3/crypto/us. Runs until stdin is closed or a line is entered.
+
+#include "synthetic_feed_server.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv) {
+    alpaca::bench::FeedServerOptions options;
+    options.port = static_cast<unsigned short>(argc > 1 ? std::atoi(argv[1]) : 8443);
+    options.messages_per_second = argc > 2 ? std::atof(argv[2]) : 0.0;
+    options.symbols = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100;
+
+    alpaca::bench::SyntheticFeedServer server(options);
+    server.start();
+    std::cout << "Serving " << server.url() << " and " << server.url("/v1beta3/crypto/us")
+              << "; press enter to stop\n";
+    std::string line;
+    std::getline(std::cin, line);
+    server.stop();
+
+    const auto stats = server.stats();
+    std::cout << "Sent " << stats.messages << " messages in " << stats.frames << " frames ("
+              << stats.bytes << " bytes) over " << stats.connections << " connection(s)\n";
+    return 0;
+}
@@ -0,0 +1,218 @@
+// Sustained-throughput load test of StockDataStream / CryptoDataStream against the synthetic
+// feed server (or any endpoint speaking the same protocol), through the real url_override,
+// TLS, websocket and dispatch path.
+//
+//   alpaca_stream_load_test [--rate=<msgs/s, 0 = unthrottled>] [--seconds=10] [--warmup=1]
+//                           [--symbols=100] [--batch=100] [--crypto] [--url=wss://...]
+//                           [--low-latency] [--cpu=<n>]
+//
+// --low-latency switches the reader to busy-poll mode (DataStream::enable_low_latency) and
+// --cpu pins the reader thread to that CPU (implies --low-latency), so jitter can be compared
+// against the default blocking reader.
+// Reports delivered messages per second, wire MB/s, drops (messages the server sent that no
+// handler saw, plus gaps in the trade sequence numbers) and latency percentiles from the
+// stream's own histograms. With --url the server side is external and only gaps are counted.
+
+#include "synthetic_feed_server.hpp"
+
+#include "alpaca/data/live/crypto.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace alpaca;
+
+namespace {
+
+struct Args {
+    double rate{0.0};
+    double seconds{10.0};
+    double warmup{1.0};
+    std::size_t symbols{100};
+    std::size_t batch{100};
+    bool crypto{false};
+    std::optional<std::string> url;
+    bool low_latency{false};
+    std::optional<int> cpu;
+};
+
+Args parse_args(int argc, char **argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        const auto eq = arg.find('=');
+        const std::string_view name = arg.substr(0, eq);
+        const std::string value(eq == std::string_view::npos ? "" : arg.substr(eq + 1));
+        if (name == "--rate") {
+            args.rate = std::stod(value);
+        } else if (name == "--seconds") {
+            args.seconds = std::stod(value);
+        } else if (name == "--warmup") {
+            args.warmup = std::stod(value);
+        } else if (name == "--symbols") {
+            args.symbols = std::stoul(value);
+        } else if (name == "--batch") {
+            args.batch = std::stoul(value);
+        } else if (name == "--crypto") {
+            args.crypto = true;
+        } else if (name == "--url") {
+            args.url = value;
+        } else if (name == "--low-latency") {
+            args.low_latency = true;
+        } else if (name == "--cpu") {
+            args.cpu = std::stoi(value);
+            args.low_latency = true;
+        } else {
+            std::cerr << "unknown argument: " << arg << '\n';
+            std::exit(2);
+        }
+    }
+    return args;
+}
+
+// Counts delivered events and gaps in the trade sequence numbers; only the reader thread
+// writes, the main thread samples.
+struct Counters {
+    std::atomic<std::uint64_t> events{0};
+    std::atomic<std::uint64_t> gaps{0};
+    std::uint64_t last_trade_id{0};
+
+    void trade(const data::Trade &trade) {
+        std::uint64_t id = 0;
+        if (trade.id) {
+            std::from_chars(trade.id->data(), trade.id->data() + trade.id->size(), id);
+        }
+        if (id < last_trade_id) {
+            last_trade_id = 0; // a new connection restarts the sequence
+        }
+        if (last_trade_id != 0 && id > last_trade_id + 1) {
+            gaps.fetch_add(id - last_trade_id - 1, std::memory_order_relaxed);
+        }
+        last_trade_id = id;
+        events.fetch_add(1, std::memory_order_relaxed);
+    }
+    void other() { events.fetch_add(1, std::memory_order_relaxed); }
+};
+
+template <typename Stream> void subscribe(Stream &stream, Counters &counters) {
+    const std::vector<std::string> all{"*"};
+    stream.subscribe_trades([&](const data::Trade &t) { counters.trade(t); }, all);
+    stream.subscribe_quotes([&](const data::Quote &) { counters.other(); }, all);
+    stream.subscribe_bars([&](const data::Bar &) { counters.other(); }, all);
+    if constexpr (requires { stream.subscribe_orderbooks(data::live::OrderbookHandler{}, {}); }) {
+        stream.subscribe_orderbooks([&](const data::Orderbook &) { counters.other(); }, all);
+    }
+}
+
+void print_histogram(std::string_view name, const core::LatencyHistogram &histogram) {
+    const auto s = histogram.summary();
+    const auto us = [](std::int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::cout << "  " << std::left << std::setw(18) << name << std::right << " p50 "
+              << std::setw(9) << us(s.p50) << " us  p99 " << std::setw(9) << us(s.p99)
+              << " us  p99.9 " << std::setw(9) << us(s.p999) << " us  max " << std::setw(9)
+              << us(s.max) << " us\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const Args args = parse_args(argc, argv);
+
+    std::unique_ptr<bench::SyntheticFeedServer> server;
+    std::string url;
+    if (args.url) {
+        url = *args.url;
+    } else {
+        bench::FeedServerOptions options;
+        options.messages_per_second = args.rate;
+        options.messages_per_frame = args.batch;
+        options.symbols = args.symbols;
+        server = std::make_unique<bench::SyntheticFeedServer>(options);
+        server->start();
+        url = server->url(args.crypto ? "/v1beta3/crypto/us" : "/v2/iex");
+    }
+
+    std::unique_ptr<data::live::DataStream> stream;
+    Counters counters;
+    if (args.crypto) {
+        auto crypto = std::make_unique<data::live::CryptoDataStream>(
+            "key", "secret", false, data::CryptoFeed::Us, url);
+        subscribe(*crypto, counters);
+        stream = std::move(crypto);
+    } else {
+        auto stock = std::make_unique<data::live::StockDataStream>("key", "secret", false,
+                                                                   data::DataFeed::Iex, url);
+        subscribe(*stock, counters);
+        stream = std::move(stock);
+    }
+    stream->enable_latency_stats();
+    if (args.low_latency) {
+        data::live::LowLatencyOptions low_latency;
+        low_latency.cpu = args.cpu;
+        stream->enable_low_latency(low_latency);
+    }
+    stream->run();
+
+    const auto sleep_s = [](double s) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(s));
+    };
+    sleep_s(args.warmup);
+    stream->latency_stats()->reset();
+    const std::uint64_t events_start = counters.events.load();
+    const std::uint64_t bytes_start = server ? server->stats().bytes : 0;
+    const auto start = std::chrono::steady_clock::now();
+    sleep_s(args.seconds);
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const std::uint64_t events = counters.events.load() - events_start;
+    const std::uint64_t bytes = server ? server->stats().bytes - bytes_start : 0;
+
+    // Stop the server first so the client drains everything sent before the close frame.
+    std::optional<bench::FeedServerStats> sent;
+    if (server) {
+        server->stop();
+        sent = server->stats();
+        for (int i = 0; i < 200 && counters.events.load() < sent->messages; ++i) {
+            sleep_s(0.01);
+        }
+    }
+    stream->stop();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << (args.crypto ? "CryptoDataStream" : "StockDataStream") << " <- " << url;
+    if (args.low_latency) {
+        std::cout << " (busy-poll reader"
+                  << (args.cpu ? ", pinned to CPU " + std::to_string(*args.cpu) : "") << ')';
+    }
+    std::cout << '\n';
+    std::cout << "  delivered         " << events << " messages in " << elapsed << " s = "
+              << static_cast<double>(events) / elapsed / 1e6 << " M msgs/s";
+    if (server) {
+        std::cout << ", " << static_cast<double>(bytes) / elapsed / 1e6 << " MB/s on the wire";
+    }
+    std::cout << '\n';
+    if (sent) {
+        const std::uint64_t delivered = counters.events.load();
+        std::cout << "  drops             "
+                  << (sent->messages > delivered ? sent->messages - delivered : 0) << " of "
+                  << sent->messages << " sent over " << sent->connections << " connection(s)\n";
+    }
+    std::cout << "  trade seq gaps    " << counters.gaps.load() << '\n';
+    const auto *stats = stream->latency_stats();
+    print_histogram("receive->parse", stats->receive_to_parse);
+    print_histogram("parse->handler", stats->parse_to_handler);
+    print_histogram("handler", stats->handler);
+    print_histogram("server->handler", stats->exchange_to_local);
+    return 0;
+}
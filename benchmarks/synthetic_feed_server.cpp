@@ -0,0 +1,477 @@
+#include "synthetic_feed_server.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <simdjson/ondemand.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace alpaca::bench {
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+using tcp = boost::asio::ip::tcp;
+using WebSocket = websocket::stream<beast::ssl_stream<tcp::socket>>;
+
+namespace {
+
+// Loads a fresh P-256 key and a one-day self-signed certificate for CN=localhost.
+void use_self_signed_certificate(ssl::context &tls) {
+    struct Free {
+        void operator()(EVP_PKEY_CTX *p) const { EVP_PKEY_CTX_free(p); }
+        void operator()(EVP_PKEY *p) const { EVP_PKEY_free(p); }
+        void operator()(X509 *p) const { X509_free(p); }
+    };
+    std::unique_ptr<EVP_PKEY_CTX, Free> keygen(EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr));
+    EVP_PKEY *raw_key = nullptr;
+    if (!keygen || EVP_PKEY_keygen_init(keygen.get()) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keygen.get(), NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(keygen.get(), &raw_key) <= 0) {
+        throw std::runtime_error("SyntheticFeedServer: key generation failed");
+    }
+    std::unique_ptr<EVP_PKEY, Free> key(raw_key);
+
+    std::unique_ptr<X509, Free> cert(X509_new());
+    X509_NAME *name = cert ? X509_get_subject_name(cert.get()) : nullptr;
+    const auto *common_name = reinterpret_cast<const unsigned char *>("localhost");
+    if (!name || X509_set_version(cert.get(), 2) != 1 ||
+        ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1) != 1 ||
+        !X509_gmtime_adj(X509_getm_notBefore(cert.get()), -3600) ||
+        !X509_gmtime_adj(X509_getm_notAfter(cert.get()), 86400) ||
+        X509_set_pubkey(cert.get(), key.get()) != 1 ||
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, common_name, -1, -1, 0) != 1 ||
+        X509_set_issuer_name(cert.get(), name) != 1 ||
+        X509_sign(cert.get(), key.get(), EVP_sha256()) <= 0 ||
+        SSL_CTX_use_certificate(tls.native_handle(), cert.get()) != 1 ||
+        SSL_CTX_use_PrivateKey(tls.native_handle(), key.get()) != 1) {
+        throw std::runtime_error("SyntheticFeedServer: certificate setup failed");
+    }
+}
+
+void append_int(std::string &out, std::uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void append_price(std::string &out, double value) {
+    char buffer[32];
+    const auto result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 2);
+    out.append(buffer, result.ptr);
+}
+
+// xorshift64*: cheap enough not to show up next to TLS and JSON formatting.
+class Random {
+  public:
+    explicit Random(std::uint64_t seed) : state_(seed | 1) {}
+    std::uint64_t next() noexcept {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 0x2545F4914F6CDD1DULL;
+    }
+    double unit() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+  private:
+    std::uint64_t state_;
+};
+
+struct Channel {
+    std::string name; // subscription key, e.g. "trades"
+    char type;        // message "T"
+    double weight;
+    std::vector<std::string> symbols;
+};
+
+std::vector<Channel> channels_for(const FeedServerOptions &options, bool crypto) {
+    std::vector<Channel> channels{{"trades", 't', options.trade_weight, {}},
+                                  {"quotes", 'q', options.quote_weight, {}},
+                                  {"bars", 'b', options.bar_weight, {}},
+                                  {"updatedBars", 'u', options.bar_weight, {}},
+                                  {"dailyBars", 'd', options.bar_weight, {}}};
+    if (crypto) {
+        channels.push_back({"orderbooks", 'o', options.orderbook_weight, {}});
+    }
+    return channels;
+}
+
+// Fills the symbols of each channel named in a subscribe message; "*" expands to the universe.
+// Returns false when the message is not a subscribe action.
+bool parse_subscription(const std::string &message, std::vector<Channel> &channels,
+                        std::size_t universe, bool crypto) {
+    simdjson::ondemand::parser parser;
+    simdjson::padded_string json(message);
+    auto doc = parser.iterate(json);
+    auto object = doc.get_object();
+    if (object.error()) {
+        return false;
+    }
+    bool subscribe = false;
+    for (auto field : object.value()) {
+        auto key = field.unescaped_key();
+        if (key.error()) {
+            return false;
+        }
+        const std::string_view name = key.value();
+        if (name == "action") {
+            auto action = field.value().get_string();
+            subscribe = !action.error() && action.value() == "subscribe";
+            continue;
+        }
+        auto channel = std::find_if(channels.begin(), channels.end(),
+                                    [&](const Channel &c) { return c.name == name; });
+        auto symbols = field.value().get_array();
+        if (channel == channels.end() || symbols.error()) {
+            continue;
+        }
+        for (auto symbol : symbols.value()) {
+            auto text = symbol.get_string();
+            if (text.error()) {
+                continue;
+            }
+            if (text.value() == "*") {
+                for (std::size_t i = 0; i < universe; ++i) {
+                    channel->symbols.push_back("SYM" + std::to_string(i) +
+                                               (crypto ? "/USD" : ""));
+                }
+            } else {
+                channel->symbols.emplace_back(text.value());
+            }
+        }
+    }
+    return subscribe;
+}
+
+std::string subscription_ack(const std::vector<Channel> &channels) {
+    std::string ack = R"([{"T":"subscription")";
+    for (const auto &channel : channels) {
+        ack += ",\"" + channel.name + "\":[";
+        for (std::size_t i = 0; i < channel.symbols.size(); ++i) {
+            ack += (i == 0 ? "\"" : ",\"") + channel.symbols[i] + '"';
+        }
+        ack += ']';
+    }
+    return ack + "}]";
+}
+
+} // namespace
+
+struct SyntheticFeedServer::Impl {
+    explicit Impl(FeedServerOptions opts) : options(std::move(opts)) {}
+
+    FeedServerOptions options;
+    net::io_context ioc;
+    ssl::context tls{ssl::context::tls_server};
+    tcp::acceptor acceptor{ioc};
+    std::thread accept_thread;
+    unsigned short port{0};
+    std::atomic<bool> running{false};
+
+    std::mutex mutex;
+    std::vector<std::thread> sessions;
+    std::vector<tcp::socket *> sockets; // live connections, shut down by stop()
+    std::atomic<std::size_t> active{0};
+
+    std::atomic<std::uint64_t> connections{0};
+    std::atomic<std::uint64_t> frames{0};
+    std::atomic<std::uint64_t> messages{0};
+    std::atomic<std::uint64_t> bytes{0};
+
+    void accept() {
+        acceptor.async_accept([this](boost::system::error_code ec, tcp::socket socket) {
+            if (ec || !running) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ++active;
+            sessions.emplace_back(&Impl::serve, this, std::move(socket));
+            accept();
+        });
+    }
+
+    // Keeps a connection's socket reachable from stop() while its session runs.
+    class Registration {
+      public:
+        Registration(Impl &impl, tcp::socket &socket) : impl_(impl), socket_(&socket) {
+            std::lock_guard<std::mutex> lock(impl_.mutex);
+            impl_.sockets.push_back(socket_);
+        }
+        ~Registration() {
+            std::lock_guard<std::mutex> lock(impl_.mutex);
+            std::erase(impl_.sockets, socket_);
+        }
+        Registration(const Registration &) = delete;
+        Registration &operator=(const Registration &) = delete;
+
+      private:
+        Impl &impl_;
+        tcp::socket *socket_;
+    };
+
+    void serve(tcp::socket socket) {
+        try {
+            WebSocket ws(std::move(socket), tls);
+            Registration registration(*this, beast::get_lowest_layer(ws));
+            ws.next_layer().handshake(ssl::stream_base::server);
+            beast::flat_buffer buffer;
+            http::request<http::string_body> upgrade;
+            http::read(ws.next_layer(), buffer, upgrade);
+            const bool crypto = upgrade.target().find("crypto") != std::string_view::npos;
+            ws.accept(upgrade);
+            ws.text(true);
+            session(ws, crypto);
+        } catch (const std::exception &) {
+            // Client went away or the server is stopping.
+        }
+        --active;
+    }
+
+    void session(WebSocket &ws, bool crypto) {
+        ++connections;
+        ws.write(net::buffer(std::string_view(R"([{"T":"success","msg":"connected"}])")));
+
+        beast::flat_buffer buffer;
+        ws.read(buffer);
+        const std::string auth = beast::buffers_to_string(buffer.data());
+        buffer.consume(buffer.size());
+        const bool authorized =
+            auth.find(R"("action":"auth")") != std::string::npos &&
+            (options.key.empty() || auth.find('"' + options.key + '"') != std::string::npos) &&
+            (options.secret.empty() || auth.find('"' + options.secret + '"') != std::string::npos);
+        if (!authorized) {
+            ws.write(net::buffer(
+                std::string_view(R"([{"T":"error","code":402,"msg":"auth failed"}])")));
+            ws.close(websocket::close_code::policy_error);
+            return;
+        }
+        ws.write(net::buffer(std::string_view(R"([{"T":"success","msg":"authenticated"}])")));
+
+        ws.read(buffer);
+        const std::string subscribe = beast::buffers_to_string(buffer.data());
+        buffer.consume(buffer.size());
+        auto channels = channels_for(options, crypto);
+        if (!parse_subscription(subscribe, channels, options.symbols, crypto)) {
+            ws.write(net::buffer(
+                std::string_view(R"([{"T":"error","code":400,"msg":"invalid syntax"}])")));
+            ws.close(websocket::close_code::policy_error);
+            return;
+        }
+        ws.write(net::buffer(subscription_ack(channels)));
+        std::erase_if(channels, [](const Channel &c) {
+            return c.symbols.empty() || c.weight <= 0.0;
+        });
+        stream(ws, channels);
+        boost::system::error_code ec;
+        ws.close(websocket::close_code::normal, ec);
+    }
+
+    void stream(WebSocket &ws, const std::vector<Channel> &channels) {
+        if (channels.empty()) {
+            while (running) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            return;
+        }
+        double total_weight = 0.0;
+        for (const auto &channel : channels) {
+            total_weight += channel.weight;
+        }
+        Random random(static_cast<std::uint64_t>(core::now_ns()));
+        const std::size_t batch = std::max<std::size_t>(options.messages_per_frame, 1);
+        const auto start = std::chrono::steady_clock::now();
+        std::uint64_t sent = 0;
+        std::uint64_t sequence = 0;
+        std::string frame;
+        frame.reserve(batch * 256);
+
+        while (running) {
+            if (options.messages_per_second > 0.0) {
+                const double due_s = static_cast<double>(sent) / options.messages_per_second;
+                std::this_thread::sleep_until(
+                    start + std::chrono::nanoseconds(static_cast<std::int64_t>(due_s * 1e9)));
+            }
+            const std::string timestamp = core::format_timestamp_ns(core::now_ns());
+            frame.assign(1, '[');
+            for (std::size_t m = 0; m < batch; ++m) {
+                double pick = random.unit() * total_weight;
+                const Channel *channel = &channels.back();
+                for (const auto &candidate : channels) {
+                    if (pick < candidate.weight) {
+                        channel = &candidate;
+                        break;
+                    }
+                    pick -= candidate.weight;
+                }
+                const std::size_t index = random.next() % channel->symbols.size();
+                if (m > 0) {
+                    frame += ',';
+                }
+                append_message(frame, *channel, channel->symbols[index], timestamp,
+                               100.0 + static_cast<double>(index), random, sequence);
+            }
+            frame += ']';
+            ws.write(net::buffer(frame));
+            sent += batch;
+            frames.fetch_add(1, std::memory_order_relaxed);
+            messages.fetch_add(batch, std::memory_order_relaxed);
+            bytes.fetch_add(frame.size(), std::memory_order_relaxed);
+        }
+    }
+
+    static void append_message(std::string &out, const Channel &channel, const std::string &symbol,
+                               const std::string &timestamp, double base, Random &random,
+                               std::uint64_t &sequence) {
+        const double mid = base + static_cast<double>(random.next() % 100) * 0.01;
+        out += R"({"T":")";
+        out += channel.type;
+        out += R"(","S":")";
+        out += symbol;
+        out += '"';
+        switch (channel.type) {
+        case 't':
+            out += R"(,"i":)";
+            append_int(out, ++sequence);
+            out += R"(,"x":"V","p":)";
+            append_price(out, mid);
+            out += R"(,"s":)";
+            append_int(out, 1 + random.next() % 500);
+            out += R"(,"c":["@"],"z":"C")";
+            break;
+        case 'q':
+            out += R"(,"bx":"V","bp":)";
+            append_price(out, mid - 0.01);
+            out += R"(,"bs":)";
+            append_int(out, 1 + random.next() % 10);
+            out += R"(,"ax":"V","ap":)";
+            append_price(out, mid + 0.01);
+            out += R"(,"as":)";
+            append_int(out, 1 + random.next() % 10);
+            out += R"(,"c":["R"],"z":"C")";
+            break;
+        case 'o':
+            for (const char *side : {R"(,"b":[)", R"(],"a":[)"}) {
+                out += side;
+                const double sign = side[3] == 'b' ? -1.0 : 1.0;
+                for (int level = 0; level < 5; ++level) {
+                    out += level == 0 ? R"({"p":)" : R"(,{"p":)";
+                    append_price(out, mid + sign * 0.01 * (level + 1));
+                    out += R"(,"s":)";
+                    append_int(out, 1 + random.next() % 10);
+                    out += '}';
+                }
+            }
+            out += R"(],"r":false)";
+            break;
+        default: // bars
+            out += R"(,"o":)";
+            append_price(out, mid);
+            out += R"(,"h":)";
+            append_price(out, mid + 0.05);
+            out += R"(,"l":)";
+            append_price(out, mid - 0.05);
+            out += R"(,"c":)";
+            append_price(out, mid + 0.01);
+            out += R"(,"v":)";
+            append_int(out, 1000 + random.next() % 1000);
+            out += R"(,"n":)";
+            append_int(out, 10 + random.next() % 10);
+            out += R"(,"vw":)";
+            append_price(out, mid);
+            break;
+        }
+        out += R"(,"t":")";
+        out += timestamp;
+        out += "\"}";
+    }
+};
+
+SyntheticFeedServer::SyntheticFeedServer(FeedServerOptions options)
+    : impl_(std::make_unique<Impl>(std::move(options))) {}
+
+SyntheticFeedServer::~SyntheticFeedServer() { stop(); }
+
+void SyntheticFeedServer::start() {
+    if (impl_->running) {
+        return;
+    }
+    try {
+        use_self_signed_certificate(impl_->tls);
+        const tcp::endpoint endpoint(net::ip::make_address(impl_->options.address),
+                                     impl_->options.port);
+        impl_->acceptor.open(endpoint.protocol());
+        impl_->acceptor.set_option(net::socket_base::reuse_address(true));
+        impl_->acceptor.bind(endpoint);
+        impl_->acceptor.listen();
+        impl_->port = impl_->acceptor.local_endpoint().port();
+    } catch (const boost::system::system_error &e) {
+        throw std::runtime_error(std::string("SyntheticFeedServer: ") + e.what());
+    }
+    impl_->running = true;
+    impl_->accept();
+    impl_->accept_thread = std::thread([this] { impl_->ioc.run(); });
+}
+
+void SyntheticFeedServer::stop() {
+    if (!impl_->running.exchange(false)) {
+        return;
+    }
+    net::post(impl_->ioc, [this] {
+        boost::system::error_code ec;
+        impl_->acceptor.close(ec);
+    });
+    impl_->accept_thread.join();
+
+    // Sessions finish their current frame and close cleanly; sockets still blocked (a client
+    // that stopped reading, or one that never authenticated) are shut down after a grace period.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (impl_->active > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::vector<std::thread> sessions;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        for (tcp::socket *socket : impl_->sockets) {
+            boost::system::error_code ec;
+            socket->shutdown(tcp::socket::shutdown_both, ec);
+        }
+        sessions.swap(impl_->sessions);
+    }
+    for (auto &session : sessions) {
+        session.join();
+    }
+}
+
+unsigned short SyntheticFeedServer::port() const noexcept { return impl_->port; }
+
+std::string SyntheticFeedServer::url(std::string_view path) const {
+    return "wss://" + impl_->options.address + ":" + std::to_string(impl_->port) +
+           std::string(path);
+}
+
+FeedServerStats SyntheticFeedServer::stats() const noexcept {
+    return {impl_->connections.load(std::memory_order_relaxed),
+            impl_->frames.load(std::memory_order_relaxed),
+            impl_->messages.load(std::memory_order_relaxed),
+            impl_->bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace alpaca::bench
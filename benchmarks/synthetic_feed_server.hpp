@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace alpaca::bench {
+
+struct FeedServerOptions {
+    std::string address{"127.0.0.1"};
+    unsigned short port{0}; // 0 picks a free port
+    // Messages per second on each connection; 0 sends as fast as the client reads.
+    double messages_per_second{0.0};
+    std::size_t messages_per_frame{100};
+    // Synthetic universe used for "*" subscriptions: SYM0..SYMn-1 (SYM0/USD.. for crypto).
+    std::size_t symbols{100};
+    // Relative frequency of each message type among the subscribed channels.
+    double trade_weight{1.0};
+    double quote_weight{4.0};
+    double bar_weight{0.01};
+    double orderbook_weight{1.0};
+    // Credentials the auth message must carry; empty accepts any.
+    std::string key;
+    std::string secret;
+};
+
+struct FeedServerStats {
+    std::uint64_t connections{0};
+    std::uint64_t frames{0};
+    std::uint64_t messages{0};
+    std::uint64_t bytes{0};
+};
+
+/**
+ * Local TLS websocket server that speaks the market data stream protocol (connected, auth,
+ * subscribe) and then streams synthetic trades, quotes, bars and, on crypto paths,
+ * orderbooks for the subscribed symbols, so StockDataStream and CryptoDataStream can be
+ * load-tested through their real url_override path without credentials.
+ *
+ * The certificate is a throwaway self-signed one generated at start(); the streams do not
+ * verify certificates. Every message is stamped with the wall-clock time its frame was built
+ * and trades carry a per-connection sequence number in "i", so clients can measure latency
+ * and detect gaps. Each connection is served by its own thread; subscriptions are read once
+ * after auth and later changes are ignored.
+ */
+class SyntheticFeedServer {
+  public:
+    explicit SyntheticFeedServer(FeedServerOptions options = {});
+    ~SyntheticFeedServer();
+    SyntheticFeedServer(const SyntheticFeedServer &) = delete;
+    SyntheticFeedServer &operator=(const SyntheticFeedServer &) = delete;
+
+    // Binds and starts accepting connections. Throws std::runtime_error on failure.
+    void start();
+    // Closes the listener and every connection, then joins their threads.
+    void stop();
+
+    [[nodiscard]] unsigned short port() const noexcept;
+    // wss://<address>:<port><path>; paths containing "crypto" serve crypto symbols.
+    [[nodiscard]] std::string url(std::string_view path = "/v2/iex") const;
+    // Totals over every connection so far; safe to call while serving.
+    [[nodiscard]] FeedServerStats stats() const noexcept;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace alpaca::bench
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace alpaca::core {
+
+// Controls how streaming clients wait between reconnect attempts. The delay grows
+// exponentially from initial_delay by multiplier per failed attempt, is capped at max_delay,
+// and is spread by +/- jitter (a fraction of the delay) so that many clients dropped at the
+// same time do not reconnect in lockstep.
+struct ReconnectPolicy {
+    std::chrono::milliseconds initial_delay{250};
+    std::chrono::milliseconds max_delay{30000};
+    double multiplier{2.0};
+    double jitter{0.2};
+};
+
+// Delay before reconnect attempt number `attempt` (0-based). `unit_random` is a sample from
+// [0, 1) supplied by the caller so the computation stays deterministic and testable.
+[[nodiscard]] inline std::chrono::milliseconds
+reconnect_delay(const ReconnectPolicy &policy, std::size_t attempt, double unit_random) noexcept {
+    const auto initial = static_cast<double>(policy.initial_delay.count());
+    const auto ceiling = static_cast<double>(policy.max_delay.count());
+    double delay = initial * std::pow(std::max(policy.multiplier, 1.0), static_cast<double>(attempt));
+    delay = std::min(delay, ceiling);
+    const double jitter = std::clamp(policy.jitter, 0.0, 1.0);
+    delay *= 1.0 + jitter * (2.0 * std::clamp(unit_random, 0.0, 1.0) - 1.0);
+    return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(
+        std::clamp(delay, 0.0, ceiling)));
+}
+
+}  // namespace alpaca::core
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace alpaca::core {
+
+// Signed fixed-point decimal with eight fractional digits, enough for equity and crypto prices
+// and quantities (range about +/-92 billion). Sums and differences are exact; products and
+// quotients round half away from zero to the last digit.
+struct Decimal {
+    static constexpr std::int64_t kScale = 100'000'000;
+
+    std::int64_t raw{0};  // value * kScale
+
+    [[nodiscard]] static constexpr Decimal from_raw(std::int64_t raw) noexcept {
+        return Decimal{raw};
+    }
+    [[nodiscard]] static constexpr Decimal from_int(std::int64_t value) noexcept {
+        return Decimal{value * kScale};
+    }
+    // Nearest Decimal to `value`; NaN and infinities give zero.
+    [[nodiscard]] static Decimal from_double(double value) noexcept;
+    // Parses API decimal strings such as "190.5", "-3" or "0.000012345" without going
+    // through double; digits past the eighth decimal are rounded. Returns std::nullopt on
+    // malformed or out-of-range input.
+    [[nodiscard]] static std::optional<Decimal> parse(std::string_view text) noexcept;
+
+    [[nodiscard]] double to_double() const noexcept;
+    // Plain decimal without trailing zeros, e.g. "190.5", "-0.00000001" or "0".
+    [[nodiscard]] std::string to_string() const;
+
+    [[nodiscard]] constexpr bool is_zero() const noexcept { return raw == 0; }
+    [[nodiscard]] constexpr Decimal abs() const noexcept { return Decimal{raw < 0 ? -raw : raw}; }
+
+    friend constexpr auto operator<=>(const Decimal &, const Decimal &) = default;
+
+    friend constexpr Decimal operator+(Decimal a, Decimal b) noexcept { return {a.raw + b.raw}; }
+    friend constexpr Decimal operator-(Decimal a, Decimal b) noexcept { return {a.raw - b.raw}; }
+    friend constexpr Decimal operator-(Decimal a) noexcept { return {-a.raw}; }
+    constexpr Decimal &operator+=(Decimal other) noexcept {
+        raw += other.raw;
+        return *this;
+    }
+    constexpr Decimal &operator-=(Decimal other) noexcept {
+        raw -= other.raw;
+        return *this;
+    }
+
+    friend Decimal operator*(Decimal a, Decimal b) noexcept;
+    // Throws std::domain_error when b is zero.
+    friend Decimal operator/(Decimal a, Decimal b);
+};
+
+}  // namespace alpaca::core
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alpaca::core {
+
+struct RecordedFrame {
+    std::int64_t received_ns{0}; // system clock, nanoseconds since the Unix epoch
+    std::string_view data;
+};
+
+/**
+ * Append-only log of raw websocket frames in a memory-mapped file, for reproducing production
+ * traffic offline.
+ *
+ * The log file holds a 16-byte header followed by 8-byte aligned records
+ * {int64 received_ns, uint32 length, uint32 reserved, bytes}. A companion index at
+ * `path` + ".idx" holds {int64 received_ns, uint64 offset} per frame. Both files grow by
+ * doubling; each header stores the committed size and is updated after the record, so a
+ * crash loses at most the frame being written. Appending is a memcpy into the mapping and
+ * never calls into the kernel except to grow. Single writer; POSIX only (the constructor
+ * throws elsewhere).
+ */
+class FrameLogWriter {
+  public:
+    // Creates or truncates the log and its index.
+    explicit FrameLogWriter(const std::string &path);
+    ~FrameLogWriter();
+    FrameLogWriter(const FrameLogWriter &) = delete;
+    FrameLogWriter &operator=(const FrameLogWriter &) = delete;
+
+    void append(std::string_view frame, std::int64_t received_ns);
+    // Stamps the frame with the current system time.
+    void append(std::string_view frame);
+
+    [[nodiscard]] std::size_t size() const noexcept { return frames_; }
+    [[nodiscard]] const std::string &path() const noexcept { return path_; }
+    // Writes dirty pages back to disk (msync); the OS does so lazily otherwise.
+    void flush();
+    // Trims both files to their used size and unmaps them. Called by the destructor.
+    void close();
+
+  private:
+    struct Mapping {
+        std::string path; // for error messages
+        int fd{-1};
+        char *data{nullptr};
+        std::size_t capacity{0};
+        std::size_t used{0};
+    };
+
+    static void reserve(Mapping &file, std::size_t bytes);
+    static void release(Mapping &file);
+
+    std::string path_;
+    Mapping log_;
+    Mapping index_;
+    std::size_t frames_{0};
+};
+
+/**
+ * Read-only view of a log written by FrameLogWriter. Frames are string_views into the
+ * mapping, valid for the reader's lifetime. The index is used when it matches the log;
+ * otherwise (missing or cut short by a crash) the log is scanned once to rebuild it.
+ */
+class FrameLogReader {
+  public:
+    explicit FrameLogReader(const std::string &path);
+    ~FrameLogReader();
+    FrameLogReader(const FrameLogReader &) = delete;
+    FrameLogReader &operator=(const FrameLogReader &) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets_.size(); }
+    [[nodiscard]] RecordedFrame operator[](std::size_t i) const;
+    // Index of the first frame received at or after `received_ns` (size() when none).
+    [[nodiscard]] std::size_t find(std::int64_t received_ns) const;
+
+    // Calls handler for frames [first, size()) in order. speed 0 replays as fast as possible;
+    // otherwise frames are spaced by their receive-time gaps divided by speed (1 = real time).
+    // Stops early once `running` (when given) reads false. Returns the number of frames
+    // handled.
+    std::size_t replay(const std::function<void(const RecordedFrame &)> &handler,
+                       double speed = 0.0, std::size_t first = 0,
+                       const std::atomic<bool> *running = nullptr) const;
+
+  private:
+    const char *data_{nullptr};
+    std::size_t length_{0};
+    std::vector<std::uint64_t> offsets_;
+};
+
+}  // namespace alpaca::core
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "alpaca/core/latency.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace alpaca::core {
+
+// Keep-alive settings for streaming websocket connections.
+struct HeartbeatOptions {
+    // Ping cadence. Each ping carries its send time, so every pong yields a round-trip time.
+    std::chrono::milliseconds ping_interval{250};
+    // The connection is declared dead when nothing at all (data, ping or pong) has been read
+    // for this long.
+    std::chrono::milliseconds silence_timeout{1000};
+    // Also declared dead when no data frame has arrived for this long even though pongs still
+    // do. Zero disables it, since a quiet market makes data silence normal.
+    std::chrono::milliseconds data_silence_timeout{0};
+};
+
+/**
+ * Ping schedule, round-trip times and stale-connection detection for one websocket. The reader
+ * thread reports what it reads and asks poll() what to do next; the statistics can be read
+ * from any thread. Times are core::steady_now_ns().
+ */
+class Heartbeat {
+  public:
+    enum class Action { None, Ping, Stale };
+
+    explicit Heartbeat(HeartbeatOptions options = {});
+
+    [[nodiscard]] const HeartbeatOptions &options() const noexcept { return options_; }
+
+    // Reader thread: a connection was (re)established.
+    void start(std::int64_t now_ns) noexcept;
+    // Reader thread: a data frame was read.
+    void on_data(std::int64_t now_ns) noexcept;
+    // Reader thread: a ping or pong control frame was read. Pongs echoing one of our pings
+    // record a round-trip time.
+    void on_control(bool pong, std::string_view payload, std::int64_t now_ns) noexcept;
+    // Reader thread: Ping asks for make_ping() to be sent now, Stale for the connection to be
+    // dropped (counted once per connection).
+    [[nodiscard]] Action poll(std::int64_t now_ns) noexcept;
+    // Payload for the ping poll() asked for; marks it sent.
+    [[nodiscard]] std::string make_ping(std::int64_t now_ns);
+    // Longest the reader may wait before calling poll() again.
+    [[nodiscard]] std::chrono::nanoseconds poll_interval() const noexcept;
+    // Why the last Stale was reported.
+    [[nodiscard]] std::string stale_reason() const;
+
+    // Any thread.
+    [[nodiscard]] std::int64_t last_rtt_ns() const noexcept {
+        return last_rtt_ns_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] const LatencyHistogram &rtt() const noexcept { return rtt_; }
+    [[nodiscard]] std::uint64_t pings_sent() const noexcept {
+        return pings_sent_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t pongs_received() const noexcept {
+        return pongs_received_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t stale_connections() const noexcept {
+        return stale_connections_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    HeartbeatOptions options_;
+    std::int64_t last_read_ns_{0};
+    std::int64_t last_data_ns_{0};
+    std::int64_t last_ping_ns_{0};
+    bool stale_{false};
+    bool data_silent_{false};
+
+    LatencyHistogram rtt_;
+    std::atomic<std::int64_t> last_rtt_ns_{0};
+    std::atomic<std::uint64_t> pings_sent_{0};
+    std::atomic<std::uint64_t> pongs_received_{0};
+    std::atomic<std::uint64_t> stale_connections_{0};
+};
+
+}  // namespace alpaca::core
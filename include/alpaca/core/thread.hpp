@@ -0,0 +1,22 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace alpaca::core {
+
+// Pins the calling thread to one CPU. Returns false when the CPU is invalid, the call is
+// refused, or the platform has no affinity API (only Linux is supported).
+bool pin_current_thread_to_cpu(int cpu) noexcept;
+
+// Spin-wait hint: lets a sibling hyper-thread run and saves power without yielding the core.
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+}  // namespace alpaca::core
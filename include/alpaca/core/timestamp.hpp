@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace alpaca::core {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's algorithm).
+[[nodiscard]] constexpr std::int64_t days_from_civil(std::int64_t y, unsigned m, unsigned d) noexcept {
+    y -= m <= 2 ? 1 : 0;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const auto yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// Inverse of days_from_civil.
+constexpr void civil_from_days(std::int64_t z, std::int64_t &y, unsigned &m, unsigned &d) noexcept {
+    z += 719468;
+    const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2 ? 1 : 0);
+}
+
+// Day of the week for days since 1970-01-01, with Sunday = 0.
+[[nodiscard]] constexpr unsigned weekday_from_days(std::int64_t days) noexcept {
+    return static_cast<unsigned>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+}
+
+// Parses an RFC 3339 timestamp ("2024-01-02T09:30:00.123456789Z" or with a "+hh:mm"
+// offset) into nanoseconds since the Unix epoch. Returns std::nullopt on malformed input.
+[[nodiscard]] std::optional<std::int64_t> parse_timestamp_ns(std::string_view text) noexcept;
+
+// Formats nanoseconds since the Unix epoch as an RFC 3339 UTC timestamp with nanosecond
+// precision, e.g. "2024-01-02T09:30:00.000000000Z".
+[[nodiscard]] std::string format_timestamp_ns(std::int64_t ns);
+
+// Nanoseconds since the Unix epoch according to the system clock.
+[[nodiscard]] std::int64_t now_ns() noexcept;
+
+}  // namespace alpaca::core
@@ -0,0 +1,115 @@
+#pragma once
+
+// Boost.Beast glue for core::Heartbeat, shared by the streaming client implementations.
+
+#include "alpaca/core/heartbeat.hpp"
+#include "alpaca/core/latency.hpp"
+#include "alpaca/core/thread.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/websocket/stream.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace alpaca::core {
+
+// Feeds the websocket's ping and pong frames to `heartbeat` and starts its clocks. Call once the
+// websocket handshake is done; the heartbeat must outlive the websocket.
+template <typename WebSocket> void watch_heartbeat(WebSocket &ws, Heartbeat &heartbeat) {
+    ws.control_callback(
+        [&heartbeat](boost::beast::websocket::frame_type kind, boost::beast::string_view payload) {
+            heartbeat.on_control(kind == boost::beast::websocket::frame_type::pong,
+                                 std::string_view(payload.data(), payload.size()),
+                                 steady_now_ns());
+        });
+    heartbeat.start(steady_now_ns());
+}
+
+// Reads one message like websocket::stream::read, sending pings on the heartbeat's schedule while
+// it waits. When the heartbeat declares the connection stale the socket is closed, so the
+// caller's close path cannot block on it either, and `ec` is set to beast::error::timeout. Once
+// `keep_running` turns false the read is cancelled with operation_aborted. With `busy_poll` the
+// wait spins on io_context::poll() instead of sleeping in the kernel.
+//
+// `write_mutex` must guard every other write to `ws`, which may come from other threads: it is
+// held from the start of a ping until the ping completes, and a ping is put off while another
+// write holds it.
+template <typename WebSocket>
+void read_with_heartbeat(WebSocket &ws, boost::asio::io_context &ioc,
+                         boost::beast::flat_buffer &buffer, boost::system::error_code &ec,
+                         Heartbeat &heartbeat, std::mutex &write_mutex,
+                         const std::atomic<bool> &keep_running, bool busy_poll = false) {
+    bool done = false;
+    bool ping_pending = false;
+    bool cancelled = false;
+    bool stale = false;
+    boost::beast::websocket::ping_data ping;
+    std::unique_lock<std::mutex> ping_lock(write_mutex, std::defer_lock);
+    ioc.restart();
+    ws.async_read(buffer, [&](boost::system::error_code result, std::size_t) {
+        ec = result;
+        done = true;
+        if (!result) {
+            heartbeat.on_data(steady_now_ns());
+        }
+    });
+
+    const auto slice = heartbeat.poll_interval();
+    // The pending ping references locals, so it has to finish before returning too.
+    while (!done || ping_pending) {
+        if (busy_poll) {
+            if (ioc.poll() == 0) {
+                cpu_relax();
+            }
+        } else {
+            ioc.run_one_for(slice);
+        }
+        if (cancelled) {
+            continue;
+        }
+        const std::int64_t now = steady_now_ns();
+        const Heartbeat::Action action = heartbeat.poll(now);
+        if (action == Heartbeat::Action::Stale || !keep_running.load(std::memory_order_relaxed)) {
+            auto &socket = boost::beast::get_lowest_layer(ws);
+            boost::system::error_code ignored;
+            socket.cancel(ignored);
+            if (action == Heartbeat::Action::Stale) {
+                socket.close(ignored);
+                stale = true;
+            }
+            cancelled = true;
+        } else if (action == Heartbeat::Action::Ping && !ping_pending && !done &&
+                   ping_lock.try_lock()) {
+            const std::string payload = heartbeat.make_ping(now);
+            ping.assign(payload.data(), payload.size());
+            ping_pending = true;
+            ws.async_ping(ping, [&](boost::system::error_code) {
+                ping_pending = false;
+                ping_lock.unlock();
+            });
+        }
+    }
+    ioc.restart();
+
+    if (stale) {
+        ec = boost::beast::error::timeout;
+    }
+}
+
+// Message for a failed read, naming the heartbeat's verdict when it dropped the connection.
+inline std::string read_failure_message(const boost::system::error_code &ec,
+                                        const Heartbeat *heartbeat) {
+    if (heartbeat && ec == boost::beast::error::timeout) {
+        return "Connection stale: " + heartbeat->stale_reason();
+    }
+    return "Read failed: " + ec.message();
+}
+
+}  // namespace alpaca::core
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "alpaca/data/enums.hpp"
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/resample.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Applies splits and dividends to raw bars locally, so one raw bar cache can serve every
+ * adjustment mode instead of downloading each one.
+ *
+ * Bars stamped before an action's ex-date (midnight US Eastern) are scaled by a cumulative
+ * multiplicative factor per bar, built in one backward pass and then applied to whole columns:
+ * - Split: forward, reverse and unit splits and stock dividends divide prices and multiply
+ *   volume by the share ratio.
+ * - Dividend: cash dividends multiply prices by 1 - dividend / previous close, where the
+ *   previous close is that of the last raw bar before the ex-date (volume is unchanged).
+ * - All: both.
+ * vwap is scaled like prices; trade_count is never adjusted. Mergers and spin-offs do not
+ * change the history of the surviving symbol and are ignored.
+ */
+class CorporateActionAdjuster {
+  public:
+    CorporateActionAdjuster() = default;
+    explicit CorporateActionAdjuster(const CorporateActionsResponse &actions) { add(actions); }
+
+    // Adds the splits and dividends of a corporate actions page. Actions with a missing or
+    // malformed ex-date are skipped, as are actions whose id was added before.
+    void add(const CorporateActionsResponse &actions);
+    void add(const SplitAction &split);
+    void add(const DividendAction &dividend);
+
+    // Price and volume factors for each bar of `raw` (which must be unadjusted and sorted).
+    struct Factors {
+        std::vector<double> price;
+        std::vector<double> volume;
+    };
+    [[nodiscard]] Factors factors(const BarColumns &raw, Adjustment mode) const;
+
+    [[nodiscard]] BarColumns adjust(const BarColumns &raw, Adjustment mode) const;
+    void adjust_in_place(BarColumns &bars, Adjustment mode) const;
+
+    [[nodiscard]] std::size_t size(std::string_view symbol) const;
+
+  private:
+    struct Event {
+        std::int64_t ex_ns{0};
+        double ratio{1.0}; // shares after / before; 1 for cash dividends
+        double cash{0.0};  // dividend per share; 0 for splits
+        bool split{false};
+    };
+
+    void insert(const std::string &id, const std::string &symbol, const Event &event);
+
+    std::map<std::string, std::vector<Event>, std::less<>> events_; // sorted by ex_ns
+    std::set<std::string> ids_;
+};
+
+} // namespace alpaca::data
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "alpaca/data/client.hpp"
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/requests.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Trades of one symbol joined with the quote prevailing at each trade, column by column. A
+ * trade without a prevailing quote has quote_ns 0 and NaN quote fields.
+ */
+struct TradeQuoteColumns {
+    std::string symbol;
+    std::vector<std::int64_t> trade_ns;
+    std::vector<double> price;
+    std::vector<double> size;
+    std::vector<std::int64_t> quote_ns;
+    std::vector<double> bid_price;
+    std::vector<double> bid_size;
+    std::vector<double> ask_price;
+    std::vector<double> ask_size;
+
+    [[nodiscard]] std::size_t size_rows() const noexcept { return trade_ns.size(); }
+    void clear();
+};
+
+/**
+ * Streaming as-of join of trades with quotes, per symbol.
+ *
+ * Each trade at time t is matched with the last quote stamped at or before t - quote_offset.
+ * Trades and quotes must arrive in time order per symbol but may arrive in pages of any size,
+ * interleaved freely. Both sides are buffered column by column only as far as one side runs
+ * ahead of the other: a trade is emitted once a later quote has been seen (or the symbol's
+ * quotes are finished), and a quote is consumed once no future trade can precede it. Joined
+ * trades are delivered in batches after each add call. Not thread-safe.
+ */
+class AsOfJoiner {
+  public:
+    using BatchCallback = std::function<void(const TradeQuoteColumns &)>;
+
+    struct Options {
+        // Quotes must be at least this much older than the trade, e.g. to model feed latency.
+        std::int64_t quote_offset_ns{0};
+        // Quotes older than this at match time are treated as missing (0 disables the limit).
+        std::int64_t max_quote_age_ns{0};
+    };
+
+    explicit AsOfJoiner(BatchCallback on_batch);
+    AsOfJoiner(BatchCallback on_batch, Options options);
+
+    void add_trades(const StockTradesResponse &page);
+    void add_quotes(const StockQuotesResponse &page);
+    void add_trades(std::string_view symbol, std::span<const std::int64_t> timestamp_ns,
+                    std::span<const double> price, std::span<const double> size);
+    void add_quotes(std::string_view symbol, std::span<const std::int64_t> timestamp_ns,
+                    std::span<const double> bid_price, std::span<const double> bid_size,
+                    std::span<const double> ask_price, std::span<const double> ask_size);
+    void add_quote(std::string_view symbol, std::int64_t timestamp_ns, double bid_price,
+                   double bid_size, double ask_price, double ask_size);
+
+    // No more quotes will arrive for the symbol: its pending and future trades are emitted
+    // against the last quote.
+    void finish_quotes(std::string_view symbol);
+    // Emits every pending trade against the quotes seen so far.
+    void finish();
+
+    [[nodiscard]] std::size_t pending_trades() const noexcept;
+    [[nodiscard]] std::size_t pending_quotes() const noexcept;
+
+  private:
+    struct SymbolState {
+        std::vector<std::int64_t> trade_ns;
+        std::vector<double> trade_price;
+        std::vector<double> trade_size;
+        std::size_t trade_head{0};
+
+        std::vector<std::int64_t> quote_ns;
+        std::vector<double> quote_fields; // bid price, bid size, ask price, ask size
+        std::size_t quote_head{0};
+
+        std::int64_t current_ns{0};
+        double current[4]{};
+        bool has_current{false};
+        bool quotes_finished{false};
+        std::int64_t trade_watermark_ns{0};
+        bool has_trades{false};
+
+        TradeQuoteColumns out;
+    };
+
+    SymbolState &state(std::string_view symbol);
+    void advance(SymbolState &s, bool drain);
+    void deliver();
+
+    BatchCallback on_batch_;
+    Options options_;
+    std::unordered_map<std::string, std::size_t> ids_;
+    std::vector<SymbolState> states_;
+    std::vector<std::size_t> ready_;
+};
+
+// Fetches trades and quotes page by page for the request's symbols and time range and joins
+// them, fetching from whichever side is behind so neither is materialized in full. Both
+// histories are requested in ascending order, which the API returns grouped by symbol in
+// symbol order; a symbol's quotes are finished as soon as the quote stream passes it. The
+// quote request takes its symbols, start, end and feed from `trades`.
+void asof_join_stock_trades(const DataClient &client, StockTradesRequest trades,
+                            AsOfJoiner &joiner, int page_limit = 10000);
+
+} // namespace alpaca::data
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/timeframe.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * How trades are grouped into bars: fixed event-time windows aligned to the Unix epoch (UTC),
+ * a fixed number of trades, or a fixed traded volume.
+ */
+struct BarSpec {
+    enum class Kind { Time, Ticks, Volume };
+
+    Kind kind{Kind::Time};
+    std::int64_t interval_ns{60'000'000'000};
+    std::uint64_t ticks{0};
+    double volume{0.0};
+
+    static BarSpec seconds(int amount);
+    // Minute, Hour and Day frames; Day windows are UTC days. Week and Month are rejected.
+    static BarSpec time(const TimeFrame &timeframe);
+    static BarSpec tick_count(std::uint64_t trades);
+    static BarSpec traded_volume(double volume);
+};
+
+/**
+ * Builds OHLCV/VWAP/trade-count bars incrementally from trades.
+ *
+ * Time bars are finalized by an event-time watermark: the latest trade time seen for the
+ * symbol minus `allowed_lateness` (advance_watermark() moves it for idle symbols). A bar is
+ * emitted once the watermark passes its end; trades arriving later for a bar that is still in
+ * the revision window revise it, older ones are counted as dropped. Tick and volume bars are
+ * emitted as soon as their threshold is reached.
+ *
+ * Cancels and corrections are matched to trades by id (or by timestamp, price and size when
+ * the trade has no id). Matching an open bar updates it silently; matching one of the last
+ * `revision_depth` emitted bars recomputes it and reports it through on_revision.
+ *
+ * Symbols are mapped to dense ids; per-symbol state lives in flat vectors indexed by id.
+ * Not thread-safe: feed it from a single thread, such as the stream's handler thread.
+ */
+class BarAggregator {
+  public:
+    using BarCallback = std::function<void(const Bar &)>;
+
+    struct Options {
+        std::chrono::nanoseconds allowed_lateness{0};
+        // Emitted bars per symbol kept for revisions (0 disables revisions).
+        std::size_t revision_depth{8};
+    };
+
+    BarAggregator(BarSpec spec, BarCallback on_bar, BarCallback on_revision = {});
+    BarAggregator(BarSpec spec, BarCallback on_bar, BarCallback on_revision, Options options);
+
+    // Dense id for a symbol, assigned on first use.
+    std::uint32_t symbol_id(const std::string &symbol);
+
+    void on_trade(const Trade &trade);
+    void on_trade(std::uint32_t symbol, std::int64_t timestamp_ns, double price, double size,
+                  std::string_view trade_id = {});
+    void on_cancel(const TradeCancel &cancel);
+    void on_correction(const TradeCorrection &correction);
+
+    // Moves every symbol's watermark to at least `timestamp_ns - allowed_lateness` and emits
+    // the time bars it closes, e.g. from a wall-clock timer so quiet symbols get their bars.
+    void advance_watermark(std::int64_t timestamp_ns);
+    // Emits every open bar regardless of the watermark.
+    void flush();
+
+    [[nodiscard]] std::uint64_t late_trades_dropped() const noexcept { return late_dropped_; }
+
+    // Handlers for StockDataStream/CryptoDataStream subscriptions. The aggregator must
+    // outlive the subscriptions.
+    [[nodiscard]] std::function<void(const Trade &)> trade_handler();
+    [[nodiscard]] std::function<void(const TradeCancel &)> cancel_handler();
+    [[nodiscard]] std::function<void(const TradeCorrection &)> correction_handler();
+
+  private:
+    struct Fill {
+        std::int64_t timestamp_ns{0};
+        double price{0.0};
+        double size{0.0};
+        std::string id;
+    };
+
+    struct Window {
+        std::int64_t start_ns{0};
+        std::int64_t end_ns{0}; // exclusive; unused for tick and volume bars
+        double volume{0.0};
+        std::vector<Fill> fills;
+    };
+
+    struct SymbolState {
+        std::string symbol;
+        std::int64_t watermark_ns{std::numeric_limits<std::int64_t>::min()};
+        std::vector<Window> open; // sorted by start_ns
+        std::deque<Window> emitted;
+    };
+
+    void close_through(std::uint32_t symbol, std::int64_t watermark_ns);
+    void emit(std::uint32_t symbol, Window window);
+    [[nodiscard]] Bar make_bar(const SymbolState &state, const Window &window) const;
+    // Replaces (or removes, when replacement is null) the fill matching `match`.
+    void revise(const std::string &symbol, const Fill &match, const Fill *replacement);
+
+    BarSpec spec_;
+    BarCallback on_bar_;
+    BarCallback on_revision_;
+    Options options_;
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    std::vector<SymbolState> states_;
+    std::uint64_t late_dropped_{0};
+};
+
+} // namespace alpaca::data
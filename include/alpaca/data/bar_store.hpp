@@ -0,0 +1,164 @@
+#pragma once
+
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/resample.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Latest indicator values for one symbol. Each value is empty until the symbol has seen
+ * enough bars for its period (RSI needs one bar more than its period).
+ */
+struct BarIndicators {
+    std::optional<double> sma;
+    std::optional<double> ema; // seeded with the SMA of the first `ema_period` closes
+    std::optional<double> rsi; // Wilder smoothing, 0-100
+    std::optional<double> atr; // Wilder smoothing of the true range
+    std::optional<double> bollinger_middle;
+    std::optional<double> bollinger_upper;
+    std::optional<double> bollinger_lower;
+    std::optional<double> vwap; // volume-weighted price over the last `vwap_period` bars
+};
+
+/**
+ * One bar per symbol for BarStore::update_all, stored column by column and indexed by the
+ * store's symbol ids. A NaN close marks a symbol without a bar in this batch.
+ */
+struct BarBatch {
+    std::int64_t timestamp_ns{0};
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<double> vwap; // NaN falls back to the typical price (high + low + close) / 3
+};
+
+/**
+ * Fixed-capacity rolling bar history per symbol with indicators updated in O(1) per bar.
+ *
+ * Each field is one 64-byte-aligned column holding a power-of-two ring per symbol, stored
+ * time-major: ring slot r of every symbol sits in row r, at r * slots + id. Indicator state
+ * is kept in per-symbol arrays. When the universe's bars arrive in step, a minute close
+ * (update_all) therefore writes one contiguous row per field and walks the state arrays in
+ * order; each symbol's indicator update is still scalar. Rolling sums are rebuilt from the
+ * ring once per `capacity` bars to keep floating-point drift bounded.
+ *
+ * Feed it from REST history (warm_up) and then from a bar stream (bar_handler); bars that
+ * are not newer than the symbol's latest bar are rejected, so the two may overlap. Symbols
+ * are mapped to dense ids like BarAggregator. Not thread-safe.
+ */
+class BarStore {
+  public:
+    struct Options {
+        std::size_t capacity{1024}; // bars retained per symbol, rounded up to a power of two
+        std::size_t sma_period{20};
+        std::size_t ema_period{20};
+        std::size_t rsi_period{14};
+        std::size_t atr_period{14};
+        std::size_t bollinger_period{20};
+        double bollinger_width{2.0}; // band distance in standard deviations
+        std::size_t vwap_period{20};
+    };
+
+    // Vwap is the bar's own vwap, or its typical price when the feed has none.
+    enum class Field { Open, High, Low, Close, Volume, Vwap };
+
+    BarStore();
+    // Throws std::invalid_argument when a period is 0 or exceeds the capacity.
+    explicit BarStore(Options options);
+
+    // Dense id for a symbol, assigned on first use.
+    std::uint32_t symbol_id(const std::string &symbol);
+    [[nodiscard]] std::optional<std::uint32_t> find(const std::string &symbol) const;
+    [[nodiscard]] const std::string &symbol(std::uint32_t id) const { return symbols_.at(id); }
+    [[nodiscard]] std::size_t symbol_count() const noexcept { return symbols_.size(); }
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Appends a bar and updates the symbol's indicators. Returns false for bars that are not
+    // newer than the symbol's latest bar or whose timestamp does not parse.
+    bool on_bar(const Bar &bar);
+    bool append(std::uint32_t id, std::int64_t timestamp_ns, double open, double high,
+                double low, double close, double volume, double vwap);
+    // Loads history such as StockBarsResponse::bars (each symbol's bars in time order) and
+    // returns how many bars were stored.
+    std::size_t warm_up(const std::vector<Bar> &bars);
+
+    // A batch sized for every known symbol with all closes set to NaN.
+    [[nodiscard]] BarBatch make_batch(std::int64_t timestamp_ns) const;
+    // Appends the batch's bar for every symbol that has one, e.g. when a minute closes.
+    // Throws std::invalid_argument unless every column has symbol_count() entries. Returns
+    // how many bars were stored.
+    std::size_t update_all(const BarBatch &batch);
+
+    // Bars currently retained (at most capacity()).
+    [[nodiscard]] std::size_t size(std::uint32_t id) const;
+    // Field of the bar `ago` bars before the latest; throws std::out_of_range past the
+    // retained history.
+    [[nodiscard]] double value(std::uint32_t id, Field field, std::size_t ago = 0) const;
+    [[nodiscard]] std::int64_t timestamp_ns(std::uint32_t id, std::size_t ago = 0) const;
+    [[nodiscard]] BarIndicators indicators(std::uint32_t id) const;
+    // Retained bars, oldest first; trade counts are not kept and read as 0.
+    [[nodiscard]] BarColumns history(std::uint32_t id) const;
+
+    [[nodiscard]] std::uint64_t rejected_bars() const noexcept { return rejected_; }
+
+    // Handler for StockDataStream/CryptoDataStream bar subscriptions. The store must outlive
+    // the subscription.
+    [[nodiscard]] std::function<void(const Bar &)> bar_handler();
+
+  private:
+    struct AlignedDelete {
+        void operator()(void *data) const noexcept;
+    };
+    template <typename T> using Column = std::unique_ptr<T[], AlignedDelete>;
+
+    static constexpr std::size_t kFieldCount = 6;
+
+    // Per-symbol indicator state; `count` is the number of bars ever appended.
+    struct State {
+        std::vector<std::uint64_t> count;
+        std::vector<std::int64_t> last_ns;
+        std::vector<double> sma_sum;
+        std::vector<double> ema;
+        std::vector<double> avg_gain;
+        std::vector<double> avg_loss;
+        std::vector<double> atr;
+        std::vector<double> band_sum;
+        std::vector<double> band_sum_sq;
+        std::vector<double> pv_sum;
+        std::vector<double> volume_sum;
+    };
+
+    void reserve_symbols(std::size_t slots);
+    void push(std::uint32_t id, std::int64_t timestamp_ns, double open, double high, double low,
+              double close, double volume, double vwap) noexcept;
+    void resum(std::uint32_t id) noexcept;
+    [[nodiscard]] std::size_t slot(std::uint32_t id, std::size_t ago) const;
+    // Column offset of the `k`-th bar ever appended for `id`.
+    [[nodiscard]] std::size_t index(std::uint32_t id, std::uint64_t k) const noexcept {
+        return static_cast<std::size_t>(k & mask_) * slots_ + id;
+    }
+
+    Options options_;
+    std::size_t mask_{0};
+    std::size_t slots_{0}; // symbols the columns have room for
+    std::array<Column<double>, kFieldCount> fields_;
+    Column<std::int64_t> timestamps_;
+    State state_;
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    std::uint64_t rejected_{0};
+};
+
+} // namespace alpaca::data
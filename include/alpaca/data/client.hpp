@@ -6,6 +6,8 @@
 #include "alpaca/data/requests.hpp"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace alpaca::data {
 
@@ -71,6 +73,7 @@ class DataClient {
     get_corporate_actions_raw(const CorporateActionsRequest &request) const;
     [[nodiscard]] std::string get_most_actives_raw(const MostActivesRequest &request) const;
     [[nodiscard]] std::string get_market_movers_raw(const MarketMoversRequest &request) const;
+    [[nodiscard]] std::string get_stock_snapshots_raw(const StockSnapshotRequest &request) const;
 
   private:
     core::HttpResponse send_request(core::HttpMethod method, std::string_view path) const;
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "alpaca/data/bar_store.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+struct CovarianceOptions {
+    enum class Mode {
+        Exponential, // exponentially weighted, RiskMetrics style
+        Window       // equally weighted over the last `window` observations
+    };
+
+    Mode mode{Mode::Exponential};
+    double decay{0.94};      // weight kept by the past per observation (Exponential)
+    std::size_t window{390}; // observations in the window (Window), at least 2
+    // Threads used by update(); matrix rows are handed out to them in blocks of block_rows.
+    std::size_t max_concurrency{8};
+    std::size_t block_rows{64};
+};
+
+/**
+ * Rolling covariance and correlation of returns across a fixed universe, updated
+ * incrementally once per observation (typically a minute close).
+ *
+ * Each observation is a rank-one update of the upper triangle (rank-two in window mode, which
+ * also removes the observation leaving the window), so an update costs O(n^2) regardless of
+ * the history length. Rows are processed in blocks by up to max_concurrency threads, and the
+ * inner loop over a row is a contiguous multiply-add the compiler vectorizes.
+ *
+ * Not thread-safe: update and read from one thread.
+ */
+class CovarianceEngine {
+  public:
+    // Throws std::invalid_argument for an empty universe, duplicate symbols, a decay outside
+    // (0, 1) or a window shorter than 2.
+    explicit CovarianceEngine(std::vector<std::string> symbols);
+    CovarianceEngine(std::vector<std::string> symbols, CovarianceOptions options);
+
+    // Adds one observation: one return per symbol, in universe order. NaN returns (symbols
+    // without a bar) count as no move. Throws std::invalid_argument on a size mismatch.
+    void update(const std::vector<double> &returns);
+    // Adds the log returns of the bar closes at `timestamp_ns` in `store`, e.g. after a
+    // minute close; symbols without a bar at that time, or without a previous bar, count as
+    // no move.
+    void update(const BarStore &store, std::int64_t timestamp_ns);
+
+    [[nodiscard]] const std::vector<std::string> &symbols() const noexcept { return symbols_; }
+    [[nodiscard]] std::optional<std::size_t> index(const std::string &symbol) const;
+    [[nodiscard]] std::size_t size() const noexcept { return symbols_.size(); }
+    // Observations added so far.
+    [[nodiscard]] std::uint64_t observations() const noexcept { return observations_; }
+
+    // Estimates need at least two observations; before that they are NaN, as is the
+    // correlation of a symbol with zero variance.
+    [[nodiscard]] double mean(std::size_t i) const;
+    [[nodiscard]] double covariance(std::size_t i, std::size_t j) const;
+    [[nodiscard]] double variance(std::size_t i) const { return covariance(i, i); }
+    [[nodiscard]] double correlation(std::size_t i, std::size_t j) const;
+    // Full symmetric n x n matrices, row-major.
+    [[nodiscard]] std::vector<double> covariance_matrix() const;
+    [[nodiscard]] std::vector<double> correlation_matrix() const;
+
+  private:
+    // Applies `kernel(first_row, last_row)` to every block of rows, in parallel.
+    template <typename Kernel> void for_each_block(const Kernel &kernel) const;
+
+    CovarianceOptions options_;
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::uint64_t observations_{0};
+
+    // Exponential: weighted mean and covariance. Window: sums and cross products of the
+    // returns in the window. Only the upper triangle (j >= i) of the n x n matrix is kept.
+    std::vector<double> mean_;
+    std::vector<double> matrix_;
+    std::vector<double> ring_; // Window: window x n returns
+    std::vector<double> returns_;
+    std::vector<double> leaving_;
+};
+
+} // namespace alpaca::data
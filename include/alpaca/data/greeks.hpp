@@ -0,0 +1,119 @@
+#pragma once
+
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/option_chain.hpp"
+#include "alpaca/trading/option_symbol.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Black-Scholes implied volatility and greeks for whole option chains, kept current from
+ * live quotes.
+ *
+ * Option quotes set each contract's mid price and underlying quotes set the spot of every
+ * contract on that underlying; either marks the affected contracts dirty. recompute() then
+ * solves IV and greeks for the dirty contracts only, in fixed-width batches of
+ * structure-of-arrays lanes with no per-lane branching, so the compiler can vectorize them.
+ * IV is solved by Newton's method, warm-started from the previous solution.
+ *
+ * Theta is per calendar day and vega and rho are per 1% move, matching Alpaca snapshots.
+ * Contracts without a two-sided quote, without a spot, past expiry, priced outside
+ * no-arbitrage bounds or whose IV does not converge get NaN. The quote handlers may be called
+ * from different stream threads; recompute() holds them off only while it copies inputs and
+ * publishes results, not during the solve. Read results on the thread that calls recompute().
+ */
+class GreeksEngine {
+  public:
+    struct Options {
+        double rate{0.0};           // continuously compounded risk-free rate
+        double dividend_yield{0.0}; // continuous dividend yield
+        // Expiration time of day in seconds after midnight UTC; 21:00 is 16:00 New York
+        // standard time.
+        std::int64_t expiry_utc_seconds{21 * 3600};
+    };
+
+    GreeksEngine();
+    explicit GreeksEngine(Options options);
+
+    // Registers a contract and returns its row; re-adding a contract returns its existing row.
+    // Throws std::invalid_argument for symbols that are not OCC option symbols.
+    std::uint32_t add_contract(std::string_view symbol, std::string_view underlying);
+    // Registers every contract of an indexed chain and seeds its quotes.
+    void add_chain(const OptionChain &chain);
+
+    [[nodiscard]] std::optional<std::uint32_t> find(std::string_view symbol) const;
+    [[nodiscard]] std::size_t size() const noexcept { return symbols_.size(); }
+    [[nodiscard]] const std::string &symbol(std::uint32_t row) const { return symbols_.at(row); }
+
+    void on_option_quote(const Quote &quote);
+    void on_underlying_quote(const Quote &quote);
+    void set_option_quote(std::uint32_t row, double bid, double ask);
+    void set_underlying_price(std::string_view underlying, double price);
+
+    // Time to expiry shrinks continuously; call this before recompute() to refresh contracts
+    // whose quotes have not changed.
+    void mark_all_dirty();
+    // Recomputes the dirty contracts as of `now_ns` and returns how many were recomputed.
+    std::size_t recompute(std::int64_t now_ns);
+
+    std::function<void(const Quote &)> option_quote_handler();
+    std::function<void(const Quote &)> underlying_quote_handler();
+
+    [[nodiscard]] std::span<const double> implied_volatility() const noexcept { return iv_; }
+    [[nodiscard]] std::span<const double> delta() const noexcept { return delta_; }
+    [[nodiscard]] std::span<const double> gamma() const noexcept { return gamma_; }
+    [[nodiscard]] std::span<const double> theta() const noexcept { return theta_; }
+    [[nodiscard]] std::span<const double> vega() const noexcept { return vega_; }
+    [[nodiscard]] std::span<const double> rho() const noexcept { return rho_; }
+
+  private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    std::uint32_t add_contract_locked(std::string_view symbol, std::string_view underlying);
+    std::uint32_t underlying_id(std::string_view underlying);
+    void mark_dirty(std::uint32_t row);
+
+    Options options_;
+    mutable std::mutex mutex_;
+
+    std::unordered_map<trading::OptionKey, std::uint32_t> rows_by_key_;
+    std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> rows_by_symbol_;
+    std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> underlying_ids_;
+    std::vector<double> spot_;                              // per underlying
+    std::vector<std::vector<std::uint32_t>> underlying_rows_; // per underlying
+
+    // Per contract.
+    std::vector<std::string> symbols_;
+    std::vector<std::uint32_t> underlying_;
+    std::vector<double> strike_;
+    std::vector<std::int64_t> expiry_ns_;
+    std::vector<double> sign_; // +1 call, -1 put
+    std::vector<double> mid_;
+    std::vector<std::uint8_t> dirty_;
+    std::vector<std::uint32_t> dirty_rows_;
+
+    std::vector<double> iv_;
+    std::vector<double> delta_;
+    std::vector<double> gamma_;
+    std::vector<double> theta_;
+    std::vector<double> vega_;
+    std::vector<double> rho_;
+};
+
+} // namespace alpaca::data
@@ -16,6 +16,7 @@ public:
     CryptoDataStream(std::string api_key, std::string secret_key, bool raw_data = false,
                      CryptoFeed feed = CryptoFeed::Us,
                      std::optional<std::string> url_override = std::nullopt);
+    ~CryptoDataStream() override;
 
     // Trade subscriptions
     void subscribe_trades(TradeHandler handler,
@@ -44,6 +45,10 @@ protected:
     void connect_impl() override;
     void authenticate_impl() override;
     void send_subscribe_message_impl() override;
+    // Subscribe message for every channel with handlers, sent on each (re)connect.
+    std::string subscription_message() const;
+    void send_subscribe_message_impl(const std::string& channel,
+                                     const std::vector<std::string>& symbols) override;
     void send_unsubscribe_message_impl(const std::string& channel,
                                        const std::vector<std::string>& symbols) override;
     void consume_messages_impl() override;
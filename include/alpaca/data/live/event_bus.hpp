@@ -0,0 +1,215 @@
+#pragma once
+
+#include "alpaca/data/live/websocket.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data::live {
+
+// Where a bus subscriber's handler runs.
+enum class Delivery {
+    Inline,   // on the stream's reader thread, in subscription order
+    Dedicated // on a thread owned by the subscriber, fed by its own queue
+};
+
+/**
+ * In-process fan-out on top of a data stream: any number of subscribers per symbol and
+ * channel, where the stream itself keeps a single handler per symbol.
+ *
+ * The bus owns the stream's handler for every symbol it has subscribers for, subscribing it
+ * when the first bus subscriber arrives and unsubscribing it when the last one leaves. Each
+ * event is parsed once by the stream. Inline subscribers receive the stream's own object by
+ * reference. Dedicated subscribers share one heap copy per event, made only when at least
+ * one of them is interested, and each drains its own bounded queue on its own thread, so a
+ * slow consumer never delays the reader thread or the other subscribers; when its queue is
+ * full the oldest event is dropped and counted in dropped().
+ *
+ * Subscribers for "*" receive every event on the channel in addition to per-symbol
+ * subscribers. Subscription changes take effect for the next event. Adding or removing a
+ * subscriber is thread-safe at any time as long as the symbol keeps at least one bus
+ * subscriber. The first subscriber for a symbol and the removal of its last one subscribe and
+ * unsubscribe the stream, whose handler tables are read by its reader thread without a lock:
+ * make those changes before run() or after stop(). Create the bus before the stream runs and
+ * destroy it after the stream stops.
+ */
+class EventBus {
+  public:
+    using SubscriptionId = std::uint64_t;
+
+    // Events a dedicated subscriber may have queued before the oldest are dropped.
+    static constexpr std::size_t kDefaultQueueCapacity = 1 << 16;
+
+    // Binds the bus to a StockDataStream, CryptoDataStream or OptionDataStream; channels the
+    // stream does not offer throw std::invalid_argument when subscribed.
+    template <typename Stream>
+    explicit EventBus(Stream &stream, std::size_t queue_capacity = kDefaultQueueCapacity);
+    // Removes the bus's stream handlers and stops the dedicated threads; events still queued
+    // for them are dropped.
+    ~EventBus();
+    EventBus(const EventBus &) = delete;
+    EventBus &operator=(const EventBus &) = delete;
+
+    SubscriptionId subscribe_trades(TradeHandler handler, const std::vector<std::string> &symbols,
+                                    Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_quotes(QuoteHandler handler, const std::vector<std::string> &symbols,
+                                    Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_bars(BarHandler handler, const std::vector<std::string> &symbols,
+                                  Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_updated_bars(BarHandler handler,
+                                          const std::vector<std::string> &symbols,
+                                          Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_daily_bars(BarHandler handler,
+                                        const std::vector<std::string> &symbols,
+                                        Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_trading_statuses(TradingStatusHandler handler,
+                                              const std::vector<std::string> &symbols,
+                                              Delivery delivery = Delivery::Inline);
+    SubscriptionId subscribe_orderbooks(OrderbookHandler handler,
+                                        const std::vector<std::string> &symbols,
+                                        Delivery delivery = Delivery::Inline);
+
+    // Stops delivery to the subscription; a dedicated thread is joined unless this is called
+    // from it. Unknown ids are ignored.
+    void unsubscribe(SubscriptionId id);
+
+    [[nodiscard]] std::size_t subscriber_count() const;
+    // Events dropped from full dedicated queues, over all subscribers.
+    [[nodiscard]] std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    enum Channel : std::size_t {
+        kTrades,
+        kQuotes,
+        kBars,
+        kUpdatedBars,
+        kDailyBars,
+        kTradingStatuses,
+        kOrderbooks,
+        kChannelCount
+    };
+
+    using Invoker = std::function<void(const void *)>;
+    using Share = std::shared_ptr<const void> (*)(const void *);
+    using StreamHook = std::function<void(const std::vector<std::string> &)>;
+
+    class Worker;
+    struct Subscriber {
+        SubscriptionId id{0};
+        Invoker invoke;                 // inline delivery
+        std::shared_ptr<Worker> worker; // dedicated delivery
+    };
+    using SubscriberList = std::vector<std::shared_ptr<const Subscriber>>;
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+    // Copy-on-write: writers publish a new table and the reader thread takes the current one
+    // per event, so it never waits on subscribe_mutex_ or on a writer's copy. The pointer is
+    // read and replaced with std::atomic_load/store_explicit, which are not lock-free in
+    // common standard libraries but hold their internal lock only for the pointer copy.
+    using Table = std::unordered_map<std::string, SubscriberList, StringHash, std::equal_to<>>;
+
+    struct ChannelState {
+        std::shared_ptr<const Table> table{std::make_shared<const Table>()};
+        StreamHook subscribe;
+        StreamHook unsubscribe;
+    };
+
+    template <typename Event, typename Subscribe, typename Unsubscribe>
+    void bind(Channel channel, Subscribe subscribe, Unsubscribe unsubscribe) {
+        channels_[channel].subscribe = [this, channel, subscribe](const auto &symbols) {
+            subscribe([this, channel](const Event &event) { publish(channel, event); }, symbols);
+        };
+        channels_[channel].unsubscribe = unsubscribe;
+    }
+
+    template <typename Event> void publish(Channel channel, const Event &event) {
+        fan_out(channel, event.symbol, &event, [](const void *e) -> std::shared_ptr<const void> {
+            return std::make_shared<const Event>(*static_cast<const Event *>(e));
+        });
+    }
+
+    template <typename Event, typename Handler>
+    SubscriptionId add(Channel channel, Handler handler, const std::vector<std::string> &symbols,
+                       Delivery delivery) {
+        Invoker invoke = [handler = std::move(handler)](const void *event) {
+            handler(*static_cast<const Event *>(event));
+        };
+        return add_subscriber(channel, std::move(invoke), symbols, delivery);
+    }
+
+    SubscriptionId add_subscriber(Channel channel, Invoker invoke,
+                                  const std::vector<std::string> &symbols, Delivery delivery);
+    void fan_out(Channel channel, std::string_view symbol, const void *event, Share share);
+
+    // Serialises subscription changes, including the calls into the stream.
+    mutable std::mutex subscribe_mutex_;
+    std::array<ChannelState, kChannelCount> channels_;
+    std::unordered_map<SubscriptionId, Channel> channel_of_;
+    SubscriptionId next_id_{1};
+    std::size_t queue_capacity_;
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+template <typename Stream>
+EventBus::EventBus(Stream &stream, std::size_t queue_capacity)
+    : queue_capacity_(std::max<std::size_t>(queue_capacity, 1)) {
+    using Symbols = std::vector<std::string>;
+    if constexpr (requires { stream.subscribe_trades(TradeHandler{}, Symbols{}); }) {
+        bind<Trade>(
+            kTrades, [&stream](auto h, const Symbols &s) { stream.subscribe_trades(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_trades(s); });
+    }
+    if constexpr (requires { stream.subscribe_quotes(QuoteHandler{}, Symbols{}); }) {
+        bind<Quote>(
+            kQuotes, [&stream](auto h, const Symbols &s) { stream.subscribe_quotes(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_quotes(s); });
+    }
+    if constexpr (requires { stream.subscribe_bars(BarHandler{}, Symbols{}); }) {
+        bind<Bar>(
+            kBars, [&stream](auto h, const Symbols &s) { stream.subscribe_bars(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_bars(s); });
+    }
+    if constexpr (requires { stream.subscribe_updated_bars(BarHandler{}, Symbols{}); }) {
+        bind<Bar>(
+            kUpdatedBars,
+            [&stream](auto h, const Symbols &s) { stream.subscribe_updated_bars(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_updated_bars(s); });
+    }
+    if constexpr (requires { stream.subscribe_daily_bars(BarHandler{}, Symbols{}); }) {
+        bind<Bar>(
+            kDailyBars, [&stream](auto h, const Symbols &s) { stream.subscribe_daily_bars(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_daily_bars(s); });
+    }
+    if constexpr (requires {
+                      stream.subscribe_trading_statuses(TradingStatusHandler{}, Symbols{});
+                  }) {
+        bind<TradingStatus>(
+            kTradingStatuses,
+            [&stream](auto h, const Symbols &s) { stream.subscribe_trading_statuses(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_trading_statuses(s); });
+    }
+    if constexpr (requires { stream.subscribe_orderbooks(OrderbookHandler{}, Symbols{}); }) {
+        bind<Orderbook>(
+            kOrderbooks, [&stream](auto h, const Symbols &s) { stream.subscribe_orderbooks(h, s); },
+            [&stream](const Symbols &s) { stream.unsubscribe_orderbooks(s); });
+    }
+}
+
+} // namespace alpaca::data::live
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "alpaca/core/latency.hpp"
+#include "alpaca/data/models.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alpaca::data::live {
+
+enum class BusEventType : std::uint8_t { Trade = 1, Quote = 2, Bar = 3 };
+
+/**
+ * Fixed-size market data event as stored in a market data bus slot. Prices and sizes share the
+ * `values` array: a trade uses {price, size}, a quote {bid_price, bid_size, ask_price,
+ * ask_size} and a bar {open, high, low, close, volume, vwap}. Symbols longer than 23
+ * characters are truncated; trade conditions are not carried.
+ */
+struct BusEvent {
+    std::uint64_t sequence{0};     // assigned by the publisher, starting at 1
+    std::int64_t timestamp_ns{0};  // event time from the feed, 0 when unparseable
+    std::int64_t published_ns{0};  // system clock when the publisher wrote the slot
+    char symbol[24]{};
+    BusEventType type{BusEventType::Trade};
+    char exchange{0};     // trade exchange or quote bid exchange
+    char ask_exchange{0}; // quotes only
+    char tape{0};
+    std::uint32_t reserved{0};
+    double values[6]{};
+    std::uint64_t extra{0}; // numeric trade id, or bar trade count
+
+    [[nodiscard]] std::string_view symbol_view() const noexcept;
+};
+
+// Conversions between feed models and bus events. The to_* functions expect an event of
+// the matching type.
+[[nodiscard]] BusEvent to_bus_event(const Trade &trade);
+[[nodiscard]] BusEvent to_bus_event(const Quote &quote);
+[[nodiscard]] BusEvent to_bus_event(const Bar &bar);
+[[nodiscard]] Trade to_trade(const BusEvent &event);
+[[nodiscard]] Quote to_quote(const BusEvent &event);
+[[nodiscard]] Bar to_bar(const BusEvent &event);
+
+/**
+ * Single-writer side of a shared-memory market data bus, so one stream connection can feed
+ * many strategy processes on the same host.
+ *
+ * The bus is a POSIX shared-memory object (/dev/shm/<name>) holding a power-of-two ring of
+ * 128-byte slots, each guarded by its own sequence word (a seqlock): the writer marks the
+ * slot busy, copies the event in and then stores the event's sequence with release ordering.
+ * Publishing never blocks or waits for readers; slow subscribers are overrun and detect it
+ * from the sequence numbers. The mapping is prefaulted and advised for transparent huge
+ * pages. POSIX only (the constructor throws elsewhere).
+ */
+class MarketDataBusPublisher {
+  public:
+    // Creates (or replaces) the bus `name` with room for `capacity` events, rounded up to a
+    // power of two. Throws std::runtime_error when the shared memory cannot be set up.
+    explicit MarketDataBusPublisher(const std::string &name, std::size_t capacity = 1 << 16);
+    // Unmaps and removes the shared-memory object; attached subscribers keep their mapping.
+    ~MarketDataBusPublisher();
+    MarketDataBusPublisher(const MarketDataBusPublisher &) = delete;
+    MarketDataBusPublisher &operator=(const MarketDataBusPublisher &) = delete;
+
+    // Stamps the event with the next sequence and the publish time and writes it. Must only
+    // be called from one thread at a time. Returns the sequence.
+    std::uint64_t publish(BusEvent event) noexcept;
+    std::uint64_t publish(const Trade &trade) { return publish(to_bus_event(trade)); }
+    std::uint64_t publish(const Quote &quote) { return publish(to_bus_event(quote)); }
+    std::uint64_t publish(const Bar &bar) { return publish(to_bus_event(bar)); }
+
+    // Subscribes trades, quotes and bars for `symbols` on a StockDataStream or
+    // CryptoDataStream and publishes every event from the stream's reader thread. Call before
+    // the stream runs; a publisher takes a single stream so it keeps a single writer.
+    template <typename Stream>
+    void attach(Stream &stream, const std::vector<std::string> &symbols) {
+        if (attached_) {
+            throw std::logic_error("MarketDataBusPublisher: already attached to a stream");
+        }
+        attached_ = true;
+        stream.subscribe_trades([this](const Trade &trade) { publish(trade); }, symbols);
+        stream.subscribe_quotes([this](const Quote &quote) { publish(quote); }, symbols);
+        stream.subscribe_bars([this](const Bar &bar) { publish(bar); }, symbols);
+    }
+
+    [[nodiscard]] const std::string &name() const noexcept { return name_; }
+    [[nodiscard]] std::size_t capacity() const noexcept;
+    // Sequence of the last published event (0 before the first).
+    [[nodiscard]] std::uint64_t sequence() const noexcept;
+
+  private:
+    struct Segment;
+
+    std::string name_;
+    std::unique_ptr<Segment> segment_;
+    bool attached_{false};
+};
+
+/**
+ * Reader side of a market data bus, usable from any process on the host. Events are validated
+ * in place against their slot's sequence word and copied into a caller-owned BusEvent, so a
+ * read never allocates or enters the kernel.
+ *
+ * Each subscriber tracks the next sequence it expects. When the publisher laps it, the
+ * missed events are added to lost() and reading resumes at the oldest event still in the
+ * ring. Not thread-safe; use one subscriber per reading thread.
+ */
+class MarketDataBusSubscriber {
+  public:
+    // Opens an existing bus. By default reading starts with the next event published; with
+    // `from_oldest` it starts with the oldest event still in the ring. Throws
+    // std::runtime_error when the bus does not exist or is not a market data bus.
+    explicit MarketDataBusSubscriber(const std::string &name, bool from_oldest = false);
+    ~MarketDataBusSubscriber();
+    MarketDataBusSubscriber(const MarketDataBusSubscriber &) = delete;
+    MarketDataBusSubscriber &operator=(const MarketDataBusSubscriber &) = delete;
+
+    // Copies the next event into `event` and returns true, or returns false when nothing new
+    // has been published.
+    bool poll(BusEvent &event) noexcept;
+
+    // Calls handler(const BusEvent &) for up to `max_events` available events and returns how
+    // many were handled.
+    template <typename Handler>
+    std::size_t drain(Handler &&handler, std::size_t max_events = 1024) {
+        BusEvent event;
+        std::size_t handled = 0;
+        while (handled < max_events && poll(event)) {
+            handler(event);
+            ++handled;
+        }
+        return handled;
+    }
+
+    [[nodiscard]] std::uint64_t next_sequence() const noexcept { return next_; }
+    // Events published but never seen by this subscriber because it was overrun.
+    [[nodiscard]] std::uint64_t lost() const noexcept { return lost_; }
+    // Events the publisher has written that this subscriber has not read yet.
+    [[nodiscard]] std::uint64_t backlog() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    // Opt-in histogram of publish-to-read latency (system clock). latency_stats() is null
+    // until enabled.
+    void enable_latency_stats();
+    [[nodiscard]] const core::LatencyHistogram *latency_stats() const noexcept {
+        return latency_.get();
+    }
+
+  private:
+    struct Segment;
+
+    std::unique_ptr<Segment> segment_;
+    std::uint64_t next_{1};
+    std::uint64_t lost_{0};
+    std::unique_ptr<core::LatencyHistogram> latency_;
+};
+
+} // namespace alpaca::data::live
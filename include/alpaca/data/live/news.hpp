@@ -14,6 +14,7 @@ class NewsDataStream : public DataStream {
 public:
     NewsDataStream(std::string api_key, std::string secret_key, bool raw_data = false,
                    std::optional<std::string> url_override = std::nullopt);
+    ~NewsDataStream() override;
 
     // News subscriptions
     void subscribe_news(NewsHandler handler, const std::vector<std::string>& symbols);
@@ -23,6 +24,10 @@ protected:
     void connect_impl() override;
     void authenticate_impl() override;
     void send_subscribe_message_impl() override;
+    // Subscribe message for every channel with handlers, sent on each (re)connect.
+    std::string subscription_message() const;
+    void send_subscribe_message_impl(const std::string& channel,
+                                     const std::vector<std::string>& symbols) override;
     void send_unsubscribe_message_impl(const std::string& channel,
                                        const std::vector<std::string>& symbols) override;
     void consume_messages_impl() override;
@@ -16,6 +16,7 @@ public:
     OptionDataStream(std::string api_key, std::string secret_key, bool raw_data = false,
                      OptionsFeed feed = OptionsFeed::Indicative,
                      std::optional<std::string> url_override = std::nullopt);
+    ~OptionDataStream() override;
 
     // Trade subscriptions
     void subscribe_trades(TradeHandler handler,
@@ -30,6 +31,10 @@ protected:
     void connect_impl() override;
     void authenticate_impl() override;
     void send_subscribe_message_impl() override;
+    // Subscribe message for every channel with handlers, sent on each (re)connect.
+    std::string subscription_message() const;
+    void send_subscribe_message_impl(const std::string& channel,
+                                     const std::vector<std::string>& symbols) override;
     void send_unsubscribe_message_impl(const std::string& channel,
                                        const std::vector<std::string>& symbols) override;
     void consume_messages_impl() override;
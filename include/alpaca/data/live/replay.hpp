@@ -0,0 +1,126 @@
+#pragma once
+
+#include "alpaca/data/enums.hpp"
+#include "alpaca/data/live/websocket.hpp"
+#include "alpaca/data/timeframe.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data::live {
+
+struct ReplayOptions {
+    // Wall-clock pacing: 0 replays as fast as possible, 1 in real time, N at N times real time.
+    double speed{0.0};
+    // Bars are delivered at their timestamp plus this delay, matching live bars that publish
+    // when their period closes.
+    std::chrono::nanoseconds bar_delay{std::chrono::minutes(1)};
+
+    // History fetched from a DataClient (unused for cached data).
+    std::optional<std::string> start; // RFC 3339
+    std::optional<std::string> end;   // RFC 3339
+    DataFeed feed{DataFeed::Iex};
+    TimeFrame bar_timeframe{TimeFrame::Minute()};
+    int page_limit{10000};
+};
+
+/**
+ * DataStream that replays historical stock trades, quotes and bars instead of reading a
+ * websocket, so strategy code written against the live handlers runs unchanged in backtests.
+ *
+ * Events come from cached data added with add_trades()/add_quotes()/add_bars() (each symbol's
+ * events in time order) and, when constructed with a client, from the REST history of every
+ * subscribed symbol fetched one page at a time as the replay reaches it. All sources are
+ * k-way merged by timestamp; ties keep trades before quotes before bars and symbol order.
+ * A "*" subscription matches every cached symbol without its own handler.
+ *
+ * replay() delivers everything on the calling thread; advance_to() delivers events up to a
+ * simulated time, for backtests that drive the clock themselves; run() replays on a worker
+ * thread and stops at the end. Subscriptions are fixed once the replay starts; call reset()
+ * to pick up new ones and start over.
+ */
+class ReplayDataStream : public DataStream {
+  public:
+    explicit ReplayDataStream(ReplayOptions options = {});
+    ReplayDataStream(std::shared_ptr<const DataClient> client, ReplayOptions options);
+    ~ReplayDataStream() override;
+
+    void subscribe_trades(TradeHandler handler, const std::vector<std::string> &symbols) override;
+    void unsubscribe_trades(const std::vector<std::string> &symbols) override;
+    void subscribe_quotes(QuoteHandler handler, const std::vector<std::string> &symbols);
+    void unsubscribe_quotes(const std::vector<std::string> &symbols);
+    void subscribe_bars(BarHandler handler, const std::vector<std::string> &symbols);
+    void unsubscribe_bars(const std::vector<std::string> &symbols);
+
+    // Cached history. Each call appends to the symbol's events, which must stay in time order.
+    // Throws std::logic_error once the replay has started, until reset().
+    void add_trades(const std::vector<Trade> &trades);
+    void add_quotes(const std::vector<Quote> &quotes);
+    void add_bars(const std::vector<Bar> &bars);
+
+    // Delivers every remaining event and returns how many were delivered.
+    std::size_t replay();
+    // Delivers the events stamped at or before `timestamp_ns` and returns how many.
+    std::size_t advance_to(std::int64_t timestamp_ns);
+    // Timestamp of the last delivered event: the simulated clock.
+    [[nodiscard]] std::int64_t clock_ns() const noexcept { return clock_ns_; }
+    [[nodiscard]] bool finished();
+    // Rewinds to the start, rebuilding sources from the current subscriptions.
+    void reset();
+
+  protected:
+    void connect_impl() override;
+    void authenticate_impl() override;
+    void send_subscribe_message_impl() override;
+    void send_subscribe_message_impl(const std::string &channel,
+                                     const std::vector<std::string> &symbols) override;
+    void send_unsubscribe_message_impl(const std::string &channel,
+                                       const std::vector<std::string> &symbols) override;
+    void consume_messages_impl() override;
+    void dispatch_message_impl(const std::string &message) override;
+    void close_impl() override;
+
+  private:
+    class Cursor;
+    template <typename Event, typename Handler> class EventCursor;
+    // One symbol's cached events with their timestamps parsed once up front.
+    template <typename Event> struct Cached {
+        std::vector<Event> events;
+        std::vector<std::int64_t> timestamp_ns;
+    };
+    struct HeapEntry {
+        std::int64_t timestamp_ns;
+        std::size_t cursor;
+    };
+
+    // Heap order: earliest timestamp first, then lowest cursor index.
+    static bool later(const HeapEntry &a, const HeapEntry &b) noexcept;
+    void ensure_not_started() const;
+    template <typename Event>
+    void add_cached(std::unordered_map<std::string, Cached<Event>> &cache,
+                    const std::vector<Event> &events);
+    void prepare();
+    void push(std::size_t cursor);
+    std::size_t deliver_until(std::int64_t timestamp_ns);
+
+    std::shared_ptr<const DataClient> client_;
+    ReplayOptions options_;
+    std::unordered_map<std::string, Cached<Trade>> cached_trades_;
+    std::unordered_map<std::string, Cached<Quote>> cached_quotes_;
+    std::unordered_map<std::string, Cached<Bar>> cached_bars_;
+
+    bool prepared_{false};
+    std::vector<std::unique_ptr<Cursor>> cursors_;
+    std::vector<HeapEntry> heap_; // min-heap on (timestamp, cursor)
+    std::int64_t clock_ns_{0};
+    std::optional<std::int64_t> first_event_ns_;
+    std::chrono::steady_clock::time_point wall_start_;
+};
+
+} // namespace alpaca::data::live
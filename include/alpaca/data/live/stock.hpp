@@ -16,7 +16,7 @@ public:
     StockDataStream(std::string api_key, std::string secret_key, bool raw_data = false,
                     DataFeed feed = DataFeed::Iex,
                     std::optional<std::string> url_override = std::nullopt);
-    ~StockDataStream();
+    ~StockDataStream() override;
 
     // Trade subscriptions
     void subscribe_trades(TradeHandler handler,
@@ -50,11 +50,16 @@ protected:
     void connect_impl() override;
     void authenticate_impl() override;
     void send_subscribe_message_impl() override;
+    // Subscribe message for every channel with handlers, sent on each (re)connect.
+    std::string subscription_message() const;
+    void send_subscribe_message_impl(const std::string& channel,
+                                     const std::vector<std::string>& symbols) override;
     void send_unsubscribe_message_impl(const std::string& channel,
                                        const std::vector<std::string>& symbols) override;
     void consume_messages_impl() override;
     void dispatch_message_impl(const std::string& message) override;
     void close_impl() override;
+    void backfill_impl(std::int64_t start_ns, std::int64_t end_ns) override;
 
 private:
     DataFeed feed_;
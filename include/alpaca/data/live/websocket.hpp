@@ -1,10 +1,22 @@
 #pragma once
 
+#include "alpaca/core/backoff.hpp"
+#include "alpaca/core/frame_log.hpp"
+#include "alpaca/core/heartbeat.hpp"
+#include "alpaca/core/latency.hpp"
+#include "alpaca/data/client.hpp"
 #include "alpaca/data/models.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -24,6 +36,31 @@ using TradeCancelHandler = std::function<void(const TradeCancel &)>;
 using TradeCorrectionHandler = std::function<void(const TradeCorrection &)>;
 using NewsHandler = std::function<void(const News &)>;
 
+/**
+ * Controls replay of events missed while a stream was disconnected.
+ */
+struct BackfillOptions {
+    // Longest outage that is backfilled; longer gaps only replay the most recent window.
+    std::chrono::seconds max_gap{std::chrono::minutes(15)};
+    // History replayed at the first connect to warm handler state (zero disables warm-up).
+    std::chrono::seconds warmup{0};
+};
+
+/**
+ * Opt-in low-latency reader mode. The reader thread never sleeps in the kernel: it spins on a
+ * non-blocking poll of the socket, trading one fully busy core for lower wake-up jitter.
+ */
+struct LowLatencyOptions {
+    // Spin on the socket instead of blocking in read().
+    bool busy_poll{true};
+    // CPU the reader thread is pinned to (Linux only; ignored elsewhere or when empty).
+    std::optional<int> cpu;
+    bool tcp_nodelay{true};
+    // Kernel socket buffer sizes in bytes; empty keeps the system default.
+    std::optional<int> receive_buffer_bytes;
+    std::optional<int> send_buffer_bytes;
+};
+
 /**
  * Base class for data websocket streams.
  * Provides common functionality for connecting to and managing websocket connections.
@@ -44,6 +81,42 @@ class DataStream {
                                   const std::vector<std::string> &symbols) = 0;
     virtual void unsubscribe_trades(const std::vector<std::string> &symbols) = 0;
 
+    // Reconnect behaviour after the connection drops
+    void set_reconnect_policy(core::ReconnectPolicy policy);
+    [[nodiscard]] const core::ReconnectPolicy &reconnect_policy() const noexcept;
+
+    // Replays events missed during a disconnect through the REST API before live delivery
+    // resumes. The same path warms handler state at the first connect when options.warmup
+    // is non-zero. Events at the edges of the window may be delivered twice.
+    void enable_backfill(std::shared_ptr<const DataClient> client, BackfillOptions options = {});
+
+    // Switches the reader thread to low-latency mode. Call before run().
+    void enable_low_latency(LowLatencyOptions options = {});
+
+    // Pings the server on a schedule, measures round-trip times and drops a connection that
+    // stays silent past options' timeouts, so it is reconnected (and backfilled, when enabled)
+    // within about a second instead of blocking in read() until TCP gives up. Call before
+    // run(); heartbeat() is null until enabled and its statistics can be read from any thread.
+    void enable_heartbeat(core::HeartbeatOptions options = {});
+    [[nodiscard]] const core::Heartbeat *heartbeat() const noexcept;
+
+    // Opt-in per-event latency histograms. Call before run(); latency_stats() is null until
+    // enabled and can be read (or reset) from any thread while the stream runs.
+    void enable_latency_stats();
+    [[nodiscard]] core::StreamLatencyStats *latency_stats() const noexcept;
+
+    // Appends every frame the stream reads, stamped with its receive time, to a memory-mapped
+    // log at `path` (and its index at `path` + ".idx"). Call before run().
+    void enable_frame_recording(const std::string &path);
+    [[nodiscard]] core::FrameLogWriter *frame_recorder() const noexcept;
+
+    // Feeds recorded frames through this stream's parser and handlers on the calling thread,
+    // as if they had just been read: speed 0 replays as fast as possible, 1 at the recorded
+    // pace, N at N times it. stop() from another thread ends it early. The stream must not
+    // be running. Returns the number of frames dispatched.
+    std::size_t replay_frames(const core::FrameLogReader &log, double speed = 0.0,
+                              std::size_t first = 0);
+
   protected:
     std::string endpoint_;
     std::string api_key_;
@@ -56,25 +129,143 @@ class DataStream {
     // Handler storage
     std::unordered_map<std::string, TradeHandler> trade_handlers_;
     std::unordered_map<std::string, QuoteHandler> quote_handlers_;
+    // Each bar channel keeps its own table so that subscribing to one never routes the
+    // others: "b" -> bar_handlers_, "u" -> updated_bar_handlers_, "d" -> daily_bar_handlers_.
     std::unordered_map<std::string, BarHandler> bar_handlers_;
+    std::unordered_map<std::string, BarHandler> updated_bar_handlers_;
+    std::unordered_map<std::string, BarHandler> daily_bar_handlers_;
     std::unordered_map<std::string, OrderbookHandler> orderbook_handlers_;
     std::unordered_map<std::string, TradingStatusHandler> status_handlers_;
     std::unordered_map<std::string, NewsHandler> news_handlers_;
     TradeCancelHandler trade_cancel_handler_;
     TradeCorrectionHandler trade_correction_handler_;
 
+    // Backfill configuration (backfill_client_ is null when disabled)
+    std::shared_ptr<const DataClient> backfill_client_;
+    BackfillOptions backfill_options_;
+
+    // Low-latency reader configuration (empty when disabled)
+    std::optional<LowLatencyOptions> low_latency_;
+
+    // Latency instrumentation (latency_stats_ is null when disabled)
+    std::unique_ptr<core::StreamLatencyStats> latency_stats_;
+    std::int64_t frame_received_ns_{0};
+
+    // Keep-alive pings and stale-connection detection (null when disabled)
+    std::unique_ptr<core::Heartbeat> heartbeat_;
+
+    // Raw frame recorder (null when disabled)
+    std::unique_ptr<core::FrameLogWriter> frame_recorder_;
+
+    // Called by consume_messages_impl() right after a frame is read.
+    void mark_frame_received() noexcept {
+        if (latency_stats_) {
+            frame_received_ns_ = core::steady_now_ns();
+        }
+    }
+
+    // Called by consume_messages_impl() with every frame before it is dispatched.
+    void record_frame(std::string_view frame) {
+        if (frame_recorder_) {
+            frame_recorder_->append(frame);
+        }
+    }
+
+    // Invokes a user handler for a live event, timing it when instrumentation is enabled.
+    template <typename Handler, typename Event>
+    void deliver(const Handler &handler, const Event &event) {
+        if (latency_stats_) {
+            latency_stats_->invoke(frame_received_ns_, handler, event);
+        } else {
+            handler(event);
+        }
+    }
+
     // Internal methods (to be implemented by derived classes)
     virtual void connect_impl() = 0;
     virtual void authenticate_impl() = 0;
+    // Sends the full handler set; used when (re)connecting.
     virtual void send_subscribe_message_impl() = 0;
+    // Sends a subscription delta for one channel while connected.
+    virtual void send_subscribe_message_impl(const std::string &channel,
+                                             const std::vector<std::string> &symbols) = 0;
     virtual void send_unsubscribe_message_impl(const std::string &channel,
                                                const std::vector<std::string> &symbols) = 0;
     virtual void consume_messages_impl() = 0;
     virtual void dispatch_message_impl(const std::string &message) = 0;
     virtual void close_impl() = 0;
+    // Replays events in [start_ns, end_ns] (nanoseconds since epoch) in timestamp order.
+    // Streams without a REST counterpart keep the default no-op.
+    virtual void backfill_impl(std::int64_t start_ns, std::int64_t end_ns);
+
+    // Handler table for a bar message type ("b", "u" or "d"), or null for other types.
+    std::unordered_map<std::string, BarHandler> *bar_handlers_for(std::string_view msg_type);
+
+    // {"action":"<action>","<channel>":["SYM",...]}
+    static std::string build_subscription_message(std::string_view action,
+                                                  const std::string &channel,
+                                                  const std::vector<std::string> &symbols);
+
+    // One channel of a full subscription message and the symbols subscribed on it.
+    struct ChannelSymbols {
+        std::string_view channel;
+        std::vector<std::string> symbols;
+    };
+    // {"action":"<action>","<channel>":[...],...}, leaving out channels without symbols.
+    static std::string build_subscription_message(std::string_view action,
+                                                  const std::vector<ChannelSymbols> &channels);
+
+    // Symbols a handler table is subscribed to.
+    template <typename Handler>
+    static std::vector<std::string>
+    symbols_of(const std::unordered_map<std::string, Handler> &handlers) {
+        std::vector<std::string> symbols;
+        symbols.reserve(handlers.size());
+        for (const auto &[symbol, handler] : handlers) {
+            symbols.push_back(symbol);
+        }
+        return symbols;
+    }
+
+    // Registers handler for symbols and returns the ones that were not subscribed before, which
+    // is the delta that has to go over the wire. Re-registering only replaces the handler.
+    template <typename Handler>
+    static std::vector<std::string>
+    add_handlers(std::unordered_map<std::string, Handler> &handlers, const Handler &handler,
+                 const std::vector<std::string> &symbols) {
+        std::vector<std::string> added;
+        for (const auto &symbol : symbols) {
+            auto [it, inserted] = handlers.insert_or_assign(symbol, handler);
+            if (inserted) {
+                added.push_back(symbol);
+            }
+        }
+        return added;
+    }
+
+    // Removes symbols and returns the ones that were actually subscribed.
+    template <typename Handler>
+    static std::vector<std::string>
+    remove_handlers(std::unordered_map<std::string, Handler> &handlers,
+                    const std::vector<std::string> &symbols) {
+        std::vector<std::string> removed;
+        for (const auto &symbol : symbols) {
+            if (handlers.erase(symbol) > 0) {
+                removed.push_back(symbol);
+            }
+        }
+        return removed;
+    }
 
   private:
     void run_loop();
+    void run_backfill(bool reconnect);
+    void wait_for_reconnect(std::chrono::milliseconds delay);
+
+    core::ReconnectPolicy reconnect_policy_;
+    std::atomic<std::int64_t> last_message_ns_{0};
+    std::mutex reconnect_mutex_;
+    std::condition_variable reconnect_cv_;
 };
 
 } // namespace alpaca::data::live
@@ -2,6 +2,7 @@
 
 #include "alpaca/data/enums.hpp"
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -36,6 +37,7 @@ struct Quote {
     std::optional<std::string> ask_exchange;
     std::vector<std::string> conditions;
     std::optional<std::string> tape;
+    std::uint64_t contract_key{0}; // trading::OptionKey for option quotes, otherwise 0
 };
 
 struct StockQuotesResponse {
@@ -52,6 +54,7 @@ struct Trade {
     std::optional<std::string> id;
     std::vector<std::string> conditions;
     std::optional<std::string> tape;
+    std::uint64_t contract_key{0}; // trading::OptionKey for option trades, otherwise 0
 };
 
 struct TradingStatus {
@@ -155,6 +158,7 @@ struct OptionsGreeks {
 
 struct OptionsSnapshot {
     std::string symbol;
+    std::uint64_t contract_key{0}; // trading::OptionKey, 0 when the symbol has no key
     std::optional<Trade> latest_trade;
     std::optional<Quote> latest_quote;
     std::optional<double> implied_volatility;
@@ -163,6 +167,7 @@ struct OptionsSnapshot {
 
 struct OptionsSnapshotResponse {
     std::vector<OptionsSnapshot> snapshots;
+    std::optional<std::string> next_page_token;
 };
 
 struct ActiveStock {
@@ -223,8 +228,83 @@ struct CorporateActionsGroup {
     std::vector<CorporateActionItem> items;
 };
 
+// Forward, reverse and unit splits. For unit splits `symbol`/`cusip` are the old security and
+// `ex_date` is the effective date. Holders get new_rate shares for every old_rate shares.
+struct SplitAction {
+    CorporateActionsType type{CorporateActionsType::ForwardSplit};
+    std::string id;
+    std::string symbol;
+    std::string cusip;
+    std::optional<std::string> new_symbol;
+    std::optional<std::string> new_cusip;
+    double old_rate{0.0};
+    double new_rate{0.0};
+    std::string ex_date; // YYYY-MM-DD
+    std::optional<std::string> record_date;
+    std::optional<std::string> payable_date;
+    std::string process_date;
+
+    [[nodiscard]] double ratio() const noexcept {
+        return old_rate > 0.0 ? new_rate / old_rate : 1.0;
+    }
+};
+
+// Cash and stock dividends. `rate` is cash per share, or new shares per share for stock
+// dividends.
+struct DividendAction {
+    CorporateActionsType type{CorporateActionsType::CashDividend};
+    std::string id;
+    std::string symbol;
+    std::string cusip;
+    double rate{0.0};
+    bool special{false};
+    bool foreign{false};
+    std::string ex_date; // YYYY-MM-DD
+    std::optional<std::string> record_date;
+    std::optional<std::string> payable_date;
+    std::string process_date;
+};
+
+// Cash, stock and stock-and-cash mergers. Holders of acquiree_rate acquiree shares receive
+// acquirer_rate acquirer shares plus cash_rate cash (the rate field of cash mergers).
+struct MergerAction {
+    CorporateActionsType type{CorporateActionsType::CashMerger};
+    std::string id;
+    std::optional<std::string> acquirer_symbol;
+    std::optional<std::string> acquirer_cusip;
+    double acquirer_rate{0.0};
+    std::string acquiree_symbol;
+    std::string acquiree_cusip;
+    double acquiree_rate{0.0};
+    double cash_rate{0.0};
+    std::string effective_date; // YYYY-MM-DD
+    std::optional<std::string> payable_date;
+    std::string process_date;
+};
+
+// Holders of source_rate source shares receive new_rate shares of the new security.
+struct SpinOffAction {
+    std::string id;
+    std::string source_symbol;
+    std::string source_cusip;
+    double source_rate{0.0};
+    std::string new_symbol;
+    std::string new_cusip;
+    double new_rate{0.0};
+    std::string ex_date; // YYYY-MM-DD
+    std::optional<std::string> record_date;
+    std::optional<std::string> payable_date;
+    std::string process_date;
+};
+
 struct CorporateActionsResponse {
+    // Every action type as raw key/value strings, in payload order.
     std::vector<CorporateActionsGroup> groups;
+    // Typed records for the action types that affect prices, parsed from the same payload.
+    std::vector<SplitAction> splits;
+    std::vector<DividendAction> dividends;
+    std::vector<MergerAction> mergers;
+    std::vector<SpinOffAction> spin_offs;
     std::optional<std::string> next_page_token;
 };
 
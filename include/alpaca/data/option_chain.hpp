@@ -0,0 +1,111 @@
+#pragma once
+
+#include "alpaca/data/client.hpp"
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/requests.hpp"
+#include "alpaca/trading/enums.hpp"
+#include "alpaca/trading/option_symbol.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Option chain for one underlying, indexed by expiry and strike.
+ *
+ * Contracts are stored column by column, sorted by expiry, then strike, then call before put.
+ * Each expiry owns a strike-sorted run of StrikeRow entries pairing the call and the put at
+ * that strike, so a strike range within an expiry is two binary searches. Missing quotes, IV
+ * and greeks are NaN. Call build_index() after adding snapshots and before querying.
+ */
+class OptionChain {
+  public:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    // Contract rows of the call and put at one strike; npos when a side is not listed.
+    struct StrikeRow {
+        double strike{0.0};
+        std::uint32_t call{npos};
+        std::uint32_t put{npos};
+    };
+
+    // One expiration date (days since the Unix epoch) and its range of strike rows.
+    struct Expiry {
+        std::int32_t days{0};
+        std::uint32_t first_strike{0};
+        std::uint32_t last_strike{0};
+    };
+
+    explicit OptionChain(std::string underlying = {});
+
+    // Appends contracts; symbols that are not OCC option symbols are ignored.
+    void add(const OptionsSnapshot &snapshot);
+    void add(const OptionsSnapshotResponse &response);
+    // Sorts the contracts and rebuilds the expiry and strike index. When a contract was added
+    // more than once, the last snapshot wins.
+    void build_index();
+
+    [[nodiscard]] const std::string &underlying() const noexcept { return underlying_; }
+    [[nodiscard]] std::size_t size() const noexcept { return symbol.size(); }
+
+    [[nodiscard]] std::span<const Expiry> expiries() const noexcept { return expiries_; }
+    [[nodiscard]] const Expiry *find_expiry(std::int32_t days) const noexcept;
+    // Expiry closest to `days`; on a tie the later one.
+    [[nodiscard]] const Expiry *nearest_expiry(std::int32_t days) const noexcept;
+
+    [[nodiscard]] std::span<const StrikeRow> strikes(const Expiry &expiry) const noexcept;
+    // Strike rows of `expiry` with low <= strike <= high.
+    [[nodiscard]] std::span<const StrikeRow> strikes_between(const Expiry &expiry, double low,
+                                                             double high) const noexcept;
+
+    // Contract row for an expiry, strike and side.
+    [[nodiscard]] std::optional<std::size_t> find(std::int32_t days, double strike_price,
+                                                  trading::ContractType side) const noexcept;
+
+    // Contract columns, one entry per contract.
+    std::vector<std::string> symbol;
+    std::vector<trading::OptionKey> contract_key;
+    std::vector<std::int32_t> expiry_days;
+    std::vector<double> strike;
+    std::vector<trading::ContractType> type;
+    std::vector<double> bid;
+    std::vector<double> ask;
+    std::vector<double> last_price;
+    std::vector<double> implied_volatility;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> theta;
+    std::vector<double> vega;
+    std::vector<double> rho;
+
+  private:
+    std::string underlying_;
+    std::vector<StrikeRow> strikes_;
+    std::vector<Expiry> expiries_;
+};
+
+struct OptionChainFetchOptions {
+    // Underlyings fetched at once; pages of one underlying are always fetched in sequence.
+    std::size_t max_concurrency{8};
+    // Contracts per page, unless the request sets its own limit.
+    int page_limit{1000};
+};
+
+// Fetches every page of the chain and returns it indexed.
+[[nodiscard]] OptionChain fetch_option_chain(const DataClient &client, OptionChainRequest request,
+                                             const OptionChainFetchOptions &options = {});
+
+// Fetches several chains with up to max_concurrency underlyings in parallel. Results follow the
+// order of `requests`. The client's transport must support concurrent send() calls; throws the
+// first request error.
+[[nodiscard]] std::vector<OptionChain>
+fetch_option_chains(const DataClient &client, const std::vector<OptionChainRequest> &requests,
+                    const OptionChainFetchOptions &options = {});
+
+} // namespace alpaca::data
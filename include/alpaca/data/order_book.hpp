@@ -0,0 +1,96 @@
+#pragma once
+
+#include "alpaca/data/client.hpp"
+#include "alpaca/data/enums.hpp"
+#include "alpaca/data/models.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Level-2 book for one symbol built from orderbook snapshots and deltas.
+ *
+ * Each side is a price-sorted vector with the best level at the back, so the top of the book
+ * is O(1) to read, updates near the top shift only a few elements, and level N is a direct
+ * index. Updates locate their level by binary search. Not thread-safe: apply updates and
+ * query from the same thread (typically the stream's handler thread).
+ */
+class OrderBook {
+  public:
+    explicit OrderBook(std::string symbol = {});
+
+    // Applies a stream or REST update. A reset replaces both sides; otherwise each level sets
+    // the size at its price and a size of zero removes the level.
+    void apply(const Orderbook &update);
+    void clear();
+
+    [[nodiscard]] const std::string &symbol() const noexcept { return symbol_; }
+    [[nodiscard]] const std::string &timestamp() const noexcept { return timestamp_; }
+    [[nodiscard]] bool empty() const noexcept { return bids_.empty() && asks_.empty(); }
+
+    [[nodiscard]] std::size_t bid_depth() const noexcept { return bids_.size(); }
+    [[nodiscard]] std::size_t ask_depth() const noexcept { return asks_.size(); }
+
+    // Level `n` counted from the top of the book (0 is the best price).
+    [[nodiscard]] std::optional<OrderbookQuote> bid(std::size_t n = 0) const noexcept;
+    [[nodiscard]] std::optional<OrderbookQuote> ask(std::size_t n = 0) const noexcept;
+
+    // Total size resting in the top `levels` levels of one side.
+    [[nodiscard]] double bid_size(std::size_t levels) const noexcept;
+    [[nodiscard]] double ask_size(std::size_t levels) const noexcept;
+
+    [[nodiscard]] std::optional<double> mid() const noexcept;
+    [[nodiscard]] std::optional<double> spread() const noexcept;
+    // Size-weighted mid: leans towards the side with less resting size at the touch.
+    [[nodiscard]] std::optional<double> microprice() const noexcept;
+    // (bid size - ask size) / (bid size + ask size) over the top `levels` levels, in [-1, 1].
+    [[nodiscard]] std::optional<double> imbalance(std::size_t levels = 1) const noexcept;
+
+  private:
+    std::string symbol_;
+    std::string timestamp_;
+    std::vector<OrderbookQuote> bids_; // ascending price, best bid at the back
+    std::vector<OrderbookQuote> asks_; // descending price, best ask at the back
+};
+
+/**
+ * Order books for a set of symbols, keyed by symbol.
+ */
+class OrderBookSet {
+  public:
+    using UpdateCallback = std::function<void(const OrderBook &)>;
+
+    // Applies an update to the symbol's book, creating the book on first use.
+    OrderBook &apply(const Orderbook &update);
+
+    // Replaces books with the REST snapshot; every entry is treated as a reset.
+    void seed(const CryptoLatestOrderbookResponse &snapshot);
+    void seed(const DataClient &client, const std::vector<std::string> &symbols,
+              CryptoFeed feed = CryptoFeed::Us);
+
+    [[nodiscard]] const OrderBook *find(std::string_view symbol) const;
+    [[nodiscard]] std::size_t size() const noexcept { return books_.size(); }
+
+    // Handler for CryptoDataStream::subscribe_orderbooks that keeps this set up to date and
+    // then calls on_update with the updated book. The set must outlive the subscription.
+    [[nodiscard]] std::function<void(const Orderbook &)> updater(UpdateCallback on_update = {});
+
+  private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    std::unordered_map<std::string, OrderBook, StringHash, std::equal_to<>> books_;
+};
+
+} // namespace alpaca::data
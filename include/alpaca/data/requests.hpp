@@ -67,6 +67,7 @@ struct StockTradesRequest {
     std::optional<std::string> end;
     std::optional<int> limit;
     std::optional<common::Sort> sort;
+    std::optional<DataFeed> feed;
     std::optional<std::string> page_token;
 };
 
@@ -165,6 +166,8 @@ struct OptionChainRequest {
     std::optional<std::string> expiration_date_lte;
     std::optional<std::string> root_symbol;
     std::optional<std::string> updated_since;
+    std::optional<int> limit;
+    std::optional<std::string> page_token;
 };
 
 struct MostActivesRequest {
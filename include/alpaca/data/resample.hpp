@@ -0,0 +1,78 @@
+#pragma once
+
+#include "alpaca/data/models.hpp"
+#include "alpaca/data/timeframe.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alpaca::data {
+
+/**
+ * Bars for one symbol stored column by column, sorted by timestamp. A missing vwap is stored
+ * as NaN (and read back as std::nullopt by to_bars()); a missing trade_count as 0.
+ */
+struct BarColumns {
+    std::string symbol;
+    std::vector<std::int64_t> timestamp_ns;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<double> vwap;
+    std::vector<double> trade_count;
+
+    [[nodiscard]] std::size_t size() const noexcept { return timestamp_ns.size(); }
+    void reserve(std::size_t count);
+    // Appends a bar; bars whose timestamp does not parse are skipped.
+    void push_back(const Bar &bar);
+
+    // Bars of `symbol` from a (possibly multi-symbol) bars response, sorted by time.
+    [[nodiscard]] static BarColumns from_bars(const std::vector<Bar> &bars, std::string_view symbol);
+    [[nodiscard]] std::vector<Bar> to_bars() const;
+};
+
+/**
+ * One trading day in UTC nanoseconds, derived from the exchange calendar (US Eastern time).
+ */
+struct TradingSession {
+    std::int64_t day_ns{0};            // midnight Eastern of the session date
+    std::int64_t open_ns{0};           // regular open
+    std::int64_t close_ns{0};          // regular close
+    std::int64_t extended_open_ns{0};  // pre-market open, 04:00 Eastern
+    std::int64_t extended_close_ns{0}; // after-hours close, 20:00 Eastern
+
+    // From trading::CalendarDay fields: date "YYYY-MM-DD", open/close "HH:MM" (or "HHMM")
+    // in Eastern time. Throws std::invalid_argument on malformed input.
+    [[nodiscard]] static TradingSession from_calendar(std::string_view date, std::string_view open,
+                                                      std::string_view close);
+};
+
+enum class SessionHours { Regular, Extended };
+
+struct ResampleOptions {
+    // Sorted trading sessions. When empty, buckets are aligned to the Unix epoch in UTC
+    // (suitable for 24/7 crypto) and Day/Week/Month use UTC calendar days.
+    std::vector<TradingSession> sessions;
+    // Which part of each session to keep; bars outside it are dropped.
+    SessionHours hours{SessionHours::Regular};
+    // Minute and Hour buckets are clock multiples (10:00, 11:00, ... for 1Hour), matching the
+    // bars endpoint, and sessions only select which bars are kept. When set, they start at
+    // the session open instead (09:30, 10:30, ...).
+    bool align_to_session_open{false};
+};
+
+// Aggregates bars (typically 1Min) into `target`. With sessions, a Day bar covers one session
+// and is stamped at midnight Eastern like Alpaca's daily bars, and Week/Month bars group whole
+// sessions and take the first session's stamp. A bucket's vwap weighs only the source bars
+// that have one and is NaN when none does. Source bars must be at least as fine as `target`.
+// Like the bars endpoint, Day and Week only come in an amount of 1; anything else throws
+// std::invalid_argument.
+[[nodiscard]] BarColumns resample(const BarColumns &bars, const TimeFrame &target,
+                                  const ResampleOptions &options = {});
+
+} // namespace alpaca::data
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "alpaca/data/option_chain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace alpaca::data {
+
+struct VolSurfaceOptions {
+    // Grid axes: log-moneyness ln(strike / forward) and tenor in years (365-day).
+    std::vector<double> moneyness{-0.3, -0.25, -0.2, -0.15, -0.1, -0.05, 0.0,
+                                  0.05, 0.1,   0.15, 0.2,   0.25, 0.3};
+    std::vector<double> tenors{7 / 365.0,  14 / 365.0,  30 / 365.0, 60 / 365.0,
+                               90 / 365.0, 180 / 365.0, 1.0};
+
+    double rate{0.0};           // for the forward
+    double dividend_yield{0.0}; // for the forward
+    // Expiration time of day in seconds after midnight UTC (16:00 New York standard time).
+    std::int64_t expiry_utc_seconds{21 * 3600};
+
+    // Quote quality filters.
+    double max_relative_spread{0.5}; // (ask - bid) / mid
+    double min_iv{0.01};
+    double max_iv{5.0};
+    bool out_of_the_money_only{true}; // puts below the forward, calls at or above it
+    std::size_t min_points{3};        // per expiry, after filtering
+
+    // Underlyings refreshed at once by VolSurfaceBuilder::update().
+    std::size_t max_concurrency{8};
+};
+
+/**
+ * Implied volatility on a regular tenor x log-moneyness grid, row-major by tenor. Within an
+ * expiry, IV is linear in log-moneyness between quotes and flat beyond them; between expiries,
+ * total variance is linear in time; outside the listed expiries the nearest expiry's smile is
+ * used. Grid points with no usable expiry are NaN.
+ */
+struct VolSurface {
+    std::string underlying;
+    double spot{0.0};
+    std::int64_t as_of_ns{0};
+    std::vector<double> moneyness;
+    std::vector<double> tenors;
+    std::vector<double> iv; // iv[t * moneyness.size() + m]
+
+    [[nodiscard]] double at(std::size_t tenor, std::size_t point) const {
+        return iv.at(tenor * moneyness.size() + point);
+    }
+    // Bilinear interpolation inside the grid, clamped to its edges.
+    [[nodiscard]] double interpolate(double tenor, double log_moneyness) const;
+};
+
+// Builds a surface from an indexed chain's IV column and quotes.
+[[nodiscard]] VolSurface build_vol_surface(const OptionChain &chain, double spot,
+                                           std::int64_t now_ns,
+                                           const VolSurfaceOptions &options = {});
+
+struct VolSurfaceInput {
+    const OptionChain *chain{nullptr};
+    double spot{0.0};
+};
+
+/**
+ * Keeps one surface per underlying and refreshes them as new chain snapshots arrive. Each
+ * expiry's smile is cached with its filtered quotes and the spot it was fitted at, and is
+ * refitted only when those change; only the cheap term-structure step reruns for the rest.
+ */
+class VolSurfaceBuilder {
+  public:
+    VolSurfaceBuilder();
+    explicit VolSurfaceBuilder(VolSurfaceOptions options);
+
+    // Refreshes the surfaces of the given underlyings, up to max_concurrency in parallel. Each
+    // underlying may appear at most once per call.
+    void update(const std::vector<VolSurfaceInput> &inputs, std::int64_t now_ns);
+    void update(const OptionChain &chain, double spot, std::int64_t now_ns);
+
+    [[nodiscard]] const VolSurface *surface(const std::string &underlying) const;
+    // Smiles refitted by the last update(), across all underlyings.
+    [[nodiscard]] std::size_t refitted() const noexcept { return refitted_; }
+
+  private:
+    struct Smile {
+        double spot{0.0};
+        std::vector<double> points; // filtered (log-moneyness, iv) pairs, flattened
+        std::vector<double> grid;   // IV at each moneyness grid point
+    };
+    struct Entry {
+        VolSurface surface;
+        std::map<std::int32_t, Smile> smiles; // by expiry day
+    };
+
+    std::size_t refresh(Entry &entry, const OptionChain &chain, double spot,
+                        std::int64_t now_ns) const;
+
+    VolSurfaceOptions options_;
+    std::map<std::string, Entry> entries_;
+    std::size_t refitted_{0};
+};
+
+} // namespace alpaca::data
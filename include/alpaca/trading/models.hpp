@@ -1,5 +1,7 @@
 #pragma once
 
+#include "alpaca/trading/option_symbol.hpp"
+
 #include <cstdint>
 #include <map>
 #include <optional>
@@ -19,9 +21,11 @@ struct Order {
     std::string symbol;
     std::string status;
     std::string submitted_at;
+    std::string updated_at;
     std::string filled_at;
     std::string qty;
     std::string filled_qty;
+    std::string filled_avg_price;  // empty until the first fill
     std::string type;
     std::string side;
 };
@@ -200,11 +204,16 @@ struct TradeUpdate {
     std::optional<double> position_qty;
     std::optional<double> price;
     std::optional<double> qty;
+    // The same three values as sent, for exact decimal arithmetic (see core::Decimal::parse).
+    std::optional<std::string> position_qty_text;
+    std::optional<std::string> price_text;
+    std::optional<std::string> qty_text;
 };
 
 struct OptionContract {
     std::string id;
     std::string symbol;
+    OptionKey contract_key{0};  // 0 when the symbol has no key
     std::string name;
     std::string status;
     bool tradable{false};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/trading/enums.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace alpaca::trading {
+
+/**
+ * Fields of an OCC option symbol such as AAPL240119C00150000: a root of 1-6 characters, the
+ * expiry as YYMMDD, C or P, and the strike in thousandths of a dollar over 8 digits.
+ */
+struct OccSymbol {
+    std::array<char, 6> root{};
+    std::uint8_t root_size{0};
+    std::int32_t expiry_days{0}; // days since the Unix epoch
+    ContractType type{ContractType::Call};
+    std::int64_t strike_thousandths{0};
+
+    [[nodiscard]] constexpr std::string_view root_view() const noexcept {
+        return {root.data(), root_size};
+    }
+    [[nodiscard]] constexpr double strike() const noexcept {
+        return static_cast<double>(strike_thousandths) / 1000.0;
+    }
+    friend constexpr bool operator==(const OccSymbol &, const OccSymbol &) = default;
+};
+
+// A formatted OCC symbol held inline, so formatting does not allocate.
+struct OccSymbolText {
+    std::array<char, 21> data{};
+    std::uint8_t size{0};
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {data.data(), size}; }
+};
+
+/**
+ * Contract identity packed into 64 bits, from the most significant bit down:
+ *
+ *   root   27 bits  up to 5 characters of [0-9A-Z], base 37 with 0 as padding
+ *   expiry 14 bits  days since 2000-01-01 (through 2044)
+ *   strike 22 bits  cents (up to 41,943.03)
+ *   right   1 bit   0 for calls, 1 for puts
+ *
+ * Keys compare in chain order (root, expiry, strike, call before put), so a sorted vector of
+ * keys is a directly searchable index, and equal contracts always have equal keys. Contracts
+ * outside these ranges (6-character roots, sub-cent strikes) have no key; 0 is never a
+ * valid key and is used by models to mean "no key".
+ */
+using OptionKey = std::uint64_t;
+
+namespace detail {
+
+inline constexpr std::int64_t kOptionKeyEpochDays = core::days_from_civil(2000, 1, 1);
+
+// 0 for padding, 1-10 for digits, 11-36 for letters: preserves ASCII order. Anything else maps
+// past the alphabet so the caller can reject it.
+[[nodiscard]] constexpr std::uint64_t root_code(char c) noexcept {
+    const auto digit = static_cast<unsigned>(c - '0');
+    const auto letter = static_cast<unsigned>(c - 'A');
+    return digit < 10 ? digit + 1 : (letter < 26 ? letter + 11 : 37);
+}
+
+[[nodiscard]] constexpr char root_char(std::uint64_t code) noexcept {
+    return code <= 10 ? static_cast<char>('0' + code - 1) : static_cast<char>('A' + code - 11);
+}
+
+} // namespace detail
+
+// Parses an OCC symbol. Fixed-position fields are decoded without early exits; validity is
+// accumulated and checked once. Returns std::nullopt for anything that is not an OCC symbol.
+[[nodiscard]] constexpr std::optional<OccSymbol>
+parse_occ_symbol(std::string_view symbol) noexcept {
+    if (symbol.size() < 16 || symbol.size() > 21) {
+        return std::nullopt;
+    }
+    const std::size_t root_size = symbol.size() - 15;
+    const std::string_view tail = symbol.substr(root_size);
+    bool valid = true;
+    const auto digit = [&](std::size_t i) {
+        const auto value = static_cast<unsigned>(tail[i] - '0');
+        valid &= value < 10;
+        return value;
+    };
+
+    OccSymbol out;
+    out.root_size = static_cast<std::uint8_t>(root_size);
+    for (std::size_t i = 0; i < root_size; ++i) {
+        out.root[i] = symbol[i];
+        valid &= detail::root_code(symbol[i]) < 37;
+    }
+    const unsigned year = digit(0) * 10 + digit(1);
+    const unsigned month = digit(2) * 10 + digit(3);
+    const unsigned day = digit(4) * 10 + digit(5);
+    valid &= month - 1 < 12 && day - 1 < 31;
+    const bool put = tail[6] == 'P';
+    valid &= put || tail[6] == 'C';
+    std::int64_t strike = 0;
+    for (std::size_t i = 7; i < 15; ++i) {
+        strike = strike * 10 + digit(i);
+    }
+    if (!valid) {
+        return std::nullopt;
+    }
+    out.expiry_days = static_cast<std::int32_t>(core::days_from_civil(2000 + year, month, day));
+    out.type = put ? ContractType::Put : ContractType::Call;
+    out.strike_thousandths = strike;
+    return out;
+}
+
+[[nodiscard]] constexpr OccSymbolText format_occ_symbol(const OccSymbol &symbol) noexcept {
+    OccSymbolText out;
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < symbol.root_size; ++i) {
+        out.data[n++] = symbol.root[i];
+    }
+    std::int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    core::civil_from_days(symbol.expiry_days, year, month, day);
+    const auto put_two = [&](unsigned value) {
+        out.data[n++] = static_cast<char>('0' + value / 10 % 10);
+        out.data[n++] = static_cast<char>('0' + value % 10);
+    };
+    put_two(static_cast<unsigned>(year % 100));
+    put_two(month);
+    put_two(day);
+    out.data[n++] = symbol.type == ContractType::Put ? 'P' : 'C';
+    auto strike = static_cast<std::uint64_t>(symbol.strike_thousandths);
+    for (std::size_t i = 8; i-- > 0;) {
+        out.data[n + i] = static_cast<char>('0' + strike % 10);
+        strike /= 10;
+    }
+    out.size = static_cast<std::uint8_t>(n + 8);
+    return out;
+}
+
+[[nodiscard]] constexpr std::optional<OptionKey>
+encode_option_key(const OccSymbol &symbol) noexcept {
+    const std::int64_t days = symbol.expiry_days - detail::kOptionKeyEpochDays;
+    const std::int64_t cents = symbol.strike_thousandths / 10;
+    if (symbol.root_size == 0 || symbol.root_size > 5 || days < 0 || days >= (1 << 14) ||
+        symbol.strike_thousandths % 10 != 0 || cents < 0 || cents >= (1 << 22)) {
+        return std::nullopt;
+    }
+    std::uint64_t root = 0;
+    for (std::size_t i = 0; i < 5; ++i) {
+        root = root * 37 + (i < symbol.root_size ? detail::root_code(symbol.root[i]) : 0);
+    }
+    return root << 37 | static_cast<std::uint64_t>(days) << 23 |
+           static_cast<std::uint64_t>(cents) << 1 |
+           static_cast<std::uint64_t>(symbol.type == ContractType::Put);
+}
+
+[[nodiscard]] constexpr OccSymbol decode_option_key(OptionKey key) noexcept {
+    OccSymbol out;
+    std::uint64_t root = key >> 37;
+    std::array<std::uint64_t, 5> codes{};
+    for (std::size_t i = 5; i-- > 0;) {
+        codes[i] = root % 37;
+        root /= 37;
+    }
+    for (auto code : codes) {
+        if (code != 0) {
+            out.root[out.root_size++] = detail::root_char(code);
+        }
+    }
+    const auto days = static_cast<std::int64_t>(key >> 23 & 0x3FFF);
+    out.expiry_days = static_cast<std::int32_t>(detail::kOptionKeyEpochDays + days);
+    out.strike_thousandths = static_cast<std::int64_t>(key >> 1 & 0x3FFFFF) * 10;
+    out.type = (key & 1) != 0 ? ContractType::Put : ContractType::Call;
+    return out;
+}
+
+// Key of an OCC symbol string, or 0 when the symbol does not parse or does not fit a key.
+[[nodiscard]] constexpr OptionKey option_key(std::string_view symbol) noexcept {
+    if (const auto parsed = parse_occ_symbol(symbol)) {
+        return encode_option_key(*parsed).value_or(0);
+    }
+    return 0;
+}
+
+} // namespace alpaca::trading
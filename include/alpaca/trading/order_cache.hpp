@@ -0,0 +1,104 @@
+#pragma once
+
+#include "alpaca/trading/models.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace alpaca::trading {
+
+class TradingClient;
+
+/**
+ * Cached view of one order: the latest Order plus its quantities parsed once on update.
+ */
+struct OrderState {
+    Order order;
+    double qty{0.0};
+    double filled_qty{0.0};
+    double filled_avg_price{0.0};
+    std::string last_event;    // last trade update event applied ("fill", "canceled", ...)
+    std::int64_t updated_ns{0};  // time of the change this state reflects
+
+    // False once the order is filled, canceled, expired, rejected or replaced.
+    [[nodiscard]] bool is_open() const noexcept;
+};
+
+struct OrderReconcileReport {
+    std::size_t added{0};     // orders the cache did not know
+    std::size_t updated{0};   // cached orders REST showed a newer state for
+    std::size_t resolved{0};  // cached open orders looked up because they left the open list
+};
+
+/**
+ * Local copy of the account's orders, keyed by id and client_order_id, kept current from
+ * TradingStream trade updates so status and fill lookups need no REST call.
+ *
+ * Every change carries a time (the trade update timestamp, or the order's updated_at for
+ * REST data) and older changes never overwrite newer ones, so reconciling with list_orders
+ * while the stream runs is safe. Thread-safe: the stream thread applies updates while other
+ * threads read; lookups take one uncontended mutex and a hash lookup.
+ */
+class OrderCache {
+public:
+    // Applies a trade update. Returns false when it is older than the cached state or has no
+    // order id.
+    bool apply(const TradeUpdate& update);
+    // Inserts or refreshes orders from REST (e.g. list_orders with status "all" at start-up).
+    // Returns how many changed the cache.
+    std::size_t load(const std::vector<Order>& orders);
+
+    // Refreshes the cache from list_orders(status "open"), paging through every open order,
+    // then fetches each cached open order missing from that list, since it closed while no
+    // update arrived for it. When the pages cannot be walked to the end, nothing is fetched.
+    OrderReconcileReport reconcile(const TradingClient& client);
+    // Same with an open-order list fetched by the caller. `lookup` is called for cached open
+    // orders missing from it and may throw to skip one; an empty `lookup` skips them all.
+    OrderReconcileReport reconcile(const std::vector<Order>& open_orders,
+                                   const std::function<Order(const std::string&)>& lookup);
+
+    [[nodiscard]] std::optional<OrderState> find(const std::string& order_id) const;
+    [[nodiscard]] std::optional<OrderState>
+    find_by_client_order_id(const std::string& client_order_id) const;
+    // Calls fn(const OrderState&) under the cache lock without copying; returns false when
+    // the order is unknown. fn must not call back into the cache.
+    template <typename Fn> bool visit(const std::string& order_id, Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = orders_.find(order_id);
+        if (it == orders_.end()) {
+            return false;
+        }
+        fn(it->second);
+        return true;
+    }
+
+    [[nodiscard]] std::vector<OrderState> open_orders() const;
+    [[nodiscard]] std::size_t size() const;
+    // Trade updates ignored because the cache already held a newer state.
+    [[nodiscard]] std::uint64_t stale_updates() const;
+    // Drops closed orders last updated before `before_ns`. Returns how many were removed.
+    std::size_t prune_closed(std::int64_t before_ns);
+
+    // Handler for TradingStream::subscribe_trade_updates. The cache must outlive the
+    // subscription.
+    [[nodiscard]] std::function<void(const TradeUpdate&)> trade_update_handler();
+
+private:
+    enum class Change { None, Added, Updated };
+
+    // Stores `order` if it is at least as new as the cached state. Caller holds mutex_.
+    Change upsert(const Order& order, std::int64_t updated_ns, const TradeUpdate* update);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, OrderState> orders_;
+    std::unordered_map<std::string, std::string> ids_by_client_id_;
+    std::uint64_t stale_{0};
+};
+
+}  // namespace alpaca::trading
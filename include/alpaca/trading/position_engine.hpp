@@ -0,0 +1,153 @@
+#pragma once
+
+#include "alpaca/core/decimal.hpp"
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/trading/models.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace alpaca::trading {
+
+class TradingClient;
+
+/**
+ * One symbol's position and PnL. Quantities and amounts are signed like the position
+ * (negative when short).
+ */
+struct PositionPnl {
+    std::string symbol;
+    core::Decimal qty;
+    core::Decimal avg_entry_price;
+    core::Decimal cost_basis;      // qty * avg_entry_price
+    core::Decimal mark_price;      // zero until the first mark
+    core::Decimal market_value;    // qty * mark_price, or the cost basis before the first mark
+    core::Decimal unrealized_pnl;  // market_value - cost_basis
+    core::Decimal realized_pnl;    // from fills that reduced the position
+    std::int64_t mark_ns{0};
+    std::int64_t updated_ns{0};    // last fill or reconcile that changed the position
+};
+
+struct AccountPnl {
+    core::Decimal market_value;
+    core::Decimal cost_basis;
+    core::Decimal unrealized_pnl;
+    core::Decimal realized_pnl;
+
+    [[nodiscard]] core::Decimal total_pnl() const noexcept {
+        return unrealized_pnl + realized_pnl;
+    }
+};
+
+struct PositionReconcileReport {
+    std::size_t matched{0};   // positions that already agreed with the broker
+    std::size_t adjusted{0};  // positions whose qty or entry price were corrected
+    std::size_t added{0};     // broker positions the engine did not hold
+    std::size_t closed{0};    // local positions the broker no longer reports
+    std::size_t skipped{0};   // positions filled after the snapshot was requested
+};
+
+/**
+ * Real-time positions and PnL kept from TradingStream fills and live quotes, so strategies
+ * need not poll list_positions.
+ *
+ * Fills move the quantity and average-cost basis and book realized PnL when they reduce or
+ * flip a position; marks revalue open positions. Amounts are core::Decimal fixed-point, so
+ * sums never drift, and account totals are maintained incrementally, making a mark O(1).
+ * Thread-safe: fills, marks and reads may come from different threads.
+ */
+class PositionEngine {
+public:
+    // Execution ids remembered for de-duplication; redeliveries come within a reconnect, so
+    // only the most recent ones are kept.
+    static constexpr std::size_t kDefaultExecutionIdWindow = 1 << 16;
+
+    explicit PositionEngine(std::size_t execution_id_window = kDefaultExecutionIdWindow);
+
+    // Applies a "fill" or "partial_fill" trade update (other events are ignored), reading
+    // price and quantities from their text so they are exact. Repeated executions are skipped
+    // by execution_id, among the last execution_id_window. When the update carries
+    // position_qty and it disagrees with the local quantity, the broker's quantity wins at the
+    // same entry price. Returns whether the position changed.
+    bool apply(const TradeUpdate& update);
+    // Applies one execution; `qty` is positive for buys and negative for sells.
+    void apply_fill(const std::string& symbol, core::Decimal qty, core::Decimal price,
+                    std::int64_t timestamp_ns);
+
+    // Revalues `symbol` at `price`. Symbols never filled nor reconciled are ignored, so a
+    // broad quote subscription costs one hash lookup per quote. Returns whether it was held.
+    bool mark(const std::string& symbol, core::Decimal price, std::int64_t timestamp_ns);
+    // Marks at the mid price, or at the one side quoted when the other is zero.
+    bool mark_quote(const std::string& symbol, double bid_price, double ask_price,
+                    std::int64_t timestamp_ns);
+
+    // Replaces quantities and entry prices with list_positions, leaving realized PnL alone.
+    // Crypto positions listed as "BTCUSD" are matched to the "BTC/USD" book.
+    PositionReconcileReport reconcile(const TradingClient& client);
+    // Same with positions fetched by the caller. Symbols filled after fill_count() read
+    // `fills_before` are skipped, since the snapshot may predate those fills.
+    PositionReconcileReport reconcile(const std::vector<Position>& positions,
+                                      std::uint64_t fills_before);
+
+    [[nodiscard]] std::optional<PositionPnl> find(const std::string& symbol) const;
+    [[nodiscard]] std::vector<PositionPnl> positions() const;
+    [[nodiscard]] AccountPnl account() const;
+    // Executions applied so far.
+    [[nodiscard]] std::uint64_t fill_count() const;
+    // Trade updates whose position_qty disagreed with the local quantity.
+    [[nodiscard]] std::uint64_t quantity_corrections() const;
+
+    // Handler for TradingStream::subscribe_trade_updates. The engine must outlive the
+    // subscription.
+    [[nodiscard]] std::function<void(const TradeUpdate&)> trade_update_handler();
+    // Handler for subscribe_quotes on StockDataStream or CryptoDataStream (data::Quote); a
+    // template so the trading library does not depend on the market data headers. The engine
+    // must outlive the subscription.
+    template <typename QuoteT> [[nodiscard]] std::function<void(const QuoteT&)> quote_handler() {
+        return [this](const QuoteT& quote) {
+            mark_quote(quote.symbol, quote.bid_price, quote.ask_price,
+                       core::parse_timestamp_ns(quote.timestamp).value_or(0));
+        };
+    }
+
+private:
+    struct Book {
+        core::Decimal qty;
+        core::Decimal cost_basis;
+        core::Decimal realized_pnl;
+        core::Decimal mark_price;
+        core::Decimal market_value;
+        std::int64_t mark_ns{0};
+        std::int64_t updated_ns{0};
+        std::uint64_t last_fill{0};  // fills_ when this symbol last filled
+    };
+
+    // Caller holds mutex_ for all of these.
+    void fill(Book& book, core::Decimal qty, core::Decimal price);
+    // Around any change to a book: detach takes its amounts out of the account totals and
+    // attach recomputes its market value and adds them back.
+    void detach(const Book& book);
+    void attach(Book& book);
+    void set_position(Book& book, core::Decimal qty, core::Decimal avg_entry_price);
+    [[nodiscard]] static PositionPnl snapshot(const std::string& symbol, const Book& book);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Book> books_;
+    // The last execution_id_window_ ids, oldest first in execution_order_.
+    std::unordered_set<std::string> execution_ids_;
+    std::deque<std::string> execution_order_;
+    std::size_t execution_id_window_;
+    AccountPnl account_;
+    std::uint64_t fills_{0};
+    std::uint64_t corrections_{0};
+};
+
+}  // namespace alpaca::trading
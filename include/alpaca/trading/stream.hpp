@@ -1,11 +1,19 @@
 #pragma once
 
+#include "alpaca/core/backoff.hpp"
 #include "alpaca/core/config.hpp"
+#include "alpaca/core/frame_log.hpp"
+#include "alpaca/core/heartbeat.hpp"
+#include "alpaca/core/latency.hpp"
 #include "alpaca/trading/models.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
@@ -28,6 +36,31 @@ public:
     void stop();
     void close();
 
+    // Reconnect behaviour after the connection drops
+    void set_reconnect_policy(core::ReconnectPolicy policy);
+    [[nodiscard]] const core::ReconnectPolicy& reconnect_policy() const noexcept;
+
+    // Pings the server and drops a silent connection so it is reconnected within about a
+    // second (see DataStream::enable_heartbeat). Call before run(); heartbeat() is null until
+    // enabled.
+    void enable_heartbeat(core::HeartbeatOptions options = {});
+    [[nodiscard]] const core::Heartbeat* heartbeat() const noexcept;
+
+    // Opt-in per-event latency histograms. Call before run(); latency_stats() is null until
+    // enabled and can be read (or reset) from any thread while the stream runs.
+    void enable_latency_stats();
+    [[nodiscard]] core::StreamLatencyStats* latency_stats() const noexcept;
+
+    // Records every frame read to a memory-mapped log at `path` (see DataStream). Call before
+    // run().
+    void enable_frame_recording(const std::string& path);
+    [[nodiscard]] core::FrameLogWriter* frame_recorder() const noexcept;
+    // Feeds recorded frames through the trade update parser and handler on the calling thread
+    // at `speed` times the recorded pace (0 = as fast as possible). The stream must not be
+    // running. Returns the number of frames dispatched.
+    std::size_t replay_frames(const core::FrameLogReader& log, double speed = 0.0,
+                              std::size_t first = 0);
+
     // Trade updates subscription
     using TradeUpdateHandler = std::function<void(const TradeUpdate&)>;
     void subscribe_trade_updates(TradeUpdateHandler handler);
@@ -42,9 +75,17 @@ private:
     std::atomic<bool> should_run_{true};
     std::unique_ptr<std::thread> worker_thread_;
     TradeUpdateHandler trade_updates_handler_;
+    core::ReconnectPolicy reconnect_policy_;
+    std::mutex reconnect_mutex_;
+    std::condition_variable reconnect_cv_;
+    std::unique_ptr<core::StreamLatencyStats> latency_stats_;
+    std::int64_t frame_received_ns_{0};
+    std::unique_ptr<core::FrameLogWriter> frame_recorder_;
+    std::unique_ptr<core::Heartbeat> heartbeat_;
 
     // Internal methods
     void run_loop();
+    void wait_for_reconnect(std::chrono::milliseconds delay);
     void connect_impl();
     void authenticate_impl();
     void subscribe_to_trade_updates_impl();
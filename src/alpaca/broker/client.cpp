@@ -664,9 +664,11 @@ trading::Order parse_trading_order_from_object(simdjson::ondemand::object& objec
     order.symbol = get_string_or_empty(object, "symbol");
     order.status = get_string_or_empty(object, "status");
     order.submitted_at = get_string_or_empty(object, "submitted_at");
+    order.updated_at = get_string_or_empty(object, "updated_at");
     order.filled_at = get_string_or_empty(object, "filled_at");
     order.qty = get_string_or_empty(object, "qty");
     order.filled_qty = get_string_or_empty(object, "filled_qty");
+    order.filled_avg_price = get_string_or_empty(object, "filled_avg_price");
     order.type = get_string_or_empty(object, "type");
     order.side = get_string_or_empty(object, "side");
     return order;
@@ -3422,9 +3424,11 @@ trading::Order parse_order_from_object(simdjson::ondemand::object& object) {
     order.symbol = get_string_or_empty(object, "symbol");
     order.status = get_string_or_empty(object, "status");
     order.submitted_at = get_string_or_empty(object, "submitted_at");
+    order.updated_at = get_string_or_empty(object, "updated_at");
     order.filled_at = get_string_or_empty(object, "filled_at");
     order.qty = get_string_or_empty(object, "qty");
     order.filled_qty = get_string_or_empty(object, "filled_qty");
+    order.filled_avg_price = get_string_or_empty(object, "filled_avg_price");
     order.type = get_string_or_empty(object, "type");
     order.side = get_string_or_empty(object, "side");
     return order;
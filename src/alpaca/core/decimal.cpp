@@ -0,0 +1,189 @@
+#include "alpaca/core/decimal.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace alpaca::core {
+
+namespace {
+
+constexpr std::int64_t kMax = std::numeric_limits<std::int64_t>::max();
+
+// Unsigned 128-bit intermediate for products and quotients. MSVC has no __int128, so the
+// halves are kept explicitly and the arithmetic falls back to 32-bit limbs there.
+struct Wide {
+    std::uint64_t hi{0};
+    std::uint64_t lo{0};
+};
+
+#ifdef __SIZEOF_INT128__
+__extension__ using Native = unsigned __int128;
+#endif
+
+Wide multiply(std::uint64_t a, std::uint64_t b) noexcept {
+#ifdef __SIZEOF_INT128__
+    const Native product = static_cast<Native>(a) * b;
+    return {static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product)};
+#else
+    constexpr std::uint64_t kLow = 0xffff'ffff;
+    const std::uint64_t ll = (a & kLow) * (b & kLow);
+    const std::uint64_t lh = (a & kLow) * (b >> 32);
+    const std::uint64_t hl = (a >> 32) * (b & kLow);
+    const std::uint64_t hh = (a >> 32) * (b >> 32);
+    const std::uint64_t mid = (ll >> 32) + (lh & kLow) + (hl & kLow);
+    return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & kLow)};
+#endif
+}
+
+// numerator / denominator rounded half up; denominator is positive and the quotient is
+// expected to fit in 64 bits (higher bits are dropped).
+std::uint64_t divide_rounded(Wide numerator, std::uint64_t denominator) noexcept {
+#ifdef __SIZEOF_INT128__
+    const Native wide = (static_cast<Native>(numerator.hi) << 64) | numerator.lo;
+    auto quotient = static_cast<std::uint64_t>(wide / denominator);
+    const auto remainder = static_cast<std::uint64_t>(wide % denominator);
+#else
+    // Shift-subtract long division; the remainder stays below the denominator.
+    std::uint64_t quotient = 0;
+    std::uint64_t remainder = 0;
+    for (int bit = 127; bit >= 0; --bit) {
+        const std::uint64_t next =
+            bit >= 64 ? (numerator.hi >> (bit - 64)) & 1 : (numerator.lo >> bit) & 1;
+        const bool carry = (remainder >> 63) != 0;
+        remainder = (remainder << 1) | next;
+        quotient <<= 1;
+        if (carry || remainder >= denominator) {
+            remainder -= denominator;
+            quotient |= 1;
+        }
+    }
+#endif
+    if (remainder >= denominator - remainder) {
+        ++quotient;
+    }
+    return quotient;
+}
+
+std::uint64_t magnitude(std::int64_t value) noexcept {
+    return value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+}
+
+// Magnitudes round half up, so signed results round half away from zero.
+std::int64_t with_sign(std::uint64_t magnitude, bool negative) noexcept {
+    const auto value = static_cast<std::int64_t>(magnitude);
+    return negative ? -value : value;
+}
+
+} // namespace
+
+Decimal Decimal::from_double(double value) noexcept {
+    const double scaled = value * static_cast<double>(kScale);
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= static_cast<double>(kMax)) {
+        return {};
+    }
+    return Decimal{std::llround(scaled)};
+}
+
+std::optional<Decimal> Decimal::parse(std::string_view text) noexcept {
+    bool negative = false;
+    if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+    if (text.empty()) {
+        return std::nullopt;
+    }
+
+    std::int64_t value = 0;
+    int fraction_digits = -1;  // -1 until the decimal point
+    bool round_up = false;
+    bool digits = false;
+    for (const char c : text) {
+        if (c == '.') {
+            if (fraction_digits >= 0) {
+                return std::nullopt;
+            }
+            fraction_digits = 0;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        digits = true;
+        if (fraction_digits >= 8) {
+            // Only the first dropped digit decides the rounding.
+            if (fraction_digits == 8) {
+                round_up = c >= '5';
+                ++fraction_digits;
+            }
+            continue;
+        }
+        const int digit = c - '0';
+        if (value > (kMax - digit) / 10) {
+            return std::nullopt;
+        }
+        value = value * 10 + digit;
+        if (fraction_digits >= 0) {
+            ++fraction_digits;
+        }
+    }
+    if (!digits) {
+        return std::nullopt;
+    }
+    for (int i = fraction_digits < 0 ? 0 : fraction_digits; i < 8; ++i) {
+        if (value > kMax / 10) {
+            return std::nullopt;
+        }
+        value *= 10;
+    }
+    if (round_up) {
+        if (value == kMax) {
+            return std::nullopt;
+        }
+        ++value;
+    }
+    return Decimal{negative ? -value : value};
+}
+
+double Decimal::to_double() const noexcept {
+    return static_cast<double>(raw / kScale) +
+           static_cast<double>(raw % kScale) / static_cast<double>(kScale);
+}
+
+std::string Decimal::to_string() const {
+    const std::uint64_t magnitude =
+        raw < 0 ? static_cast<std::uint64_t>(-(raw + 1)) + 1 : static_cast<std::uint64_t>(raw);
+    const auto scale = static_cast<std::uint64_t>(kScale);
+    std::string out = raw < 0 ? "-" : "";
+    out += std::to_string(magnitude / scale);
+    std::uint64_t fraction = magnitude % scale;
+    if (fraction != 0) {
+        std::string digits(8, '0');
+        for (std::size_t i = 8; i-- > 0; fraction /= 10) {
+            digits[i] = static_cast<char>('0' + fraction % 10);
+        }
+        digits.erase(digits.find_last_not_of('0') + 1);
+        out += '.';
+        out += digits;
+    }
+    return out;
+}
+
+Decimal operator*(Decimal a, Decimal b) noexcept {
+    const std::uint64_t product = divide_rounded(multiply(magnitude(a.raw), magnitude(b.raw)),
+                                                 static_cast<std::uint64_t>(Decimal::kScale));
+    return Decimal{with_sign(product, (a.raw < 0) != (b.raw < 0))};
+}
+
+Decimal operator/(Decimal a, Decimal b) {
+    if (b.raw == 0) {
+        throw std::domain_error("Decimal: division by zero");
+    }
+    const Wide numerator =
+        multiply(magnitude(a.raw), static_cast<std::uint64_t>(Decimal::kScale));
+    return Decimal{
+        with_sign(divide_rounded(numerator, magnitude(b.raw)), (a.raw < 0) != (b.raw < 0))};
+}
+
+}  // namespace alpaca::core
@@ -0,0 +1,296 @@
+#include "alpaca/core/frame_log.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ALPACA_FRAME_LOG_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace alpaca::core {
+
+namespace {
+
+constexpr char kLogMagic[8] = {'A', 'L', 'P', 'F', 'R', 'L', 'O', 'G'};
+constexpr char kIndexMagic[8] = {'A', 'L', 'P', 'F', 'R', 'I', 'D', 'X'};
+constexpr std::size_t kFileHeader = 16;   // magic + committed bytes (log) or frames (index)
+constexpr std::size_t kRecordHeader = 16; // received_ns + length + reserved
+constexpr std::size_t kIndexEntry = 16;   // received_ns + offset
+constexpr std::size_t kInitialCapacity = std::size_t{1} << 20;
+
+constexpr std::size_t align8(std::size_t n) noexcept { return (n + 7) & ~std::size_t{7}; }
+
+template <typename T> T load(const char *p) noexcept {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T> void store(char *p, T value) noexcept { std::memcpy(p, &value, sizeof(T)); }
+
+[[noreturn]] void fail(const std::string &what, const std::string &path) {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+#else
+    throw std::runtime_error(what + " " + path + ": frame logs need a POSIX platform");
+#endif
+}
+
+} // namespace
+
+FrameLogWriter::FrameLogWriter(const std::string &path) : path_(path) {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    log_.path = path;
+    index_.path = path + ".idx";
+    log_.fd = ::open(log_.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (log_.fd < 0) {
+        fail("FrameLogWriter: cannot open", log_.path);
+    }
+    index_.fd = ::open(index_.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (index_.fd < 0) {
+        const std::string index_path = index_.path;
+        release(log_);
+        fail("FrameLogWriter: cannot open", index_path);
+    }
+    try {
+        reserve(log_, kInitialCapacity);
+        reserve(index_, kInitialCapacity);
+    } catch (...) {
+        release(log_);
+        release(index_);
+        throw;
+    }
+    std::memcpy(log_.data, kLogMagic, sizeof(kLogMagic));
+    std::memcpy(index_.data, kIndexMagic, sizeof(kIndexMagic));
+    log_.used = kFileHeader;
+    index_.used = kFileHeader;
+    store<std::uint64_t>(log_.data + 8, log_.used);
+    store<std::uint64_t>(index_.data + 8, 0);
+#else
+    fail("FrameLogWriter: cannot open", path);
+#endif
+}
+
+FrameLogWriter::~FrameLogWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; the headers already describe every complete frame.
+    }
+}
+
+void FrameLogWriter::reserve(Mapping &file, std::size_t bytes) {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    if (bytes <= file.capacity) {
+        return;
+    }
+    const std::size_t capacity = std::max({bytes, file.capacity * 2, kInitialCapacity});
+    if (file.data != nullptr) {
+        ::munmap(file.data, file.capacity);
+        file.data = nullptr;
+        file.capacity = 0;
+    }
+    if (::ftruncate(file.fd, static_cast<off_t>(capacity)) != 0) {
+        fail("FrameLogWriter: cannot grow", file.path);
+    }
+    void *data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (data == MAP_FAILED) {
+        fail("FrameLogWriter: cannot map", file.path);
+    }
+    file.data = static_cast<char *>(data);
+    file.capacity = capacity;
+#else
+    (void)file;
+    (void)bytes;
+#endif
+}
+
+void FrameLogWriter::release(Mapping &file) {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    if (file.data != nullptr) {
+        ::munmap(file.data, file.capacity);
+    }
+    if (file.fd >= 0) {
+        if (file.used > 0) {
+            (void)::ftruncate(file.fd, static_cast<off_t>(file.used));
+        }
+        ::close(file.fd);
+    }
+#endif
+    file = Mapping{};
+}
+
+void FrameLogWriter::append(std::string_view frame, std::int64_t received_ns) {
+    if (log_.fd < 0) {
+        throw std::logic_error("FrameLogWriter: append after close");
+    }
+    if (frame.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("FrameLogWriter: frame larger than 4 GiB");
+    }
+    const std::size_t offset = log_.used;
+    const std::size_t end = offset + align8(kRecordHeader + frame.size());
+    reserve(log_, end);
+    reserve(index_, index_.used + kIndexEntry);
+
+    char *record = log_.data + offset;
+    store<std::int64_t>(record, received_ns);
+    store<std::uint32_t>(record + 8, static_cast<std::uint32_t>(frame.size()));
+    store<std::uint32_t>(record + 12, 0);
+    std::memcpy(record + kRecordHeader, frame.data(), frame.size());
+    char *entry = index_.data + index_.used;
+    store<std::int64_t>(entry, received_ns);
+    store<std::uint64_t>(entry + 8, offset);
+
+    // Commit the record before the index so a reader never sees an entry past the log's end.
+    log_.used = end;
+    index_.used += kIndexEntry;
+    ++frames_;
+    store<std::uint64_t>(log_.data + 8, log_.used);
+    store<std::uint64_t>(index_.data + 8, frames_);
+}
+
+void FrameLogWriter::append(std::string_view frame) { append(frame, now_ns()); }
+
+void FrameLogWriter::flush() {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    for (Mapping *file : {&log_, &index_}) {
+        if (file->data != nullptr && ::msync(file->data, file->used, MS_SYNC) != 0) {
+            fail("FrameLogWriter: cannot sync", file->path);
+        }
+    }
+#endif
+}
+
+void FrameLogWriter::close() {
+    release(log_);
+    release(index_);
+}
+
+FrameLogReader::FrameLogReader(const std::string &path) {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        fail("FrameLogReader: cannot open", path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        fail("FrameLogReader: cannot stat", path);
+    }
+    const auto file_size = static_cast<std::size_t>(info.st_size);
+    if (file_size < kFileHeader) {
+        ::close(fd);
+        throw std::runtime_error("FrameLogReader: not a frame log: " + path);
+    }
+    void *data = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        fail("FrameLogReader: cannot map", path);
+    }
+    data_ = static_cast<const char *>(data);
+    length_ = file_size;
+    if (std::memcmp(data_, kLogMagic, sizeof(kLogMagic)) != 0) {
+        ::munmap(const_cast<char *>(data_), length_);
+        throw std::runtime_error("FrameLogReader: not a frame log: " + path);
+    }
+#else
+    fail("FrameLogReader: cannot open", path);
+#endif
+    const std::size_t committed =
+        std::min<std::size_t>(load<std::uint64_t>(data_ + 8), length_);
+    const auto record_end = [&](std::uint64_t offset) {
+        return offset + kRecordHeader + load<std::uint32_t>(data_ + offset + 8);
+    };
+
+    // Index: trusted only when its last entry ends exactly at the committed log size.
+    std::ifstream index(path + ".idx", std::ios::binary);
+    char header[kFileHeader];
+    if (index.read(header, sizeof(header)) &&
+        std::memcmp(header, kIndexMagic, sizeof(kIndexMagic)) == 0) {
+        const auto frames = load<std::uint64_t>(header + 8);
+        std::vector<char> entries(static_cast<std::size_t>(frames) * kIndexEntry);
+        if (index.read(entries.data(), static_cast<std::streamsize>(entries.size()))) {
+            offsets_.reserve(static_cast<std::size_t>(frames));
+            std::uint64_t expected = kFileHeader;
+            for (std::size_t i = 0; i < frames; ++i) {
+                const auto offset = load<std::uint64_t>(entries.data() + i * kIndexEntry + 8);
+                if (offset != expected || offset + kRecordHeader > committed) {
+                    break;
+                }
+                offsets_.push_back(offset);
+                expected = align8(record_end(offset));
+            }
+            if (offsets_.size() != frames || expected != committed) {
+                offsets_.clear();
+            }
+        }
+    }
+    if (offsets_.empty()) {
+        std::size_t offset = kFileHeader;
+        while (offset + kRecordHeader <= committed && record_end(offset) <= committed) {
+            offsets_.push_back(offset);
+            offset = align8(record_end(offset));
+        }
+    }
+}
+
+FrameLogReader::~FrameLogReader() {
+#ifdef ALPACA_FRAME_LOG_POSIX
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char *>(data_), length_);
+    }
+#endif
+}
+
+RecordedFrame FrameLogReader::operator[](std::size_t i) const {
+    const char *record = data_ + offsets_.at(i);
+    return {load<std::int64_t>(record),
+            std::string_view(record + kRecordHeader, load<std::uint32_t>(record + 8))};
+}
+
+std::size_t FrameLogReader::find(std::int64_t received_ns) const {
+    const auto it = std::partition_point(
+        offsets_.begin(), offsets_.end(),
+        [&](std::uint64_t offset) { return load<std::int64_t>(data_ + offset) < received_ns; });
+    return static_cast<std::size_t>(it - offsets_.begin());
+}
+
+std::size_t FrameLogReader::replay(const std::function<void(const RecordedFrame &)> &handler,
+                                   double speed, std::size_t first,
+                                   const std::atomic<bool> *running) const {
+    if (first >= size()) {
+        return 0;
+    }
+    const std::int64_t first_ns = (*this)[first].received_ns;
+    const auto wall_start = std::chrono::steady_clock::now();
+    std::size_t handled = 0;
+    for (std::size_t i = first; i < size(); ++i) {
+        if (running != nullptr && !running->load(std::memory_order_relaxed)) {
+            break;
+        }
+        const RecordedFrame frame = (*this)[i];
+        if (speed > 0.0) {
+            const auto offset = static_cast<double>(frame.received_ns - first_ns);
+            std::this_thread::sleep_until(
+                wall_start +
+                std::chrono::nanoseconds(static_cast<std::int64_t>(offset / speed)));
+        }
+        handler(frame);
+        ++handled;
+    }
+    return handled;
+}
+
+}  // namespace alpaca::core
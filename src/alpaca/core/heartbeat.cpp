@@ -0,0 +1,84 @@
+#include "alpaca/core/heartbeat.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace alpaca::core {
+
+namespace {
+std::int64_t to_ns(std::chrono::milliseconds duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+} // namespace
+
+Heartbeat::Heartbeat(HeartbeatOptions options) : options_(options) {}
+
+void Heartbeat::start(std::int64_t now_ns) noexcept {
+    last_read_ns_ = last_data_ns_ = last_ping_ns_ = now_ns;
+    stale_ = false;
+    data_silent_ = false;
+}
+
+void Heartbeat::on_data(std::int64_t now_ns) noexcept {
+    last_read_ns_ = last_data_ns_ = now_ns;
+}
+
+void Heartbeat::on_control(bool pong, std::string_view payload, std::int64_t now_ns) noexcept {
+    last_read_ns_ = now_ns;
+    if (!pong) {
+        return;
+    }
+    pongs_received_.fetch_add(1, std::memory_order_relaxed);
+    std::int64_t sent_ns = 0;
+    const auto [end, error] =
+        std::from_chars(payload.data(), payload.data() + payload.size(), sent_ns);
+    // Unsolicited pongs and foreign payloads count as activity but carry no round trip.
+    if (error != std::errc{} || end != payload.data() + payload.size() || sent_ns > now_ns ||
+        sent_ns < last_ping_ns_ - to_ns(options_.silence_timeout)) {
+        return;
+    }
+    rtt_.record(now_ns - sent_ns);
+    last_rtt_ns_.store(now_ns - sent_ns, std::memory_order_relaxed);
+}
+
+Heartbeat::Action Heartbeat::poll(std::int64_t now_ns) noexcept {
+    if (stale_) {
+        return Action::Stale;
+    }
+    const bool silent = now_ns - last_read_ns_ >= to_ns(options_.silence_timeout);
+    data_silent_ = options_.data_silence_timeout.count() > 0 &&
+                   now_ns - last_data_ns_ >= to_ns(options_.data_silence_timeout);
+    if (silent || data_silent_) {
+        stale_ = true;
+        stale_connections_.fetch_add(1, std::memory_order_relaxed);
+        return Action::Stale;
+    }
+    if (now_ns - last_ping_ns_ >= to_ns(options_.ping_interval)) {
+        return Action::Ping;
+    }
+    return Action::None;
+}
+
+std::string Heartbeat::make_ping(std::int64_t now_ns) {
+    last_ping_ns_ = now_ns;
+    pings_sent_.fetch_add(1, std::memory_order_relaxed);
+    return std::to_string(now_ns);
+}
+
+std::chrono::nanoseconds Heartbeat::poll_interval() const noexcept {
+    auto shortest = std::min(options_.ping_interval, options_.silence_timeout);
+    if (options_.data_silence_timeout.count() > 0) {
+        shortest = std::min(shortest, options_.data_silence_timeout);
+    }
+    // A quarter of the shortest deadline bounds how late a ping or a verdict can be.
+    return std::max<std::chrono::nanoseconds>(shortest / 4, std::chrono::milliseconds(1));
+}
+
+std::string Heartbeat::stale_reason() const {
+    if (data_silent_) {
+        return "no data for " + std::to_string(options_.data_silence_timeout.count()) + " ms";
+    }
+    return "nothing read for " + std::to_string(options_.silence_timeout.count()) + " ms";
+}
+
+}  // namespace alpaca::core
@@ -0,0 +1,56 @@
+#include "alpaca/core/latency.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace alpaca::core {
+
+std::int64_t LatencyHistogram::percentile(double quantile) const noexcept {
+    // Snapshot the counts first so the total and the walk agree under concurrent recording.
+    std::array<std::uint64_t, kBucketCount> snapshot;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        snapshot[i] = counts_[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const double q = std::clamp(quantile, 0.0, 1.0);
+    const auto target =
+        std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += snapshot[i];
+        if (seen >= target) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(kBucketCount - 1);
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept {
+    std::uint64_t total = 0;
+    for (const auto &bucket : counts_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+LatencySummary LatencyHistogram::summary() const noexcept {
+    LatencySummary result;
+    result.count = count();
+    result.p50 = percentile(0.5);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = percentile(1.0);
+    return result;
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto &bucket : counts_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace alpaca::core
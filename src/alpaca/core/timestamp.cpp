@@ -0,0 +1,127 @@
+#include "alpaca/core/timestamp.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace alpaca::core {
+
+namespace {
+
+constexpr std::int64_t kNanosPerSecond = 1'000'000'000;
+
+bool read_digits(std::string_view text, std::size_t pos, std::size_t count, int &out) noexcept {
+    if (pos + count > text.size()) {
+        return false;
+    }
+    int value = 0;
+    for (std::size_t i = pos; i < pos + count; ++i) {
+        const char c = text[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    out = value;
+    return true;
+}
+
+} // namespace
+
+std::optional<std::int64_t> parse_timestamp_ns(std::string_view text) noexcept {
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (text.size() < 19 || !read_digits(text, 0, 4, year) || text[4] != '-' ||
+        !read_digits(text, 5, 2, month) || text[7] != '-' || !read_digits(text, 8, 2, day) ||
+        (text[10] != 'T' && text[10] != 't' && text[10] != ' ') ||
+        !read_digits(text, 11, 2, hour) || text[13] != ':' || !read_digits(text, 14, 2, minute) ||
+        text[16] != ':' || !read_digits(text, 17, 2, second)) {
+        return std::nullopt;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 ||
+        second > 60) {
+        return std::nullopt;
+    }
+
+    std::size_t pos = 19;
+    std::int64_t fraction = 0;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        std::int64_t scale = kNanosPerSecond;
+        const std::size_t start = pos;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            if (scale > 1) {
+                scale /= 10;
+                fraction += (text[pos] - '0') * scale;
+            }
+            ++pos;
+        }
+        if (pos == start) {
+            return std::nullopt;
+        }
+    }
+
+    std::int64_t offset_seconds = 0;
+    if (pos < text.size() && (text[pos] == 'Z' || text[pos] == 'z')) {
+        ++pos;
+    } else if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+        int off_hour = 0;
+        int off_minute = 0;
+        const bool negative = text[pos] == '-';
+        if (!read_digits(text, pos + 1, 2, off_hour) || pos + 3 >= text.size() ||
+            text[pos + 3] != ':' || !read_digits(text, pos + 4, 2, off_minute)) {
+            return std::nullopt;
+        }
+        offset_seconds = (off_hour * 3600 + off_minute * 60) * (negative ? -1 : 1);
+        pos += 6;
+    } else if (pos < text.size()) {
+        return std::nullopt;
+    }
+    if (pos != text.size()) {
+        return std::nullopt;
+    }
+
+    const std::int64_t days =
+        days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    const std::int64_t seconds =
+        days * 86400 + hour * 3600 + minute * 60 + second - offset_seconds;
+    return seconds * kNanosPerSecond + fraction;
+}
+
+std::string format_timestamp_ns(std::int64_t ns) {
+    std::int64_t seconds = ns / kNanosPerSecond;
+    std::int64_t fraction = ns % kNanosPerSecond;
+    if (fraction < 0) {
+        fraction += kNanosPerSecond;
+        --seconds;
+    }
+    std::int64_t days = seconds / 86400;
+    std::int64_t secs_of_day = seconds % 86400;
+    if (secs_of_day < 0) {
+        secs_of_day += 86400;
+        --days;
+    }
+    std::int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civil_from_days(days, year, month, day);
+
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02uT%02lld:%02lld:%02lld.%09lldZ",
+                  static_cast<long long>(year), month, day,
+                  static_cast<long long>(secs_of_day / 3600),
+                  static_cast<long long>((secs_of_day / 60) % 60),
+                  static_cast<long long>(secs_of_day % 60), static_cast<long long>(fraction));
+    return std::string(buffer);
+}
+
+std::int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace alpaca::core
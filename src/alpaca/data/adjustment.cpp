@@ -0,0 +1,124 @@
+#include "alpaca/data/adjustment.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+namespace alpaca::data {
+
+namespace {
+
+std::optional<std::int64_t> ex_date_ns(const std::string &date) {
+    try {
+        return TradingSession::from_calendar(date, "00:00", "00:00").day_ns;
+    } catch (const std::invalid_argument &) {
+        return std::nullopt;
+    }
+}
+
+void scale(std::vector<double> &column, const std::vector<double> &factors) {
+    for (std::size_t i = 0; i < column.size(); ++i) {
+        column[i] *= factors[i];
+    }
+}
+
+} // namespace
+
+void CorporateActionAdjuster::add(const CorporateActionsResponse &actions) {
+    for (const auto &split : actions.splits) {
+        add(split);
+    }
+    for (const auto &dividend : actions.dividends) {
+        add(dividend);
+    }
+}
+
+void CorporateActionAdjuster::add(const SplitAction &split) {
+    const auto ex_ns = ex_date_ns(split.ex_date);
+    if (!ex_ns || split.symbol.empty() || !(split.ratio() > 0.0)) {
+        return;
+    }
+    insert(split.id, split.symbol, Event{*ex_ns, split.ratio(), 0.0, true});
+}
+
+void CorporateActionAdjuster::add(const DividendAction &dividend) {
+    const auto ex_ns = ex_date_ns(dividend.ex_date);
+    if (!ex_ns || dividend.symbol.empty() || !(dividend.rate > 0.0)) {
+        return;
+    }
+    Event event{*ex_ns, 1.0, dividend.rate, false};
+    if (dividend.type == CorporateActionsType::StockDividend) {
+        event = Event{*ex_ns, 1.0 + dividend.rate, 0.0, true};
+    }
+    insert(dividend.id, dividend.symbol, event);
+}
+
+void CorporateActionAdjuster::insert(const std::string &id, const std::string &symbol,
+                                     const Event &event) {
+    if (!id.empty() && !ids_.insert(id).second) {
+        return;
+    }
+    auto &events = events_[symbol];
+    const auto at = std::upper_bound(
+        events.begin(), events.end(), event.ex_ns,
+        [](std::int64_t ex_ns, const Event &other) { return ex_ns < other.ex_ns; });
+    events.insert(at, event);
+}
+
+CorporateActionAdjuster::Factors CorporateActionAdjuster::factors(const BarColumns &raw,
+                                                                  Adjustment mode) const {
+    const std::size_t n = raw.size();
+    Factors factors{std::vector<double>(n, 1.0), std::vector<double>(n, 1.0)};
+    const auto it = events_.find(raw.symbol);
+    if (mode == Adjustment::Raw || it == events_.end()) {
+        return factors;
+    }
+    const bool splits = mode == Adjustment::Split || mode == Adjustment::All;
+    const bool dividends = mode == Adjustment::Dividend || mode == Adjustment::All;
+
+    // Walk back in time, folding in each action as the first bar before its ex-date is reached.
+    const auto &events = it->second;
+    std::size_t pending = events.size();
+    double price = 1.0;
+    double volume = 1.0;
+    for (std::size_t i = n; i-- > 0;) {
+        for (; pending > 0 && events[pending - 1].ex_ns > raw.timestamp_ns[i]; --pending) {
+            const Event &event = events[pending - 1];
+            if (event.split && splits) {
+                price /= event.ratio;
+                volume *= event.ratio;
+            } else if (!event.split && dividends && raw.close[i] > event.cash) {
+                price *= 1.0 - event.cash / raw.close[i];
+            }
+        }
+        factors.price[i] = price;
+        factors.volume[i] = volume;
+    }
+    return factors;
+}
+
+BarColumns CorporateActionAdjuster::adjust(const BarColumns &raw, Adjustment mode) const {
+    BarColumns bars = raw;
+    adjust_in_place(bars, mode);
+    return bars;
+}
+
+void CorporateActionAdjuster::adjust_in_place(BarColumns &bars, Adjustment mode) const {
+    if (mode == Adjustment::Raw || size(bars.symbol) == 0) {
+        return;
+    }
+    const auto f = factors(bars, mode);
+    scale(bars.open, f.price);
+    scale(bars.high, f.price);
+    scale(bars.low, f.price);
+    scale(bars.close, f.price);
+    scale(bars.vwap, f.price);
+    scale(bars.volume, f.volume);
+}
+
+std::size_t CorporateActionAdjuster::size(std::string_view symbol) const {
+    const auto it = events_.find(symbol);
+    return it == events_.end() ? 0 : it->second.size();
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,308 @@
+#include "alpaca/data/asof_join.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+// Drops the consumed prefix once it outweighs the live tail, keeping buffers bounded by the
+// distance one side runs ahead of the other.
+template <typename T> void compact(std::vector<T> &column, std::size_t head, std::size_t stride) {
+    column.erase(column.begin(), column.begin() + static_cast<std::ptrdiff_t>(head * stride));
+}
+
+// Position of a paged stream: the symbol and timestamp of the last row fetched.
+struct StreamPosition {
+    std::string symbol;
+    std::int64_t timestamp_ns{std::numeric_limits<std::int64_t>::min()};
+    bool done{false};
+};
+
+} // namespace
+
+void TradeQuoteColumns::clear() {
+    trade_ns.clear();
+    price.clear();
+    size.clear();
+    quote_ns.clear();
+    bid_price.clear();
+    bid_size.clear();
+    ask_price.clear();
+    ask_size.clear();
+}
+
+AsOfJoiner::AsOfJoiner(BatchCallback on_batch) : AsOfJoiner(std::move(on_batch), Options{}) {}
+
+AsOfJoiner::AsOfJoiner(BatchCallback on_batch, Options options)
+    : on_batch_(std::move(on_batch)), options_(options) {
+    if (!on_batch_) {
+        throw std::invalid_argument("AsOfJoiner requires a batch callback");
+    }
+    if (options_.quote_offset_ns < 0 || options_.max_quote_age_ns < 0) {
+        throw std::invalid_argument("AsOfJoiner offsets must not be negative");
+    }
+}
+
+AsOfJoiner::SymbolState &AsOfJoiner::state(std::string_view symbol) {
+    auto [it, inserted] = ids_.try_emplace(std::string(symbol), states_.size());
+    if (inserted) {
+        states_.emplace_back().out.symbol = it->first;
+    }
+    return states_[it->second];
+}
+
+void AsOfJoiner::add_trades(const StockTradesResponse &page) {
+    for (const auto &trade : page.trades) {
+        auto &s = state(trade.symbol);
+        const auto timestamp = core::parse_timestamp_ns(trade.timestamp).value_or(0);
+        s.trade_ns.push_back(timestamp);
+        s.trade_price.push_back(trade.price);
+        s.trade_size.push_back(trade.size);
+    }
+    for (auto &s : states_) {
+        if (s.trade_head < s.trade_ns.size()) {
+            advance(s, false);
+        }
+    }
+    deliver();
+}
+
+void AsOfJoiner::add_quotes(const StockQuotesResponse &page) {
+    for (const auto &quote : page.quotes) {
+        auto &s = state(quote.symbol);
+        s.quote_ns.push_back(core::parse_timestamp_ns(quote.timestamp).value_or(0));
+        s.quote_fields.insert(s.quote_fields.end(),
+                              {quote.bid_price, quote.bid_size, quote.ask_price, quote.ask_size});
+    }
+    for (auto &s : states_) {
+        if (s.quote_head < s.quote_ns.size()) {
+            advance(s, false);
+        }
+    }
+    deliver();
+}
+
+void AsOfJoiner::add_trades(std::string_view symbol, std::span<const std::int64_t> timestamp_ns,
+                            std::span<const double> price, std::span<const double> size) {
+    if (price.size() != timestamp_ns.size() || size.size() != timestamp_ns.size()) {
+        throw std::invalid_argument("AsOfJoiner::add_trades columns differ in length");
+    }
+    auto &s = state(symbol);
+    s.trade_ns.insert(s.trade_ns.end(), timestamp_ns.begin(), timestamp_ns.end());
+    s.trade_price.insert(s.trade_price.end(), price.begin(), price.end());
+    s.trade_size.insert(s.trade_size.end(), size.begin(), size.end());
+    advance(s, false);
+    deliver();
+}
+
+void AsOfJoiner::add_quotes(std::string_view symbol, std::span<const std::int64_t> timestamp_ns,
+                            std::span<const double> bid_price, std::span<const double> bid_size,
+                            std::span<const double> ask_price, std::span<const double> ask_size) {
+    const std::size_t n = timestamp_ns.size();
+    if (bid_price.size() != n || bid_size.size() != n || ask_price.size() != n ||
+        ask_size.size() != n) {
+        throw std::invalid_argument("AsOfJoiner::add_quotes columns differ in length");
+    }
+    auto &s = state(symbol);
+    s.quote_ns.insert(s.quote_ns.end(), timestamp_ns.begin(), timestamp_ns.end());
+    s.quote_fields.reserve(s.quote_fields.size() + 4 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        s.quote_fields.insert(s.quote_fields.end(),
+                              {bid_price[i], bid_size[i], ask_price[i], ask_size[i]});
+    }
+    advance(s, false);
+    deliver();
+}
+
+void AsOfJoiner::add_quote(std::string_view symbol, std::int64_t timestamp_ns, double bid_price,
+                           double bid_size, double ask_price, double ask_size) {
+    auto &s = state(symbol);
+    s.quote_ns.push_back(timestamp_ns);
+    s.quote_fields.insert(s.quote_fields.end(), {bid_price, bid_size, ask_price, ask_size});
+    advance(s, false);
+    deliver();
+}
+
+void AsOfJoiner::finish_quotes(std::string_view symbol) {
+    auto &s = state(symbol);
+    s.quotes_finished = true;
+    advance(s, false);
+    deliver();
+}
+
+void AsOfJoiner::finish() {
+    for (auto &s : states_) {
+        advance(s, true);
+    }
+    deliver();
+}
+
+std::size_t AsOfJoiner::pending_trades() const noexcept {
+    std::size_t count = 0;
+    for (const auto &s : states_) {
+        count += s.trade_ns.size() - s.trade_head;
+    }
+    return count;
+}
+
+std::size_t AsOfJoiner::pending_quotes() const noexcept {
+    std::size_t count = 0;
+    for (const auto &s : states_) {
+        count += s.quote_ns.size() - s.quote_head;
+    }
+    return count;
+}
+
+void AsOfJoiner::advance(SymbolState &s, bool drain) {
+    const std::size_t quotes = s.quote_ns.size();
+    const auto take_quotes_through = [&](std::int64_t cutoff) {
+        while (s.quote_head < quotes && s.quote_ns[s.quote_head] <= cutoff) {
+            s.current_ns = s.quote_ns[s.quote_head];
+            std::copy_n(s.quote_fields.begin() + static_cast<std::ptrdiff_t>(4 * s.quote_head), 4,
+                        s.current);
+            s.has_current = true;
+            ++s.quote_head;
+        }
+    };
+
+    const std::size_t emitted_before = s.out.trade_ns.size();
+    for (; s.trade_head < s.trade_ns.size(); ++s.trade_head) {
+        const std::int64_t t = s.trade_ns[s.trade_head];
+        const std::int64_t cutoff = t - options_.quote_offset_ns;
+        take_quotes_through(cutoff);
+        // A later quote may still arrive unless one past the cutoff has been seen already.
+        if (s.quote_head == quotes && !s.quotes_finished && !drain) {
+            break;
+        }
+        const bool usable = s.has_current && (options_.max_quote_age_ns == 0 ||
+                                              cutoff - s.current_ns <= options_.max_quote_age_ns);
+        s.out.trade_ns.push_back(t);
+        s.out.price.push_back(s.trade_price[s.trade_head]);
+        s.out.size.push_back(s.trade_size[s.trade_head]);
+        s.out.quote_ns.push_back(usable ? s.current_ns : 0);
+        s.out.bid_price.push_back(usable ? s.current[0] : kMissing);
+        s.out.bid_size.push_back(usable ? s.current[1] : kMissing);
+        s.out.ask_price.push_back(usable ? s.current[2] : kMissing);
+        s.out.ask_size.push_back(usable ? s.current[3] : kMissing);
+        s.trade_watermark_ns = t;
+        s.has_trades = true;
+    }
+    if (s.out.trade_ns.size() != emitted_before) {
+        ready_.push_back(static_cast<std::size_t>(&s - states_.data()));
+    }
+
+    // Future trades are no earlier than the last one seen, so quotes up to its cutoff are
+    // already superseded or current; fold them in rather than buffering them.
+    if (s.trade_head == s.trade_ns.size() && s.has_trades) {
+        take_quotes_through(s.trade_watermark_ns - options_.quote_offset_ns);
+    }
+
+    if (s.trade_head > 0 && 2 * s.trade_head >= s.trade_ns.size()) {
+        compact(s.trade_ns, s.trade_head, 1);
+        compact(s.trade_price, s.trade_head, 1);
+        compact(s.trade_size, s.trade_head, 1);
+        s.trade_head = 0;
+    }
+    if (s.quote_head > 0 && 2 * s.quote_head >= s.quote_ns.size()) {
+        compact(s.quote_ns, s.quote_head, 1);
+        compact(s.quote_fields, s.quote_head, 4);
+        s.quote_head = 0;
+    }
+}
+
+void AsOfJoiner::deliver() {
+    for (const auto id : ready_) {
+        auto &out = states_[id].out;
+        if (out.trade_ns.empty()) {
+            continue; // listed twice
+        }
+        on_batch_(out);
+        out.clear();
+    }
+    ready_.clear();
+}
+
+void asof_join_stock_trades(const DataClient &client, StockTradesRequest trades,
+                            AsOfJoiner &joiner, int page_limit) {
+    trades.limit = page_limit;
+    trades.sort = common::Sort::Asc;
+    trades.page_token.reset();
+    StockQuotesRequest quotes;
+    quotes.symbols = trades.symbols;
+    quotes.start = trades.start;
+    quotes.end = trades.end;
+    quotes.feed = trades.feed;
+    quotes.sort = common::Sort::Asc;
+    quotes.limit = page_limit;
+
+    std::vector<std::string> symbols = trades.symbols;
+    std::sort(symbols.begin(), symbols.end());
+    std::size_t finished = 0; // symbols[0, finished) have no more quotes
+
+    StreamPosition trade_position;
+    StreamPosition quote_position;
+    bool quotes_started = false;
+
+    while (!trade_position.done || !quote_position.done) {
+        // Fetch from the side that is behind; the streams are ordered by symbol, then time.
+        const bool fetch_quotes =
+            !quote_position.done &&
+            (!quotes_started || trade_position.done ||
+             std::tie(quote_position.symbol, quote_position.timestamp_ns) <
+                 std::tie(trade_position.symbol, trade_position.timestamp_ns));
+
+        if (fetch_quotes) {
+            quotes_started = true;
+            const auto page = client.get_stock_quotes(quotes);
+            // Split the page at symbol changes: once the stream reaches a symbol, every symbol
+            // ordered before it has no more quotes and its waiting trades can be emitted.
+            StockQuotesResponse run;
+            for (const auto &quote : page.quotes) {
+                if (quote.symbol != quote_position.symbol) {
+                    joiner.add_quotes(run);
+                    run.quotes.clear();
+                    for (; finished < symbols.size() && symbols[finished] < quote.symbol;
+                         ++finished) {
+                        joiner.finish_quotes(symbols[finished]);
+                    }
+                    quote_position.symbol = quote.symbol;
+                }
+                run.quotes.push_back(quote);
+            }
+            joiner.add_quotes(run);
+            if (!page.quotes.empty()) {
+                quote_position.timestamp_ns =
+                    core::parse_timestamp_ns(page.quotes.back().timestamp).value_or(0);
+            }
+            quotes.page_token = page.next_page_token;
+            quote_position.done = !page.next_page_token || page.next_page_token->empty();
+            if (quote_position.done) {
+                for (; finished < symbols.size(); ++finished) {
+                    joiner.finish_quotes(symbols[finished]);
+                }
+            }
+        } else {
+            const auto page = client.get_stock_trades(trades);
+            joiner.add_trades(page);
+            if (!page.trades.empty()) {
+                trade_position.symbol = page.trades.back().symbol;
+                trade_position.timestamp_ns =
+                    core::parse_timestamp_ns(page.trades.back().timestamp).value_or(0);
+            }
+            trades.page_token = page.next_page_token;
+            trade_position.done = !page.next_page_token || page.next_page_token->empty();
+        }
+    }
+    joiner.finish();
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,318 @@
+#include "alpaca/data/bar_aggregator.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr std::int64_t kNanosPerSecond = 1'000'000'000;
+
+std::int64_t floor_to(std::int64_t value, std::int64_t step) noexcept {
+    std::int64_t q = value / step;
+    if (value % step != 0 && value < 0) {
+        --q;
+    }
+    return q * step;
+}
+
+} // namespace
+
+BarSpec BarSpec::seconds(int amount) {
+    if (amount <= 0) {
+        throw std::invalid_argument("bar interval must be positive");
+    }
+    BarSpec spec;
+    spec.kind = Kind::Time;
+    spec.interval_ns = static_cast<std::int64_t>(amount) * kNanosPerSecond;
+    return spec;
+}
+
+BarSpec BarSpec::time(const TimeFrame &timeframe) {
+    switch (timeframe.unit) {
+        case TimeFrameUnit::Minute:
+            return seconds(timeframe.amount * 60);
+        case TimeFrameUnit::Hour:
+            return seconds(timeframe.amount * 3600);
+        case TimeFrameUnit::Day:
+            return seconds(timeframe.amount * 86400);
+        case TimeFrameUnit::Week:
+        case TimeFrameUnit::Month:
+            break;
+    }
+    throw std::invalid_argument("bar aggregation supports Minute, Hour and Day timeframes");
+}
+
+BarSpec BarSpec::tick_count(std::uint64_t trades) {
+    if (trades == 0) {
+        throw std::invalid_argument("tick bars need at least one trade");
+    }
+    BarSpec spec;
+    spec.kind = Kind::Ticks;
+    spec.ticks = trades;
+    return spec;
+}
+
+BarSpec BarSpec::traded_volume(double volume) {
+    if (!(volume > 0.0)) {
+        throw std::invalid_argument("volume bars need a positive volume");
+    }
+    BarSpec spec;
+    spec.kind = Kind::Volume;
+    spec.volume = volume;
+    return spec;
+}
+
+BarAggregator::BarAggregator(BarSpec spec, BarCallback on_bar, BarCallback on_revision)
+    : BarAggregator(spec, std::move(on_bar), std::move(on_revision), Options{}) {}
+
+BarAggregator::BarAggregator(BarSpec spec, BarCallback on_bar, BarCallback on_revision,
+                             Options options)
+    : spec_(spec), on_bar_(std::move(on_bar)), on_revision_(std::move(on_revision)),
+      options_(options) {}
+
+std::uint32_t BarAggregator::symbol_id(const std::string &symbol) {
+    if (auto it = ids_.find(symbol); it != ids_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(states_.size());
+    ids_.emplace(symbol, id);
+    states_.emplace_back().symbol = symbol;
+    return id;
+}
+
+void BarAggregator::on_trade(const Trade &trade) {
+    const auto timestamp = core::parse_timestamp_ns(trade.timestamp);
+    if (!timestamp) {
+        return;
+    }
+    on_trade(symbol_id(trade.symbol), *timestamp, trade.price, trade.size,
+             trade.id ? std::string_view(*trade.id) : std::string_view{});
+}
+
+void BarAggregator::on_trade(std::uint32_t symbol, std::int64_t timestamp_ns, double price,
+                             double size, std::string_view trade_id) {
+    auto &state = states_.at(symbol);
+    Fill fill{timestamp_ns, price, size, std::string(trade_id)};
+
+    if (spec_.kind != BarSpec::Kind::Time) {
+        if (state.open.empty()) {
+            state.open.push_back(Window{timestamp_ns, 0, 0.0, {}});
+        }
+        auto &window = state.open.back();
+        window.start_ns = std::min(window.start_ns, timestamp_ns);
+        window.volume += size;
+        window.fills.push_back(std::move(fill));
+        const bool full = spec_.kind == BarSpec::Kind::Ticks
+                              ? window.fills.size() >= spec_.ticks
+                              : window.volume >= spec_.volume;
+        if (full) {
+            Window done = std::move(window);
+            state.open.pop_back();
+            emit(symbol, std::move(done));
+        }
+        return;
+    }
+
+    const std::int64_t start = floor_to(timestamp_ns, spec_.interval_ns);
+    const std::int64_t end = start + spec_.interval_ns;
+    if (end <= state.watermark_ns) {
+        // The bar is already final: revise it if it is still retained, otherwise drop.
+        auto it = std::find_if(state.emitted.begin(), state.emitted.end(),
+                               [&](const Window &window) { return window.start_ns == start; });
+        if (it == state.emitted.end()) {
+            ++late_dropped_;
+            return;
+        }
+        it->volume += size;
+        it->fills.push_back(std::move(fill));
+        if (on_revision_) {
+            on_revision_(make_bar(state, *it));
+        }
+        return;
+    }
+
+    auto it = std::lower_bound(state.open.begin(), state.open.end(), start,
+                               [](const Window &window, std::int64_t value) {
+                                   return window.start_ns < value;
+                               });
+    if (it == state.open.end() || it->start_ns != start) {
+        it = state.open.insert(it, Window{start, end, 0.0, {}});
+    }
+    it->volume += size;
+    it->fills.push_back(std::move(fill));
+
+    close_through(symbol, timestamp_ns - options_.allowed_lateness.count());
+}
+
+void BarAggregator::on_cancel(const TradeCancel &cancel) {
+    Fill match{core::parse_timestamp_ns(cancel.timestamp).value_or(0), cancel.price, cancel.size,
+               cancel.id.value_or("")};
+    revise(cancel.symbol, match, nullptr);
+}
+
+void BarAggregator::on_correction(const TradeCorrection &correction) {
+    const auto timestamp = core::parse_timestamp_ns(correction.timestamp).value_or(0);
+    Fill match{timestamp, correction.original_price, correction.original_size,
+               correction.original_id.value_or("")};
+    Fill replacement{timestamp, correction.corrected_price, correction.corrected_size,
+                     correction.corrected_id.value_or(match.id)};
+    revise(correction.symbol, match, correction.corrected_size > 0.0 ? &replacement : nullptr);
+}
+
+void BarAggregator::advance_watermark(std::int64_t timestamp_ns) {
+    for (std::uint32_t symbol = 0; symbol < states_.size(); ++symbol) {
+        close_through(symbol, timestamp_ns - options_.allowed_lateness.count());
+    }
+}
+
+void BarAggregator::flush() {
+    for (std::uint32_t symbol = 0; symbol < states_.size(); ++symbol) {
+        auto &state = states_[symbol];
+        if (spec_.kind == BarSpec::Kind::Time && !state.open.empty()) {
+            state.watermark_ns = std::max(state.watermark_ns, state.open.back().end_ns);
+        }
+        auto open = std::move(state.open);
+        state.open.clear();
+        for (auto &window : open) {
+            emit(symbol, std::move(window));
+        }
+    }
+}
+
+std::function<void(const Trade &)> BarAggregator::trade_handler() {
+    return [this](const Trade &trade) { on_trade(trade); };
+}
+
+std::function<void(const TradeCancel &)> BarAggregator::cancel_handler() {
+    return [this](const TradeCancel &cancel) { on_cancel(cancel); };
+}
+
+std::function<void(const TradeCorrection &)> BarAggregator::correction_handler() {
+    return [this](const TradeCorrection &correction) { on_correction(correction); };
+}
+
+void BarAggregator::close_through(std::uint32_t symbol, std::int64_t watermark_ns) {
+    auto &state = states_[symbol];
+    if (watermark_ns <= state.watermark_ns) {
+        return;
+    }
+    state.watermark_ns = watermark_ns;
+    if (spec_.kind != BarSpec::Kind::Time) {
+        return;
+    }
+    std::size_t closed = 0;
+    while (closed < state.open.size() && state.open[closed].end_ns <= watermark_ns) {
+        ++closed;
+    }
+    if (closed == 0) {
+        return;
+    }
+    const auto last = state.open.begin() + static_cast<std::ptrdiff_t>(closed);
+    std::vector<Window> done(std::make_move_iterator(state.open.begin()),
+                             std::make_move_iterator(last));
+    state.open.erase(state.open.begin(), last);
+    for (auto &window : done) {
+        emit(symbol, std::move(window));
+    }
+}
+
+void BarAggregator::emit(std::uint32_t symbol, Window window) {
+    auto &state = states_[symbol];
+    if (on_bar_) {
+        on_bar_(make_bar(state, window));
+    }
+    if (options_.revision_depth == 0) {
+        return;
+    }
+    state.emitted.push_back(std::move(window));
+    while (state.emitted.size() > options_.revision_depth) {
+        state.emitted.pop_front();
+    }
+}
+
+Bar BarAggregator::make_bar(const SymbolState &state, const Window &window) const {
+    Bar bar;
+    bar.symbol = state.symbol;
+    bar.timestamp = core::format_timestamp_ns(window.start_ns);
+    bar.trade_count = static_cast<double>(window.fills.size());
+    if (window.fills.empty()) {
+        return bar;
+    }
+
+    // Open and close follow event time; ties keep arrival order.
+    const Fill *first = &window.fills.front();
+    const Fill *last = &window.fills.front();
+    double notional = 0.0;
+    bar.high = window.fills.front().price;
+    bar.low = window.fills.front().price;
+    for (const auto &fill : window.fills) {
+        if (fill.timestamp_ns < first->timestamp_ns) {
+            first = &fill;
+        }
+        if (fill.timestamp_ns >= last->timestamp_ns) {
+            last = &fill;
+        }
+        bar.high = std::max(bar.high, fill.price);
+        bar.low = std::min(bar.low, fill.price);
+        bar.volume += fill.size;
+        notional += fill.price * fill.size;
+    }
+    bar.open = first->price;
+    bar.close = last->price;
+    if (bar.volume > 0.0) {
+        bar.vwap = notional / bar.volume;
+    }
+    return bar;
+}
+
+void BarAggregator::revise(const std::string &symbol, const Fill &match, const Fill *replacement) {
+    auto id = ids_.find(symbol);
+    if (id == ids_.end()) {
+        return;
+    }
+    auto &state = states_[id->second];
+    const auto matches = [&](const Fill &fill) {
+        if (!match.id.empty() && !fill.id.empty()) {
+            return fill.id == match.id;
+        }
+        return fill.timestamp_ns == match.timestamp_ns && fill.price == match.price &&
+               fill.size == match.size;
+    };
+    const auto apply = [&](Window &window) {
+        auto it = std::find_if(window.fills.begin(), window.fills.end(), matches);
+        if (it == window.fills.end()) {
+            return false;
+        }
+        window.volume -= it->size;
+        if (replacement) {
+            it->price = replacement->price;
+            it->size = replacement->size;
+            it->id = replacement->id;
+            window.volume += it->size;
+        } else {
+            window.fills.erase(it);
+        }
+        return true;
+    };
+
+    for (auto &window : state.open) {
+        if (apply(window)) {
+            return;
+        }
+    }
+    for (auto it = state.emitted.rbegin(); it != state.emitted.rend(); ++it) {
+        if (apply(*it)) {
+            if (on_revision_) {
+                on_revision_(make_bar(state, *it));
+            }
+            return;
+        }
+    }
+}
+
+} // namespace alpaca::data
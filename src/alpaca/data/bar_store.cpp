@@ -0,0 +1,341 @@
+#include "alpaca/data/bar_store.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr std::align_val_t kColumnAlignment{64};
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+constexpr std::size_t kOpen = static_cast<std::size_t>(BarStore::Field::Open);
+constexpr std::size_t kHigh = static_cast<std::size_t>(BarStore::Field::High);
+constexpr std::size_t kLow = static_cast<std::size_t>(BarStore::Field::Low);
+constexpr std::size_t kClose = static_cast<std::size_t>(BarStore::Field::Close);
+constexpr std::size_t kVolume = static_cast<std::size_t>(BarStore::Field::Volume);
+constexpr std::size_t kVwap = static_cast<std::size_t>(BarStore::Field::Vwap);
+
+template <typename T> T *allocate_column(std::size_t count) {
+    auto *data = static_cast<T *>(::operator new(count * sizeof(T), kColumnAlignment));
+    std::fill_n(data, count, T{});
+    return data;
+}
+
+void check_period(std::size_t period, std::size_t capacity, const char *name) {
+    if (period == 0 || period > capacity) {
+        throw std::invalid_argument(std::string("BarStore: ") + name +
+                                    " must be between 1 and the capacity");
+    }
+}
+
+} // namespace
+
+void BarStore::AlignedDelete::operator()(void *data) const noexcept {
+    ::operator delete(data, kColumnAlignment);
+}
+
+BarStore::BarStore() : BarStore(Options{}) {}
+
+BarStore::BarStore(Options options) : options_(options) {
+    mask_ = std::bit_ceil(std::max<std::size_t>(options_.capacity, 1)) - 1;
+    check_period(options_.sma_period, capacity(), "sma_period");
+    check_period(options_.ema_period, capacity(), "ema_period");
+    check_period(options_.rsi_period, capacity(), "rsi_period");
+    check_period(options_.atr_period, capacity(), "atr_period");
+    check_period(options_.bollinger_period, capacity(), "bollinger_period");
+    check_period(options_.vwap_period, capacity(), "vwap_period");
+}
+
+std::uint32_t BarStore::symbol_id(const std::string &symbol) {
+    if (const auto it = ids_.find(symbol); it != ids_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(symbols_.size());
+    if (symbols_.size() == slots_) {
+        reserve_symbols(std::max<std::size_t>(slots_ * 2, 8));
+    }
+    ids_.emplace(symbol, id);
+    symbols_.push_back(symbol);
+    state_.count.push_back(0);
+    state_.last_ns.push_back(0);
+    for (auto *column : {&state_.sma_sum, &state_.ema, &state_.avg_gain, &state_.avg_loss,
+                         &state_.atr, &state_.band_sum, &state_.band_sum_sq, &state_.pv_sum,
+                         &state_.volume_sum}) {
+        column->push_back(0.0);
+    }
+    return id;
+}
+
+std::optional<std::uint32_t> BarStore::find(const std::string &symbol) const {
+    if (const auto it = ids_.find(symbol); it != ids_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+// Columns are time-major, so growing widens every ring row and the rows are copied one by
+// one into the wider layout.
+void BarStore::reserve_symbols(std::size_t slots) {
+    const std::size_t size = slots * capacity();
+    const auto widen = [&](auto &column, auto *grown) {
+        if (column) {
+            for (std::size_t row = 0; row < capacity(); ++row) {
+                std::copy_n(column.get() + row * slots_, slots_, grown + row * slots);
+            }
+        }
+        column.reset(grown);
+    };
+    for (auto &field : fields_) {
+        widen(field, allocate_column<double>(size));
+    }
+    widen(timestamps_, allocate_column<std::int64_t>(size));
+    slots_ = slots;
+}
+
+bool BarStore::on_bar(const Bar &bar) {
+    const auto timestamp_ns = core::parse_timestamp_ns(bar.timestamp);
+    if (!timestamp_ns) {
+        ++rejected_;
+        return false;
+    }
+    return append(symbol_id(bar.symbol), *timestamp_ns, bar.open, bar.high, bar.low, bar.close,
+                  bar.volume, bar.vwap.value_or(kNaN));
+}
+
+bool BarStore::append(std::uint32_t id, std::int64_t timestamp_ns, double open, double high,
+                      double low, double close, double volume, double vwap) {
+    if (id >= symbols_.size()) {
+        throw std::out_of_range("BarStore: unknown symbol id");
+    }
+    if (state_.count[id] > 0 && timestamp_ns <= state_.last_ns[id]) {
+        ++rejected_;
+        return false;
+    }
+    push(id, timestamp_ns, open, high, low, close, volume, vwap);
+    return true;
+}
+
+std::size_t BarStore::warm_up(const std::vector<Bar> &bars) {
+    std::size_t stored = 0;
+    for (const auto &bar : bars) {
+        if (on_bar(bar)) {
+            ++stored;
+        }
+    }
+    return stored;
+}
+
+BarBatch BarStore::make_batch(std::int64_t timestamp_ns) const {
+    BarBatch batch;
+    batch.timestamp_ns = timestamp_ns;
+    const std::size_t count = symbols_.size();
+    batch.open.assign(count, 0.0);
+    batch.high.assign(count, 0.0);
+    batch.low.assign(count, 0.0);
+    batch.close.assign(count, kNaN);
+    batch.volume.assign(count, 0.0);
+    batch.vwap.assign(count, kNaN);
+    return batch;
+}
+
+std::size_t BarStore::update_all(const BarBatch &batch) {
+    const std::size_t count = symbols_.size();
+    for (const auto *column : {&batch.open, &batch.high, &batch.low, &batch.close, &batch.volume,
+                               &batch.vwap}) {
+        if (column->size() != count) {
+            throw std::invalid_argument("BarStore: batch columns must cover every symbol");
+        }
+    }
+    std::size_t stored = 0;
+    for (std::uint32_t id = 0; id < count; ++id) {
+        if (std::isnan(batch.close[id])) {
+            continue;
+        }
+        if (state_.count[id] > 0 && batch.timestamp_ns <= state_.last_ns[id]) {
+            ++rejected_;
+            continue;
+        }
+        push(id, batch.timestamp_ns, batch.open[id], batch.high[id], batch.low[id],
+             batch.close[id], batch.volume[id], batch.vwap[id]);
+        ++stored;
+    }
+    return stored;
+}
+
+void BarStore::push(std::uint32_t id, std::int64_t timestamp_ns, double open, double high,
+                    double low, double close, double volume, double vwap) noexcept {
+    const double *closes = fields_[kClose].get();
+    const double *vwaps = fields_[kVwap].get();
+    const double *volumes = fields_[kVolume].get();
+    const std::uint64_t k = state_.count[id];
+    if (std::isnan(vwap)) {
+        vwap = (high + low + close) / 3.0;
+    }
+
+    // Values leaving each window are read before the new bar can overwrite their slot.
+    const auto leaving = [&](const double *column, std::size_t period) {
+        return k >= period ? column[index(id, k - period)] : 0.0;
+    };
+    const double sma_out = leaving(closes, options_.sma_period);
+    const double band_out = leaving(closes, options_.bollinger_period);
+    const double pv_out =
+        leaving(vwaps, options_.vwap_period) * leaving(volumes, options_.vwap_period);
+    const double volume_out = leaving(volumes, options_.vwap_period);
+    const double prev_close = k > 0 ? closes[index(id, k - 1)] : close;
+
+    state_.sma_sum[id] += close - sma_out;
+    state_.band_sum[id] += close - band_out;
+    state_.band_sum_sq[id] += close * close - band_out * band_out;
+    state_.pv_sum[id] += vwap * volume - pv_out;
+    state_.volume_sum[id] += volume - volume_out;
+
+    // Seeding phases average the first `period` samples incrementally, which makes the first
+    // ready EMA the SMA and the first RSI/ATR averages Wilder's simple means.
+    const auto smooth = [](double &average, double sample, std::uint64_t samples,
+                           std::size_t period) {
+        const auto divisor = static_cast<double>(std::min<std::uint64_t>(samples, period));
+        average += (sample - average) / divisor;
+    };
+    const double ema_alpha = 2.0 / (static_cast<double>(options_.ema_period) + 1.0);
+    if (k + 1 <= options_.ema_period) {
+        smooth(state_.ema[id], close, k + 1, options_.ema_period);
+    } else {
+        state_.ema[id] += ema_alpha * (close - state_.ema[id]);
+    }
+    if (k > 0) {
+        const double change = close - prev_close;
+        smooth(state_.avg_gain[id], std::max(change, 0.0), k, options_.rsi_period);
+        smooth(state_.avg_loss[id], std::max(-change, 0.0), k, options_.rsi_period);
+    }
+    const double true_range =
+        k > 0 ? std::max({high - low, std::abs(high - prev_close), std::abs(low - prev_close)})
+              : high - low;
+    smooth(state_.atr[id], true_range, k + 1, options_.atr_period);
+
+    const std::size_t at = index(id, k);
+    fields_[kOpen][at] = open;
+    fields_[kHigh][at] = high;
+    fields_[kLow][at] = low;
+    fields_[kClose][at] = close;
+    fields_[kVolume][at] = volume;
+    fields_[kVwap][at] = vwap;
+    timestamps_[at] = timestamp_ns;
+    state_.count[id] = k + 1;
+    state_.last_ns[id] = timestamp_ns;
+
+    if (((k + 1) & mask_) == 0) {
+        resum(id);
+    }
+}
+
+void BarStore::resum(std::uint32_t id) noexcept {
+    const std::uint64_t count = state_.count[id];
+    const auto window_sum = [&](std::size_t period, auto term) {
+        double sum = 0.0;
+        const std::uint64_t first = count - std::min<std::uint64_t>(count, period);
+        for (std::uint64_t k = first; k < count; ++k) {
+            sum += term(index(id, k));
+        }
+        return sum;
+    };
+    const double *closes = fields_[kClose].get();
+    const double *vwaps = fields_[kVwap].get();
+    const double *volumes = fields_[kVolume].get();
+    state_.sma_sum[id] = window_sum(options_.sma_period, [&](std::size_t i) { return closes[i]; });
+    state_.band_sum[id] =
+        window_sum(options_.bollinger_period, [&](std::size_t i) { return closes[i]; });
+    state_.band_sum_sq[id] = window_sum(options_.bollinger_period,
+                                        [&](std::size_t i) { return closes[i] * closes[i]; });
+    state_.pv_sum[id] =
+        window_sum(options_.vwap_period, [&](std::size_t i) { return vwaps[i] * volumes[i]; });
+    state_.volume_sum[id] =
+        window_sum(options_.vwap_period, [&](std::size_t i) { return volumes[i]; });
+}
+
+std::size_t BarStore::size(std::uint32_t id) const {
+    return static_cast<std::size_t>(std::min<std::uint64_t>(state_.count.at(id), capacity()));
+}
+
+std::size_t BarStore::slot(std::uint32_t id, std::size_t ago) const {
+    if (ago >= size(id)) {
+        throw std::out_of_range("BarStore: bar is not in the retained history");
+    }
+    return index(id, state_.count[id] - 1 - ago);
+}
+
+double BarStore::value(std::uint32_t id, Field field, std::size_t ago) const {
+    return fields_[static_cast<std::size_t>(field)][slot(id, ago)];
+}
+
+std::int64_t BarStore::timestamp_ns(std::uint32_t id, std::size_t ago) const {
+    return timestamps_[slot(id, ago)];
+}
+
+BarIndicators BarStore::indicators(std::uint32_t id) const {
+    const std::uint64_t count = state_.count.at(id);
+    BarIndicators out;
+    if (count >= options_.sma_period) {
+        out.sma = state_.sma_sum[id] / static_cast<double>(options_.sma_period);
+    }
+    if (count >= options_.ema_period) {
+        out.ema = state_.ema[id];
+    }
+    if (count > options_.rsi_period) {
+        const double gain = state_.avg_gain[id];
+        const double loss = state_.avg_loss[id];
+        if (loss == 0.0) {
+            out.rsi = gain == 0.0 ? 50.0 : 100.0;
+        } else {
+            out.rsi = 100.0 - 100.0 / (1.0 + gain / loss);
+        }
+    }
+    if (count >= options_.atr_period) {
+        out.atr = state_.atr[id];
+    }
+    if (count >= options_.bollinger_period) {
+        const auto period = static_cast<double>(options_.bollinger_period);
+        const double mean = state_.band_sum[id] / period;
+        const double variance = std::max(state_.band_sum_sq[id] / period - mean * mean, 0.0);
+        const double width = options_.bollinger_width * std::sqrt(variance);
+        out.bollinger_middle = mean;
+        out.bollinger_upper = mean + width;
+        out.bollinger_lower = mean - width;
+    }
+    if (count >= options_.vwap_period && state_.volume_sum[id] > 0.0) {
+        out.vwap = state_.pv_sum[id] / state_.volume_sum[id];
+    }
+    return out;
+}
+
+BarColumns BarStore::history(std::uint32_t id) const {
+    BarColumns columns;
+    columns.symbol = symbol(id);
+    const std::size_t count = size(id);
+    columns.reserve(count);
+    for (std::size_t ago = count; ago-- > 0;) {
+        const std::size_t at = slot(id, ago);
+        columns.timestamp_ns.push_back(timestamps_[at]);
+        columns.open.push_back(fields_[kOpen][at]);
+        columns.high.push_back(fields_[kHigh][at]);
+        columns.low.push_back(fields_[kLow][at]);
+        columns.close.push_back(fields_[kClose][at]);
+        columns.volume.push_back(fields_[kVolume][at]);
+        columns.vwap.push_back(fields_[kVwap][at]);
+        columns.trade_count.push_back(0.0);
+    }
+    return columns;
+}
+
+std::function<void(const Bar &)> BarStore::bar_handler() {
+    return [this](const Bar &bar) { on_bar(bar); };
+}
+
+} // namespace alpaca::data
@@ -1,8 +1,11 @@
 #include "alpaca/data/client.hpp"
 
+#include "alpaca/trading/option_symbol.hpp"
+
 #include <simdjson/ondemand.h>
 #include <simdjson/padded_string_view-inl.h>
 
+#include <charconv>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -358,6 +361,10 @@ std::string build_option_chain_path(const OptionChainRequest &request) {
     append_param("expiration_date_lte", request.expiration_date_lte.value_or(""));
     append_param("root_symbol", request.root_symbol.value_or(""));
     append_param("updated_since", request.updated_since.value_or(""));
+    if (request.limit) {
+        append_param("limit", std::to_string(*request.limit));
+    }
+    append_param("page_token", request.page_token.value_or(""));
 
     std::string url = oss.str();
     if (url.back() == '?') {
@@ -485,6 +492,142 @@ std::string build_corporate_actions_path(const CorporateActionsRequest &request)
     return oss.str();
 }
 
+// One corporate action field, as text for strings and as a number/flag when the payload
+// carries one.
+struct ActionField {
+    std::string_view text;
+    std::optional<double> number;
+    std::optional<bool> flag;
+
+    [[nodiscard]] double as_double() const {
+        if (number) {
+            return *number;
+        }
+        double value = 0.0;
+        std::from_chars(text.data(), text.data() + text.size(), value);
+        return value;
+    }
+    [[nodiscard]] std::string as_string() const { return std::string(text); }
+    [[nodiscard]] std::optional<std::string> as_optional() const {
+        return text.empty() ? std::nullopt : std::optional<std::string>(text);
+    }
+};
+
+std::optional<CorporateActionsType> corporate_action_type(std::string_view group) {
+    for (auto type : {CorporateActionsType::ReverseSplit, CorporateActionsType::ForwardSplit,
+                      CorporateActionsType::UnitSplit, CorporateActionsType::CashDividend,
+                      CorporateActionsType::StockDividend, CorporateActionsType::SpinOff,
+                      CorporateActionsType::CashMerger, CorporateActionsType::StockMerger,
+                      CorporateActionsType::StockAndCashMerger}) {
+        if (to_string(type) == group) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+void set_action_field(SplitAction &action, std::string_view key, const ActionField &value) {
+    if (key == "id") {
+        action.id = value.as_string();
+    } else if (key == "symbol" || key == "old_symbol") {
+        action.symbol = value.as_string();
+    } else if (key == "cusip" || key == "old_cusip") {
+        action.cusip = value.as_string();
+    } else if (key == "new_symbol") {
+        action.new_symbol = value.as_optional();
+    } else if (key == "new_cusip") {
+        action.new_cusip = value.as_optional();
+    } else if (key == "old_rate") {
+        action.old_rate = value.as_double();
+    } else if (key == "new_rate") {
+        action.new_rate = value.as_double();
+    } else if (key == "ex_date" || key == "effective_date") {
+        action.ex_date = value.as_string();
+    } else if (key == "record_date") {
+        action.record_date = value.as_optional();
+    } else if (key == "payable_date") {
+        action.payable_date = value.as_optional();
+    } else if (key == "process_date") {
+        action.process_date = value.as_string();
+    }
+}
+
+void set_action_field(DividendAction &action, std::string_view key, const ActionField &value) {
+    if (key == "id") {
+        action.id = value.as_string();
+    } else if (key == "symbol") {
+        action.symbol = value.as_string();
+    } else if (key == "cusip") {
+        action.cusip = value.as_string();
+    } else if (key == "rate") {
+        action.rate = value.as_double();
+    } else if (key == "special") {
+        action.special = value.flag.value_or(value.text == "true");
+    } else if (key == "foreign") {
+        action.foreign = value.flag.value_or(value.text == "true");
+    } else if (key == "ex_date") {
+        action.ex_date = value.as_string();
+    } else if (key == "record_date") {
+        action.record_date = value.as_optional();
+    } else if (key == "payable_date") {
+        action.payable_date = value.as_optional();
+    } else if (key == "process_date") {
+        action.process_date = value.as_string();
+    }
+}
+
+void set_action_field(MergerAction &action, std::string_view key, const ActionField &value) {
+    if (key == "id") {
+        action.id = value.as_string();
+    } else if (key == "acquirer_symbol") {
+        action.acquirer_symbol = value.as_optional();
+    } else if (key == "acquirer_cusip") {
+        action.acquirer_cusip = value.as_optional();
+    } else if (key == "acquirer_rate") {
+        action.acquirer_rate = value.as_double();
+    } else if (key == "acquiree_symbol") {
+        action.acquiree_symbol = value.as_string();
+    } else if (key == "acquiree_cusip") {
+        action.acquiree_cusip = value.as_string();
+    } else if (key == "acquiree_rate") {
+        action.acquiree_rate = value.as_double();
+    } else if (key == "cash_rate" || key == "rate") {
+        action.cash_rate = value.as_double();
+    } else if (key == "effective_date") {
+        action.effective_date = value.as_string();
+    } else if (key == "payable_date") {
+        action.payable_date = value.as_optional();
+    } else if (key == "process_date") {
+        action.process_date = value.as_string();
+    }
+}
+
+void set_action_field(SpinOffAction &action, std::string_view key, const ActionField &value) {
+    if (key == "id") {
+        action.id = value.as_string();
+    } else if (key == "source_symbol") {
+        action.source_symbol = value.as_string();
+    } else if (key == "source_cusip") {
+        action.source_cusip = value.as_string();
+    } else if (key == "source_rate") {
+        action.source_rate = value.as_double();
+    } else if (key == "new_symbol") {
+        action.new_symbol = value.as_string();
+    } else if (key == "new_cusip") {
+        action.new_cusip = value.as_string();
+    } else if (key == "new_rate") {
+        action.new_rate = value.as_double();
+    } else if (key == "ex_date") {
+        action.ex_date = value.as_string();
+    } else if (key == "record_date") {
+        action.record_date = value.as_optional();
+    } else if (key == "payable_date") {
+        action.payable_date = value.as_optional();
+    } else if (key == "process_date") {
+        action.process_date = value.as_string();
+    }
+}
+
 CorporateActionsResponse parse_corporate_actions_response(std::string_view payload) {
     simdjson::ondemand::parser parser;
     std::string storage(payload);
@@ -516,18 +659,24 @@ CorporateActionsResponse parse_corporate_actions_response(std::string_view paylo
         }
         CorporateActionsGroup group;
         group.type = key;
+        const auto type = corporate_action_type(key);
         for (auto entry : arr_res.value()) {
             auto obj_res = entry.get_object();
             if (obj_res.error())
                 continue;
             auto obj = obj_res.value();
             CorporateActionItem item;
+            SplitAction split;
+            DividendAction dividend;
+            MergerAction merger;
+            SpinOffAction spin_off;
             for (auto kv : obj) {
                 auto k_res = kv.unescaped_key();
                 if (k_res.error())
                     continue;
                 std::string k(k_res.value());
                 std::string v_str;
+                ActionField field_value;
                 std::string_view sview{};
                 if (!kv.value().get_string().get(sview)) {
                     v_str = std::string(sview);
@@ -537,17 +686,71 @@ CorporateActionsResponse parse_corporate_actions_response(std::string_view paylo
                     bool b{};
                     if (!kv.value().get_double().get(d)) {
                         v_str = std::to_string(d);
+                        field_value.number = d;
                     } else if (!kv.value().get_int64().get(i)) {
                         v_str = std::to_string(i);
+                        field_value.number = static_cast<double>(i);
                     } else if (!kv.value().get_bool().get(b)) {
                         v_str = b ? "true" : "false";
+                        field_value.flag = b;
                     } else {
                         v_str = "";
                     }
                 }
+                if (type) {
+                    field_value.text = v_str;
+                    switch (*type) {
+                    case CorporateActionsType::ReverseSplit:
+                    case CorporateActionsType::ForwardSplit:
+                    case CorporateActionsType::UnitSplit:
+                        set_action_field(split, k, field_value);
+                        break;
+                    case CorporateActionsType::CashDividend:
+                    case CorporateActionsType::StockDividend:
+                        set_action_field(dividend, k, field_value);
+                        break;
+                    case CorporateActionsType::CashMerger:
+                    case CorporateActionsType::StockMerger:
+                    case CorporateActionsType::StockAndCashMerger:
+                        set_action_field(merger, k, field_value);
+                        break;
+                    case CorporateActionsType::SpinOff:
+                        set_action_field(spin_off, k, field_value);
+                        break;
+                    default:
+                        break;
+                    }
+                }
                 item.fields.emplace_back(std::move(k), std::move(v_str));
             }
             group.items.emplace_back(std::move(item));
+            if (!type) {
+                continue;
+            }
+            switch (*type) {
+            case CorporateActionsType::ReverseSplit:
+            case CorporateActionsType::ForwardSplit:
+            case CorporateActionsType::UnitSplit:
+                split.type = *type;
+                resp.splits.push_back(std::move(split));
+                break;
+            case CorporateActionsType::CashDividend:
+            case CorporateActionsType::StockDividend:
+                dividend.type = *type;
+                resp.dividends.push_back(std::move(dividend));
+                break;
+            case CorporateActionsType::CashMerger:
+            case CorporateActionsType::StockMerger:
+            case CorporateActionsType::StockAndCashMerger:
+                merger.type = *type;
+                resp.mergers.push_back(std::move(merger));
+                break;
+            case CorporateActionsType::SpinOff:
+                resp.spin_offs.push_back(std::move(spin_off));
+                break;
+            default:
+                break;
+            }
         }
         resp.groups.emplace_back(std::move(group));
     }
@@ -716,6 +919,9 @@ std::string build_stock_trades_query(const StockTradesRequest &request) {
     if (request.sort) {
         append("sort", std::string(common::to_string(*request.sort)));
     }
+    if (request.feed) {
+        append("feed", std::string(to_string(*request.feed)));
+    }
     if (request.page_token) {
         append("page_token", *request.page_token);
     }
@@ -1315,6 +1521,7 @@ OptionsSnapshotResponse parse_options_snapshot_response(std::string_view payload
             auto snapshot_obj = snapshot_obj_result.value();
             OptionsSnapshot snapshot;
             snapshot.symbol = symbol;
+            snapshot.contract_key = trading::option_key(symbol);
 
             if (auto latest_trade_field = snapshot_obj.find_field_unordered("latestTrade");
                 !latest_trade_field.error()) {
@@ -1345,6 +1552,13 @@ OptionsSnapshotResponse parse_options_snapshot_response(std::string_view payload
         }
     }
 
+    if (auto next_token = doc.find_field_unordered("next_page_token"); !next_token.error()) {
+        std::string_view token_view;
+        if (!next_token.get_string().get(token_view)) {
+            response.next_page_token = std::string(token_view);
+        }
+    }
+
     return response;
 }
 
@@ -1447,6 +1661,13 @@ Movers parse_market_movers_response(std::string_view payload) {
     return response;
 }
 
+// Option endpoints reuse the stock parsers; tag each event with its contract key.
+template <typename Event> void set_contract_keys(std::vector<Event> &events) {
+    for (auto &event : events) {
+        event.contract_key = trading::option_key(event.symbol);
+    }
+}
+
 } // namespace
 
 DataClient::DataClient(core::ClientConfig config, std::shared_ptr<core::IHttpTransport> transport)
@@ -1508,6 +1729,13 @@ StockSnapshotResponse DataClient::get_stock_snapshots(const StockSnapshotRequest
     return parse_stock_snapshot_response(response.body);
 }
 
+std::string DataClient::get_stock_snapshots_raw(const StockSnapshotRequest &request) const {
+    auto path = build_stock_snapshot_path(request);
+    auto response = send_request(core::HttpMethod::Get, path);
+    ensure_success(response.status_code, "get_stock_snapshots_raw", response.body);
+    return response.body;
+}
+
 StockLatestTradeResponse
 DataClient::get_stock_latest_trades_reverse(const StockLatestTradeRequest &request) const {
     auto path = build_stock_latest_trades_reverse_path(request);
@@ -1603,7 +1831,9 @@ StockTradesResponse DataClient::get_option_trades(const OptionTradesRequest &req
     auto path = build_option_trades_path(request);
     auto response = send_request(core::HttpMethod::Get, path);
     ensure_success(response.status_code, "get_option_trades", response.body);
-    return parse_stock_trades_response(response.body);
+    auto trades = parse_stock_trades_response(response.body);
+    set_contract_keys(trades.trades);
+    return trades;
 }
 
 StockLatestTradeResponse
@@ -1611,7 +1841,9 @@ DataClient::get_option_latest_trades(const OptionLatestTradeRequest &request) co
     auto path = build_option_latest_path("/trades/latest", request.symbols, request.feed);
     auto response = send_request(core::HttpMethod::Get, path);
     ensure_success(response.status_code, "get_option_latest_trades", response.body);
-    return parse_stock_latest_trades_response(response.body);
+    auto latest = parse_stock_latest_trades_response(response.body);
+    set_contract_keys(latest.trades);
+    return latest;
 }
 
 StockLatestQuoteResponse
@@ -1619,7 +1851,9 @@ DataClient::get_option_latest_quotes(const OptionLatestQuoteRequest &request) co
     auto path = build_option_latest_path("/quotes/latest", request.symbols, request.feed);
     auto response = send_request(core::HttpMethod::Get, path);
     ensure_success(response.status_code, "get_option_latest_quotes", response.body);
-    return parse_stock_latest_quotes_response(response.body);
+    auto latest = parse_stock_latest_quotes_response(response.body);
+    set_contract_keys(latest.quotes);
+    return latest;
 }
 
 OptionsSnapshotResponse
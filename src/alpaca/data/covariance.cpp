@@ -0,0 +1,238 @@
+#include "alpaca/data/covariance.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace alpaca::data {
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+} // namespace
+
+CovarianceEngine::CovarianceEngine(std::vector<std::string> symbols)
+    : CovarianceEngine(std::move(symbols), CovarianceOptions{}) {}
+
+CovarianceEngine::CovarianceEngine(std::vector<std::string> symbols, CovarianceOptions options)
+    : options_(options), symbols_(std::move(symbols)) {
+    if (symbols_.empty()) {
+        throw std::invalid_argument("CovarianceEngine: the universe is empty");
+    }
+    if (options_.mode == CovarianceOptions::Mode::Exponential &&
+        !(options_.decay > 0.0 && options_.decay < 1.0)) {
+        throw std::invalid_argument("CovarianceEngine: decay must be in (0, 1)");
+    }
+    if (options_.mode == CovarianceOptions::Mode::Window && options_.window < 2) {
+        throw std::invalid_argument("CovarianceEngine: window must be at least 2");
+    }
+    for (std::size_t i = 0; i < symbols_.size(); ++i) {
+        if (!index_.emplace(symbols_[i], i).second) {
+            throw std::invalid_argument("CovarianceEngine: duplicate symbol " + symbols_[i]);
+        }
+    }
+    options_.block_rows = std::max<std::size_t>(options_.block_rows, 1);
+
+    const std::size_t n = symbols_.size();
+    mean_.assign(n, 0.0);
+    matrix_.assign(n * n, 0.0);
+    returns_.assign(n, 0.0);
+    leaving_.assign(n, 0.0);
+    if (options_.mode == CovarianceOptions::Mode::Window) {
+        ring_.assign(options_.window * n, 0.0);
+    }
+}
+
+std::optional<std::size_t> CovarianceEngine::index(const std::string &symbol) const {
+    if (const auto it = index_.find(symbol); it != index_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+template <typename Kernel> void CovarianceEngine::for_each_block(const Kernel &kernel) const {
+    const std::size_t n = symbols_.size();
+    const std::size_t blocks = (n + options_.block_rows - 1) / options_.block_rows;
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for (std::size_t b = next.fetch_add(1); b < blocks; b = next.fetch_add(1)) {
+            const std::size_t first = b * options_.block_rows;
+            kernel(first, std::min(first + options_.block_rows, n));
+        }
+    };
+
+    const std::size_t thread_count =
+        std::min(std::max<std::size_t>(options_.max_concurrency, 1), blocks);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void CovarianceEngine::update(const std::vector<double> &returns) {
+    const std::size_t n = symbols_.size();
+    if (returns.size() != n) {
+        throw std::invalid_argument("CovarianceEngine: expected one return per symbol");
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        returns_[i] = std::isnan(returns[i]) ? 0.0 : returns[i];
+    }
+    double *matrix = matrix_.data();
+
+    if (options_.mode == CovarianceOptions::Mode::Exponential) {
+        if (observations_ == 0) {
+            mean_ = returns_;
+            ++observations_;
+            return;
+        }
+        // With d = r - mean: mean += (1 - decay) d and C = decay (C + (1 - decay) d d^T).
+        const double decay = options_.decay;
+        const double weight = 1.0 - decay;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double deviation = returns_[i] - mean_[i];
+            mean_[i] += weight * deviation;
+            returns_[i] = deviation;
+        }
+        const double *d = returns_.data();
+        for_each_block([&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                double *row = matrix + i * n;
+                const double scale = weight * d[i];
+                for (std::size_t j = i; j < n; ++j) {
+                    row[j] = decay * (row[j] + scale * d[j]);
+                }
+            }
+        });
+        ++observations_;
+        return;
+    }
+
+    // Window: the slot about to be reused holds the observation leaving the window.
+    double *slot = ring_.data() + (observations_ % options_.window) * n;
+    const bool full = observations_ >= options_.window;
+    std::copy_n(slot, n, leaving_.data());
+    std::copy_n(returns_.data(), n, slot);
+    for (std::size_t i = 0; i < n; ++i) {
+        mean_[i] += returns_[i] - (full ? leaving_[i] : 0.0);
+    }
+    const double *r = returns_.data();
+    const double *o = leaving_.data();
+    if (full) {
+        for_each_block([&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                double *row = matrix + i * n;
+                const double ri = r[i];
+                const double oi = o[i];
+                for (std::size_t j = i; j < n; ++j) {
+                    row[j] += ri * r[j] - oi * o[j];
+                }
+            }
+        });
+    } else {
+        for_each_block([&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                double *row = matrix + i * n;
+                const double ri = r[i];
+                for (std::size_t j = i; j < n; ++j) {
+                    row[j] += ri * r[j];
+                }
+            }
+        });
+    }
+    ++observations_;
+}
+
+void CovarianceEngine::update(const BarStore &store, std::int64_t timestamp_ns) {
+    std::vector<double> returns(symbols_.size(), kNaN);
+    for (std::size_t i = 0; i < symbols_.size(); ++i) {
+        const auto id = store.find(symbols_[i]);
+        if (!id || store.size(*id) < 2 || store.timestamp_ns(*id) != timestamp_ns) {
+            continue;
+        }
+        const double close = store.value(*id, BarStore::Field::Close);
+        const double previous = store.value(*id, BarStore::Field::Close, 1);
+        if (close > 0.0 && previous > 0.0) {
+            returns[i] = std::log(close / previous);
+        }
+    }
+    update(returns);
+}
+
+double CovarianceEngine::mean(std::size_t i) const {
+    if (i >= symbols_.size()) {
+        throw std::out_of_range("CovarianceEngine: symbol index out of range");
+    }
+    if (observations_ < 2) {
+        return kNaN;
+    }
+    if (options_.mode == CovarianceOptions::Mode::Exponential) {
+        return mean_[i];
+    }
+    const auto count = static_cast<double>(std::min<std::uint64_t>(observations_, options_.window));
+    return mean_[i] / count;
+}
+
+double CovarianceEngine::covariance(std::size_t i, std::size_t j) const {
+    const std::size_t n = symbols_.size();
+    if (i >= n || j >= n) {
+        throw std::out_of_range("CovarianceEngine: symbol index out of range");
+    }
+    if (observations_ < 2) {
+        return kNaN;
+    }
+    if (i > j) {
+        std::swap(i, j);
+    }
+    if (options_.mode == CovarianceOptions::Mode::Exponential) {
+        return matrix_[i * n + j];
+    }
+    const auto count = static_cast<double>(std::min<std::uint64_t>(observations_, options_.window));
+    return (matrix_[i * n + j] - mean_[i] * mean_[j] / count) / (count - 1.0);
+}
+
+double CovarianceEngine::correlation(std::size_t i, std::size_t j) const {
+    const double scale = std::sqrt(variance(i) * variance(j));
+    if (!(scale > 0.0)) {
+        return kNaN;
+    }
+    return std::clamp(covariance(i, j) / scale, -1.0, 1.0);
+}
+
+std::vector<double> CovarianceEngine::covariance_matrix() const {
+    const std::size_t n = symbols_.size();
+    std::vector<double> out(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i; j < n; ++j) {
+            out[i * n + j] = out[j * n + i] = covariance(i, j);
+        }
+    }
+    return out;
+}
+
+std::vector<double> CovarianceEngine::correlation_matrix() const {
+    const std::size_t n = symbols_.size();
+    std::vector<double> out = covariance_matrix();
+    std::vector<double> scale(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        scale[i] = std::sqrt(out[i * n + i]);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const double denominator = scale[i] * scale[j];
+            out[i * n + j] = denominator > 0.0
+                                 ? std::clamp(out[i * n + j] / denominator, -1.0, 1.0)
+                                 : kNaN;
+        }
+    }
+    return out;
+}
+
+} // namespace alpaca::data
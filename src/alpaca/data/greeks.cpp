@@ -0,0 +1,336 @@
+#include "alpaca/data/greeks.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+constexpr std::int64_t kNanosPerDay = 86'400'000'000'000;
+constexpr double kNanosPerYear = 365.0 * 86'400'000'000'000.0;
+constexpr double kInvSqrt2 = 0.70710678118654752440;
+constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+constexpr double kMinVol = 1e-4;
+constexpr double kMaxVol = 10.0;
+constexpr double kPriceTolerance = 1e-10;
+// A lane still this far off the quote after the last step, because it hit the step limit or
+// is pinned at kMinVol/kMaxVol, has no implied volatility.
+constexpr double kConvergedTolerance = 1e-6;
+constexpr int kMaxNewtonSteps = 40;
+
+// Contracts solved together; every lane runs the same instruction stream.
+constexpr std::size_t kLanes = 16;
+
+using Lanes = std::array<double, kLanes>;
+
+inline double norm_cdf(double x) noexcept { return 0.5 * std::erfc(-x * kInvSqrt2); }
+
+inline double norm_pdf(double x) noexcept { return kInvSqrt2Pi * std::exp(-0.5 * x * x); }
+
+struct Batch {
+    Lanes spot{};
+    Lanes strike{};
+    Lanes years{};
+    Lanes sign{};
+    Lanes price{};
+    Lanes sigma{};
+    Lanes valid{}; // 1 or 0
+
+    Lanes iv{};
+    Lanes delta{};
+    Lanes gamma{};
+    Lanes theta{};
+    Lanes vega{};
+    Lanes rho{};
+};
+
+// One batch with the rows its lanes belong to.
+struct Job {
+    Batch batch;
+    std::array<std::uint32_t, kLanes> rows{};
+    std::size_t count{0};
+};
+
+void solve(Batch &b, double r, double q) noexcept {
+    Lanes sqrt_t{};
+    Lanes log_moneyness{};
+    Lanes fwd{};       // S e^{-qT}
+    Lanes strike_df{}; // K e^{-rT}
+    for (std::size_t i = 0; i < kLanes; ++i) {
+        sqrt_t[i] = std::sqrt(b.years[i]);
+        fwd[i] = b.spot[i] * std::exp(-q * b.years[i]);
+        strike_df[i] = b.strike[i] * std::exp(-r * b.years[i]);
+        log_moneyness[i] = std::log(fwd[i] / strike_df[i]);
+    }
+
+    for (int step = 0; step < kMaxNewtonSteps; ++step) {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < kLanes; ++i) {
+            const double vol_t = b.sigma[i] * sqrt_t[i];
+            const double d1 = log_moneyness[i] / vol_t + 0.5 * vol_t;
+            const double d2 = d1 - vol_t;
+            const double s = b.sign[i];
+            const double model = s * (fwd[i] * norm_cdf(s * d1) - strike_df[i] * norm_cdf(s * d2));
+            const double vega = fwd[i] * norm_pdf(d1) * sqrt_t[i];
+            const double error = (model - b.price[i]) * b.valid[i];
+            b.sigma[i] = std::clamp(b.sigma[i] - error / std::max(vega, 1e-12), kMinVol, kMaxVol);
+            worst = std::max(worst, std::abs(error));
+        }
+        if (worst < kPriceTolerance) {
+            break;
+        }
+    }
+
+    for (std::size_t i = 0; i < kLanes; ++i) {
+        const double s = b.sign[i];
+        const double vol_t = b.sigma[i] * sqrt_t[i];
+        const double d1 = log_moneyness[i] / vol_t + 0.5 * vol_t;
+        const double d2 = d1 - vol_t;
+        const double pdf = norm_pdf(d1);
+        const double cdf1 = norm_cdf(s * d1);
+        const double cdf2 = norm_cdf(s * d2);
+        const double model = s * (fwd[i] * cdf1 - strike_df[i] * cdf2);
+        const bool solved =
+            b.valid[i] > 0.0 && std::abs(model - b.price[i]) <= kConvergedTolerance;
+        const double nan_unless_valid = solved ? 0.0 : kMissing;
+        b.iv[i] = b.sigma[i] + nan_unless_valid;
+        b.delta[i] = s * fwd[i] / b.spot[i] * cdf1 + nan_unless_valid;
+        b.gamma[i] = fwd[i] * pdf / (b.spot[i] * b.spot[i] * vol_t) + nan_unless_valid;
+        b.vega[i] = fwd[i] * pdf * sqrt_t[i] / 100.0 + nan_unless_valid;
+        b.theta[i] = (-fwd[i] * pdf * b.sigma[i] / (2.0 * sqrt_t[i]) -
+                      s * r * strike_df[i] * cdf2 + s * q * fwd[i] * cdf1) /
+                         365.0 +
+                     nan_unless_valid;
+        b.rho[i] = s * b.years[i] * strike_df[i] * cdf2 / 100.0 + nan_unless_valid;
+    }
+}
+
+} // namespace
+
+GreeksEngine::GreeksEngine() : GreeksEngine(Options{}) {}
+
+GreeksEngine::GreeksEngine(Options options) : options_(options) {}
+
+std::uint32_t GreeksEngine::add_contract(std::string_view symbol, std::string_view underlying) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return add_contract_locked(symbol, underlying);
+}
+
+std::uint32_t GreeksEngine::add_contract_locked(std::string_view symbol,
+                                                std::string_view underlying) {
+    if (auto it = rows_by_symbol_.find(symbol); it != rows_by_symbol_.end()) {
+        return it->second;
+    }
+    const auto occ = trading::parse_occ_symbol(symbol);
+    if (!occ) {
+        throw std::invalid_argument("not an OCC option symbol: " + std::string(symbol));
+    }
+    const auto row = static_cast<std::uint32_t>(symbols_.size());
+    const auto id = underlying_id(underlying);
+    rows_by_symbol_.emplace(std::string(symbol), row);
+    if (const auto key = trading::encode_option_key(*occ)) {
+        rows_by_key_.emplace(*key, row);
+    }
+    underlying_rows_[id].push_back(row);
+
+    symbols_.emplace_back(symbol);
+    underlying_.push_back(id);
+    strike_.push_back(occ->strike());
+    expiry_ns_.push_back(occ->expiry_days * kNanosPerDay +
+                         options_.expiry_utc_seconds * 1'000'000'000);
+    sign_.push_back(occ->type == trading::ContractType::Call ? 1.0 : -1.0);
+    mid_.push_back(kMissing);
+    dirty_.push_back(0);
+    iv_.push_back(kMissing);
+    delta_.push_back(kMissing);
+    gamma_.push_back(kMissing);
+    theta_.push_back(kMissing);
+    vega_.push_back(kMissing);
+    rho_.push_back(kMissing);
+    return row;
+}
+
+void GreeksEngine::add_chain(const OptionChain &chain) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < chain.size(); ++i) {
+        const auto row = add_contract_locked(chain.symbol[i], chain.underlying());
+        const double bid = chain.bid[i];
+        const double ask = chain.ask[i];
+        mid_[row] = bid > 0.0 && ask >= bid ? 0.5 * (bid + ask) : kMissing;
+        if (std::isfinite(chain.implied_volatility[i])) {
+            iv_[row] = chain.implied_volatility[i];
+        }
+        mark_dirty(row);
+    }
+}
+
+std::optional<std::uint32_t> GreeksEngine::find(std::string_view symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = rows_by_symbol_.find(symbol); it != rows_by_symbol_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void GreeksEngine::on_option_quote(const Quote &quote) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::uint32_t row = 0;
+    if (auto it = rows_by_key_.find(quote.contract_key);
+        quote.contract_key != 0 && it != rows_by_key_.end()) {
+        row = it->second;
+    } else if (auto by_symbol = rows_by_symbol_.find(quote.symbol);
+               by_symbol != rows_by_symbol_.end()) {
+        row = by_symbol->second;
+    } else {
+        return;
+    }
+    const bool two_sided = quote.bid_price > 0.0 && quote.ask_price >= quote.bid_price;
+    mid_[row] = two_sided ? 0.5 * (quote.bid_price + quote.ask_price) : kMissing;
+    mark_dirty(row);
+}
+
+void GreeksEngine::on_underlying_quote(const Quote &quote) {
+    if (quote.bid_price > 0.0 && quote.ask_price >= quote.bid_price) {
+        set_underlying_price(quote.symbol, 0.5 * (quote.bid_price + quote.ask_price));
+    }
+}
+
+void GreeksEngine::set_option_quote(std::uint32_t row, double bid, double ask) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mid_.at(row) = bid > 0.0 && ask >= bid ? 0.5 * (bid + ask) : kMissing;
+    mark_dirty(row);
+}
+
+void GreeksEngine::set_underlying_price(std::string_view underlying, double price) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = underlying_ids_.find(underlying);
+    if (it == underlying_ids_.end() || spot_[it->second] == price) {
+        return;
+    }
+    spot_[it->second] = price;
+    for (auto row : underlying_rows_[it->second]) {
+        mark_dirty(row);
+    }
+}
+
+void GreeksEngine::mark_all_dirty() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::uint32_t row = 0; row < symbols_.size(); ++row) {
+        mark_dirty(row);
+    }
+}
+
+std::size_t GreeksEngine::recompute(std::int64_t now_ns) {
+    const double r = options_.rate;
+    const double q = options_.dividend_yield;
+    std::vector<Job> jobs;
+    std::size_t recomputed = 0;
+
+    // Snapshot the dirty rows' inputs under the lock, so quote handlers are only held off for
+    // the copy and the publish, not for the solve.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recomputed = dirty_rows_.size();
+        jobs.resize((recomputed + kLanes - 1) / kLanes);
+        for (std::size_t index = 0; index < recomputed; ++index) {
+            const auto row = dirty_rows_[index];
+            dirty_[row] = 0;
+            auto &job = jobs[index / kLanes];
+            const std::size_t lane = job.count++;
+            job.rows[lane] = row;
+            Batch &batch = job.batch;
+
+            const double spot = spot_[underlying_[row]];
+            const double strike = strike_[row];
+            const double years = static_cast<double>(expiry_ns_[row] - now_ns) / kNanosPerYear;
+            const double price = mid_[row];
+            const double sign = sign_[row];
+
+            // No-arbitrage bounds: above discounted intrinsic value, below the forward
+            // (calls) or the discounted strike (puts).
+            const double fwd = spot * std::exp(-q * years);
+            const double strike_df = strike * std::exp(-r * years);
+            const double lower = std::max(sign * (fwd - strike_df), 0.0);
+            const double upper = sign > 0.0 ? fwd : strike_df;
+            const bool valid = spot > 0.0 && strike > 0.0 && years > 0.0 && price > lower &&
+                               price < upper;
+
+            batch.spot[lane] = valid ? spot : 1.0;
+            batch.strike[lane] = valid ? strike : 1.0;
+            batch.years[lane] = valid ? years : 1.0;
+            batch.sign[lane] = sign;
+            batch.price[lane] = valid ? price : 0.1;
+            batch.valid[lane] = valid ? 1.0 : 0.0;
+            // Warm start from the last solution, otherwise from the point of inflection of
+            // price in volatility, from which Newton's method converges monotonically.
+            const double previous = iv_[row];
+            const double inflection =
+                valid ? std::sqrt(2.0 * std::abs(std::log(fwd / strike_df)) / years) : 0.25;
+            batch.sigma[lane] = std::isfinite(previous) && previous > kMinVol
+                                    ? previous
+                                    : std::clamp(inflection, 0.05, kMaxVol);
+        }
+        dirty_rows_.clear();
+    }
+
+    for (auto &job : jobs) {
+        Batch &batch = job.batch;
+        for (std::size_t lane = job.count; lane < kLanes; ++lane) {
+            // Padding lanes solve a benign at-the-money contract and are discarded.
+            batch.spot[lane] = batch.strike[lane] = batch.years[lane] = 1.0;
+            batch.sign[lane] = 1.0;
+            batch.price[lane] = 0.1;
+            batch.sigma[lane] = 0.25;
+            batch.valid[lane] = 0.0;
+        }
+        solve(batch, r, q);
+    }
+
+    // Rows re-quoted during the solve are dirty again and get fresh results next round.
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &job : jobs) {
+        for (std::size_t lane = 0; lane < job.count; ++lane) {
+            const auto row = job.rows[lane];
+            iv_[row] = job.batch.iv[lane];
+            delta_[row] = job.batch.delta[lane];
+            gamma_[row] = job.batch.gamma[lane];
+            theta_[row] = job.batch.theta[lane];
+            vega_[row] = job.batch.vega[lane];
+            rho_[row] = job.batch.rho[lane];
+        }
+    }
+    return recomputed;
+}
+
+std::function<void(const Quote &)> GreeksEngine::option_quote_handler() {
+    return [this](const Quote &quote) { on_option_quote(quote); };
+}
+
+std::function<void(const Quote &)> GreeksEngine::underlying_quote_handler() {
+    return [this](const Quote &quote) { on_underlying_quote(quote); };
+}
+
+std::uint32_t GreeksEngine::underlying_id(std::string_view underlying) {
+    if (auto it = underlying_ids_.find(underlying); it != underlying_ids_.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(spot_.size());
+    underlying_ids_.emplace(std::string(underlying), id);
+    spot_.push_back(kMissing);
+    underlying_rows_.emplace_back();
+    return id;
+}
+
+void GreeksEngine::mark_dirty(std::uint32_t row) {
+    if (dirty_[row] == 0) {
+        dirty_[row] = 1;
+        dirty_rows_.push_back(row);
+    }
+}
+
+} // namespace alpaca::data
@@ -1,6 +1,7 @@
 #include "alpaca/data/live/crypto.hpp"
 
 #include "alpaca/data/enums.hpp"
+#include "low_latency.hpp"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -12,6 +13,7 @@
 #include <simdjson/ondemand.h>
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -33,6 +35,14 @@ struct CryptoDataStream::Impl {
     std::string port_;
     std::string path_;
 
+    // Held for every write; heartbeat pings from the reader thread take it too.
+    std::mutex write_mutex_;
+
+    void write(const std::string &message, boost::system::error_code &ec) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        ws_->write(net::buffer(message), ec);
+    }
+
     Impl() : ctx_(ssl::context::sslv23_client) {
         ctx_.set_default_verify_paths();
         ctx_.set_verify_mode(ssl::verify_none); // For now, skip verification
@@ -69,117 +79,97 @@ CryptoDataStream::CryptoDataStream(std::string api_key, std::string secret_key,
                                          : std::string(encoded_path.data(), encoded_path.size());
 }
 
+CryptoDataStream::~CryptoDataStream() {
+    stop();
+}
+
 void CryptoDataStream::subscribe_trades(TradeHandler handler,
                                         const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(trade_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("trades", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_trades(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("trades", symbols);
+    auto removed = remove_handlers(trade_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("trades", removed);
     }
 }
 
 void CryptoDataStream::subscribe_quotes(QuoteHandler handler,
                                          const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(quote_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("quotes", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_quotes(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("quotes", symbols);
+    auto removed = remove_handlers(quote_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("quotes", removed);
     }
 }
 
 void CryptoDataStream::subscribe_bars(BarHandler handler,
                                        const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("bars", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("bars", symbols);
+    auto removed = remove_handlers(bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("bars", removed);
     }
 }
 
 void CryptoDataStream::subscribe_updated_bars(BarHandler handler,
                                               const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(updated_bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("updatedBars", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_updated_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("updatedBars", symbols);
+    auto removed = remove_handlers(updated_bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("updatedBars", removed);
     }
 }
 
 void CryptoDataStream::subscribe_daily_bars(BarHandler handler,
                                             const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(daily_bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("dailyBars", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_daily_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("dailyBars", symbols);
+    auto removed = remove_handlers(daily_bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("dailyBars", removed);
     }
 }
 
 void CryptoDataStream::subscribe_orderbooks(OrderbookHandler handler,
                                             const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        orderbook_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(orderbook_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("orderbooks", added);
     }
 }
 
 void CryptoDataStream::unsubscribe_orderbooks(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        orderbook_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("orderbooks", symbols);
+    auto removed = remove_handlers(orderbook_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("orderbooks", removed);
     }
 }
 
@@ -200,6 +190,9 @@ void CryptoDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("Connect failed: " + ec.message());
     }
+    if (low_latency_) {
+        apply_socket_options(lowest_layer, *low_latency_);
+    }
 
     pimpl_->ws_->next_layer().handshake(ssl::stream_base::client, ec);
     if (ec) {
@@ -216,10 +209,14 @@ void CryptoDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("WebSocket handshake failed: " + ec.message());
     }
+    if (heartbeat_) {
+        core::watch_heartbeat(*pimpl_->ws_, *heartbeat_);
+    }
 
     // Read initial connection message
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read connection message: " + ec.message());
     }
@@ -265,13 +262,14 @@ void CryptoDataStream::authenticate_impl() {
 
     boost::system::error_code ec;
     auto auth_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(auth_msg), ec);
+    pimpl_->write(auth_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send auth: " + ec.message());
     }
 
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read auth response: " + ec.message());
     }
@@ -327,59 +325,42 @@ void CryptoDataStream::authenticate_impl() {
     }
 }
 
-void CryptoDataStream::send_subscribe_message_impl() {
-    std::ostringstream oss;
-    oss << "{\"action\":\"subscribe\"";
-    bool first = true;
-
-    auto append_symbols = [&](const std::string &channel, const auto &handlers) {
-        if (!handlers.empty()) {
-            if (!first)
-                oss << ",";
-            first = false;
-            oss << "\"" << channel << "\":[";
-            bool sym_first = true;
-            for (const auto &[symbol, handler] : handlers) {
-                if (!sym_first)
-                    oss << ",";
-                sym_first = false;
-                oss << "\"" << symbol << "\"";
-            }
-            oss << "]";
-        }
+std::string CryptoDataStream::subscription_message() const {
+    const std::vector<ChannelSymbols> channels{
+        {"trades", symbols_of(trade_handlers_)},
+        {"quotes", symbols_of(quote_handlers_)},
+        {"bars", symbols_of(bar_handlers_)},
+        {"updatedBars", symbols_of(updated_bar_handlers_)},
+        {"dailyBars", symbols_of(daily_bar_handlers_)},
+        {"orderbooks", symbols_of(orderbook_handlers_)},
     };
+    return build_subscription_message("subscribe", channels);
+}
 
-    append_symbols("trades", trade_handlers_);
-    append_symbols("quotes", quote_handlers_);
-    append_symbols("bars", bar_handlers_);
-    append_symbols("updatedBars", bar_handlers_);
-    append_symbols("dailyBars", bar_handlers_);
-    append_symbols("orderbooks", orderbook_handlers_);
-
-    oss << "}";
-
+void CryptoDataStream::send_subscribe_message_impl() {
     boost::system::error_code ec;
-    auto subscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(subscribe_msg), ec);
+    const auto subscribe_msg = subscription_message();
+    pimpl_->write(subscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
 }
 
-void CryptoDataStream::send_unsubscribe_message_impl(const std::string &channel,
-                                                     const std::vector<std::string> &symbols) {
-    std::ostringstream oss;
-    oss << "{\"action\":\"unsubscribe\",\"" << channel << "\":[";
-    for (size_t i = 0; i < symbols.size(); ++i) {
-        if (i > 0)
-            oss << ",";
-        oss << "\"" << symbols[i] << "\"";
+void CryptoDataStream::send_subscribe_message_impl(const std::string &channel,
+                                                  const std::vector<std::string> &symbols) {
+    boost::system::error_code ec;
+    auto subscribe_msg = build_subscription_message("subscribe", channel, symbols);
+    pimpl_->write(subscribe_msg, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
-    oss << "]}";
+}
 
+void CryptoDataStream::send_unsubscribe_message_impl(const std::string &channel,
+                                                    const std::vector<std::string> &symbols) {
     boost::system::error_code ec;
-    auto unsubscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(unsubscribe_msg), ec);
+    auto unsubscribe_msg = build_subscription_message("unsubscribe", channel, symbols);
+    pimpl_->write(unsubscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send unsubscribe: " + ec.message());
     }
@@ -389,15 +370,18 @@ void CryptoDataStream::consume_messages_impl() {
     beast::flat_buffer buffer;
     boost::system::error_code ec;
 
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec == boost::asio::error::operation_aborted) {
         return;
     }
     if (ec) {
-        throw std::runtime_error("Read failed: " + ec.message());
+        throw std::runtime_error(core::read_failure_message(ec, heartbeat_.get()));
     }
+    mark_frame_received();
 
     std::string message(static_cast<const char *>(buffer.data().data()), buffer.size());
+    record_frame(message);
     dispatch_message_impl(message);
 }
 
@@ -495,6 +479,15 @@ Orderbook parse_orderbook_from_websocket(simdjson::ondemand::object &obj) {
         }
     }
 
+    // "r": true marks a full snapshot that replaces the book instead of a delta
+    auto reset_field = obj.find_field_unordered("r");
+    if (!reset_field.error()) {
+        auto reset_val = reset_field.value().get_bool();
+        if (!reset_val.error()) {
+            orderbook.reset = reset_val.value();
+        }
+    }
+
     return orderbook;
 }
 } // namespace
@@ -573,9 +566,9 @@ void CryptoDataStream::dispatch_message_impl(const std::string &message) {
             trade.tape = get_string_field(obj, "z");
 
             if (auto it = trade_handlers_.find(symbol); it != trade_handlers_.end()) {
-                it->second(trade);
+                deliver(it->second, trade);
             } else if (auto it = trade_handlers_.find("*"); it != trade_handlers_.end()) {
-                it->second(trade);
+                deliver(it->second, trade);
             }
         } else if (msg_type == "q") { // Quote
             Quote quote;
@@ -591,11 +584,11 @@ void CryptoDataStream::dispatch_message_impl(const std::string &message) {
             quote.tape = get_string_field(obj, "z");
 
             if (auto it = quote_handlers_.find(symbol); it != quote_handlers_.end()) {
-                it->second(quote);
+                deliver(it->second, quote);
             } else if (auto it = quote_handlers_.find("*"); it != quote_handlers_.end()) {
-                it->second(quote);
+                deliver(it->second, quote);
             }
-        } else if (msg_type == "b" || msg_type == "u" || msg_type == "d") { // Bar types
+        } else if (auto *handlers = bar_handlers_for(msg_type)) { // Bar types
             Bar bar;
             bar.symbol = symbol;
             bar.timestamp = get_string_field(obj, "t");
@@ -619,18 +612,18 @@ void CryptoDataStream::dispatch_message_impl(const std::string &message) {
                 }
             }
 
-            if (auto it = bar_handlers_.find(symbol); it != bar_handlers_.end()) {
-                it->second(bar);
-            } else if (auto it = bar_handlers_.find("*"); it != bar_handlers_.end()) {
-                it->second(bar);
+            if (auto it = handlers->find(symbol); it != handlers->end()) {
+                deliver(it->second, bar);
+            } else if (auto it = handlers->find("*"); it != handlers->end()) {
+                deliver(it->second, bar);
             }
         } else if (msg_type == "o") { // Orderbook
             if (auto it = orderbook_handlers_.find(symbol); it != orderbook_handlers_.end()) {
                 Orderbook orderbook = parse_orderbook_from_websocket(obj);
-                it->second(orderbook);
+                deliver(it->second, orderbook);
             } else if (auto it = orderbook_handlers_.find("*"); it != orderbook_handlers_.end()) {
                 Orderbook orderbook = parse_orderbook_from_websocket(obj);
-                it->second(orderbook);
+                deliver(it->second, orderbook);
             }
         }
     }
@@ -639,7 +632,10 @@ void CryptoDataStream::dispatch_message_impl(const std::string &message) {
 void CryptoDataStream::close_impl() {
     if (pimpl_->ws_) {
         boost::system::error_code ec;
-        pimpl_->ws_->close(websocket::close_code::normal, ec);
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->write_mutex_);
+            pimpl_->ws_->close(websocket::close_code::normal, ec);
+        }
         pimpl_->ws_.reset();
     }
 }
@@ -0,0 +1,266 @@
+#include "alpaca/data/live/event_bus.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <utility>
+
+namespace alpaca::data::live {
+
+// Bounded queue and thread behind one dedicated subscriber. The thread keeps the worker
+// alive, so a handler may unsubscribe itself: the worker then detaches instead of joining.
+class EventBus::Worker {
+  public:
+    Worker(Invoker invoke, std::size_t capacity, std::atomic<std::uint64_t> &dropped)
+        : invoke_(std::move(invoke)), capacity_(capacity), dropped_(dropped) {}
+
+    static std::shared_ptr<Worker> start(Invoker invoke, std::size_t capacity,
+                                         std::atomic<std::uint64_t> &dropped) {
+        auto worker = std::make_shared<Worker>(std::move(invoke), capacity, dropped);
+        worker->thread_ = std::thread([self = worker] { self->run(); });
+        return worker;
+    }
+
+    // Reader thread. A full queue sheds its oldest event so the subscriber catches up on
+    // the latest state instead of the reader waiting for it.
+    void push(std::shared_ptr<const void> event) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            if (queue_.size() >= capacity_) {
+                queue_.pop_front();
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            queue_.push_back(std::move(event));
+        }
+        ready_.notify_one();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            queue_.clear();
+        }
+        ready_.notify_one();
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+  private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            // Timed only so the binary does not need the untimed wait, which libstdc++ 12
+            // versions as GLIBCXX_3.4.30; an idle worker wakes once an hour.
+            if (!ready_.wait_for(lock, std::chrono::hours(1),
+                                 [this] { return stopping_ || !queue_.empty(); })) {
+                continue;
+            }
+            if (stopping_) {
+                return;
+            }
+            auto event = std::move(queue_.front());
+            queue_.pop_front();
+            lock.unlock();
+            invoke_(event.get());
+            event.reset();
+            lock.lock();
+        }
+    }
+
+    Invoker invoke_;
+    const std::size_t capacity_;
+    std::atomic<std::uint64_t> &dropped_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::shared_ptr<const void>> queue_;
+    bool stopping_{false};
+    std::thread thread_;
+};
+
+EventBus::~EventBus() {
+    std::vector<std::shared_ptr<Worker>> workers;
+    {
+        std::lock_guard<std::mutex> guard(subscribe_mutex_);
+        for (auto &channel : channels_) {
+            std::vector<std::string> symbols;
+            for (const auto &[symbol, subscribers] : *channel.table) {
+                symbols.push_back(symbol);
+                for (const auto &subscriber : subscribers) {
+                    if (subscriber->worker) {
+                        workers.push_back(subscriber->worker);
+                    }
+                }
+            }
+            if (!symbols.empty()) {
+                channel.unsubscribe(symbols);
+            }
+        }
+    }
+    // A subscriber listed under several symbols appears more than once; stopping is idempotent.
+    for (const auto &worker : workers) {
+        worker->stop();
+    }
+}
+
+EventBus::SubscriptionId EventBus::subscribe_trades(TradeHandler handler,
+                                                    const std::vector<std::string> &symbols,
+                                                    Delivery delivery) {
+    return add<Trade>(kTrades, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::subscribe_quotes(QuoteHandler handler,
+                                                    const std::vector<std::string> &symbols,
+                                                    Delivery delivery) {
+    return add<Quote>(kQuotes, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::subscribe_bars(BarHandler handler,
+                                                  const std::vector<std::string> &symbols,
+                                                  Delivery delivery) {
+    return add<Bar>(kBars, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::subscribe_updated_bars(BarHandler handler,
+                                                          const std::vector<std::string> &symbols,
+                                                          Delivery delivery) {
+    return add<Bar>(kUpdatedBars, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::subscribe_daily_bars(BarHandler handler,
+                                                        const std::vector<std::string> &symbols,
+                                                        Delivery delivery) {
+    return add<Bar>(kDailyBars, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId
+EventBus::subscribe_trading_statuses(TradingStatusHandler handler,
+                                     const std::vector<std::string> &symbols, Delivery delivery) {
+    return add<TradingStatus>(kTradingStatuses, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::subscribe_orderbooks(OrderbookHandler handler,
+                                                        const std::vector<std::string> &symbols,
+                                                        Delivery delivery) {
+    return add<Orderbook>(kOrderbooks, std::move(handler), symbols, delivery);
+}
+
+EventBus::SubscriptionId EventBus::add_subscriber(Channel channel, Invoker invoke,
+                                                  const std::vector<std::string> &symbols,
+                                                  Delivery delivery) {
+    std::lock_guard<std::mutex> guard(subscribe_mutex_);
+    ChannelState &state = channels_[channel];
+    if (!state.subscribe) {
+        throw std::invalid_argument("EventBus: the stream does not offer this channel");
+    }
+
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->id = next_id_++;
+    if (delivery == Delivery::Dedicated) {
+        subscriber->worker = Worker::start(std::move(invoke), queue_capacity_, dropped_);
+    } else {
+        subscriber->invoke = std::move(invoke);
+    }
+
+    auto table = std::make_shared<Table>(*state.table);
+    std::vector<std::string> added;
+    for (const auto &symbol : symbols) {
+        auto &list = (*table)[symbol];
+        if (list.empty()) {
+            added.push_back(symbol);
+        }
+        if (list.empty() || list.back()->id != subscriber->id) {
+            list.push_back(subscriber);
+        }
+    }
+    std::atomic_store_explicit(&state.table, std::shared_ptr<const Table>(std::move(table)),
+                              std::memory_order_release);
+    channel_of_.emplace(subscriber->id, channel);
+    if (!added.empty()) {
+        state.subscribe(added);
+    }
+    return subscriber->id;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+    std::shared_ptr<Worker> worker;
+    {
+        std::lock_guard<std::mutex> guard(subscribe_mutex_);
+        const auto it = channel_of_.find(id);
+        if (it == channel_of_.end()) {
+            return;
+        }
+        ChannelState &state = channels_[it->second];
+
+        auto table = std::make_shared<Table>(*state.table);
+        std::vector<std::string> removed;
+        for (auto entry = table->begin(); entry != table->end();) {
+            auto &list = entry->second;
+            const auto match = std::find_if(list.begin(), list.end(),
+                                            [id](const auto &s) { return s->id == id; });
+            if (match != list.end()) {
+                if ((*match)->worker) {
+                    worker = (*match)->worker;
+                }
+                list.erase(match);
+            }
+            if (list.empty()) {
+                removed.push_back(entry->first);
+                entry = table->erase(entry);
+            } else {
+                ++entry;
+            }
+        }
+        std::atomic_store_explicit(&state.table,
+                                   std::shared_ptr<const Table>(std::move(table)),
+                                   std::memory_order_release);
+        channel_of_.erase(it);
+        if (!removed.empty()) {
+            state.unsubscribe(removed);
+        }
+    }
+    if (worker) {
+        worker->stop();
+    }
+}
+
+std::size_t EventBus::subscriber_count() const {
+    std::lock_guard<std::mutex> guard(subscribe_mutex_);
+    return channel_of_.size();
+}
+
+void EventBus::fan_out(Channel channel, std::string_view symbol, const void *event, Share share) {
+    const auto table =
+        std::atomic_load_explicit(&channels_[channel].table, std::memory_order_acquire);
+    std::shared_ptr<const void> shared;
+    const auto deliver = [&](const SubscriberList &subscribers) {
+        for (const auto &subscriber : subscribers) {
+            if (subscriber->worker) {
+                if (!shared) {
+                    shared = share(event);
+                }
+                subscriber->worker->push(shared);
+            } else {
+                subscriber->invoke(event);
+            }
+        }
+    };
+    if (symbol != "*") {
+        if (const auto it = table->find(symbol); it != table->end()) {
+            deliver(it->second);
+        }
+    }
+    if (const auto it = table->find(std::string_view("*")); it != table->end()) {
+        deliver(it->second);
+    }
+}
+
+} // namespace alpaca::data::live
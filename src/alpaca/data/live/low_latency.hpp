@@ -0,0 +1,81 @@
+#pragma once
+
+// Socket tuning, busy-poll and heartbeat reads shared by the data stream implementations.
+
+#include "alpaca/core/thread.hpp"
+#include "alpaca/core/websocket_heartbeat.hpp"
+#include "alpaca/data/live/websocket.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace alpaca::data::live {
+
+// Applies TCP_NODELAY and the requested kernel buffer sizes to a connected socket.
+inline void apply_socket_options(boost::asio::ip::tcp::socket &socket,
+                                 const LowLatencyOptions &options) {
+    boost::system::error_code ec;
+    socket.set_option(boost::asio::ip::tcp::no_delay(options.tcp_nodelay), ec);
+    if (options.receive_buffer_bytes) {
+        socket.set_option(
+            boost::asio::socket_base::receive_buffer_size(*options.receive_buffer_bytes), ec);
+    }
+    if (options.send_buffer_bytes) {
+        socket.set_option(boost::asio::socket_base::send_buffer_size(*options.send_buffer_bytes),
+                          ec);
+    }
+}
+
+// Reads one websocket message without blocking in the kernel: the read is started
+// asynchronously and completed by spinning on io_context::poll(), which only ever issues a
+// zero-timeout epoll_wait. Once `keep_running` turns false the read is cancelled and finishes
+// with operation_aborted.
+template <typename WebSocket>
+void busy_poll_read(WebSocket &ws, boost::asio::io_context &ioc, boost::beast::flat_buffer &buffer,
+                    boost::system::error_code &ec, const std::atomic<bool> &keep_running) {
+    bool done = false;
+    ws.async_read(buffer, [&](boost::system::error_code result, std::size_t) {
+        ec = result;
+        done = true;
+    });
+    bool cancelled = false;
+    while (!done) {
+        if (ioc.poll() == 0) {
+            if (!cancelled && !keep_running.load(std::memory_order_relaxed)) {
+                boost::system::error_code ignored;
+                boost::beast::get_lowest_layer(ws).cancel(ignored);
+                cancelled = true;
+            }
+            core::cpu_relax();
+        }
+    }
+    ioc.restart();
+}
+
+// Reads one frame the way the stream is configured: through the heartbeat when it is enabled,
+// by busy polling in low-latency mode, otherwise with a blocking read. `write_mutex` is the
+// stream's write lock, which heartbeat pings take too.
+template <typename WebSocket>
+void read_frame(WebSocket &ws, boost::asio::io_context &ioc, boost::beast::flat_buffer &buffer,
+                boost::system::error_code &ec, core::Heartbeat *heartbeat,
+                std::mutex &write_mutex, const std::optional<LowLatencyOptions> &low_latency,
+                const std::atomic<bool> &keep_running) {
+    const bool busy_poll = low_latency && low_latency->busy_poll;
+    if (heartbeat) {
+        core::read_with_heartbeat(ws, ioc, buffer, ec, *heartbeat, write_mutex, keep_running,
+                                  busy_poll);
+    } else if (busy_poll) {
+        busy_poll_read(ws, ioc, buffer, ec, keep_running);
+    } else {
+        ws.read(buffer, ec);
+    }
+}
+
+} // namespace alpaca::data::live
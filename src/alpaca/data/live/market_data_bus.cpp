@@ -0,0 +1,392 @@
+#include "alpaca/data/live/market_data_bus.hpp"
+
+#include "alpaca/core/thread.hpp"
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ALPACA_MARKET_DATA_BUS_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace alpaca::data::live {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'L', 'P', 'M', 'D', 'B', 'U', 'S'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint64_t kBusy = std::numeric_limits<std::uint64_t>::max();
+constexpr std::size_t kHugePage = std::size_t{2} << 20;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the bus needs lock-free 64-bit atomics to be shared between processes");
+
+// Layout of the shared-memory object: one header page followed by the slots. The head and
+// the slots sit on their own cache lines so readers polling the head do not share a line
+// with the slot being written.
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head; // sequence of the last published event
+};
+
+struct alignas(64) Slot {
+    std::atomic<std::uint64_t> sequence; // kBusy while being written
+    BusEvent event;
+};
+static_assert(sizeof(Slot) == 128);
+
+constexpr std::size_t kSlotsOffset = 4096;
+static_assert(sizeof(Header) <= kSlotsOffset);
+
+std::string shm_name(const std::string &name) {
+    return name.empty() || name.front() != '/' ? "/" + name : name;
+}
+
+[[noreturn]] void fail(const std::string &what, const std::string &name) {
+#ifdef ALPACA_MARKET_DATA_BUS_POSIX
+    throw std::runtime_error(what + " " + name + ": " + std::strerror(errno));
+#else
+    throw std::runtime_error(what + " " + name + ": the market data bus needs a POSIX platform");
+#endif
+}
+
+struct Mapping {
+    char *data{nullptr};
+    std::size_t bytes{0};
+
+    Mapping() = default;
+    Mapping(const Mapping &) = delete;
+    Mapping &operator=(const Mapping &) = delete;
+
+    [[nodiscard]] Header &header() const noexcept { return *reinterpret_cast<Header *>(data); }
+    [[nodiscard]] Slot *slots() const noexcept {
+        return reinterpret_cast<Slot *>(data + kSlotsOffset);
+    }
+    [[nodiscard]] std::uint64_t mask() const noexcept { return header().capacity - 1; }
+
+    ~Mapping() {
+#ifdef ALPACA_MARKET_DATA_BUS_POSIX
+        if (data != nullptr) {
+            ::munmap(data, bytes);
+        }
+#endif
+    }
+};
+
+template <std::size_t N> void copy_symbol(char (&out)[N], const std::string &symbol) noexcept {
+    const std::size_t n = std::min(symbol.size(), N - 1);
+    std::memcpy(out, symbol.data(), n);
+    out[n] = '\0';
+}
+
+char first_char(const std::optional<std::string> &value) noexcept {
+    return value && !value->empty() ? value->front() : '\0';
+}
+
+std::optional<std::string> from_char(char c) {
+    return c == '\0' ? std::nullopt : std::optional<std::string>(std::string(1, c));
+}
+
+std::string format_event_time(std::int64_t ns) {
+    return ns == 0 ? std::string() : core::format_timestamp_ns(ns);
+}
+
+} // namespace
+
+std::string_view BusEvent::symbol_view() const noexcept {
+    return {symbol, ::strnlen(symbol, sizeof(symbol))};
+}
+
+BusEvent to_bus_event(const Trade &trade) {
+    BusEvent event;
+    event.type = BusEventType::Trade;
+    copy_symbol(event.symbol, trade.symbol);
+    event.timestamp_ns = core::parse_timestamp_ns(trade.timestamp).value_or(0);
+    event.exchange = first_char(trade.exchange);
+    event.tape = first_char(trade.tape);
+    event.values[0] = trade.price;
+    event.values[1] = trade.size;
+    if (trade.id) {
+        std::from_chars(trade.id->data(), trade.id->data() + trade.id->size(), event.extra);
+    }
+    return event;
+}
+
+BusEvent to_bus_event(const Quote &quote) {
+    BusEvent event;
+    event.type = BusEventType::Quote;
+    copy_symbol(event.symbol, quote.symbol);
+    event.timestamp_ns = core::parse_timestamp_ns(quote.timestamp).value_or(0);
+    event.exchange = first_char(quote.bid_exchange);
+    event.ask_exchange = first_char(quote.ask_exchange);
+    event.tape = first_char(quote.tape);
+    event.values[0] = quote.bid_price;
+    event.values[1] = quote.bid_size;
+    event.values[2] = quote.ask_price;
+    event.values[3] = quote.ask_size;
+    return event;
+}
+
+BusEvent to_bus_event(const Bar &bar) {
+    BusEvent event;
+    event.type = BusEventType::Bar;
+    copy_symbol(event.symbol, bar.symbol);
+    event.timestamp_ns = core::parse_timestamp_ns(bar.timestamp).value_or(0);
+    event.values[0] = bar.open;
+    event.values[1] = bar.high;
+    event.values[2] = bar.low;
+    event.values[3] = bar.close;
+    event.values[4] = bar.volume;
+    event.values[5] = bar.vwap.value_or(0.0);
+    event.extra = static_cast<std::uint64_t>(bar.trade_count.value_or(0.0));
+    return event;
+}
+
+Trade to_trade(const BusEvent &event) {
+    Trade trade;
+    trade.symbol = std::string(event.symbol_view());
+    trade.timestamp = format_event_time(event.timestamp_ns);
+    trade.price = event.values[0];
+    trade.size = event.values[1];
+    trade.exchange = from_char(event.exchange);
+    trade.tape = from_char(event.tape);
+    if (event.extra != 0) {
+        trade.id = std::to_string(event.extra);
+    }
+    return trade;
+}
+
+Quote to_quote(const BusEvent &event) {
+    Quote quote;
+    quote.symbol = std::string(event.symbol_view());
+    quote.timestamp = format_event_time(event.timestamp_ns);
+    quote.bid_price = event.values[0];
+    quote.bid_size = event.values[1];
+    quote.ask_price = event.values[2];
+    quote.ask_size = event.values[3];
+    quote.bid_exchange = from_char(event.exchange);
+    quote.ask_exchange = from_char(event.ask_exchange);
+    quote.tape = from_char(event.tape);
+    return quote;
+}
+
+Bar to_bar(const BusEvent &event) {
+    Bar bar;
+    bar.symbol = std::string(event.symbol_view());
+    bar.timestamp = format_event_time(event.timestamp_ns);
+    bar.open = event.values[0];
+    bar.high = event.values[1];
+    bar.low = event.values[2];
+    bar.close = event.values[3];
+    bar.volume = event.values[4];
+    if (event.values[5] != 0.0) {
+        bar.vwap = event.values[5];
+    }
+    if (event.extra != 0) {
+        bar.trade_count = static_cast<double>(event.extra);
+    }
+    return bar;
+}
+
+struct MarketDataBusPublisher::Segment {
+    Mapping map;
+    std::uint64_t sequence{0};
+};
+
+MarketDataBusPublisher::MarketDataBusPublisher(const std::string &name, std::size_t capacity)
+    : name_(shm_name(name)), segment_(std::make_unique<Segment>()) {
+    std::size_t slots = 2;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+#ifdef ALPACA_MARKET_DATA_BUS_POSIX
+    const std::size_t bytes = kSlotsOffset + slots * sizeof(Slot);
+    // Whole huge pages, so the kernel can back the ring with them when THP is enabled for
+    // shared memory.
+    const std::size_t mapped = (bytes + kHugePage - 1) / kHugePage * kHugePage;
+
+    ::shm_unlink(name_.c_str());
+    const int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd < 0) {
+        fail("MarketDataBusPublisher: cannot create", name_);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(mapped)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        fail("MarketDataBusPublisher: cannot size", name_);
+    }
+    void *data = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        fail("MarketDataBusPublisher: cannot map", name_);
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(data, mapped, MADV_HUGEPAGE);
+#endif
+    segment_->map.data = static_cast<char *>(data);
+    segment_->map.bytes = mapped;
+
+    // Touching every page up front keeps page faults off the publish path.
+    std::memset(data, 0, mapped);
+    auto *header = new (data) Header{};
+    header->version = kVersion;
+    header->slot_size = sizeof(Slot);
+    header->capacity = slots;
+    header->head.store(0, std::memory_order_relaxed);
+    Slot *ring = segment_->map.slots();
+    for (std::size_t i = 0; i < slots; ++i) {
+        new (&ring[i]) Slot{};
+        ring[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    // The magic goes in last: subscribers reject the segment until it is fully initialised.
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+#else
+    (void)slots;
+    fail("MarketDataBusPublisher: cannot create", name_);
+#endif
+}
+
+MarketDataBusPublisher::~MarketDataBusPublisher() {
+#ifdef ALPACA_MARKET_DATA_BUS_POSIX
+    ::shm_unlink(name_.c_str());
+#endif
+}
+
+std::uint64_t MarketDataBusPublisher::publish(BusEvent event) noexcept {
+    const Mapping &map = segment_->map;
+    const std::uint64_t sequence = ++segment_->sequence;
+    event.sequence = sequence;
+    event.published_ns = core::now_ns();
+
+    Slot &slot = map.slots()[sequence & map.mask()];
+    slot.sequence.store(kBusy, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.event, &event, sizeof(BusEvent));
+    slot.sequence.store(sequence, std::memory_order_release);
+    map.header().head.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+std::size_t MarketDataBusPublisher::capacity() const noexcept {
+    return static_cast<std::size_t>(segment_->map.header().capacity);
+}
+
+std::uint64_t MarketDataBusPublisher::sequence() const noexcept { return segment_->sequence; }
+
+struct MarketDataBusSubscriber::Segment {
+    Mapping map;
+};
+
+MarketDataBusSubscriber::MarketDataBusSubscriber(const std::string &name, bool from_oldest)
+    : segment_(std::make_unique<Segment>()) {
+    const std::string path = shm_name(name);
+#ifdef ALPACA_MARKET_DATA_BUS_POSIX
+    const int fd = ::shm_open(path.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        fail("MarketDataBusSubscriber: cannot open", path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        fail("MarketDataBusSubscriber: cannot stat", path);
+    }
+    const auto bytes = static_cast<std::size_t>(info.st_size);
+    if (bytes < kSlotsOffset) {
+        ::close(fd);
+        throw std::runtime_error("MarketDataBusSubscriber: " + path + " is not a market data bus");
+    }
+    // Mapped writable only because atomics in read-only memory are not portable; the
+    // subscriber never stores to the segment.
+    void *data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        fail("MarketDataBusSubscriber: cannot map", path);
+    }
+    segment_->map.data = static_cast<char *>(data);
+    segment_->map.bytes = bytes;
+#else
+    fail("MarketDataBusSubscriber: cannot open", path);
+#endif
+
+    const Header &header = segment_->map.header();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.slot_size != sizeof(Slot) || header.capacity == 0 ||
+        kSlotsOffset + header.capacity * sizeof(Slot) > bytes) {
+        throw std::runtime_error("MarketDataBusSubscriber: " + path + " is not a market data bus");
+    }
+    const std::uint64_t head = header.head.load(std::memory_order_acquire);
+    if (!from_oldest) {
+        next_ = head + 1;
+    } else if (head >= header.capacity) {
+        next_ = head - header.capacity + 1;
+    }
+}
+
+MarketDataBusSubscriber::~MarketDataBusSubscriber() = default;
+
+bool MarketDataBusSubscriber::poll(BusEvent &event) noexcept {
+    const Mapping &map = segment_->map;
+    const Header &header = map.header();
+    for (;;) {
+        const Slot &slot = map.slots()[next_ & map.mask()];
+        const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == next_) {
+            std::memcpy(&event, &slot.event, sizeof(BusEvent));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == next_) {
+                ++next_;
+                if (latency_) {
+                    latency_->record(core::now_ns() - event.published_ns);
+                }
+                return true;
+            }
+        }
+        const std::uint64_t head = header.head.load(std::memory_order_acquire);
+        if (head < next_) {
+            return false; // not published yet (or still being written)
+        }
+        if (head < next_ + header.capacity) {
+            // Published after the slot was read, or its overwrite is still in flight: the
+            // slot settles within one publish.
+            core::cpu_relax();
+            continue;
+        }
+        // The slot has been reused for a later event: skip to the oldest one still in the ring.
+        const std::uint64_t oldest = head - header.capacity + 1;
+        lost_ += oldest - next_;
+        next_ = oldest;
+    }
+}
+
+std::uint64_t MarketDataBusSubscriber::backlog() const noexcept {
+    const std::uint64_t head = segment_->map.header().head.load(std::memory_order_acquire);
+    return head >= next_ ? head - next_ + 1 : 0;
+}
+
+std::size_t MarketDataBusSubscriber::capacity() const noexcept {
+    return static_cast<std::size_t>(segment_->map.header().capacity);
+}
+
+void MarketDataBusSubscriber::enable_latency_stats() {
+    if (!latency_) {
+        latency_ = std::make_unique<core::LatencyHistogram>();
+    }
+}
+
+} // namespace alpaca::data::live
@@ -1,5 +1,7 @@
 #include "alpaca/data/live/news.hpp"
 
+#include "low_latency.hpp"
+
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
@@ -10,6 +12,7 @@
 #include <simdjson/ondemand.h>
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -31,6 +34,14 @@ struct NewsDataStream::Impl {
     std::string port_;
     std::string path_;
 
+    // Held for every write; heartbeat pings from the reader thread take it too.
+    std::mutex write_mutex_;
+
+    void write(const std::string &message, boost::system::error_code &ec) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        ws_->write(net::buffer(message), ec);
+    }
+
     Impl() : ctx_(ssl::context::sslv23_client) {
         ctx_.set_default_verify_paths();
         ctx_.set_verify_mode(ssl::verify_none);
@@ -60,21 +71,21 @@ NewsDataStream::NewsDataStream(std::string api_key, std::string secret_key, bool
                                          : std::string(encoded_path.data(), encoded_path.size());
 }
 
+NewsDataStream::~NewsDataStream() {
+    stop();
+}
+
 void NewsDataStream::subscribe_news(NewsHandler handler, const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        news_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(news_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("news", added);
     }
 }
 
 void NewsDataStream::unsubscribe_news(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        news_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("news", symbols);
+    auto removed = remove_handlers(news_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("news", removed);
     }
 }
 
@@ -95,6 +106,9 @@ void NewsDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("Connect failed: " + ec.message());
     }
+    if (low_latency_) {
+        apply_socket_options(lowest_layer, *low_latency_);
+    }
 
     pimpl_->ws_->next_layer().handshake(ssl::stream_base::client, ec);
     if (ec) {
@@ -111,10 +125,14 @@ void NewsDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("WebSocket handshake failed: " + ec.message());
     }
+    if (heartbeat_) {
+        core::watch_heartbeat(*pimpl_->ws_, *heartbeat_);
+    }
 
     // Read initial connection message
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read connection message: " + ec.message());
     }
@@ -160,13 +178,14 @@ void NewsDataStream::authenticate_impl() {
 
     boost::system::error_code ec;
     auto auth_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(auth_msg), ec);
+    pimpl_->write(auth_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send auth: " + ec.message());
     }
 
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read auth response: " + ec.message());
     }
@@ -222,50 +241,34 @@ void NewsDataStream::authenticate_impl() {
     }
 }
 
+std::string NewsDataStream::subscription_message() const {
+    return build_subscription_message("subscribe", {{"news", symbols_of(news_handlers_)}});
+}
+
 void NewsDataStream::send_subscribe_message_impl() {
-    std::ostringstream oss;
-    oss << "{\"action\":\"subscribe\"";
-    bool first = true;
-
-    if (!news_handlers_.empty()) {
-        if (!first)
-            oss << ",";
-        first = false;
-        oss << "\"news\":[";
-        bool sym_first = true;
-        for (const auto &[symbol, handler] : news_handlers_) {
-            if (!sym_first)
-                oss << ",";
-            sym_first = false;
-            oss << "\"" << symbol << "\"";
-        }
-        oss << "]";
+    boost::system::error_code ec;
+    const auto subscribe_msg = subscription_message();
+    pimpl_->write(subscribe_msg, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
+}
 
-    oss << "}";
-
+void NewsDataStream::send_subscribe_message_impl(const std::string &channel,
+                                                const std::vector<std::string> &symbols) {
     boost::system::error_code ec;
-    auto subscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(subscribe_msg), ec);
+    auto subscribe_msg = build_subscription_message("subscribe", channel, symbols);
+    pimpl_->write(subscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
 }
 
 void NewsDataStream::send_unsubscribe_message_impl(const std::string &channel,
-                                                   const std::vector<std::string> &symbols) {
-    std::ostringstream oss;
-    oss << "{\"action\":\"unsubscribe\",\"" << channel << "\":[";
-    for (size_t i = 0; i < symbols.size(); ++i) {
-        if (i > 0)
-            oss << ",";
-        oss << "\"" << symbols[i] << "\"";
-    }
-    oss << "]}";
-
+                                                  const std::vector<std::string> &symbols) {
     boost::system::error_code ec;
-    auto unsubscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(unsubscribe_msg), ec);
+    auto unsubscribe_msg = build_subscription_message("unsubscribe", channel, symbols);
+    pimpl_->write(unsubscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send unsubscribe: " + ec.message());
     }
@@ -275,15 +278,18 @@ void NewsDataStream::consume_messages_impl() {
     beast::flat_buffer buffer;
     boost::system::error_code ec;
 
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec == boost::asio::error::operation_aborted) {
         return;
     }
     if (ec) {
-        throw std::runtime_error("Read failed: " + ec.message());
+        throw std::runtime_error(core::read_failure_message(ec, heartbeat_.get()));
     }
+    mark_frame_received();
 
     std::string message(static_cast<const char *>(buffer.data().data()), buffer.size());
+    record_frame(message);
     dispatch_message_impl(message);
 }
 
@@ -468,10 +474,10 @@ void NewsDataStream::dispatch_message_impl(const std::string &message) {
             bool star_handler_called = false;
             for (const auto &symbol : symbols) {
                 if (auto it = news_handlers_.find(symbol); it != news_handlers_.end()) {
-                    it->second(news);
+                    deliver(it->second, news);
                 } else if (!star_handler_called) {
                     if (auto it = news_handlers_.find("*"); it != news_handlers_.end()) {
-                        it->second(news);
+                        deliver(it->second, news);
                         star_handler_called = true;
                     }
                 }
@@ -483,7 +489,10 @@ void NewsDataStream::dispatch_message_impl(const std::string &message) {
 void NewsDataStream::close_impl() {
     if (pimpl_->ws_) {
         boost::system::error_code ec;
-        pimpl_->ws_->close(websocket::close_code::normal, ec);
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->write_mutex_);
+            pimpl_->ws_->close(websocket::close_code::normal, ec);
+        }
         pimpl_->ws_.reset();
     }
 }
@@ -1,6 +1,8 @@
 #include "alpaca/data/live/option.hpp"
 
 #include "alpaca/data/enums.hpp"
+#include "alpaca/trading/option_symbol.hpp"
+#include "low_latency.hpp"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -12,6 +14,7 @@
 #include <simdjson/ondemand.h>
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -33,6 +36,14 @@ struct OptionDataStream::Impl {
     std::string port_;
     std::string path_;
 
+    // Held for every write; heartbeat pings from the reader thread take it too.
+    std::mutex write_mutex_;
+
+    void write(const std::string &message, boost::system::error_code &ec) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        ws_->write(net::buffer(message), ec);
+    }
+
     Impl() : ctx_(ssl::context::sslv23_client) {
         ctx_.set_default_verify_paths();
         ctx_.set_verify_mode(ssl::verify_none);
@@ -69,41 +80,37 @@ OptionDataStream::OptionDataStream(std::string api_key, std::string secret_key,
         encoded_path.empty() ? "/" : std::string(encoded_path.data(), encoded_path.size());
 }
 
+OptionDataStream::~OptionDataStream() {
+    stop();
+}
+
 void OptionDataStream::subscribe_trades(TradeHandler handler,
                                         const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(trade_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("trades", added);
     }
 }
 
 void OptionDataStream::unsubscribe_trades(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("trades", symbols);
+    auto removed = remove_handlers(trade_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("trades", removed);
     }
 }
 
 void OptionDataStream::subscribe_quotes(QuoteHandler handler,
                                         const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(quote_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("quotes", added);
     }
 }
 
 void OptionDataStream::unsubscribe_quotes(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("quotes", symbols);
+    auto removed = remove_handlers(quote_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("quotes", removed);
     }
 }
 
@@ -124,6 +131,9 @@ void OptionDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("Connect failed: " + ec.message());
     }
+    if (low_latency_) {
+        apply_socket_options(lowest_layer, *low_latency_);
+    }
 
     pimpl_->ws_->next_layer().handshake(ssl::stream_base::client, ec);
     if (ec) {
@@ -139,10 +149,14 @@ void OptionDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("WebSocket handshake failed: " + ec.message());
     }
+    if (heartbeat_) {
+        core::watch_heartbeat(*pimpl_->ws_, *heartbeat_);
+    }
 
     // Read initial connection message
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read connection message: " + ec.message());
     }
@@ -188,13 +202,14 @@ void OptionDataStream::authenticate_impl() {
 
     boost::system::error_code ec;
     auto auth_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(auth_msg), ec);
+    pimpl_->write(auth_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send auth: " + ec.message());
     }
 
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read auth response: " + ec.message());
     }
@@ -250,55 +265,38 @@ void OptionDataStream::authenticate_impl() {
     }
 }
 
-void OptionDataStream::send_subscribe_message_impl() {
-    std::ostringstream oss;
-    oss << "{\"action\":\"subscribe\"";
-    bool first = true;
-
-    auto append_symbols = [&](const std::string &channel, const auto &handlers) {
-        if (!handlers.empty()) {
-            if (!first)
-                oss << ",";
-            first = false;
-            oss << "\"" << channel << "\":[";
-            bool sym_first = true;
-            for (const auto &[symbol, handler] : handlers) {
-                if (!sym_first)
-                    oss << ",";
-                sym_first = false;
-                oss << "\"" << symbol << "\"";
-            }
-            oss << "]";
-        }
+std::string OptionDataStream::subscription_message() const {
+    const std::vector<ChannelSymbols> channels{
+        {"trades", symbols_of(trade_handlers_)},
+        {"quotes", symbols_of(quote_handlers_)},
     };
+    return build_subscription_message("subscribe", channels);
+}
 
-    append_symbols("trades", trade_handlers_);
-    append_symbols("quotes", quote_handlers_);
-
-    oss << "}";
-
+void OptionDataStream::send_subscribe_message_impl() {
     boost::system::error_code ec;
-    auto subscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(subscribe_msg), ec);
+    const auto subscribe_msg = subscription_message();
+    pimpl_->write(subscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
 }
 
-void OptionDataStream::send_unsubscribe_message_impl(const std::string &channel,
-                                                     const std::vector<std::string> &symbols) {
-    std::ostringstream oss;
-    oss << "{\"action\":\"unsubscribe\",\"" << channel << "\":[";
-    for (size_t i = 0; i < symbols.size(); ++i) {
-        if (i > 0)
-            oss << ",";
-        oss << "\"" << symbols[i] << "\"";
+void OptionDataStream::send_subscribe_message_impl(const std::string &channel,
+                                                  const std::vector<std::string> &symbols) {
+    boost::system::error_code ec;
+    auto subscribe_msg = build_subscription_message("subscribe", channel, symbols);
+    pimpl_->write(subscribe_msg, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
-    oss << "]}";
+}
 
+void OptionDataStream::send_unsubscribe_message_impl(const std::string &channel,
+                                                    const std::vector<std::string> &symbols) {
     boost::system::error_code ec;
-    auto unsubscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(unsubscribe_msg), ec);
+    auto unsubscribe_msg = build_subscription_message("unsubscribe", channel, symbols);
+    pimpl_->write(unsubscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send unsubscribe: " + ec.message());
     }
@@ -308,15 +306,18 @@ void OptionDataStream::consume_messages_impl() {
     beast::flat_buffer buffer;
     boost::system::error_code ec;
 
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec == boost::asio::error::operation_aborted) {
         return;
     }
     if (ec) {
-        throw std::runtime_error("Read failed: " + ec.message());
+        throw std::runtime_error(core::read_failure_message(ec, heartbeat_.get()));
     }
+    mark_frame_received();
 
     std::string message(static_cast<const char *>(buffer.data().data()), buffer.size());
+    record_frame(message);
     dispatch_message_impl(message);
 }
 
@@ -419,6 +420,7 @@ void OptionDataStream::dispatch_message_impl(const std::string &message) {
         if (msg_type == "t") { // Trade
             Trade trade;
             trade.symbol = symbol;
+            trade.contract_key = trading::option_key(symbol);
             trade.timestamp = get_string_field(obj, "t");
             trade.price = get_double_field(obj, "p");
             trade.size = get_double_field(obj, "s");
@@ -445,13 +447,14 @@ void OptionDataStream::dispatch_message_impl(const std::string &message) {
             trade.tape = get_string_field(obj, "z");
 
             if (auto it = trade_handlers_.find(symbol); it != trade_handlers_.end()) {
-                it->second(trade);
+                deliver(it->second, trade);
             } else if (auto it = trade_handlers_.find("*"); it != trade_handlers_.end()) {
-                it->second(trade);
+                deliver(it->second, trade);
             }
         } else if (msg_type == "q") { // Quote
             Quote quote;
             quote.symbol = symbol;
+            quote.contract_key = trading::option_key(symbol);
             quote.timestamp = get_string_field(obj, "t");
             quote.bid_price = get_double_field(obj, "bp");
             quote.bid_size = get_double_field(obj, "bs");
@@ -463,9 +466,9 @@ void OptionDataStream::dispatch_message_impl(const std::string &message) {
             quote.tape = get_string_field(obj, "z");
 
             if (auto it = quote_handlers_.find(symbol); it != quote_handlers_.end()) {
-                it->second(quote);
+                deliver(it->second, quote);
             } else if (auto it = quote_handlers_.find("*"); it != quote_handlers_.end()) {
-                it->second(quote);
+                deliver(it->second, quote);
             }
         }
     }
@@ -474,7 +477,10 @@ void OptionDataStream::dispatch_message_impl(const std::string &message) {
 void OptionDataStream::close_impl() {
     if (pimpl_->ws_) {
         boost::system::error_code ec;
-        pimpl_->ws_->close(websocket::close_code::normal, ec);
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->write_mutex_);
+            pimpl_->ws_->close(websocket::close_code::normal, ec);
+        }
         pimpl_->ws_.reset();
     }
 }
@@ -0,0 +1,337 @@
+#include "alpaca/data/live/replay.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace alpaca::data::live {
+
+class ReplayDataStream::Cursor {
+  public:
+    virtual ~Cursor() = default;
+    // Moves to the next event; false when the source is exhausted.
+    virtual bool advance() = 0;
+    virtual void deliver(ReplayDataStream &stream) = 0;
+
+    std::int64_t timestamp_ns{0};
+};
+
+// Walks one symbol's events of one type, from a cached vector or from REST pages fetched on
+// demand.
+template <typename Event, typename Handler>
+class ReplayDataStream::EventCursor final : public ReplayDataStream::Cursor {
+  public:
+    // Fills the next page and returns false when there are no more.
+    using Fetch = std::function<bool(std::vector<Event> &)>;
+
+    EventCursor(Handler handler, const Cached<Event> &cached, std::int64_t delay_ns)
+        : handler_(std::move(handler)), page_(cached.events), page_ns_(cached.timestamp_ns),
+          delay_ns_(delay_ns) {}
+    EventCursor(Handler handler, Fetch fetch, std::int64_t delay_ns)
+        : handler_(std::move(handler)), fetch_(std::move(fetch)), delay_ns_(delay_ns) {}
+
+    bool advance() override {
+        while (next_ >= page_.size()) {
+            if (!fetch_) {
+                return false;
+            }
+            owned_.clear();
+            if (!fetch_(owned_)) {
+                fetch_ = nullptr;
+            }
+            page_ = owned_;
+            page_ns_ = {};
+            next_ = 0;
+        }
+        current_ = next_++;
+        const std::int64_t event_ns =
+            page_ns_.empty() ? core::parse_timestamp_ns(page_[current_].timestamp).value_or(0)
+                             : page_ns_[current_];
+        timestamp_ns = event_ns + delay_ns_;
+        return true;
+    }
+
+    void deliver(ReplayDataStream &stream) override { stream.deliver(handler_, page_[current_]); }
+
+  private:
+    Handler handler_;
+    Fetch fetch_;
+    std::vector<Event> owned_;
+    std::span<const Event> page_;
+    std::span<const std::int64_t> page_ns_; // parsed timestamps of cached pages
+    std::size_t next_{0};
+    std::size_t current_{0};
+    std::int64_t delay_ns_{0};
+};
+
+namespace {
+
+// Pages through one symbol's history; `get` issues the request, fills the page's rows and
+// returns the next page token.
+template <typename Request, typename Event, typename Get>
+std::function<bool(std::vector<Event> &)> paged(Request request, Get get) {
+    return [request = std::move(request), get = std::move(get)](std::vector<Event> &out) mutable {
+        request.page_token = get(request, out);
+        return request.page_token && !request.page_token->empty();
+    };
+}
+
+template <typename Handlers, typename Cache>
+std::map<std::string, typename Handlers::mapped_type>
+resolve_handlers(const Handlers &handlers, const Cache &cached, bool remote) {
+    // Sorted so ties between symbols replay in a stable order.
+    std::map<std::string, typename Handlers::mapped_type> resolved;
+    for (const auto &[symbol, handler] : handlers) {
+        if (symbol != "*" && (remote || cached.count(symbol) > 0)) {
+            resolved.emplace(symbol, handler);
+        }
+    }
+    if (auto wildcard = handlers.find("*"); wildcard != handlers.end()) {
+        for (const auto &[symbol, events] : cached) {
+            resolved.emplace(symbol, wildcard->second);
+        }
+    }
+    return resolved;
+}
+
+} // namespace
+
+ReplayDataStream::ReplayDataStream(ReplayOptions options)
+    : DataStream("replay", "", ""), options_(std::move(options)) {}
+
+ReplayDataStream::ReplayDataStream(std::shared_ptr<const DataClient> client, ReplayOptions options)
+    : DataStream("replay", "", ""), client_(std::move(client)), options_(std::move(options)) {}
+
+ReplayDataStream::~ReplayDataStream() { stop(); }
+
+void ReplayDataStream::subscribe_trades(TradeHandler handler,
+                                        const std::vector<std::string> &symbols) {
+    add_handlers(trade_handlers_, handler, symbols);
+}
+
+void ReplayDataStream::unsubscribe_trades(const std::vector<std::string> &symbols) {
+    remove_handlers(trade_handlers_, symbols);
+}
+
+void ReplayDataStream::subscribe_quotes(QuoteHandler handler,
+                                        const std::vector<std::string> &symbols) {
+    add_handlers(quote_handlers_, handler, symbols);
+}
+
+void ReplayDataStream::unsubscribe_quotes(const std::vector<std::string> &symbols) {
+    remove_handlers(quote_handlers_, symbols);
+}
+
+void ReplayDataStream::subscribe_bars(BarHandler handler, const std::vector<std::string> &symbols) {
+    add_handlers(bar_handlers_, handler, symbols);
+}
+
+void ReplayDataStream::unsubscribe_bars(const std::vector<std::string> &symbols) {
+    remove_handlers(bar_handlers_, symbols);
+}
+
+void ReplayDataStream::ensure_not_started() const {
+    // Cursors point into the cached vectors, which must not reallocate under them.
+    if (prepared_) {
+        throw std::logic_error("ReplayDataStream: cached data added after the replay started");
+    }
+}
+
+template <typename Event>
+void ReplayDataStream::add_cached(std::unordered_map<std::string, Cached<Event>> &cache,
+                                  const std::vector<Event> &events) {
+    ensure_not_started();
+    for (const auto &event : events) {
+        auto &cached = cache[event.symbol];
+        cached.events.push_back(event);
+        cached.timestamp_ns.push_back(core::parse_timestamp_ns(event.timestamp).value_or(0));
+    }
+}
+
+void ReplayDataStream::add_trades(const std::vector<Trade> &trades) {
+    add_cached(cached_trades_, trades);
+}
+
+void ReplayDataStream::add_quotes(const std::vector<Quote> &quotes) {
+    add_cached(cached_quotes_, quotes);
+}
+
+void ReplayDataStream::add_bars(const std::vector<Bar> &bars) { add_cached(cached_bars_, bars); }
+
+void ReplayDataStream::prepare() {
+    if (prepared_) {
+        return;
+    }
+    prepared_ = true;
+    cursors_.clear();
+    heap_.clear();
+    first_event_ns_.reset();
+    const bool remote = client_ != nullptr;
+
+    for (auto &[symbol, handler] : resolve_handlers(trade_handlers_, cached_trades_, remote)) {
+        if (auto it = cached_trades_.find(symbol); it != cached_trades_.end()) {
+            cursors_.push_back(std::make_unique<EventCursor<Trade, TradeHandler>>(
+                handler, it->second, 0));
+        } else {
+            StockTradesRequest request;
+            request.symbols = {symbol};
+            request.start = options_.start;
+            request.end = options_.end;
+            request.feed = options_.feed;
+            request.limit = options_.page_limit;
+            auto fetch = paged<StockTradesRequest, Trade>(
+                std::move(request), [client = client_](const auto &r, auto &out) {
+                    auto page = client->get_stock_trades(r);
+                    out = std::move(page.trades);
+                    return page.next_page_token;
+                });
+            cursors_.push_back(std::make_unique<EventCursor<Trade, TradeHandler>>(
+                handler, std::move(fetch), 0));
+        }
+    }
+    for (auto &[symbol, handler] : resolve_handlers(quote_handlers_, cached_quotes_, remote)) {
+        if (auto it = cached_quotes_.find(symbol); it != cached_quotes_.end()) {
+            cursors_.push_back(std::make_unique<EventCursor<Quote, QuoteHandler>>(
+                handler, it->second, 0));
+        } else {
+            StockQuotesRequest request;
+            request.symbols = {symbol};
+            request.start = options_.start;
+            request.end = options_.end;
+            request.feed = options_.feed;
+            request.limit = options_.page_limit;
+            auto fetch = paged<StockQuotesRequest, Quote>(
+                std::move(request), [client = client_](const auto &r, auto &out) {
+                    auto page = client->get_stock_quotes(r);
+                    out = std::move(page.quotes);
+                    return page.next_page_token;
+                });
+            cursors_.push_back(std::make_unique<EventCursor<Quote, QuoteHandler>>(
+                handler, std::move(fetch), 0));
+        }
+    }
+    const std::int64_t bar_delay_ns = options_.bar_delay.count();
+    for (auto &[symbol, handler] : resolve_handlers(bar_handlers_, cached_bars_, remote)) {
+        if (auto it = cached_bars_.find(symbol); it != cached_bars_.end()) {
+            cursors_.push_back(std::make_unique<EventCursor<Bar, BarHandler>>(
+                handler, it->second, bar_delay_ns));
+        } else {
+            StockBarsRequest request;
+            request.symbols = {symbol};
+            request.timeframe = options_.bar_timeframe;
+            request.start = options_.start;
+            request.end = options_.end;
+            request.feed = options_.feed;
+            request.limit = options_.page_limit;
+            auto fetch = paged<StockBarsRequest, Bar>(
+                std::move(request), [client = client_](const auto &r, auto &out) {
+                    auto page = client->get_stock_bars(r);
+                    out = std::move(page.bars);
+                    return page.next_page_token;
+                });
+            cursors_.push_back(std::make_unique<EventCursor<Bar, BarHandler>>(
+                handler, std::move(fetch), bar_delay_ns));
+        }
+    }
+
+    for (std::size_t i = 0; i < cursors_.size(); ++i) {
+        push(i);
+    }
+}
+
+bool ReplayDataStream::later(const HeapEntry &a, const HeapEntry &b) noexcept {
+    return a.timestamp_ns > b.timestamp_ns ||
+           (a.timestamp_ns == b.timestamp_ns && a.cursor > b.cursor);
+}
+
+void ReplayDataStream::push(std::size_t cursor) {
+    if (!cursors_[cursor]->advance()) {
+        return;
+    }
+    heap_.push_back({cursors_[cursor]->timestamp_ns, cursor});
+    std::push_heap(heap_.begin(), heap_.end(), later);
+}
+
+std::size_t ReplayDataStream::deliver_until(std::int64_t timestamp_ns) {
+    prepare();
+    std::size_t delivered = 0;
+    while (!heap_.empty() && heap_.front().timestamp_ns <= timestamp_ns && should_run_) {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        const HeapEntry next = heap_.back();
+        heap_.pop_back();
+
+        if (options_.speed > 0.0) {
+            if (!first_event_ns_) {
+                first_event_ns_ = next.timestamp_ns;
+                wall_start_ = std::chrono::steady_clock::now();
+            }
+            const auto offset = static_cast<double>(next.timestamp_ns - *first_event_ns_);
+            std::this_thread::sleep_until(
+                wall_start_ + std::chrono::nanoseconds(
+                                  static_cast<std::int64_t>(offset / options_.speed)));
+        }
+        clock_ns_ = std::max(clock_ns_, next.timestamp_ns);
+        cursors_[next.cursor]->deliver(*this);
+        ++delivered;
+        push(next.cursor);
+    }
+    return delivered;
+}
+
+std::size_t ReplayDataStream::replay() {
+    should_run_ = true;
+    return deliver_until(std::numeric_limits<std::int64_t>::max());
+}
+
+std::size_t ReplayDataStream::advance_to(std::int64_t timestamp_ns) {
+    should_run_ = true;
+    const std::size_t delivered = deliver_until(timestamp_ns);
+    clock_ns_ = std::max(clock_ns_, timestamp_ns);
+    return delivered;
+}
+
+bool ReplayDataStream::finished() {
+    prepare();
+    return heap_.empty();
+}
+
+void ReplayDataStream::reset() {
+    prepared_ = false;
+    clock_ns_ = 0;
+}
+
+void ReplayDataStream::connect_impl() { prepare(); }
+
+void ReplayDataStream::authenticate_impl() {}
+
+void ReplayDataStream::send_subscribe_message_impl() {}
+
+void ReplayDataStream::send_subscribe_message_impl(const std::string &channel,
+                                                   const std::vector<std::string> &symbols) {
+    (void)channel;
+    (void)symbols;
+}
+
+void ReplayDataStream::send_unsubscribe_message_impl(const std::string &channel,
+                                                     const std::vector<std::string> &symbols) {
+    (void)channel;
+    (void)symbols;
+}
+
+void ReplayDataStream::consume_messages_impl() {
+    deliver_until(std::numeric_limits<std::int64_t>::max());
+    should_run_ = false; // end of history ends the stream
+}
+
+void ReplayDataStream::dispatch_message_impl(const std::string &message) { (void)message; }
+
+void ReplayDataStream::close_impl() {}
+
+} // namespace alpaca::data::live
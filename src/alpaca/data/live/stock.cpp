@@ -1,6 +1,8 @@
 #include "alpaca/data/live/stock.hpp"
 
+#include "alpaca/core/timestamp.hpp"
 #include "alpaca/data/enums.hpp"
+#include "low_latency.hpp"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -12,7 +14,9 @@
 #include <simdjson/ondemand.h>
 #include <simdjson/padded_string_view-inl.h>
 
+#include <algorithm>
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -34,6 +38,14 @@ struct StockDataStream::Impl {
     std::string port_;
     std::string path_;
 
+    // Held for every write; heartbeat pings from the reader thread take it too.
+    std::mutex write_mutex_;
+
+    void write(const std::string &message, boost::system::error_code &ec) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        ws_->write(net::buffer(message), ec);
+    }
+
     Impl() : ctx_(ssl::context::sslv23_client) {
         ctx_.set_default_verify_paths();
         ctx_.set_verify_mode(ssl::verify_none); // For now, skip verification
@@ -74,119 +86,97 @@ StockDataStream::StockDataStream(std::string api_key, std::string secret_key, bo
                                          : std::string(encoded_path.data(), encoded_path.size());
 }
 
-StockDataStream::~StockDataStream() = default;
+StockDataStream::~StockDataStream() {
+    stop();
+}
 
 void StockDataStream::subscribe_trades(TradeHandler handler,
                                        const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(trade_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("trades", added);
     }
 }
 
 void StockDataStream::unsubscribe_trades(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        trade_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("trades", symbols);
+    auto removed = remove_handlers(trade_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("trades", removed);
     }
 }
 
 void StockDataStream::subscribe_quotes(QuoteHandler handler,
                                         const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(quote_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("quotes", added);
     }
 }
 
 void StockDataStream::unsubscribe_quotes(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        quote_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("quotes", symbols);
+    auto removed = remove_handlers(quote_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("quotes", removed);
     }
 }
 
 void StockDataStream::subscribe_bars(BarHandler handler,
                                       const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("bars", added);
     }
 }
 
 void StockDataStream::unsubscribe_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("bars", symbols);
+    auto removed = remove_handlers(bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("bars", removed);
     }
 }
 
 void StockDataStream::subscribe_updated_bars(BarHandler handler,
                                               const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(updated_bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("updatedBars", added);
     }
 }
 
 void StockDataStream::unsubscribe_updated_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("updatedBars", symbols);
+    auto removed = remove_handlers(updated_bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("updatedBars", removed);
     }
 }
 
 void StockDataStream::subscribe_daily_bars(BarHandler handler,
                                            const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(daily_bar_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("dailyBars", added);
     }
 }
 
 void StockDataStream::unsubscribe_daily_bars(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        bar_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("dailyBars", symbols);
+    auto removed = remove_handlers(daily_bar_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("dailyBars", removed);
     }
 }
 
 void StockDataStream::subscribe_trading_statuses(TradingStatusHandler handler,
                                                   const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        status_handlers_[symbol] = handler;
-    }
-    if (running_) {
-        send_subscribe_message_impl();
+    auto added = add_handlers(status_handlers_, handler, symbols);
+    if (running_ && !added.empty()) {
+        send_subscribe_message_impl("statuses", added);
     }
 }
 
 void StockDataStream::unsubscribe_trading_statuses(const std::vector<std::string> &symbols) {
-    for (const auto &symbol : symbols) {
-        status_handlers_.erase(symbol);
-    }
-    if (running_) {
-        send_unsubscribe_message_impl("statuses", symbols);
+    auto removed = remove_handlers(status_handlers_, symbols);
+    if (running_ && !removed.empty()) {
+        send_unsubscribe_message_impl("statuses", removed);
     }
 }
 
@@ -215,6 +205,9 @@ void StockDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("Connect failed: " + ec.message());
     }
+    if (low_latency_) {
+        apply_socket_options(lowest_layer, *low_latency_);
+    }
 
     pimpl_->ws_->next_layer().handshake(ssl::stream_base::client, ec);
     if (ec) {
@@ -231,10 +224,14 @@ void StockDataStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("WebSocket handshake failed: " + ec.message());
     }
+    if (heartbeat_) {
+        core::watch_heartbeat(*pimpl_->ws_, *heartbeat_);
+    }
 
     // Read initial connection message
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read connection message: " + ec.message());
     }
@@ -280,13 +277,14 @@ void StockDataStream::authenticate_impl() {
 
     boost::system::error_code ec;
     auto auth_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(auth_msg), ec);
+    pimpl_->write(auth_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send auth: " + ec.message());
     }
 
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read auth response: " + ec.message());
     }
@@ -342,60 +340,42 @@ void StockDataStream::authenticate_impl() {
     }
 }
 
-void StockDataStream::send_subscribe_message_impl() {
-    std::ostringstream oss;
-    oss << "{\"action\":\"subscribe\"";
-    bool first = true;
-
-    auto append_symbols = [&](const std::string &channel,
-                               const auto &handlers) {
-        if (!handlers.empty()) {
-            if (!first)
-                oss << ",";
-            first = false;
-            oss << "\"" << channel << "\":[";
-            bool sym_first = true;
-            for (const auto &[symbol, handler] : handlers) {
-                if (!sym_first)
-                    oss << ",";
-                sym_first = false;
-                oss << "\"" << symbol << "\"";
-            }
-            oss << "]";
-        }
+std::string StockDataStream::subscription_message() const {
+    const std::vector<ChannelSymbols> channels{
+        {"trades", symbols_of(trade_handlers_)},
+        {"quotes", symbols_of(quote_handlers_)},
+        {"bars", symbols_of(bar_handlers_)},
+        {"updatedBars", symbols_of(updated_bar_handlers_)},
+        {"dailyBars", symbols_of(daily_bar_handlers_)},
+        {"statuses", symbols_of(status_handlers_)},
     };
+    return build_subscription_message("subscribe", channels);
+}
 
-    append_symbols("trades", trade_handlers_);
-    append_symbols("quotes", quote_handlers_);
-    append_symbols("bars", bar_handlers_);
-    append_symbols("updatedBars", bar_handlers_);
-    append_symbols("dailyBars", bar_handlers_);
-    append_symbols("statuses", status_handlers_);
-
-    oss << "}";
-
+void StockDataStream::send_subscribe_message_impl() {
     boost::system::error_code ec;
-    auto subscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(subscribe_msg), ec);
+    const auto subscribe_msg = subscription_message();
+    pimpl_->write(subscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
 }
 
-void StockDataStream::send_unsubscribe_message_impl(const std::string &channel,
-                                                     const std::vector<std::string> &symbols) {
-    std::ostringstream oss;
-    oss << "{\"action\":\"unsubscribe\",\"" << channel << "\":[";
-    for (size_t i = 0; i < symbols.size(); ++i) {
-        if (i > 0)
-            oss << ",";
-        oss << "\"" << symbols[i] << "\"";
+void StockDataStream::send_subscribe_message_impl(const std::string &channel,
+                                                 const std::vector<std::string> &symbols) {
+    boost::system::error_code ec;
+    auto subscribe_msg = build_subscription_message("subscribe", channel, symbols);
+    pimpl_->write(subscribe_msg, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
-    oss << "]}";
+}
 
+void StockDataStream::send_unsubscribe_message_impl(const std::string &channel,
+                                                   const std::vector<std::string> &symbols) {
     boost::system::error_code ec;
-    auto unsubscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(unsubscribe_msg), ec);
+    auto unsubscribe_msg = build_subscription_message("unsubscribe", channel, symbols);
+    pimpl_->write(unsubscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send unsubscribe: " + ec.message());
     }
@@ -405,16 +385,19 @@ void StockDataStream::consume_messages_impl() {
     beast::flat_buffer buffer;
     boost::system::error_code ec;
 
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               low_latency_, should_run_);
     if (ec == boost::asio::error::operation_aborted) {
         // Operation aborted is OK, just continue
         return;
     }
     if (ec) {
-        throw std::runtime_error("Read failed: " + ec.message());
+        throw std::runtime_error(core::read_failure_message(ec, heartbeat_.get()));
     }
+    mark_frame_received();
 
     std::string message(static_cast<const char *>(buffer.data().data()), buffer.size());
+    record_frame(message);
     dispatch_message_impl(message);
 }
 
@@ -467,6 +450,31 @@ std::vector<std::string> get_string_array_field(simdjson::ondemand::object &obj,
     return result;
 }
 
+// Trade ids arrive as numbers on SIP/IEX but are kept as strings in the models
+std::optional<std::string> get_id_field(simdjson::ondemand::object &obj, std::string_view key) {
+    auto field = obj.find_field_unordered(key);
+    if (field.error()) {
+        return std::nullopt;
+    }
+    auto value = field.value();
+    auto type = value.type();
+    if (type.error()) {
+        return std::nullopt;
+    }
+    if (type.value() == simdjson::ondemand::json_type::string) {
+        auto str = value.get_string();
+        if (!str.error()) {
+            return std::string(std::string_view(str.value()));
+        }
+    } else if (type.value() == simdjson::ondemand::json_type::number) {
+        auto number = value.get_int64();
+        if (!number.error()) {
+            return std::to_string(number.value());
+        }
+    }
+    return std::nullopt;
+}
+
 Trade parse_trade_from_websocket(simdjson::ondemand::object &obj) {
     Trade trade;
     trade.symbol = get_string_field(obj, "S");
@@ -474,29 +482,45 @@ Trade parse_trade_from_websocket(simdjson::ondemand::object &obj) {
     trade.price = get_double_field(obj, "p");
     trade.size = get_double_field(obj, "s");
     trade.exchange = get_string_field(obj, "x");
-    auto id_field = obj.find_field_unordered("i");
-    if (!id_field.error()) {
-        auto id_val = id_field.value();
-        if (id_val.type().error() == simdjson::SUCCESS) {
-            auto type = id_val.type().value();
-            if (type == simdjson::ondemand::json_type::string) {
-                auto id_str = id_val.get_string();
-                if (!id_str.error()) {
-                    trade.id = std::string(std::string_view(id_str.value()));
-                }
-            } else if (type == simdjson::ondemand::json_type::number) {
-                auto id_int = id_val.get_int64();
-                if (!id_int.error()) {
-                    trade.id = std::to_string(id_int.value());
-                }
-            }
-        }
-    }
+    trade.id = get_id_field(obj, "i");
     trade.conditions = get_string_array_field(obj, "c");
     trade.tape = get_string_field(obj, "z");
     return trade;
 }
 
+TradeCancel parse_trade_cancel_from_websocket(simdjson::ondemand::object &obj) {
+    TradeCancel cancel;
+    cancel.symbol = get_string_field(obj, "S");
+    cancel.timestamp = get_string_field(obj, "t");
+    cancel.exchange = get_string_field(obj, "x");
+    cancel.price = get_double_field(obj, "p");
+    cancel.size = get_double_field(obj, "s");
+    cancel.id = get_id_field(obj, "i");
+    auto action = get_string_field(obj, "a");
+    if (!action.empty()) {
+        cancel.action = action;
+    }
+    cancel.tape = get_string_field(obj, "z");
+    return cancel;
+}
+
+TradeCorrection parse_trade_correction_from_websocket(simdjson::ondemand::object &obj) {
+    TradeCorrection correction;
+    correction.symbol = get_string_field(obj, "S");
+    correction.timestamp = get_string_field(obj, "t");
+    correction.exchange = get_string_field(obj, "x");
+    correction.original_id = get_id_field(obj, "oi");
+    correction.original_price = get_double_field(obj, "op");
+    correction.original_size = get_double_field(obj, "os");
+    correction.original_conditions = get_string_array_field(obj, "oc");
+    correction.corrected_id = get_id_field(obj, "ci");
+    correction.corrected_price = get_double_field(obj, "cp");
+    correction.corrected_size = get_double_field(obj, "cs");
+    correction.corrected_conditions = get_string_array_field(obj, "cc");
+    correction.tape = get_string_field(obj, "z");
+    return correction;
+}
+
 Quote parse_quote_from_websocket(simdjson::ondemand::object &obj) {
     Quote quote;
     quote.symbol = get_string_field(obj, "S");
@@ -633,44 +657,149 @@ void StockDataStream::dispatch_message_impl(const std::string &message) {
         if (msg_type == "t") { // Trade
             if (auto it = trade_handlers_.find(symbol); it != trade_handlers_.end()) {
                 Trade trade = parse_trade_from_websocket(obj);
-                it->second(trade);
+                deliver(it->second, trade);
             } else if (auto it = trade_handlers_.find("*"); it != trade_handlers_.end()) {
                 Trade trade = parse_trade_from_websocket(obj);
-                it->second(trade);
+                deliver(it->second, trade);
             }
         } else if (msg_type == "q") { // Quote
             if (auto it = quote_handlers_.find(symbol); it != quote_handlers_.end()) {
                 Quote quote = parse_quote_from_websocket(obj);
-                it->second(quote);
+                deliver(it->second, quote);
             } else if (auto it = quote_handlers_.find("*"); it != quote_handlers_.end()) {
                 Quote quote = parse_quote_from_websocket(obj);
-                it->second(quote);
+                deliver(it->second, quote);
             }
-        } else if (msg_type == "b" || msg_type == "u" || msg_type == "d") { // Bar types
-            if (auto it = bar_handlers_.find(symbol); it != bar_handlers_.end()) {
+        } else if (auto *handlers = bar_handlers_for(msg_type)) { // Bar types
+            if (auto it = handlers->find(symbol); it != handlers->end()) {
                 Bar bar = parse_bar_from_websocket(obj);
-                it->second(bar);
-            } else if (auto it = bar_handlers_.find("*"); it != bar_handlers_.end()) {
+                deliver(it->second, bar);
+            } else if (auto it = handlers->find("*"); it != handlers->end()) {
                 Bar bar = parse_bar_from_websocket(obj);
-                it->second(bar);
+                deliver(it->second, bar);
             }
         } else if (msg_type == "s") { // Trading status
             if (auto it = status_handlers_.find(symbol); it != status_handlers_.end()) {
                 TradingStatus status = parse_trading_status_from_websocket(obj);
-                it->second(status);
+                deliver(it->second, status);
             } else if (auto it = status_handlers_.find("*"); it != status_handlers_.end()) {
                 TradingStatus status = parse_trading_status_from_websocket(obj);
-                it->second(status);
+                deliver(it->second, status);
             }
         } else if (msg_type == "c") { // Trade correction
             if (trade_correction_handler_) {
-                // TODO: Parse TradeCorrection
-                // trade_correction_handler_(correction);
+                TradeCorrection correction = parse_trade_correction_from_websocket(obj);
+                deliver(trade_correction_handler_, correction);
             }
         } else if (msg_type == "x") { // Trade cancel
             if (trade_cancel_handler_) {
-                // TODO: Parse TradeCancel
-                // trade_cancel_handler_(cancel);
+                TradeCancel cancel = parse_trade_cancel_from_websocket(obj);
+                deliver(trade_cancel_handler_, cancel);
+            }
+        }
+    }
+}
+
+namespace {
+constexpr int kBackfillPageLimit = 10000;
+
+template <typename Handlers>
+std::vector<std::string> backfill_symbols(const Handlers &handlers) {
+    std::vector<std::string> symbols;
+    for (const auto &[symbol, handler] : handlers) {
+        // Wildcard subscriptions cannot be expressed as a REST symbol list.
+        if (symbol != "*") {
+            symbols.push_back(symbol);
+        }
+    }
+    return symbols;
+}
+
+template <typename Handlers>
+const typename Handlers::mapped_type *find_handler(const Handlers &handlers,
+                                                   const std::string &symbol) {
+    if (auto it = handlers.find(symbol); it != handlers.end()) {
+        return &it->second;
+    }
+    if (auto it = handlers.find("*"); it != handlers.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+} // namespace
+
+void StockDataStream::backfill_impl(std::int64_t start_ns, std::int64_t end_ns) {
+    if (!backfill_client_) {
+        return;
+    }
+
+    struct Event {
+        std::int64_t timestamp;
+        std::size_t index;
+        bool is_bar;
+    };
+    std::vector<Trade> trades;
+    std::vector<Bar> bars;
+    std::vector<Event> events;
+
+    if (auto symbols = backfill_symbols(trade_handlers_); !symbols.empty()) {
+        StockTradesRequest request;
+        request.symbols = std::move(symbols);
+        request.start = core::format_timestamp_ns(start_ns);
+        request.end = core::format_timestamp_ns(end_ns);
+        request.limit = kBackfillPageLimit;
+        request.feed = feed_;
+        do {
+            auto page = backfill_client_->get_stock_trades(request);
+            for (auto &trade : page.trades) {
+                auto ts = core::parse_timestamp_ns(trade.timestamp);
+                if (ts && *ts >= start_ns && *ts <= end_ns) {
+                    events.push_back({*ts, trades.size(), false});
+                    trades.push_back(std::move(trade));
+                }
+            }
+            request.page_token = page.next_page_token;
+        } while (request.page_token && !request.page_token->empty());
+    }
+
+    if (auto symbols = backfill_symbols(bar_handlers_); !symbols.empty()) {
+        // Live minute bars are published when the minute closes, so order them by their end
+        // time and only replay bars that completed inside the window.
+        constexpr std::int64_t bar_length_ns = 60'000'000'000;
+        StockBarsRequest request;
+        request.symbols = std::move(symbols);
+        request.timeframe = TimeFrame::Minute();
+        request.start = core::format_timestamp_ns(start_ns - bar_length_ns);
+        request.end = core::format_timestamp_ns(end_ns);
+        request.limit = kBackfillPageLimit;
+        request.feed = feed_;
+        do {
+            auto page = backfill_client_->get_stock_bars(request);
+            for (auto &bar : page.bars) {
+                auto ts = core::parse_timestamp_ns(bar.timestamp);
+                if (ts && *ts + bar_length_ns > start_ns && *ts + bar_length_ns <= end_ns) {
+                    events.push_back({*ts + bar_length_ns, bars.size(), true});
+                    bars.push_back(std::move(bar));
+                }
+            }
+            request.page_token = page.next_page_token;
+        } while (request.page_token && !request.page_token->empty());
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const Event &lhs, const Event &rhs) {
+        return lhs.timestamp < rhs.timestamp;
+    });
+
+    for (const auto &event : events) {
+        if (event.is_bar) {
+            const auto &bar = bars[event.index];
+            if (const auto *handler = find_handler(bar_handlers_, bar.symbol)) {
+                (*handler)(bar);
+            }
+        } else {
+            const auto &trade = trades[event.index];
+            if (const auto *handler = find_handler(trade_handlers_, trade.symbol)) {
+                (*handler)(trade);
             }
         }
     }
@@ -679,7 +808,10 @@ void StockDataStream::dispatch_message_impl(const std::string &message) {
 void StockDataStream::close_impl() {
     if (pimpl_->ws_) {
         boost::system::error_code ec;
-        pimpl_->ws_->close(websocket::close_code::normal, ec);
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->write_mutex_);
+            pimpl_->ws_->close(websocket::close_code::normal, ec);
+        }
         pimpl_->ws_.reset();
     }
 }
@@ -1,6 +1,11 @@
 #include "alpaca/data/live/websocket.hpp"
 
+#include "alpaca/core/thread.hpp"
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
 #include <chrono>
+#include <random>
 #include <stdexcept>
 #include <thread>
 
@@ -12,7 +17,16 @@ DataStream::DataStream(std::string endpoint, std::string api_key, std::string se
       secret_key_(std::move(secret_key)), raw_data_(raw_data) {}
 
 DataStream::~DataStream() {
-    stop();
+    // Derived destructors call stop() while close_impl() can still be dispatched; by the time
+    // the base is destroyed only the worker thread may remain to be joined.
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+        should_run_ = false;
+    }
+    reconnect_cv_.notify_all();
+    if (worker_thread_ && worker_thread_->joinable()) {
+        worker_thread_->join();
+    }
 }
 
 void DataStream::run() {
@@ -23,29 +37,206 @@ void DataStream::run() {
     worker_thread_ = std::make_unique<std::thread>(&DataStream::run_loop, this);
 }
 
+void DataStream::set_reconnect_policy(core::ReconnectPolicy policy) {
+    reconnect_policy_ = policy;
+}
+
+const core::ReconnectPolicy &DataStream::reconnect_policy() const noexcept {
+    return reconnect_policy_;
+}
+
+void DataStream::enable_backfill(std::shared_ptr<const DataClient> client,
+                                 BackfillOptions options) {
+    backfill_client_ = std::move(client);
+    backfill_options_ = options;
+}
+
+void DataStream::enable_low_latency(LowLatencyOptions options) {
+    low_latency_ = options;
+}
+
+void DataStream::enable_heartbeat(core::HeartbeatOptions options) {
+    heartbeat_ = std::make_unique<core::Heartbeat>(options);
+}
+
+const core::Heartbeat *DataStream::heartbeat() const noexcept {
+    return heartbeat_.get();
+}
+
+void DataStream::enable_latency_stats() {
+    if (!latency_stats_) {
+        latency_stats_ = std::make_unique<core::StreamLatencyStats>();
+    }
+}
+
+core::StreamLatencyStats *DataStream::latency_stats() const noexcept {
+    return latency_stats_.get();
+}
+
+void DataStream::enable_frame_recording(const std::string &path) {
+    frame_recorder_ = std::make_unique<core::FrameLogWriter>(path);
+}
+
+core::FrameLogWriter *DataStream::frame_recorder() const noexcept {
+    return frame_recorder_.get();
+}
+
+std::size_t DataStream::replay_frames(const core::FrameLogReader &log, double speed,
+                                      std::size_t first) {
+    if (worker_thread_ && worker_thread_->joinable()) {
+        throw std::logic_error("DataStream: replay_frames() while the stream is running");
+    }
+    should_run_ = true;
+    std::string message;
+    return log.replay(
+        [&](const core::RecordedFrame &frame) {
+            mark_frame_received();
+            message.assign(frame.data);
+            dispatch_message_impl(message);
+        },
+        speed, first, &should_run_);
+}
+
+void DataStream::backfill_impl(std::int64_t start_ns, std::int64_t end_ns) {
+    (void)start_ns;
+    (void)end_ns;
+}
+
+std::unordered_map<std::string, BarHandler> *DataStream::bar_handlers_for(std::string_view msg_type) {
+    if (msg_type == "b") {
+        return &bar_handlers_;
+    }
+    if (msg_type == "u") {
+        return &updated_bar_handlers_;
+    }
+    if (msg_type == "d") {
+        return &daily_bar_handlers_;
+    }
+    return nullptr;
+}
+
+namespace {
+// Appends ,"<channel>":["SYM",...] to a message opened by {"action":"...".
+void append_channel(std::string &msg, std::string_view channel,
+                    const std::vector<std::string> &symbols) {
+    msg += ",\"";
+    msg += channel;
+    msg += "\":[";
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        if (i > 0) {
+            msg += ',';
+        }
+        msg += '"';
+        msg += symbols[i];
+        msg += '"';
+    }
+    msg += ']';
+}
+} // namespace
+
+std::string DataStream::build_subscription_message(std::string_view action,
+                                                   const std::string &channel,
+                                                   const std::vector<std::string> &symbols) {
+    std::string msg;
+    msg.reserve(32 + channel.size() + symbols.size() * 8);
+    msg += "{\"action\":\"";
+    msg += action;
+    msg += '"';
+    append_channel(msg, channel, symbols);
+    msg += '}';
+    return msg;
+}
+
+std::string DataStream::build_subscription_message(std::string_view action,
+                                                   const std::vector<ChannelSymbols> &channels) {
+    std::string msg = "{\"action\":\"";
+    msg += action;
+    msg += '"';
+    for (const auto &[channel, symbols] : channels) {
+        if (!symbols.empty()) {
+            append_channel(msg, channel, symbols);
+        }
+    }
+    msg += '}';
+    return msg;
+}
+
 void DataStream::run_loop() {
+    if (low_latency_ && low_latency_->cpu) {
+        // Best effort: an unavailable CPU leaves the thread unpinned rather than failing.
+        (void)core::pin_current_thread_to_cpu(*low_latency_->cpu);
+    }
+    std::minstd_rand rng{std::random_device{}()};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+    std::size_t attempt = 0;
+    bool connected_before = false;
+
     while (should_run_) {
         try {
             if (!running_) {
                 connect_impl();
                 authenticate_impl();
+                // Resubscribe the full handler set before backfilling so live frames queue up
+                // on the socket while missed history is replayed.
                 send_subscribe_message_impl();
                 running_ = true;
+                run_backfill(connected_before);
+                connected_before = true;
+                last_message_ns_ = core::now_ns();
             }
             consume_messages_impl();
+            last_message_ns_ = core::now_ns();
+            attempt = 0;
         } catch (const std::exception &e) {
             running_ = false;
             close_impl();
             if (should_run_) {
-                // Wait a bit before reconnecting
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+                wait_for_reconnect(core::reconnect_delay(reconnect_policy_, attempt++, unit(rng)));
             }
         }
     }
 }
 
+void DataStream::run_backfill(bool reconnect) {
+    if (!backfill_client_) {
+        return;
+    }
+
+    const std::int64_t now = core::now_ns();
+    std::int64_t start = 0;
+    if (reconnect) {
+        start = last_message_ns_;
+    } else if (backfill_options_.warmup.count() > 0) {
+        start = now - std::chrono::duration_cast<std::chrono::nanoseconds>(backfill_options_.warmup)
+                          .count();
+    } else {
+        return;
+    }
+    const auto max_gap =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(backfill_options_.max_gap).count();
+    start = std::max(start, now - max_gap);
+    if (start >= now) {
+        return;
+    }
+
+    try {
+        backfill_impl(start, now);
+    } catch (const std::exception &e) {
+        // A failed REST backfill leaves the gap unfilled instead of keeping the stream down.
+    }
+}
+
+void DataStream::wait_for_reconnect(std::chrono::milliseconds delay) {
+    std::unique_lock<std::mutex> lock(reconnect_mutex_);
+    reconnect_cv_.wait_for(lock, delay, [this] { return !should_run_; });
+}
+
 void DataStream::stop() {
-    should_run_ = false;
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+        should_run_ = false;
+    }
+    reconnect_cv_.notify_all();
     close();
     if (worker_thread_ && worker_thread_->joinable()) {
         worker_thread_->join();
@@ -58,4 +249,3 @@ void DataStream::close() {
 }
 
 } // namespace alpaca::data::live
-
@@ -0,0 +1,224 @@
+#include "alpaca/data/option_chain.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+template <typename T>
+void permute(std::vector<T> &column, const std::vector<std::uint32_t> &order) {
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for (auto index : order) {
+        sorted.push_back(std::move(column[index]));
+    }
+    column = std::move(sorted);
+}
+
+} // namespace
+
+OptionChain::OptionChain(std::string underlying) : underlying_(std::move(underlying)) {}
+
+void OptionChain::add(const OptionsSnapshot &snapshot) {
+    const auto occ = trading::parse_occ_symbol(snapshot.symbol);
+    if (!occ) {
+        return;
+    }
+    symbol.push_back(snapshot.symbol);
+    contract_key.push_back(trading::encode_option_key(*occ).value_or(0));
+    expiry_days.push_back(occ->expiry_days);
+    strike.push_back(occ->strike());
+    type.push_back(occ->type);
+    bid.push_back(snapshot.latest_quote ? snapshot.latest_quote->bid_price : kMissing);
+    ask.push_back(snapshot.latest_quote ? snapshot.latest_quote->ask_price : kMissing);
+    last_price.push_back(snapshot.latest_trade ? snapshot.latest_trade->price : kMissing);
+    implied_volatility.push_back(snapshot.implied_volatility.value_or(kMissing));
+    const OptionsGreeks greeks = snapshot.greeks.value_or(OptionsGreeks{});
+    delta.push_back(greeks.delta.value_or(kMissing));
+    gamma.push_back(greeks.gamma.value_or(kMissing));
+    theta.push_back(greeks.theta.value_or(kMissing));
+    vega.push_back(greeks.vega.value_or(kMissing));
+    rho.push_back(greeks.rho.value_or(kMissing));
+}
+
+void OptionChain::add(const OptionsSnapshotResponse &response) {
+    for (const auto &snapshot : response.snapshots) {
+        add(snapshot);
+    }
+}
+
+void OptionChain::build_index() {
+    const auto key = [this](std::uint32_t i) {
+        return std::make_tuple(expiry_days[i], strike[i], type[i]);
+    };
+    std::vector<std::uint32_t> order(size());
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return key(a) < key(b); });
+    // Keep the last of each run of duplicates, i.e. the most recently added snapshot.
+    std::vector<std::uint32_t> unique;
+    unique.reserve(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() && key(order[i]) == key(order[i + 1])) {
+            continue;
+        }
+        unique.push_back(order[i]);
+    }
+
+    permute(symbol, unique);
+    permute(contract_key, unique);
+    permute(expiry_days, unique);
+    permute(strike, unique);
+    permute(type, unique);
+    permute(bid, unique);
+    permute(ask, unique);
+    permute(last_price, unique);
+    permute(implied_volatility, unique);
+    permute(delta, unique);
+    permute(gamma, unique);
+    permute(theta, unique);
+    permute(vega, unique);
+    permute(rho, unique);
+
+    strikes_.clear();
+    expiries_.clear();
+    for (std::uint32_t i = 0; i < size(); ++i) {
+        if (expiries_.empty() || expiries_.back().days != expiry_days[i]) {
+            const auto first = static_cast<std::uint32_t>(strikes_.size());
+            expiries_.push_back(Expiry{expiry_days[i], first, first});
+        }
+        auto &expiry = expiries_.back();
+        if (expiry.last_strike == expiry.first_strike || strikes_.back().strike != strike[i]) {
+            strikes_.push_back(StrikeRow{strike[i], npos, npos});
+            ++expiry.last_strike;
+        }
+        (type[i] == trading::ContractType::Call ? strikes_.back().call : strikes_.back().put) = i;
+    }
+}
+
+const OptionChain::Expiry *OptionChain::find_expiry(std::int32_t days) const noexcept {
+    auto it = std::lower_bound(
+        expiries_.begin(), expiries_.end(), days,
+        [](const Expiry &expiry, std::int32_t value) { return expiry.days < value; });
+    return it != expiries_.end() && it->days == days ? &*it : nullptr;
+}
+
+const OptionChain::Expiry *OptionChain::nearest_expiry(std::int32_t days) const noexcept {
+    if (expiries_.empty()) {
+        return nullptr;
+    }
+    auto it = std::lower_bound(
+        expiries_.begin(), expiries_.end(), days,
+        [](const Expiry &expiry, std::int32_t value) { return expiry.days < value; });
+    if (it == expiries_.end()) {
+        return &expiries_.back();
+    }
+    if (it != expiries_.begin() && days - std::prev(it)->days < it->days - days) {
+        return &*std::prev(it);
+    }
+    return &*it;
+}
+
+std::span<const OptionChain::StrikeRow>
+OptionChain::strikes(const Expiry &expiry) const noexcept {
+    return std::span<const StrikeRow>(strikes_).subspan(expiry.first_strike,
+                                                        expiry.last_strike - expiry.first_strike);
+}
+
+std::span<const OptionChain::StrikeRow>
+OptionChain::strikes_between(const Expiry &expiry, double low, double high) const noexcept {
+    const auto rows = strikes(expiry);
+    auto first = std::lower_bound(
+        rows.begin(), rows.end(), low,
+        [](const StrikeRow &row, double value) { return row.strike < value; });
+    auto last = std::upper_bound(
+        first, rows.end(), high,
+        [](double value, const StrikeRow &row) { return value < row.strike; });
+    return rows.subspan(static_cast<std::size_t>(first - rows.begin()),
+                        static_cast<std::size_t>(last - first));
+}
+
+std::optional<std::size_t> OptionChain::find(std::int32_t days, double strike_price,
+                                             trading::ContractType side) const noexcept {
+    const auto *expiry = find_expiry(days);
+    if (!expiry) {
+        return std::nullopt;
+    }
+    const auto rows = strikes_between(*expiry, strike_price, strike_price);
+    if (rows.empty()) {
+        return std::nullopt;
+    }
+    const auto row = side == trading::ContractType::Call ? rows.front().call : rows.front().put;
+    if (row == npos) {
+        return std::nullopt;
+    }
+    return row;
+}
+
+OptionChain fetch_option_chain(const DataClient &client, OptionChainRequest request,
+                               const OptionChainFetchOptions &options) {
+    if (!request.limit) {
+        request.limit = options.page_limit;
+    }
+    OptionChain chain(request.underlying_symbol);
+    while (true) {
+        auto page = client.get_option_chain(request);
+        chain.add(page);
+        if (!page.next_page_token || page.next_page_token->empty()) {
+            break;
+        }
+        request.page_token = std::move(page.next_page_token);
+    }
+    chain.build_index();
+    return chain;
+}
+
+std::vector<OptionChain> fetch_option_chains(const DataClient &client,
+                                             const std::vector<OptionChainRequest> &requests,
+                                             const OptionChainFetchOptions &options) {
+    std::vector<OptionChain> chains(requests.size());
+    std::vector<std::exception_ptr> errors(requests.size());
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < requests.size(); i = next.fetch_add(1)) {
+            try {
+                chains[i] = fetch_option_chain(client, requests[i], options);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t thread_count =
+        std::min(std::max<std::size_t>(options.max_concurrency, 1), requests.size());
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count > 0 ? thread_count - 1 : 0);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return chains;
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,183 @@
+#include "alpaca/data/order_book.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace alpaca::data {
+
+namespace {
+
+// Sets the size at `level.price` in a side kept sorted by `before` (best price at the back).
+template <typename Compare>
+void apply_level(std::vector<OrderbookQuote> &side, const OrderbookQuote &level, Compare before) {
+    auto it = std::lower_bound(side.begin(), side.end(), level.price,
+                               [&](const OrderbookQuote &existing, double price) {
+                                   return before(existing.price, price);
+                               });
+    const bool found = it != side.end() && it->price == level.price;
+    if (level.size <= 0.0) {
+        if (found) {
+            side.erase(it);
+        }
+    } else if (found) {
+        it->size = level.size;
+    } else {
+        side.insert(it, level);
+    }
+}
+
+template <typename Compare>
+void replace_side(std::vector<OrderbookQuote> &side, const std::vector<OrderbookQuote> &levels,
+                  Compare before) {
+    side.clear();
+    for (const auto &level : levels) {
+        if (level.size > 0.0) {
+            side.push_back(level);
+        }
+    }
+    std::stable_sort(side.begin(), side.end(), [&](const OrderbookQuote &a, const OrderbookQuote &b) {
+        return before(a.price, b.price);
+    });
+    // Keep the last occurrence of a duplicated price, matching delta semantics.
+    auto last = std::unique(side.rbegin(), side.rend(),
+                            [](const OrderbookQuote &a, const OrderbookQuote &b) {
+                                return a.price == b.price;
+                            });
+    side.erase(side.begin(), last.base());
+}
+
+std::optional<OrderbookQuote> level_from_top(const std::vector<OrderbookQuote> &side,
+                                             std::size_t n) noexcept {
+    if (n >= side.size()) {
+        return std::nullopt;
+    }
+    return side[side.size() - 1 - n];
+}
+
+double size_from_top(const std::vector<OrderbookQuote> &side, std::size_t levels) noexcept {
+    const std::size_t count = std::min(levels, side.size());
+    double total = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += side[side.size() - 1 - i].size;
+    }
+    return total;
+}
+
+} // namespace
+
+OrderBook::OrderBook(std::string symbol) : symbol_(std::move(symbol)) {}
+
+void OrderBook::apply(const Orderbook &update) {
+    if (symbol_.empty()) {
+        symbol_ = update.symbol;
+    }
+    if (!update.timestamp.empty()) {
+        timestamp_ = update.timestamp;
+    }
+    if (update.reset) {
+        replace_side(bids_, update.bids, std::less<double>{});
+        replace_side(asks_, update.asks, std::greater<double>{});
+        return;
+    }
+    for (const auto &level : update.bids) {
+        apply_level(bids_, level, std::less<double>{});
+    }
+    for (const auto &level : update.asks) {
+        apply_level(asks_, level, std::greater<double>{});
+    }
+}
+
+void OrderBook::clear() {
+    bids_.clear();
+    asks_.clear();
+    timestamp_.clear();
+}
+
+std::optional<OrderbookQuote> OrderBook::bid(std::size_t n) const noexcept {
+    return level_from_top(bids_, n);
+}
+
+std::optional<OrderbookQuote> OrderBook::ask(std::size_t n) const noexcept {
+    return level_from_top(asks_, n);
+}
+
+double OrderBook::bid_size(std::size_t levels) const noexcept {
+    return size_from_top(bids_, levels);
+}
+
+double OrderBook::ask_size(std::size_t levels) const noexcept {
+    return size_from_top(asks_, levels);
+}
+
+std::optional<double> OrderBook::mid() const noexcept {
+    if (bids_.empty() || asks_.empty()) {
+        return std::nullopt;
+    }
+    return (bids_.back().price + asks_.back().price) / 2.0;
+}
+
+std::optional<double> OrderBook::spread() const noexcept {
+    if (bids_.empty() || asks_.empty()) {
+        return std::nullopt;
+    }
+    return asks_.back().price - bids_.back().price;
+}
+
+std::optional<double> OrderBook::microprice() const noexcept {
+    if (bids_.empty() || asks_.empty()) {
+        return std::nullopt;
+    }
+    const auto &best_bid = bids_.back();
+    const auto &best_ask = asks_.back();
+    const double total = best_bid.size + best_ask.size;
+    return (best_bid.price * best_ask.size + best_ask.price * best_bid.size) / total;
+}
+
+std::optional<double> OrderBook::imbalance(std::size_t levels) const noexcept {
+    const double bids = bid_size(levels);
+    const double asks = ask_size(levels);
+    if (bids + asks <= 0.0) {
+        return std::nullopt;
+    }
+    return (bids - asks) / (bids + asks);
+}
+
+OrderBook &OrderBookSet::apply(const Orderbook &update) {
+    auto it = books_.find(std::string_view(update.symbol));
+    if (it == books_.end()) {
+        it = books_.emplace(update.symbol, OrderBook(update.symbol)).first;
+    }
+    it->second.apply(update);
+    return it->second;
+}
+
+void OrderBookSet::seed(const CryptoLatestOrderbookResponse &snapshot) {
+    for (const auto &book : snapshot.orderbooks) {
+        Orderbook reset = book;
+        reset.reset = true;
+        apply(reset);
+    }
+}
+
+void OrderBookSet::seed(const DataClient &client, const std::vector<std::string> &symbols,
+                        CryptoFeed feed) {
+    CryptoLatestOrderbookRequest request;
+    request.symbols = symbols;
+    seed(client.get_crypto_latest_orderbooks(request, feed));
+}
+
+const OrderBook *OrderBookSet::find(std::string_view symbol) const {
+    auto it = books_.find(symbol);
+    return it == books_.end() ? nullptr : &it->second;
+}
+
+std::function<void(const Orderbook &)> OrderBookSet::updater(UpdateCallback on_update) {
+    return [this, on_update = std::move(on_update)](const Orderbook &update) {
+        const OrderBook &book = apply(update);
+        if (on_update) {
+            on_update(book);
+        }
+    };
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,296 @@
+#include "alpaca/data/resample.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr std::int64_t kNanosPerSecond = 1'000'000'000;
+constexpr std::int64_t kNanosPerDay = 86'400 * kNanosPerSecond;
+constexpr std::int64_t kDropped = std::numeric_limits<std::int64_t>::min();
+
+std::int64_t floor_div(std::int64_t value, std::int64_t step) noexcept {
+    std::int64_t q = value / step;
+    if (value % step != 0 && value < 0) {
+        --q;
+    }
+    return q;
+}
+
+std::int64_t first_sunday_on_or_after(std::int64_t days) noexcept {
+    return days + (7 - core::weekday_from_days(days)) % 7;
+}
+
+// US daylight saving time (since 2007): second Sunday of March to first Sunday of November.
+// Sessions never touch the 02:00 switch, so whole days are classified.
+bool is_us_dst(std::int64_t days) noexcept {
+    std::int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    core::civil_from_days(days, year, month, day);
+    const auto start = first_sunday_on_or_after(core::days_from_civil(year, 3, 1)) + 7;
+    const auto end = first_sunday_on_or_after(core::days_from_civil(year, 11, 1));
+    return days >= start && days < end;
+}
+
+std::int64_t eastern_to_utc_ns(std::int64_t days, int minutes) noexcept {
+    const std::int64_t offset_hours = is_us_dst(days) ? 4 : 5;
+    return (days * 86'400 + minutes * 60 + offset_hours * 3'600) * kNanosPerSecond;
+}
+
+int parse_clock_minutes(std::string_view text) {
+    std::string digits;
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            digits.push_back(c);
+        } else if (c != ':') {
+            throw std::invalid_argument("invalid session time: " + std::string(text));
+        }
+    }
+    if (digits.size() != 4) {
+        throw std::invalid_argument("invalid session time: " + std::string(text));
+    }
+    const int hours = std::stoi(digits.substr(0, 2));
+    const int minutes = std::stoi(digits.substr(2, 2));
+    if (hours > 24 || minutes > 59) {
+        throw std::invalid_argument("invalid session time: " + std::string(text));
+    }
+    return hours * 60 + minutes;
+}
+
+std::int64_t monday_of(std::int64_t days) noexcept {
+    return days - (core::weekday_from_days(days) + 6) % 7;
+}
+
+std::int64_t interval_ns(const TimeFrame &target) {
+    switch (target.unit) {
+        case TimeFrameUnit::Minute:
+            return target.amount * 60 * kNanosPerSecond;
+        case TimeFrameUnit::Hour:
+            return target.amount * 3'600 * kNanosPerSecond;
+        default:
+            return 0;
+    }
+}
+
+// Month bucket (year * 12 + first month index of the group) and its first day.
+std::pair<std::int64_t, std::int64_t> month_bucket(std::int64_t days, int amount) noexcept {
+    std::int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    core::civil_from_days(days, year, month, day);
+    const auto group = static_cast<unsigned>(amount);
+    const auto first_month = (month - 1) / group * group;
+    return {year * 12 + first_month, core::days_from_civil(year, first_month + 1, 1)};
+}
+
+} // namespace
+
+void BarColumns::reserve(std::size_t count) {
+    timestamp_ns.reserve(count);
+    open.reserve(count);
+    high.reserve(count);
+    low.reserve(count);
+    close.reserve(count);
+    volume.reserve(count);
+    vwap.reserve(count);
+    trade_count.reserve(count);
+}
+
+void BarColumns::push_back(const Bar &bar) {
+    const auto timestamp = core::parse_timestamp_ns(bar.timestamp);
+    if (!timestamp) {
+        return;
+    }
+    timestamp_ns.push_back(*timestamp);
+    open.push_back(bar.open);
+    high.push_back(bar.high);
+    low.push_back(bar.low);
+    close.push_back(bar.close);
+    volume.push_back(bar.volume);
+    vwap.push_back(bar.vwap.value_or(std::numeric_limits<double>::quiet_NaN()));
+    trade_count.push_back(bar.trade_count.value_or(0.0));
+}
+
+BarColumns BarColumns::from_bars(const std::vector<Bar> &bars, std::string_view symbol) {
+    std::vector<const Bar *> selected;
+    std::vector<std::int64_t> times;
+    for (const auto &bar : bars) {
+        if (bar.symbol != symbol) {
+            continue;
+        }
+        if (auto timestamp = core::parse_timestamp_ns(bar.timestamp)) {
+            selected.push_back(&bar);
+            times.push_back(*timestamp);
+        }
+    }
+    std::vector<std::size_t> order(selected.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) { return times[a] < times[b]; });
+
+    BarColumns columns;
+    columns.symbol = std::string(symbol);
+    columns.reserve(order.size());
+    for (auto index : order) {
+        columns.push_back(*selected[index]);
+    }
+    return columns;
+}
+
+std::vector<Bar> BarColumns::to_bars() const {
+    std::vector<Bar> bars;
+    bars.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        Bar bar;
+        bar.symbol = symbol;
+        bar.timestamp = core::format_timestamp_ns(timestamp_ns[i]);
+        bar.open = open[i];
+        bar.high = high[i];
+        bar.low = low[i];
+        bar.close = close[i];
+        bar.volume = volume[i];
+        if (!std::isnan(vwap[i])) {
+            bar.vwap = vwap[i];
+        }
+        bar.trade_count = trade_count[i];
+        bars.push_back(std::move(bar));
+    }
+    return bars;
+}
+
+TradingSession TradingSession::from_calendar(std::string_view date, std::string_view open,
+                                             std::string_view close) {
+    const auto midnight = core::parse_timestamp_ns(std::string(date) + "T00:00:00Z");
+    if (date.size() != 10 || !midnight) {
+        throw std::invalid_argument("invalid session date: " + std::string(date));
+    }
+    const std::int64_t days = *midnight / kNanosPerDay;
+    TradingSession session;
+    session.day_ns = eastern_to_utc_ns(days, 0);
+    session.open_ns = eastern_to_utc_ns(days, parse_clock_minutes(open));
+    session.close_ns = eastern_to_utc_ns(days, parse_clock_minutes(close));
+    session.extended_open_ns = eastern_to_utc_ns(days, 4 * 60);
+    session.extended_close_ns = eastern_to_utc_ns(days, 20 * 60);
+    return session;
+}
+
+BarColumns resample(const BarColumns &bars, const TimeFrame &target,
+                    const ResampleOptions &options) {
+    if ((target.unit == TimeFrameUnit::Day || target.unit == TimeFrameUnit::Week) &&
+        target.amount != 1) {
+        throw std::invalid_argument("resample supports only 1Day and 1Week, got " +
+                                    target.serialize());
+    }
+    const std::size_t n = bars.size();
+    const std::int64_t step = interval_ns(target);
+    const bool regular = options.hours == SessionHours::Regular;
+    const auto &sessions = options.sessions;
+
+    // Pass 1: bucket key and output timestamp for every source bar.
+    std::vector<std::int64_t> key(n, kDropped);
+    std::vector<std::int64_t> label(n, kDropped);
+    std::size_t s = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::int64_t ts = bars.timestamp_ns[i];
+        std::int64_t anchor = 0;
+        std::int64_t day_label = floor_div(ts, kNanosPerDay) * kNanosPerDay;
+        if (!sessions.empty()) {
+            while (s < sessions.size() &&
+                   ts >= (regular ? sessions[s].close_ns : sessions[s].extended_close_ns)) {
+                ++s;
+            }
+            if (s == sessions.size() ||
+                ts < (regular ? sessions[s].open_ns : sessions[s].extended_open_ns)) {
+                continue;
+            }
+            if (options.align_to_session_open) {
+                anchor = regular ? sessions[s].open_ns : sessions[s].extended_open_ns;
+            }
+            day_label = sessions[s].day_ns;
+        }
+        const std::int64_t days = floor_div(day_label, kNanosPerDay);
+        switch (target.unit) {
+            case TimeFrameUnit::Minute:
+            case TimeFrameUnit::Hour:
+                label[i] = anchor + floor_div(ts - anchor, step) * step;
+                key[i] = label[i];
+                break;
+            case TimeFrameUnit::Day:
+                label[i] = day_label;
+                key[i] = day_label;
+                break;
+            case TimeFrameUnit::Week:
+                key[i] = monday_of(days);
+                label[i] = sessions.empty() ? key[i] * kNanosPerDay : day_label;
+                break;
+            case TimeFrameUnit::Month: {
+                const auto [bucket, first_day] = month_bucket(days, target.amount);
+                key[i] = bucket;
+                label[i] = sessions.empty() ? first_day * kNanosPerDay : day_label;
+                break;
+            }
+        }
+    }
+
+    // Pass 2: reduce each run of equal keys over the kept bars. Bars dropped between two
+    // sessions do not split a Week or Month bucket.
+    std::vector<std::size_t> kept;
+    kept.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (key[i] != kDropped) {
+            kept.push_back(i);
+        }
+    }
+
+    BarColumns out;
+    out.symbol = bars.symbol;
+    std::size_t k = 0;
+    while (k < kept.size()) {
+        const std::size_t first = kept[k];
+        std::size_t end = k + 1;
+        while (end < kept.size() && key[kept[end]] == key[first]) {
+            ++end;
+        }
+
+        double high = bars.high[first];
+        double low = bars.low[first];
+        double volume = 0.0;
+        double notional = 0.0;
+        double priced_volume = 0.0; // volume of the bars that carry a vwap
+        double trades = 0.0;
+        for (std::size_t j = k; j < end; ++j) {
+            const std::size_t row = kept[j];
+            high = std::max(high, bars.high[row]);
+            low = std::min(low, bars.low[row]);
+            volume += bars.volume[row];
+            if (!std::isnan(bars.vwap[row])) {
+                notional += bars.vwap[row] * bars.volume[row];
+                priced_volume += bars.volume[row];
+            }
+            trades += bars.trade_count[row];
+        }
+
+        out.timestamp_ns.push_back(label[first]);
+        out.open.push_back(bars.open[first]);
+        out.high.push_back(high);
+        out.low.push_back(low);
+        out.close.push_back(bars.close[kept[end - 1]]);
+        out.volume.push_back(volume);
+        out.vwap.push_back(priced_volume > 0.0 ? notional / priced_volume
+                                               : std::numeric_limits<double>::quiet_NaN());
+        out.trade_count.push_back(trades);
+        k = end;
+    }
+    return out;
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,231 @@
+#include "alpaca/data/snapshot_sweep.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+
+#include <simdjson/ondemand.h>
+#include <simdjson/padded_string_view-inl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+template <typename T> void move_append(std::vector<T> &to, std::vector<T> &from) {
+    to.insert(to.end(), std::make_move_iterator(from.begin()),
+              std::make_move_iterator(from.end()));
+}
+
+void read_double(simdjson::ondemand::object &object, std::string_view key, double &out) {
+    if (auto value = object.find_field_unordered(key); !value.error()) {
+        double parsed{};
+        if (!value.get_double().get(parsed)) {
+            out = parsed;
+        }
+    }
+}
+
+void read_timestamp(simdjson::ondemand::object &object, std::int64_t &out) {
+    if (auto value = object.find_field_unordered("t"); !value.error()) {
+        std::string_view text;
+        if (!value.get_string().get(text)) {
+            out = core::parse_timestamp_ns(text).value_or(0);
+        }
+    }
+}
+
+template <typename Fn>
+void with_object(simdjson::ondemand::object &parent, std::string_view key, Fn &&fn) {
+    if (auto field = parent.find_field_unordered(key); !field.error()) {
+        if (auto object = field.get_object(); !object.error()) {
+            fn(object.value());
+        }
+    }
+}
+
+} // namespace
+
+std::optional<std::size_t> SnapshotTable::index_of(std::string_view name) const {
+    if (auto it = index_.find(name); it != index_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void SnapshotTable::add_row() {
+    trade_ns.push_back(0);
+    trade_price.push_back(kMissing);
+    trade_size.push_back(kMissing);
+    quote_ns.push_back(0);
+    bid_price.push_back(kMissing);
+    bid_size.push_back(kMissing);
+    ask_price.push_back(kMissing);
+    ask_size.push_back(kMissing);
+    minute_close.push_back(kMissing);
+    minute_volume.push_back(kMissing);
+    daily_open.push_back(kMissing);
+    daily_high.push_back(kMissing);
+    daily_low.push_back(kMissing);
+    daily_close.push_back(kMissing);
+    daily_volume.push_back(kMissing);
+    prev_close.push_back(kMissing);
+    prev_volume.push_back(kMissing);
+}
+
+void SnapshotTable::append_json(std::string_view payload) {
+    simdjson::ondemand::parser parser;
+    std::string storage(payload);
+    storage.append(simdjson::SIMDJSON_PADDING, '\0');
+    auto doc = parser.iterate(storage.data(), payload.size(), storage.size());
+    auto root = doc.get_object();
+    if (root.error()) {
+        throw std::runtime_error("Invalid snapshots payload");
+    }
+
+    auto read_snapshot = [&](std::string_view name, simdjson::ondemand::object snapshot) {
+        const std::size_t row = size();
+        symbol.emplace_back(name);
+        index_.emplace(symbol.back(), row);
+        add_row();
+        with_object(snapshot, "latestTrade", [&](simdjson::ondemand::object &trade) {
+            read_timestamp(trade, trade_ns[row]);
+            read_double(trade, "p", trade_price[row]);
+            read_double(trade, "s", trade_size[row]);
+        });
+        with_object(snapshot, "latestQuote", [&](simdjson::ondemand::object &quote) {
+            read_timestamp(quote, quote_ns[row]);
+            read_double(quote, "bp", bid_price[row]);
+            read_double(quote, "bs", bid_size[row]);
+            read_double(quote, "ap", ask_price[row]);
+            read_double(quote, "as", ask_size[row]);
+        });
+        with_object(snapshot, "minuteBar", [&](simdjson::ondemand::object &bar) {
+            read_double(bar, "c", minute_close[row]);
+            read_double(bar, "v", minute_volume[row]);
+        });
+        with_object(snapshot, "dailyBar", [&](simdjson::ondemand::object &bar) {
+            read_double(bar, "o", daily_open[row]);
+            read_double(bar, "h", daily_high[row]);
+            read_double(bar, "l", daily_low[row]);
+            read_double(bar, "c", daily_close[row]);
+            read_double(bar, "v", daily_volume[row]);
+        });
+        with_object(snapshot, "prevDailyBar", [&](simdjson::ondemand::object &bar) {
+            read_double(bar, "c", prev_close[row]);
+            read_double(bar, "v", prev_volume[row]);
+        });
+    };
+
+    // Snapshots are keyed by symbol, either at the top level or under "snapshots".
+    for (auto field : root.value()) {
+        std::string_view key;
+        if (field.unescaped_key().get(key)) {
+            continue;
+        }
+        auto object = field.value().get_object();
+        if (object.error()) {
+            continue;
+        }
+        if (key == "snapshots") {
+            for (auto entry : object.value()) {
+                std::string_view name;
+                if (entry.unescaped_key().get(name)) {
+                    continue;
+                }
+                std::string owned_name(name);
+                if (auto snapshot = entry.value().get_object(); !snapshot.error()) {
+                    read_snapshot(owned_name, snapshot.value());
+                }
+            }
+        } else {
+            read_snapshot(std::string(key), object.value());
+        }
+    }
+}
+
+void SnapshotTable::append(SnapshotTable &&other) {
+    const std::size_t offset = size();
+    for (std::size_t i = 0; i < other.size(); ++i) {
+        index_.emplace(other.symbol[i], offset + i);
+    }
+    move_append(symbol, other.symbol);
+    move_append(trade_ns, other.trade_ns);
+    move_append(trade_price, other.trade_price);
+    move_append(trade_size, other.trade_size);
+    move_append(quote_ns, other.quote_ns);
+    move_append(bid_price, other.bid_price);
+    move_append(bid_size, other.bid_size);
+    move_append(ask_price, other.ask_price);
+    move_append(ask_size, other.ask_size);
+    move_append(minute_close, other.minute_close);
+    move_append(minute_volume, other.minute_volume);
+    move_append(daily_open, other.daily_open);
+    move_append(daily_high, other.daily_high);
+    move_append(daily_low, other.daily_low);
+    move_append(daily_close, other.daily_close);
+    move_append(daily_volume, other.daily_volume);
+    move_append(prev_close, other.prev_close);
+    move_append(prev_volume, other.prev_volume);
+    other = SnapshotTable{};
+}
+
+SnapshotTable sweep_stock_snapshots(const DataClient &client,
+                                    const std::vector<std::string> &symbols,
+                                    const SnapshotSweepOptions &options) {
+    if (options.chunk_size == 0) {
+        throw std::invalid_argument("SnapshotSweepOptions.chunk_size must be positive");
+    }
+    const std::size_t chunks = (symbols.size() + options.chunk_size - 1) / options.chunk_size;
+    std::vector<SnapshotTable> results(chunks);
+    std::vector<std::exception_ptr> errors(chunks);
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&] {
+        for (std::size_t chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1)) {
+            try {
+                const std::size_t first = chunk * options.chunk_size;
+                const std::size_t last = std::min(symbols.size(), first + options.chunk_size);
+                StockSnapshotRequest request;
+                request.symbols.assign(symbols.begin() + static_cast<std::ptrdiff_t>(first),
+                                       symbols.begin() + static_cast<std::ptrdiff_t>(last));
+                request.feed = options.feed;
+                results[chunk].append_json(client.get_stock_snapshots_raw(request));
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t thread_count =
+        std::min(std::max<std::size_t>(options.max_concurrency, 1), chunks);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count > 0 ? thread_count - 1 : 0);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    SnapshotTable table;
+    for (auto &result : results) {
+        table.append(std::move(result));
+    }
+    return table;
+}
+
+} // namespace alpaca::data
@@ -0,0 +1,241 @@
+#include "alpaca/data/vol_surface.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace alpaca::data {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+constexpr std::int64_t kNanosPerDay = 86'400'000'000'000;
+constexpr double kNanosPerYear = 365.0 * 86'400'000'000'000.0;
+
+double years_to_expiry(std::int32_t expiry_days, std::int64_t now_ns,
+                       const VolSurfaceOptions &options) {
+    const std::int64_t expiry_ns =
+        expiry_days * kNanosPerDay + options.expiry_utc_seconds * 1'000'000'000;
+    return static_cast<double>(expiry_ns - now_ns) / kNanosPerYear;
+}
+
+// Quotes of one expiry that pass the quality filters, as (log-moneyness, iv) pairs sorted by
+// log-moneyness and flattened.
+std::vector<double> filter_points(const OptionChain &chain, const OptionChain::Expiry &expiry,
+                                  double forward, const VolSurfaceOptions &options) {
+    std::vector<double> points;
+    for (const auto &row : chain.strikes(expiry)) {
+        const double k = std::log(row.strike / forward);
+        for (const auto contract : {row.put, row.call}) {
+            if (contract == OptionChain::npos) {
+                continue;
+            }
+            const bool call = chain.type[contract] == trading::ContractType::Call;
+            if (options.out_of_the_money_only && call != (k >= 0.0)) {
+                continue;
+            }
+            const double bid = chain.bid[contract];
+            const double ask = chain.ask[contract];
+            const double iv = chain.implied_volatility[contract];
+            const double mid = 0.5 * (bid + ask);
+            if (!(bid > 0.0 && ask >= bid) || (ask - bid) / mid > options.max_relative_spread ||
+                !(iv >= options.min_iv && iv <= options.max_iv)) {
+                continue;
+            }
+            points.push_back(k);
+            points.push_back(iv);
+        }
+    }
+    return points; // strike rows are sorted, so the points are too
+}
+
+// Linear in log-moneyness between points, flat beyond the outermost ones. At a strike quoted
+// on both sides (out_of_the_money_only off) the put comes first and the call wins on the right.
+std::vector<double> fit_smile(const std::vector<double> &points,
+                              const std::vector<double> &moneyness) {
+    const std::size_t n = points.size() / 2;
+    std::vector<double> grid(moneyness.size());
+    std::size_t j = 0;
+    for (std::size_t m = 0; m < moneyness.size(); ++m) {
+        const double k = moneyness[m];
+        while (j + 1 < n && points[2 * (j + 1)] <= k) {
+            ++j;
+        }
+        if (k <= points[0]) {
+            grid[m] = points[1];
+        } else if (j + 1 >= n) {
+            grid[m] = points[2 * (n - 1) + 1];
+        } else {
+            const double k0 = points[2 * j];
+            const double k1 = points[2 * (j + 1)];
+            const double w = (k - k0) / (k1 - k0);
+            grid[m] = points[2 * j + 1] + w * (points[2 * (j + 1) + 1] - points[2 * j + 1]);
+        }
+    }
+    return grid;
+}
+
+} // namespace
+
+double VolSurface::interpolate(double tenor, double log_moneyness) const {
+    if (tenors.empty() || moneyness.empty()) {
+        return kMissing;
+    }
+    const auto locate = [](const std::vector<double> &axis, double x) {
+        if (axis.size() == 1 || x <= axis.front()) {
+            return std::pair<std::size_t, double>{0, 0.0};
+        }
+        if (x >= axis.back()) {
+            return std::pair<std::size_t, double>{axis.size() - 2, 1.0};
+        }
+        const auto i = static_cast<std::size_t>(
+            std::upper_bound(axis.begin(), axis.end(), x) - axis.begin() - 1);
+        return std::pair<std::size_t, double>{i, (x - axis[i]) / (axis[i + 1] - axis[i])};
+    };
+    const auto [t, wt] = locate(tenors, tenor);
+    const auto [m, wm] = locate(moneyness, log_moneyness);
+    const std::size_t t1 = std::min(t + 1, tenors.size() - 1);
+    const std::size_t m1 = std::min(m + 1, moneyness.size() - 1);
+    const double low = at(t, m) + wm * (at(t, m1) - at(t, m));
+    const double high = at(t1, m) + wm * (at(t1, m1) - at(t1, m));
+    return low + wt * (high - low);
+}
+
+VolSurface build_vol_surface(const OptionChain &chain, double spot, std::int64_t now_ns,
+                             const VolSurfaceOptions &options) {
+    VolSurfaceBuilder builder(options);
+    builder.update(chain, spot, now_ns);
+    return *builder.surface(chain.underlying());
+}
+
+VolSurfaceBuilder::VolSurfaceBuilder() : VolSurfaceBuilder(VolSurfaceOptions{}) {}
+
+VolSurfaceBuilder::VolSurfaceBuilder(VolSurfaceOptions options) : options_(std::move(options)) {}
+
+void VolSurfaceBuilder::update(const OptionChain &chain, double spot, std::int64_t now_ns) {
+    update(std::vector<VolSurfaceInput>{{&chain, spot}}, now_ns);
+}
+
+void VolSurfaceBuilder::update(const std::vector<VolSurfaceInput> &inputs, std::int64_t now_ns) {
+    // Entries are created up front so workers only touch their own entry.
+    std::vector<Entry *> entries;
+    entries.reserve(inputs.size());
+    for (const auto &input : inputs) {
+        entries.push_back(&entries_[input.chain->underlying()]);
+    }
+
+    std::vector<std::exception_ptr> errors(inputs.size());
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> refitted{0};
+    auto worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < inputs.size(); i = next.fetch_add(1)) {
+            try {
+                refitted += refresh(*entries[i], *inputs[i].chain, inputs[i].spot, now_ns);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    const std::size_t thread_count =
+        std::min(std::max<std::size_t>(options_.max_concurrency, 1), inputs.size());
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count > 0 ? thread_count - 1 : 0);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    refitted_ = refitted.load();
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+const VolSurface *VolSurfaceBuilder::surface(const std::string &underlying) const {
+    if (auto it = entries_.find(underlying); it != entries_.end()) {
+        return &it->second.surface;
+    }
+    return nullptr;
+}
+
+std::size_t VolSurfaceBuilder::refresh(Entry &entry, const OptionChain &chain, double spot,
+                                       std::int64_t now_ns) const {
+    const auto &moneyness = options_.moneyness;
+    std::size_t refitted = 0;
+    std::map<std::int32_t, Smile> smiles;
+    std::vector<std::pair<double, const Smile *>> term; // (years, smile), by expiry
+
+    for (const auto &expiry : chain.expiries()) {
+        const double years = years_to_expiry(expiry.days, now_ns, options_);
+        if (!(years > 0.0)) {
+            continue;
+        }
+        const double forward =
+            spot * std::exp((options_.rate - options_.dividend_yield) * years);
+        auto points = filter_points(chain, expiry, forward, options_);
+        if (points.size() / 2 < std::max<std::size_t>(options_.min_points, 1)) {
+            continue;
+        }
+        Smile &smile = smiles[expiry.days];
+        auto old = entry.smiles.find(expiry.days);
+        if (old != entry.smiles.end() && old->second.spot == spot && old->second.points == points &&
+            old->second.grid.size() == moneyness.size()) {
+            smile = std::move(old->second);
+        } else {
+            smile.spot = spot;
+            smile.grid = fit_smile(points, moneyness);
+            smile.points = std::move(points);
+            ++refitted;
+        }
+        term.emplace_back(years, &smile);
+    }
+
+    auto &surface = entry.surface;
+    surface.underlying = chain.underlying();
+    surface.spot = spot;
+    surface.as_of_ns = now_ns;
+    surface.moneyness = moneyness;
+    surface.tenors = options_.tenors;
+    surface.iv.assign(surface.tenors.size() * moneyness.size(), kMissing);
+    if (!term.empty()) {
+        for (std::size_t t = 0; t < surface.tenors.size(); ++t) {
+            const double tenor = surface.tenors[t];
+            auto upper = std::upper_bound(
+                term.begin(), term.end(), tenor,
+                [](double value, const auto &slice) { return value < slice.first; });
+            for (std::size_t m = 0; m < moneyness.size(); ++m) {
+                double iv = 0.0;
+                if (upper == term.begin()) {
+                    iv = upper->second->grid[m];
+                } else if (upper == term.end()) {
+                    iv = term.back().second->grid[m];
+                } else {
+                    // Linear in total variance between the surrounding expiries.
+                    const auto &[t0, s0] = *std::prev(upper);
+                    const auto &[t1, s1] = *upper;
+                    const double w0 = s0->grid[m] * s0->grid[m] * t0;
+                    const double w1 = s1->grid[m] * s1->grid[m] * t1;
+                    const double w = w0 + (tenor - t0) / (t1 - t0) * (w1 - w0);
+                    iv = std::sqrt(std::max(w, 0.0) / tenor);
+                }
+                surface.iv[t * moneyness.size() + m] = iv;
+            }
+        }
+    }
+    entry.smiles = std::move(smiles);
+    return refitted;
+}
+
+} // namespace alpaca::data
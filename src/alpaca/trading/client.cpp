@@ -246,9 +246,11 @@ Order parse_order_from_object(simdjson::ondemand::object &object) {
     order.symbol = get_string_or_empty(object, "symbol");
     order.status = get_string_or_empty(object, "status");
     order.submitted_at = get_string_or_empty(object, "submitted_at");
+    order.updated_at = get_string_or_empty(object, "updated_at");
     order.filled_at = get_string_or_empty(object, "filled_at");
     order.qty = get_string_or_empty(object, "qty");
     order.filled_qty = get_string_or_empty(object, "filled_qty");
+    order.filled_avg_price = get_string_or_empty(object, "filled_avg_price");
     order.type = get_string_or_empty(object, "type");
     order.side = get_string_or_empty(object, "side");
     return order;
@@ -1433,6 +1435,7 @@ OptionContract parse_option_contract_from_object(simdjson::ondemand::object &obj
     OptionContract contract;
     contract.id = get_string_or_empty(object, "id");
     contract.symbol = get_string_or_empty(object, "symbol");
+    contract.contract_key = option_key(contract.symbol);
     contract.name = get_string_or_empty(object, "name");
     contract.status = get_string_or_empty(object, "status");
     contract.tradable = get_bool_or_default(object, "tradable");
@@ -0,0 +1,250 @@
+#include "alpaca/trading/order_cache.hpp"
+
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/trading/client.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <unordered_set>
+#include <utility>
+
+namespace alpaca::trading {
+
+namespace {
+
+double to_double(const std::string& text) {
+    return text.empty() ? 0.0 : std::strtod(text.c_str(), nullptr);
+}
+
+std::int64_t order_time_ns(const Order& order) {
+    return core::parse_timestamp_ns(order.updated_at).value_or(0);
+}
+
+}  // namespace
+
+bool OrderState::is_open() const noexcept {
+    const auto& status = order.status;
+    return status != "filled" && status != "canceled" && status != "expired" &&
+           status != "rejected" && status != "replaced";
+}
+
+OrderCache::Change OrderCache::upsert(const Order& order, std::int64_t updated_ns,
+                                      const TradeUpdate* update) {
+    if (order.id.empty()) {
+        return Change::None;
+    }
+    auto it = orders_.find(order.id);
+    Change change = Change::Added;
+    if (it != orders_.end()) {
+        // Stream updates may share a timestamp; REST data at the same time adds nothing.
+        const std::int64_t cached_ns = it->second.updated_ns;
+        if (updated_ns < cached_ns || (!update && updated_ns == cached_ns)) {
+            return Change::None;
+        }
+        change = Change::Updated;
+    } else {
+        it = orders_.emplace(order.id, OrderState{}).first;
+    }
+
+    OrderState& state = it->second;
+    const double previous_filled = state.filled_qty;
+    const double previous_avg = state.filled_avg_price;
+    if (!state.order.client_order_id.empty() &&
+        state.order.client_order_id != order.client_order_id) {
+        ids_by_client_id_.erase(state.order.client_order_id);
+    }
+    state.order = order;
+    state.qty = to_double(order.qty);
+    state.filled_qty = to_double(order.filled_qty);
+    state.filled_avg_price = to_double(order.filled_avg_price);
+    state.updated_ns = updated_ns;
+    if (update) {
+        state.last_event = update->event;
+        // Without an average from the feed, fold the execution into the previous one.
+        if (order.filled_avg_price.empty() && update->price && update->qty &&
+            (update->event == "fill" || update->event == "partial_fill")) {
+            const double filled = previous_filled + *update->qty;
+            if (filled > 0.0) {
+                state.filled_avg_price =
+                    (previous_avg * previous_filled + *update->price * *update->qty) / filled;
+            }
+            if (order.filled_qty.empty()) {
+                state.filled_qty = filled;
+            }
+        }
+    }
+    if (!order.client_order_id.empty()) {
+        ids_by_client_id_[order.client_order_id] = order.id;
+    }
+    return change;
+}
+
+bool OrderCache::apply(const TradeUpdate& update) {
+    if (update.order.id.empty()) {
+        return false;
+    }
+    const std::int64_t updated_ns =
+        core::parse_timestamp_ns(update.timestamp).value_or(order_time_ns(update.order));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (upsert(update.order, updated_ns, &update) == Change::None) {
+        ++stale_;
+        return false;
+    }
+    return true;
+}
+
+std::size_t OrderCache::load(const std::vector<Order>& orders) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t changed = 0;
+    for (const auto& order : orders) {
+        if (upsert(order, order_time_ns(order), nullptr) != Change::None) {
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+OrderReconcileReport OrderCache::reconcile(const TradingClient& client) {
+    // Pages oldest first, each starting after the last order's submission time, until a
+    // short page. Orders sharing that timestamp across a page boundary are left out of the
+    // list and fall back to get_order like closed ones.
+    constexpr int kPageSize = 500;
+    GetOrdersRequest request;
+    request.status = "open";
+    request.limit = kPageSize;
+    request.direction = "asc";
+    std::vector<Order> open_orders;
+    std::unordered_set<std::string> listed;
+    bool complete = false;
+    for (;;) {
+        auto page = client.list_orders(request);
+        const bool full = page.size() >= static_cast<std::size_t>(kPageSize);
+        std::string last_submitted = page.empty() ? std::string{} : page.back().submitted_at;
+        std::size_t fresh = 0;
+        for (auto& order : page) {
+            if (listed.insert(order.id).second) {
+                open_orders.push_back(std::move(order));
+                ++fresh;
+            }
+        }
+        if (!full) {
+            complete = true;
+            break;
+        }
+        // A full page that cannot be paged past leaves the listing incomplete.
+        if (fresh == 0 || last_submitted.empty() || last_submitted == request.after) {
+            break;
+        }
+        request.after = std::move(last_submitted);
+    }
+    if (!complete) {
+        return reconcile(open_orders, nullptr);
+    }
+    return reconcile(open_orders, [&client](const std::string& order_id) {
+        return client.get_order(order_id);
+    });
+}
+
+OrderReconcileReport
+OrderCache::reconcile(const std::vector<Order>& open_orders,
+                      const std::function<Order(const std::string&)>& lookup) {
+    OrderReconcileReport report;
+    std::vector<std::string> missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_set<std::string> listed;
+        for (const auto& order : open_orders) {
+            listed.insert(order.id);
+            const Change change = upsert(order, order_time_ns(order), nullptr);
+            if (change == Change::Added) {
+                ++report.added;
+            } else if (change == Change::Updated) {
+                ++report.updated;
+            }
+        }
+        for (const auto& [id, state] : orders_) {
+            if (lookup && state.is_open() && listed.count(id) == 0) {
+                missing.push_back(id);
+            }
+        }
+    }
+
+    // Looked up without the lock so the stream keeps applying updates meanwhile.
+    for (const auto& id : missing) {
+        Order order;
+        try {
+            order = lookup(id);
+        } catch (const std::exception&) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (upsert(order, order_time_ns(order), nullptr) != Change::None) {
+            ++report.resolved;
+        }
+    }
+    return report;
+}
+
+std::optional<OrderState> OrderCache::find(const std::string& order_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto it = orders_.find(order_id); it != orders_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::optional<OrderState>
+OrderCache::find_by_client_order_id(const std::string& client_order_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto id = ids_by_client_id_.find(client_order_id);
+    if (id == ids_by_client_id_.end()) {
+        return std::nullopt;
+    }
+    if (const auto it = orders_.find(id->second); it != orders_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::vector<OrderState> OrderCache::open_orders() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<OrderState> open;
+    for (const auto& [id, state] : orders_) {
+        if (state.is_open()) {
+            open.push_back(state);
+        }
+    }
+    return open;
+}
+
+std::size_t OrderCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return orders_.size();
+}
+
+std::uint64_t OrderCache::stale_updates() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stale_;
+}
+
+std::size_t OrderCache::prune_closed(std::int64_t before_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t removed = 0;
+    for (auto it = orders_.begin(); it != orders_.end();) {
+        const OrderState& state = it->second;
+        if (!state.is_open() && state.updated_ns < before_ns) {
+            ids_by_client_id_.erase(state.order.client_order_id);
+            it = orders_.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+std::function<void(const TradeUpdate&)> OrderCache::trade_update_handler() {
+    return [this](const TradeUpdate& update) { apply(update); };
+}
+
+}  // namespace alpaca::trading
@@ -0,0 +1,288 @@
+#include "alpaca/trading/position_engine.hpp"
+
+#include "alpaca/trading/client.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+namespace alpaca::trading {
+
+namespace {
+
+using core::Decimal;
+
+// Broker entry prices carry more digits than ours; a cent of cost basis is agreement.
+constexpr Decimal kCostTolerance = Decimal::from_raw(Decimal::kScale / 100);
+
+bool same_sign(Decimal a, Decimal b) {
+    return (a.raw > 0) == (b.raw > 0);
+}
+
+Decimal average(const Decimal& cost_basis, const Decimal& qty) {
+    return qty.is_zero() ? Decimal{} : cost_basis / qty;
+}
+
+// Trade update amounts come from their wire text so they stay exact; the double is only a
+// fallback for updates built by hand or sent in exponent notation.
+Decimal amount(const std::optional<std::string>& text, double value) {
+    if (text) {
+        if (const auto parsed = Decimal::parse(*text)) {
+            return *parsed;
+        }
+    }
+    return Decimal::from_double(value);
+}
+
+// list_positions reports crypto pairs without the slash ("BTCUSD") while orders, fills and
+// quotes name them "BTC/USD"; books are keyed by the latter.
+std::string book_symbol(const Position& position) {
+    const std::string& symbol = position.symbol;
+    if (position.asset_class != "crypto" || symbol.find('/') != std::string::npos) {
+        return symbol;
+    }
+    for (const std::string_view quote : {"USDT", "USDC", "USD", "BTC"}) {
+        if (symbol.size() > quote.size() &&
+            std::string_view(symbol).substr(symbol.size() - quote.size()) == quote) {
+            return symbol.substr(0, symbol.size() - quote.size()) + "/" + std::string(quote);
+        }
+    }
+    return symbol;
+}
+
+}  // namespace
+
+PositionEngine::PositionEngine(std::size_t execution_id_window)
+    : execution_id_window_(std::max<std::size_t>(execution_id_window, 1)) {}
+
+void PositionEngine::detach(const Book& book) {
+    account_.market_value -= book.market_value;
+    account_.cost_basis -= book.cost_basis;
+    account_.unrealized_pnl -= book.market_value - book.cost_basis;
+}
+
+void PositionEngine::attach(Book& book) {
+    book.market_value = book.mark_price.raw > 0 ? book.qty * book.mark_price : book.cost_basis;
+    account_.market_value += book.market_value;
+    account_.cost_basis += book.cost_basis;
+    account_.unrealized_pnl += book.market_value - book.cost_basis;
+}
+
+void PositionEngine::fill(Book& book, Decimal qty, Decimal price) {
+    if (book.qty.is_zero() || same_sign(book.qty, qty)) {
+        book.cost_basis += qty * price;
+        book.qty += qty;
+        return;
+    }
+    // The part of the fill that closes the position books realized PnL against the average
+    // cost; anything left over opens the opposite side at the fill price.
+    const Decimal closing = qty.abs() < book.qty.abs() ? qty : -book.qty;
+    const Decimal released = closing == -book.qty
+                                 ? book.cost_basis
+                                 : book.cost_basis * closing.abs() / book.qty.abs();
+    const Decimal realized = -(closing * price) - released;
+    book.realized_pnl += realized;
+    account_.realized_pnl += realized;
+    book.cost_basis -= released;
+    book.qty += closing;
+
+    const Decimal opening = qty - closing;
+    if (!opening.is_zero()) {
+        book.qty = opening;
+        book.cost_basis = opening * price;
+    }
+}
+
+void PositionEngine::set_position(Book& book, Decimal qty, Decimal avg_entry_price) {
+    book.qty = qty;
+    book.cost_basis = qty * avg_entry_price;
+}
+
+bool PositionEngine::apply(const TradeUpdate& update) {
+    if ((update.event != "fill" && update.event != "partial_fill") || !update.price ||
+        !update.qty || update.order.symbol.empty()) {
+        return false;
+    }
+    const Decimal price = amount(update.price_text, *update.price);
+    Decimal qty = amount(update.qty_text, *update.qty);
+    if (update.order.side == "sell") {
+        qty = -qty;
+    }
+    const std::int64_t timestamp_ns = core::parse_timestamp_ns(update.timestamp).value_or(0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (update.execution_id) {
+        if (!execution_ids_.insert(*update.execution_id).second) {
+            return false;
+        }
+        execution_order_.push_back(*update.execution_id);
+        if (execution_order_.size() > execution_id_window_) {
+            execution_ids_.erase(execution_order_.front());
+            execution_order_.pop_front();
+        }
+    }
+    Book& book = books_[update.order.symbol];
+    detach(book);
+    fill(book, qty, price);
+    if (update.position_qty) {
+        const Decimal broker_qty = amount(update.position_qty_text, *update.position_qty);
+        if (broker_qty != book.qty) {
+            ++corrections_;
+            const Decimal avg = book.qty.is_zero() ? price : average(book.cost_basis, book.qty);
+            set_position(book, broker_qty, avg);
+        }
+    }
+    book.updated_ns = timestamp_ns;
+    book.last_fill = ++fills_;
+    attach(book);
+    return true;
+}
+
+void PositionEngine::apply_fill(const std::string& symbol, Decimal qty, Decimal price,
+                                std::int64_t timestamp_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Book& book = books_[symbol];
+    detach(book);
+    fill(book, qty, price);
+    book.updated_ns = timestamp_ns;
+    book.last_fill = ++fills_;
+    attach(book);
+}
+
+bool PositionEngine::mark(const std::string& symbol, Decimal price, std::int64_t timestamp_ns) {
+    if (price.raw <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = books_.find(symbol);
+    if (it == books_.end()) {
+        return false;
+    }
+    Book& book = it->second;
+    detach(book);
+    book.mark_price = price;
+    book.mark_ns = timestamp_ns;
+    attach(book);
+    return true;
+}
+
+bool PositionEngine::mark_quote(const std::string& symbol, double bid_price, double ask_price,
+                                std::int64_t timestamp_ns) {
+    const double mid = bid_price > 0.0 && ask_price > 0.0 ? 0.5 * (bid_price + ask_price)
+                                                          : std::max(bid_price, ask_price);
+    return mark(symbol, Decimal::from_double(mid), timestamp_ns);
+}
+
+PositionReconcileReport PositionEngine::reconcile(const TradingClient& client) {
+    const std::uint64_t fills_before = fill_count();
+    return reconcile(client.list_positions(), fills_before);
+}
+
+PositionReconcileReport PositionEngine::reconcile(const std::vector<Position>& positions,
+                                                  std::uint64_t fills_before) {
+    PositionReconcileReport report;
+    const std::int64_t now = core::now_ns();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_set<std::string> listed;
+    for (const auto& position : positions) {
+        const auto qty = Decimal::parse(position.qty);
+        const auto avg = Decimal::parse(position.avg_entry_price);
+        if (!qty || !avg) {
+            continue;
+        }
+        std::string symbol = book_symbol(position);
+        listed.insert(symbol);
+        auto it = books_.find(symbol);
+        if (it == books_.end()) {
+            it = books_.emplace(std::move(symbol), Book{}).first;
+            ++report.added;
+        } else if (it->second.last_fill > fills_before) {
+            ++report.skipped;
+            continue;
+        } else if (it->second.qty == *qty &&
+                   (it->second.cost_basis - *qty * *avg).abs() <= kCostTolerance) {
+            ++report.matched;
+            continue;
+        } else {
+            ++report.adjusted;
+        }
+
+        Book& book = it->second;
+        detach(book);
+        set_position(book, *qty, *avg);
+        if (book.mark_price.raw <= 0) {
+            if (const auto current = Decimal::parse(position.current_price)) {
+                book.mark_price = *current;
+                book.mark_ns = now;
+            }
+        }
+        book.updated_ns = now;
+        attach(book);
+    }
+
+    for (auto& [symbol, book] : books_) {
+        if (book.qty.is_zero() || listed.count(symbol) != 0 || book.last_fill > fills_before) {
+            continue;
+        }
+        ++report.closed;
+        detach(book);
+        set_position(book, Decimal{}, Decimal{});
+        book.updated_ns = now;
+        attach(book);
+    }
+    return report;
+}
+
+PositionPnl PositionEngine::snapshot(const std::string& symbol, const Book& book) {
+    PositionPnl pnl;
+    pnl.symbol = symbol;
+    pnl.qty = book.qty;
+    pnl.avg_entry_price = average(book.cost_basis, book.qty);
+    pnl.cost_basis = book.cost_basis;
+    pnl.mark_price = book.mark_price;
+    pnl.market_value = book.market_value;
+    pnl.unrealized_pnl = book.market_value - book.cost_basis;
+    pnl.realized_pnl = book.realized_pnl;
+    pnl.mark_ns = book.mark_ns;
+    pnl.updated_ns = book.updated_ns;
+    return pnl;
+}
+
+std::optional<PositionPnl> PositionEngine::find(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto it = books_.find(symbol); it != books_.end()) {
+        return snapshot(it->first, it->second);
+    }
+    return std::nullopt;
+}
+
+std::vector<PositionPnl> PositionEngine::positions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<PositionPnl> out;
+    out.reserve(books_.size());
+    for (const auto& [symbol, book] : books_) {
+        out.push_back(snapshot(symbol, book));
+    }
+    return out;
+}
+
+AccountPnl PositionEngine::account() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return account_;
+}
+
+std::uint64_t PositionEngine::fill_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fills_;
+}
+
+std::uint64_t PositionEngine::quantity_corrections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return corrections_;
+}
+
+std::function<void(const TradeUpdate&)> PositionEngine::trade_update_handler() {
+    return [this](const TradeUpdate& update) { apply(update); };
+}
+
+}  // namespace alpaca::trading
@@ -1,5 +1,7 @@
 #include "alpaca/trading/stream.hpp"
 
+#include "alpaca/core/websocket_heartbeat.hpp"
+
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
@@ -9,8 +11,12 @@
 #include <boost/url.hpp>
 #include <simdjson/ondemand.h>
 
+#include <cctype>
 #include <chrono>
+#include <cstdlib>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 
@@ -23,6 +29,20 @@ namespace net = boost::asio;
 namespace ssl = boost::asio::ssl;
 using tcp = boost::asio::ip::tcp;
 
+namespace {
+// Reads one frame, through the heartbeat when it is enabled; its pings take `write_mutex`.
+template <typename WebSocket>
+void read_frame(WebSocket &ws, net::io_context &ioc, beast::flat_buffer &buffer,
+                boost::system::error_code &ec, core::Heartbeat *heartbeat,
+                std::mutex &write_mutex, const std::atomic<bool> &keep_running) {
+    if (heartbeat) {
+        core::read_with_heartbeat(ws, ioc, buffer, ec, *heartbeat, write_mutex, keep_running);
+    } else {
+        ws.read(buffer, ec);
+    }
+}
+} // namespace
+
 struct TradingStream::Impl {
     net::io_context ioc_;
     ssl::context ctx_;
@@ -31,6 +51,14 @@ struct TradingStream::Impl {
     std::string port_;
     std::string path_;
 
+    // Held for every write; heartbeat pings from the reader thread take it too.
+    std::mutex write_mutex_;
+
+    void write(const std::string &message, boost::system::error_code &ec) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        ws_->write(net::buffer(message), ec);
+    }
+
     Impl() : ctx_(ssl::context::sslv23_client) {
         ctx_.set_default_verify_paths();
         ctx_.set_verify_mode(ssl::verify_none);
@@ -76,7 +104,19 @@ void TradingStream::run() {
     worker_thread_ = std::make_unique<std::thread>(&TradingStream::run_loop, this);
 }
 
+void TradingStream::set_reconnect_policy(core::ReconnectPolicy policy) {
+    reconnect_policy_ = policy;
+}
+
+const core::ReconnectPolicy &TradingStream::reconnect_policy() const noexcept {
+    return reconnect_policy_;
+}
+
 void TradingStream::run_loop() {
+    std::minstd_rand rng{std::random_device{}()};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+    std::size_t attempt = 0;
+
     while (should_run_) {
         try {
             if (!running_) {
@@ -91,18 +131,28 @@ void TradingStream::run_loop() {
                 running_ = true;
             }
             consume_messages_impl();
+            attempt = 0;
         } catch (const std::exception &e) {
             running_ = false;
             close_impl();
             if (should_run_) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+                wait_for_reconnect(core::reconnect_delay(reconnect_policy_, attempt++, unit(rng)));
             }
         }
     }
 }
 
+void TradingStream::wait_for_reconnect(std::chrono::milliseconds delay) {
+    std::unique_lock<std::mutex> lock(reconnect_mutex_);
+    reconnect_cv_.wait_for(lock, delay, [this] { return !should_run_; });
+}
+
 void TradingStream::stop() {
-    should_run_ = false;
+    {
+        std::lock_guard<std::mutex> lock(reconnect_mutex_);
+        should_run_ = false;
+    }
+    reconnect_cv_.notify_all();
     close();
     if (worker_thread_ && worker_thread_->joinable()) {
         worker_thread_->join();
@@ -114,6 +164,50 @@ void TradingStream::close() {
     close_impl();
 }
 
+void TradingStream::enable_heartbeat(core::HeartbeatOptions options) {
+    heartbeat_ = std::make_unique<core::Heartbeat>(options);
+}
+
+const core::Heartbeat *TradingStream::heartbeat() const noexcept {
+    return heartbeat_.get();
+}
+
+void TradingStream::enable_latency_stats() {
+    if (!latency_stats_) {
+        latency_stats_ = std::make_unique<core::StreamLatencyStats>();
+    }
+}
+
+core::StreamLatencyStats *TradingStream::latency_stats() const noexcept {
+    return latency_stats_.get();
+}
+
+void TradingStream::enable_frame_recording(const std::string &path) {
+    frame_recorder_ = std::make_unique<core::FrameLogWriter>(path);
+}
+
+core::FrameLogWriter *TradingStream::frame_recorder() const noexcept {
+    return frame_recorder_.get();
+}
+
+std::size_t TradingStream::replay_frames(const core::FrameLogReader &log, double speed,
+                                         std::size_t first) {
+    if (worker_thread_ && worker_thread_->joinable()) {
+        throw std::logic_error("TradingStream: replay_frames() while the stream is running");
+    }
+    should_run_ = true;
+    std::string message;
+    return log.replay(
+        [&](const core::RecordedFrame &frame) {
+            if (latency_stats_) {
+                frame_received_ns_ = core::steady_now_ns();
+            }
+            message.assign(frame.data);
+            dispatch_message_impl(message);
+        },
+        speed, first, &should_run_);
+}
+
 void TradingStream::subscribe_trade_updates(TradeUpdateHandler handler) {
     trade_updates_handler_ = handler;
     if (running_) {
@@ -154,6 +248,9 @@ void TradingStream::connect_impl() {
     if (ec) {
         throw std::runtime_error("WebSocket handshake failed: " + ec.message());
     }
+    if (heartbeat_) {
+        core::watch_heartbeat(*pimpl_->ws_, *heartbeat_);
+    }
 }
 
 void TradingStream::authenticate_impl() {
@@ -163,13 +260,14 @@ void TradingStream::authenticate_impl() {
 
     boost::system::error_code ec;
     auto auth_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(auth_msg), ec);
+    pimpl_->write(auth_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send auth: " + ec.message());
     }
 
     beast::flat_buffer buffer;
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               should_run_);
     if (ec) {
         throw std::runtime_error("Failed to read auth response: " + ec.message());
     }
@@ -213,7 +311,7 @@ void TradingStream::subscribe_to_trade_updates_impl() {
 
     boost::system::error_code ec;
     auto subscribe_msg = oss.str();
-    pimpl_->ws_->write(net::buffer(subscribe_msg), ec);
+    pimpl_->write(subscribe_msg, ec);
     if (ec) {
         throw std::runtime_error("Failed to send subscribe: " + ec.message());
     }
@@ -223,15 +321,22 @@ void TradingStream::consume_messages_impl() {
     beast::flat_buffer buffer;
     boost::system::error_code ec;
 
-    pimpl_->ws_->read(buffer, ec);
+    read_frame(*pimpl_->ws_, pimpl_->ioc_, buffer, ec, heartbeat_.get(), pimpl_->write_mutex_,
+               should_run_);
     if (ec == boost::asio::error::operation_aborted) {
         return;
     }
     if (ec) {
-        throw std::runtime_error("Read failed: " + ec.message());
+        throw std::runtime_error(core::read_failure_message(ec, heartbeat_.get()));
+    }
+    if (latency_stats_) {
+        frame_received_ns_ = core::steady_now_ns();
     }
 
     std::string message(static_cast<const char *>(buffer.data().data()), buffer.size());
+    if (frame_recorder_) {
+        frame_recorder_->append(message);
+    }
     dispatch_message_impl(message);
 }
 
@@ -262,16 +367,38 @@ std::optional<std::string> get_optional_string_field(simdjson::ondemand::object
     return std::string(std::string_view(str.value()));
 }
 
-double get_optional_double_field(simdjson::ondemand::object &obj, std::string_view key) {
+// Trade update quantities and prices arrive as JSON strings; plain numbers are accepted too
+// and kept as their JSON text.
+std::optional<std::string> get_optional_number_text(simdjson::ondemand::object &obj,
+                                                    std::string_view key) {
     auto field = obj.find_field_unordered(key);
     if (field.error()) {
-        return 0.0;
+        return std::nullopt;
     }
-    auto val = field.value().get_double();
-    if (val.error()) {
-        return 0.0;
+    auto value = field.value();
+    if (auto str = value.get_string(); !str.error()) {
+        return std::string(std::string_view(str.value()));
     }
-    return val.value();
+    if (auto number = value.get_number_type(); number.error()) {
+        return std::nullopt;
+    }
+    std::string_view token = value.raw_json_token();
+    while (!token.empty() && std::isspace(static_cast<unsigned char>(token.back()))) {
+        token.remove_suffix(1);
+    }
+    return std::string(token);
+}
+
+std::optional<double> to_optional_double(const std::optional<std::string> &text) {
+    if (!text || text->empty()) {
+        return std::nullopt;
+    }
+    char *end = nullptr;
+    const double parsed = std::strtod(text->c_str(), &end);
+    if (end != text->c_str() + text->size()) {
+        return std::nullopt;
+    }
+    return parsed;
 }
 
 Order parse_order_from_trade_update(simdjson::ondemand::object &obj) {
@@ -281,9 +408,11 @@ Order parse_order_from_trade_update(simdjson::ondemand::object &obj) {
     order.symbol = get_string_field(obj, "symbol");
     order.status = get_string_field(obj, "status");
     order.submitted_at = get_string_field(obj, "submitted_at");
+    order.updated_at = get_string_field(obj, "updated_at");
     order.filled_at = get_string_field(obj, "filled_at");
     order.qty = get_string_field(obj, "qty");
     order.filled_qty = get_string_field(obj, "filled_qty");
+    order.filled_avg_price = get_string_field(obj, "filled_avg_price");
     order.type = get_string_field(obj, "type");
     order.side = get_string_field(obj, "side");
     return order;
@@ -327,13 +456,33 @@ void TradingStream::dispatch_message_impl(const std::string &message) {
                 TradeUpdate update;
                 update.event = get_string_field(data_obj.value(), "event");
                 update.execution_id = get_optional_string_field(data_obj.value(), "execution_id");
-                update.order = parse_order_from_trade_update(data_obj.value());
                 update.timestamp = get_string_field(data_obj.value(), "timestamp");
-                update.position_qty = get_optional_double_field(data_obj.value(), "position_qty");
-                update.price = get_optional_double_field(data_obj.value(), "price");
-                update.qty = get_optional_double_field(data_obj.value(), "qty");
+                update.position_qty_text =
+                    get_optional_number_text(data_obj.value(), "position_qty");
+                update.price_text = get_optional_number_text(data_obj.value(), "price");
+                update.qty_text = get_optional_number_text(data_obj.value(), "qty");
+                update.position_qty = to_optional_double(update.position_qty_text);
+                update.price = to_optional_double(update.price_text);
+                update.qty = to_optional_double(update.qty_text);
+                // The order is nested under "order"; older payloads carried its fields inline.
+                bool nested = false;
+                auto order_field = data_obj.value().find_field_unordered("order");
+                if (!order_field.error()) {
+                    auto order_obj = order_field.value().get_object();
+                    if (!order_obj.error()) {
+                        update.order = parse_order_from_trade_update(order_obj.value());
+                        nested = true;
+                    }
+                }
+                if (!nested) {
+                    update.order = parse_order_from_trade_update(data_obj.value());
+                }
 
-                trade_updates_handler_(update);
+                if (latency_stats_) {
+                    latency_stats_->invoke(frame_received_ns_, trade_updates_handler_, update);
+                } else {
+                    trade_updates_handler_(update);
+                }
             }
         }
     }
@@ -342,7 +491,10 @@ void TradingStream::dispatch_message_impl(const std::string &message) {
 void TradingStream::close_impl() {
     if (pimpl_->ws_) {
         boost::system::error_code ec;
-        pimpl_->ws_->close(websocket::close_code::normal, ec);
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->write_mutex_);
+            pimpl_->ws_->close(websocket::close_code::normal, ec);
+        }
         pimpl_->ws_.reset();
     }
 }
@@ -0,0 +1,207 @@
+#include "alpaca/core/heartbeat.hpp"
+#include "alpaca/core/websocket_heartbeat.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace alpaca;
+using Action = core::Heartbeat::Action;
+
+namespace {
+namespace net = boost::asio;
+namespace websocket = boost::beast::websocket;
+using tcp = net::ip::tcp;
+
+constexpr std::int64_t kMs = 1'000'000;
+
+// Accepts one websocket client, sends "hello" and answers pings for `answer_for`, then stops
+// reading (so no more pongs go out) while keeping the socket open until `release` is set.
+void silent_server(tcp::acceptor &acceptor, std::chrono::milliseconds answer_for,
+                   const std::atomic<bool> &release) {
+    net::io_context ioc;
+    tcp::socket socket(ioc);
+    acceptor.accept(socket);
+    websocket::stream<tcp::socket> ws(std::move(socket));
+    ws.accept();
+    ws.write(net::buffer(std::string("hello")));
+    boost::beast::flat_buffer buffer;
+    ws.async_read(buffer, [](boost::system::error_code, std::size_t) {});
+    ioc.run_for(answer_for);
+    while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+// Accepts one websocket client and reads `count` text messages (answering pings meanwhile),
+// checking each is "subscribe <i>", then sends "done".
+void subscription_server(tcp::acceptor &acceptor, int count, std::atomic<int> &received) {
+    net::io_context ioc;
+    tcp::socket socket(ioc);
+    acceptor.accept(socket);
+    websocket::stream<tcp::socket> ws(std::move(socket));
+    ws.accept();
+    for (int i = 0; i < count; ++i) {
+        boost::beast::flat_buffer buffer;
+        ws.read(buffer);
+        if (boost::beast::buffers_to_string(buffer.data()) == "subscribe " + std::to_string(i)) {
+            ++received;
+        }
+    }
+    ws.write(net::buffer(std::string("done")));
+    boost::beast::flat_buffer buffer;
+    boost::system::error_code ec;
+    ws.read(buffer, ec); // until the client closes
+}
+} // namespace
+
+int main() {
+    // Pings follow the interval, pongs echoing them give round-trip times, and silence past
+    // the timeout is reported once.
+    {
+        core::HeartbeatOptions options;
+        options.ping_interval = std::chrono::milliseconds(100);
+        options.silence_timeout = std::chrono::milliseconds(400);
+        core::Heartbeat heartbeat(options);
+        assert(heartbeat.poll_interval() == std::chrono::milliseconds(25));
+        heartbeat.start(0);
+        assert(heartbeat.poll(50 * kMs) == Action::None);
+        assert(heartbeat.poll(100 * kMs) == Action::Ping);
+        const std::string payload = heartbeat.make_ping(100 * kMs);
+        assert(heartbeat.poll(150 * kMs) == Action::None && heartbeat.pings_sent() == 1);
+
+        heartbeat.on_control(true, payload, 112 * kMs);
+        assert(heartbeat.last_rtt_ns() == 12 * kMs && heartbeat.rtt().count() == 1);
+        heartbeat.on_control(true, "unsolicited", 120 * kMs);
+        heartbeat.on_control(false, "", 130 * kMs);
+        assert(heartbeat.pongs_received() == 2 && heartbeat.rtt().count() == 1);
+
+        assert(heartbeat.poll(529 * kMs) == Action::Ping);
+        assert(heartbeat.poll(530 * kMs) == Action::Stale);
+        assert(heartbeat.poll(600 * kMs) == Action::Stale && heartbeat.stale_connections() == 1);
+        assert(heartbeat.stale_reason() == "nothing read for 400 ms");
+
+        heartbeat.start(1000 * kMs);
+        assert(heartbeat.poll(1050 * kMs) == Action::None);
+    }
+
+    // The data watchdog fires even while pongs keep the connection alive.
+    {
+        core::HeartbeatOptions options;
+        options.data_silence_timeout = std::chrono::milliseconds(2000);
+        core::Heartbeat heartbeat(options);
+        heartbeat.start(0);
+        heartbeat.on_data(500 * kMs);
+        for (std::int64_t t = 750; t < 2500; t += 250) {
+            heartbeat.on_control(true, "", t * kMs);
+            assert(heartbeat.poll(t * kMs) != Action::Stale);
+        }
+        assert(heartbeat.poll(2500 * kMs) == Action::Stale);
+        assert(heartbeat.stale_reason() == "no data for 2000 ms");
+    }
+
+    // Against a live websocket: round trips are measured while the server answers, and the
+    // read gives up shortly after it goes silent instead of blocking.
+    {
+        net::io_context ioc;
+        tcp::acceptor acceptor(ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0));
+        std::atomic<bool> release{false};
+        std::thread server(silent_server, std::ref(acceptor), std::chrono::milliseconds(300),
+                           std::cref(release));
+
+        websocket::stream<tcp::socket> ws(ioc);
+        ws.next_layer().connect(acceptor.local_endpoint());
+        ws.handshake("127.0.0.1", "/");
+        core::HeartbeatOptions options;
+        options.ping_interval = std::chrono::milliseconds(40);
+        options.silence_timeout = std::chrono::milliseconds(250);
+        core::Heartbeat heartbeat(options);
+        core::watch_heartbeat(ws, heartbeat);
+        std::atomic<bool> keep_running{true};
+        std::mutex write_mutex;
+
+        boost::beast::flat_buffer buffer;
+        boost::system::error_code ec;
+        core::read_with_heartbeat(ws, ioc, buffer, ec, heartbeat, write_mutex, keep_running);
+        assert(!ec && boost::beast::buffers_to_string(buffer.data()) == "hello");
+
+        const auto start = std::chrono::steady_clock::now();
+        buffer.clear();
+        core::read_with_heartbeat(ws, ioc, buffer, ec, heartbeat, write_mutex, keep_running);
+        const auto waited = std::chrono::steady_clock::now() - start;
+        release = true;
+        server.join();
+
+        assert(ec == boost::beast::error::timeout);
+        assert(waited >= std::chrono::milliseconds(250) && waited < std::chrono::seconds(3));
+        assert(heartbeat.pongs_received() >= 2 && heartbeat.last_rtt_ns() > 0);
+        assert(heartbeat.stale_connections() == 1);
+        assert(core::read_failure_message(ec, &heartbeat) ==
+               "Connection stale: nothing read for 250 ms");
+    }
+
+    // Subscription changes written from another thread while the reader keeps pings in flight:
+    // the shared write lock keeps the frames whole and every message arrives in order.
+    {
+        constexpr int kMessages = 2000;
+        net::io_context ioc;
+        tcp::acceptor acceptor(ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0));
+        std::atomic<int> received{0};
+        std::thread server(subscription_server, std::ref(acceptor), kMessages,
+                           std::ref(received));
+
+        websocket::stream<tcp::socket> ws(ioc);
+        ws.next_layer().connect(acceptor.local_endpoint());
+        ws.handshake("127.0.0.1", "/");
+        core::HeartbeatOptions options;
+        options.ping_interval = std::chrono::milliseconds(1);
+        options.silence_timeout = std::chrono::seconds(10);
+        core::Heartbeat heartbeat(options);
+        core::watch_heartbeat(ws, heartbeat);
+        std::atomic<bool> keep_running{true};
+        std::mutex write_mutex;
+
+        std::string last;
+        std::thread reader([&] {
+            boost::beast::flat_buffer buffer;
+            boost::system::error_code ec;
+            core::read_with_heartbeat(ws, ioc, buffer, ec, heartbeat, write_mutex, keep_running);
+            assert(!ec);
+            last = boost::beast::buffers_to_string(buffer.data());
+        });
+        for (int i = 0; i < kMessages; ++i) {
+            const std::string message = "subscribe " + std::to_string(i);
+            boost::system::error_code ec;
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                ws.write(net::buffer(message), ec);
+            }
+            assert(!ec);
+            if (i % 100 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        reader.join();
+        {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            boost::system::error_code ec;
+            ws.close(websocket::close_code::normal, ec);
+        }
+        server.join();
+
+        assert(last == "done" && received == kMessages);
+        assert(heartbeat.pings_sent() > 0 && heartbeat.pongs_received() > 0);
+    }
+
+    std::cout << "Heartbeat tests passed\n";
+    return 0;
+}
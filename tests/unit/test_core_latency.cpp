@@ -0,0 +1,57 @@
+#include "alpaca/core/latency.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace alpaca::core;
+
+namespace {
+struct Event {
+    std::string timestamp;
+};
+} // namespace
+
+int main() {
+    // Bucket boundaries are contiguous and every value falls inside its bucket.
+    for (std::int64_t v = 0; v < (1 << 20); v += 37) {
+        const auto index = LatencyHistogram::bucket_index(v);
+        assert(index < LatencyHistogram::kBucketCount);
+        assert(LatencyHistogram::bucket_upper_bound(index) >= v);
+        assert(index == 0 || LatencyHistogram::bucket_upper_bound(index - 1) < v);
+    }
+    assert(LatencyHistogram::bucket_index(-5) == 0);
+    assert(LatencyHistogram::bucket_index(INT64_MAX) == LatencyHistogram::kBucketCount - 1);
+
+    LatencyHistogram histogram;
+    assert(histogram.percentile(0.5) == 0);
+    for (std::int64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v * 100);
+    }
+    const auto summary = histogram.summary();
+    assert(summary.count == 1000);
+    // Reported values are bucket upper bounds: never below the true value, within 1.6% above.
+    assert(summary.p50 >= 50000 && summary.p50 <= 50800);
+    assert(summary.p99 >= 99000 && summary.p99 <= 100600);
+    assert(summary.p999 >= 99900 && summary.p999 <= 101500);
+    assert(summary.max >= 100000 && summary.max <= 101600);
+    histogram.reset();
+    assert(histogram.count() == 0);
+
+    StreamLatencyStats stats;
+    int calls = 0;
+    const auto handler = [&](const Event &) { ++calls; };
+    const auto received = steady_now_ns();
+    stats.invoke(received, handler, Event{format_timestamp_ns(now_ns() - 5'000'000)});
+    stats.invoke(received, handler, Event{"not a timestamp"});
+    assert(calls == 2);
+    assert(stats.receive_to_parse.count() == 2);
+    assert(stats.parse_to_handler.count() == 2);
+    assert(stats.handler.count() == 2);
+    assert(stats.exchange_to_local.count() == 1);
+    assert(stats.exchange_to_local.percentile(1.0) >= 5'000'000);
+
+    std::cout << "Core latency tests passed\n";
+    return 0;
+}
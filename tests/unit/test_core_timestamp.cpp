@@ -0,0 +1,49 @@
+#include "alpaca/core/backoff.hpp"
+#include "alpaca/core/timestamp.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using namespace alpaca::core;
+
+int main() {
+    auto epoch = parse_timestamp_ns("1970-01-01T00:00:00Z");
+    assert(epoch && *epoch == 0);
+
+    auto ts = parse_timestamp_ns("2024-01-02T09:30:00.123456789Z");
+    assert(ts && *ts == 1704187800123456789LL);
+    assert(format_timestamp_ns(*ts) == "2024-01-02T09:30:00.123456789Z");
+
+    // Fractions shorter than nanoseconds and numeric offsets normalise to UTC.
+    auto millis = parse_timestamp_ns("2024-01-02T09:30:00.5Z");
+    assert(millis && *millis == 1704187800500000000LL);
+    auto offset = parse_timestamp_ns("2024-01-02T04:30:00-05:00");
+    assert(offset && *offset == 1704187800000000000LL);
+
+    // Lexicographic ordering of the strings would put these the other way round.
+    auto whole = parse_timestamp_ns("2024-01-02T09:30:00Z");
+    auto fractional = parse_timestamp_ns("2024-01-02T09:30:00.000001Z");
+    assert(whole && fractional && *whole < *fractional);
+
+    assert(!parse_timestamp_ns(""));
+    assert(!parse_timestamp_ns("2024-13-02T09:30:00Z"));
+    assert(!parse_timestamp_ns("2024-01-02T09:30:00Zjunk"));
+
+    assert(format_timestamp_ns(-1) == "1969-12-31T23:59:59.999999999Z");
+
+    ReconnectPolicy policy{.initial_delay = std::chrono::milliseconds(100),
+                           .max_delay = std::chrono::milliseconds(1000),
+                           .multiplier = 2.0,
+                           .jitter = 0.0};
+    assert(reconnect_delay(policy, 0, 0.5).count() == 100);
+    assert(reconnect_delay(policy, 3, 0.5).count() == 800);
+    assert(reconnect_delay(policy, 10, 0.5).count() == 1000);
+
+    policy.jitter = 0.5;
+    assert(reconnect_delay(policy, 0, 0.0).count() == 50);
+    assert(reconnect_delay(policy, 0, 0.999).count() >= 149);
+    assert(reconnect_delay(policy, 10, 0.999).count() == 1000);
+
+    std::cout << "Core timestamp tests passed\n";
+    return 0;
+}
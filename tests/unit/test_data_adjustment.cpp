@@ -0,0 +1,141 @@
+#include "alpaca/core/mock_http_transport.hpp"
+#include "alpaca/data/adjustment.hpp"
+#include "alpaca/data/client.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace alpaca;
+
+namespace {
+bool near(double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); }
+
+data::Bar bar(const char *timestamp, double close, double volume) {
+    data::Bar b;
+    b.symbol = "AAPL";
+    b.timestamp = timestamp;
+    b.open = close - 1.0;
+    b.high = close + 1.0;
+    b.low = close - 2.0;
+    b.close = close;
+    b.volume = volume;
+    b.vwap = close;
+    b.trade_count = 10.0;
+    return b;
+}
+} // namespace
+
+int main() {
+    // Typed records are parsed alongside the raw groups.
+    auto transport = std::make_shared<core::MockHttpTransport>();
+    transport->enqueue_response({200, {}, R"({
+      "forward_splits": [
+        {"id":"fs1","symbol":"AAPL","cusip":"037833100","new_rate":4,"old_rate":1,
+         "process_date":"2020-08-31","ex_date":"2020-08-31","record_date":"2020-08-24",
+         "payable_date":"2020-08-28"}
+      ],
+      "unit_splits": [
+        {"id":"us1","old_symbol":"OLD","old_cusip":"1","old_rate":1,"new_symbol":"NEW",
+         "new_cusip":"2","new_rate":1.5,"effective_date":"2021-01-04","process_date":"2021-01-04"}
+      ],
+      "cash_dividends": [
+        {"id":"cd1","symbol":"AAPL","cusip":"037833100","rate":0.82,"special":false,
+         "foreign":true,"process_date":"2020-08-14","ex_date":"2020-08-07",
+         "record_date":"2020-08-10","payable_date":"2020-08-13"}
+      ],
+      "stock_dividends": [
+        {"id":"sd1","symbol":"XYZ","cusip":"3","rate":"0.05","ex_date":"2021-03-01",
+         "process_date":"2021-03-02"}
+      ],
+      "stock_and_cash_mergers": [
+        {"id":"m1","acquirer_symbol":"BIG","acquirer_rate":0.5,"acquiree_symbol":"SMALL",
+         "acquiree_cusip":"4","acquiree_rate":1,"cash_rate":12.5,
+         "effective_date":"2022-06-01","process_date":"2022-06-01"}
+      ],
+      "spin_offs": [
+        {"id":"so1","source_symbol":"PAR","source_cusip":"5","source_rate":3,"new_symbol":"KID",
+         "new_cusip":"6","new_rate":1,"ex_date":"2023-04-03","process_date":"2023-04-03"}
+      ],
+      "name_changes": [
+        {"id":"nc1","old_symbol":"A","new_symbol":"B","process_date":"2023-01-01"}
+      ],
+      "next_page_token": "tok"
+    })"});
+    data::DataClient client(core::ClientConfig::WithPaperKeys("key", "secret"), transport);
+    const auto actions = client.get_corporate_actions({});
+
+    assert(actions.groups.size() == 7 && actions.next_page_token == "tok");
+    assert(actions.splits.size() == 2 && actions.dividends.size() == 2);
+    assert(actions.mergers.size() == 1 && actions.spin_offs.size() == 1);
+    const auto &forward = actions.splits[0];
+    assert(forward.type == data::CorporateActionsType::ForwardSplit && forward.id == "fs1");
+    assert(forward.symbol == "AAPL" && forward.ratio() == 4.0 && forward.ex_date == "2020-08-31");
+    assert(forward.record_date == "2020-08-24" && !forward.new_symbol);
+    const auto &unit = actions.splits[1];
+    assert(unit.type == data::CorporateActionsType::UnitSplit && unit.symbol == "OLD");
+    assert(unit.new_symbol == "NEW" && unit.ratio() == 1.5 && unit.ex_date == "2021-01-04");
+    const auto &cash = actions.dividends[0];
+    assert(cash.type == data::CorporateActionsType::CashDividend && cash.rate == 0.82);
+    assert(!cash.special && cash.foreign && cash.payable_date == "2020-08-13");
+    assert(actions.dividends[1].type == data::CorporateActionsType::StockDividend);
+    assert(actions.dividends[1].rate == 0.05); // from a string field
+    const auto &merger = actions.mergers[0];
+    assert(merger.type == data::CorporateActionsType::StockAndCashMerger);
+    assert(merger.acquirer_symbol == "BIG" && merger.acquirer_rate == 0.5);
+    assert(merger.acquiree_symbol == "SMALL" && merger.cash_rate == 12.5);
+    const auto &spin = actions.spin_offs[0];
+    assert(spin.source_symbol == "PAR" && spin.source_rate == 3.0 && spin.new_symbol == "KID");
+
+    // Daily bars stamped at midnight Eastern around a dividend (ex 08-07) and a 4:1 split
+    // (ex 08-31).
+    data::BarColumns raw;
+    raw.symbol = "AAPL";
+    raw.push_back(bar("2020-08-06T04:00:00Z", 400.0, 100.0));
+    raw.push_back(bar("2020-08-07T04:00:00Z", 401.0, 100.0));
+    raw.push_back(bar("2020-08-28T04:00:00Z", 500.0, 100.0));
+    raw.push_back(bar("2020-08-31T04:00:00Z", 125.0, 400.0));
+
+    data::CorporateActionAdjuster adjuster(actions);
+    adjuster.add(actions); // duplicates by id are ignored
+    assert(adjuster.size("AAPL") == 2 && adjuster.size("MSFT") == 0);
+
+    const auto unchanged = adjuster.adjust(raw, data::Adjustment::Raw);
+    assert(unchanged.close == raw.close && unchanged.volume == raw.volume);
+
+    const auto split = adjuster.adjust(raw, data::Adjustment::Split);
+    assert(near(split.close[0], 100.0) && near(split.close[2], 125.0));
+    assert(near(split.close[3], 125.0) && near(split.volume[2], 400.0));
+    assert(near(split.open[2], 499.0 / 4) && near(split.vwap[0], 100.0));
+    assert(split.trade_count[0] == 10.0);
+
+    const double dividend_factor = 1.0 - 0.82 / 400.0;
+    const auto dividend = adjuster.adjust(raw, data::Adjustment::Dividend);
+    assert(near(dividend.close[0], 400.0 * dividend_factor) && dividend.close[1] == 401.0);
+    assert(dividend.volume[0] == 100.0);
+
+    const auto all = adjuster.adjust(raw, data::Adjustment::All);
+    assert(near(all.close[0], 100.0 * dividend_factor));
+    assert(near(all.low[0], 398.0 / 4 * dividend_factor));
+    assert(near(all.close[1], 401.0 / 4) && near(all.volume[0], 400.0));
+
+    const auto factors = adjuster.factors(raw, data::Adjustment::All);
+    assert(near(factors.price[0], dividend_factor / 4) && factors.price[3] == 1.0);
+
+    // Stock dividends are share-count changes; bars of symbols without actions pass through.
+    data::BarColumns xyz;
+    xyz.symbol = "XYZ";
+    xyz.push_back(bar("2021-02-26T05:00:00Z", 105.0, 100.0));
+    xyz.push_back(bar("2021-03-01T05:00:00Z", 100.0, 100.0));
+    adjuster.adjust_in_place(xyz, data::Adjustment::Split);
+    assert(near(xyz.close[0], 100.0) && near(xyz.volume[0], 105.0) && xyz.close[1] == 100.0);
+    data::BarColumns other = raw;
+    other.symbol = "MSFT";
+    adjuster.adjust_in_place(other, data::Adjustment::All);
+    assert(other.close == raw.close);
+
+    std::cout << "Corporate action adjustment tests passed\n";
+    return 0;
+}
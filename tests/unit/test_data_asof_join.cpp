@@ -0,0 +1,209 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/asof_join.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+
+struct Row {
+    std::string symbol;
+    std::int64_t trade_ns;
+    double price;
+    std::int64_t quote_ns;
+    double bid;
+};
+
+struct Tick {
+    std::string symbol;
+    std::int64_t ns;
+    double value;
+};
+
+void collect(std::vector<Row> &rows, const data::TradeQuoteColumns &batch) {
+    for (std::size_t i = 0; i < batch.size_rows(); ++i) {
+        rows.push_back({batch.symbol, batch.trade_ns[i], batch.price[i], batch.quote_ns[i],
+                        batch.bid_price[i]});
+    }
+}
+
+// Serves trades and quotes ordered by symbol then time, three rows per page.
+class HistoryTransport final : public core::IHttpTransport {
+  public:
+    HistoryTransport(std::vector<Tick> trades, std::vector<Tick> quotes)
+        : trades_(std::move(trades)), quotes_(std::move(quotes)) {}
+
+    core::HttpResponse send(const core::HttpRequest &request) override {
+        const bool is_trades = request.url.find("/stocks/trades") != std::string::npos;
+        ++(is_trades ? trade_pages : quote_pages);
+        const auto &rows = is_trades ? trades_ : quotes_;
+        std::size_t offset = 0;
+        if (auto at = request.url.find("page_token="); at != std::string::npos) {
+            offset = std::stoul(request.url.substr(at + 11));
+        }
+        const std::size_t end = std::min(offset + 3, rows.size());
+
+        std::string body = is_trades ? "{\"trades\":{" : "{\"quotes\":{";
+        std::string open;
+        for (std::size_t i = offset; i < end; ++i) {
+            if (rows[i].symbol != open) {
+                body += open.empty() ? "" : "],";
+                body += "\"" + rows[i].symbol + "\":[";
+                open = rows[i].symbol;
+            } else {
+                body += ",";
+            }
+            const std::string t = "\"t\":\"" + core::format_timestamp_ns(rows[i].ns) + "\"";
+            const std::string v = std::to_string(rows[i].value);
+            body += is_trades ? "{" + t + ",\"p\":" + v + ",\"s\":100}"
+                              : "{" + t + ",\"bp\":" + v + ",\"bs\":1,\"ap\":" + v + ",\"as\":1}";
+        }
+        body += open.empty() ? "}" : "]}";
+        body += end < rows.size() ? ",\"next_page_token\":\"" + std::to_string(end) + "\"}"
+                                  : ",\"next_page_token\":null}";
+        return {200, {}, body};
+    }
+
+    int trade_pages{0};
+    int quote_pages{0};
+
+  private:
+    std::vector<Tick> trades_;
+    std::vector<Tick> quotes_;
+};
+
+// Reference join: for each trade, the last quote of its symbol at or before the trade.
+std::vector<Row> brute_force(const std::vector<Tick> &trades, const std::vector<Tick> &quotes) {
+    std::vector<Row> rows;
+    for (const auto &trade : trades) {
+        Row row{trade.symbol, trade.ns, trade.value, 0, std::nan("")};
+        for (const auto &quote : quotes) {
+            if (quote.symbol == trade.symbol && quote.ns <= trade.ns) {
+                row.quote_ns = quote.ns;
+                row.bid = quote.value;
+            }
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+bool same(const Row &a, const Row &b) {
+    return a.symbol == b.symbol && a.trade_ns == b.trade_ns && a.price == b.price &&
+           a.quote_ns == b.quote_ns && (a.bid == b.bid || (std::isnan(a.bid) && std::isnan(b.bid)));
+}
+
+} // namespace
+
+int main() {
+    // Trades wait for a later quote; quotes are matched at or before trade time minus the offset.
+    {
+        std::vector<Row> rows;
+        data::AsOfJoiner joiner([&](const auto &batch) { collect(rows, batch); }, {10, 0});
+        const std::vector<std::int64_t> times{100, 105};
+        const std::vector<double> prices{1.0, 2.0};
+        const std::vector<double> sizes{1.0, 1.0};
+        joiner.add_quote("AAPL", 50, 10.0, 1, 10.1, 1);
+        joiner.add_trades("AAPL", times, prices, sizes);
+        assert(rows.empty() && joiner.pending_trades() == 2);
+        joiner.add_quote("AAPL", 92, 11.0, 1, 11.1, 1); // 92 > 100 - 10: trade at 100 done
+        assert(rows.size() == 1 && rows[0].quote_ns == 50 && rows[0].bid == 10.0);
+        joiner.add_quote("AAPL", 95, 12.0, 1, 12.1, 1); // exactly at 105 - 10: still waiting
+        assert(rows.size() == 1);
+        joiner.add_quote("AAPL", 96, 13.0, 1, 13.1, 1);
+        assert(rows.size() == 2 && rows[1].quote_ns == 95 && rows[1].bid == 12.0);
+        assert(joiner.pending_trades() == 0 && joiner.pending_quotes() == 1);
+
+        // Quotes no future trade can precede are folded into the current quote, not buffered.
+        joiner.add_quote("AAPL", 97, 14.0, 1, 14.1, 1);
+        const std::vector<std::int64_t> late{110};
+        joiner.add_trades("AAPL", late, std::span(prices).first(1), std::span(sizes).first(1));
+        assert(rows.size() == 2);
+        joiner.finish_quotes("AAPL");
+        assert(rows.size() == 3 && rows[2].quote_ns == 97 && rows[2].bid == 14.0);
+
+        // A symbol without quotes: trades wait until finish() and then have no quote.
+        joiner.add_trades("MSFT", late, std::span(prices).first(1), std::span(sizes).first(1));
+        assert(rows.size() == 3 && joiner.pending_trades() == 1);
+        joiner.finish();
+        assert(rows.size() == 4 && rows[3].symbol == "MSFT" && rows[3].quote_ns == 0);
+        assert(std::isnan(rows[3].bid) && joiner.pending_trades() == 0);
+    }
+
+    // Stale quotes are reported as missing.
+    {
+        std::vector<Row> rows;
+        data::AsOfJoiner joiner([&](const auto &batch) { collect(rows, batch); }, {0, 5});
+        joiner.add_quote("SPY", 10, 1.0, 1, 1.1, 1);
+        const std::vector<std::int64_t> times{14, 16};
+        const std::vector<double> values{1.0, 1.0};
+        joiner.add_trades("SPY", times, values, values);
+        joiner.finish();
+        assert(rows.size() == 2 && rows[0].bid == 1.0 && std::isnan(rows[1].bid));
+    }
+
+    // Paged history for several symbols matches a brute-force join, and the streaming buffers
+    // stay bounded.
+    {
+        std::vector<Tick> trades;
+        std::vector<Tick> quotes;
+        const std::int64_t base = 1'704'207'600'000'000'000; // 2024-01-02T15:00:00Z
+        for (const char *symbol : {"AAPL", "IBM", "MSFT"}) {
+            for (std::int64_t i = 0; i < 20; ++i) {
+                if (std::string(symbol) != "IBM") { // IBM has trades but no quotes
+                    quotes.push_back({symbol, base + i * 1000, 100.0 + static_cast<double>(i)});
+                }
+                if (i % 3 == 1) {
+                    trades.push_back({symbol, base + i * 1000 + 500, static_cast<double>(i)});
+                }
+                if (i == 6) {
+                    trades.push_back({symbol, base + i * 1000, static_cast<double>(i)});
+                }
+            }
+        }
+        std::stable_sort(trades.begin(), trades.end(), [](const auto &a, const auto &b) {
+            return a.symbol < b.symbol || (a.symbol == b.symbol && a.ns < b.ns);
+        });
+        trades.insert(trades.begin(), {"AAPL", base - 1, 99.0}); // before the first quote
+
+        auto transport = std::make_shared<HistoryTransport>(trades, quotes);
+        data::DataClient client(core::ClientConfig::WithPaperKeys("key", "secret"), transport);
+        std::vector<Row> rows;
+        std::size_t max_pending = 0;
+        data::AsOfJoiner *self = nullptr;
+        data::AsOfJoiner joiner([&](const auto &batch) {
+            collect(rows, batch);
+            max_pending = std::max(max_pending, self->pending_trades() + self->pending_quotes());
+        });
+        self = &joiner;
+        data::StockTradesRequest request;
+        request.symbols = {"AAPL", "IBM", "MSFT"};
+        data::asof_join_stock_trades(client, request, joiner, 3);
+        assert(joiner.pending_trades() == 0);
+
+        const auto expected = brute_force(trades, quotes);
+        assert(rows.size() == expected.size());
+        std::map<std::string, std::vector<Row>> by_symbol;
+        for (const auto &row : rows) {
+            by_symbol[row.symbol].push_back(row);
+        }
+        std::size_t i = 0;
+        for (const auto &[symbol, symbol_rows] : by_symbol) {
+            for (const auto &row : symbol_rows) {
+                assert(same(row, expected[i++]));
+            }
+        }
+        assert(max_pending <= 3);
+        assert(transport->trade_pages == 9 && transport->quote_pages == 14);
+    }
+
+    std::cout << "As-of join tests passed\n";
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/bar_aggregator.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+class DispatchProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::StockDataStream;
+    using StockDataStream::dispatch_message_impl;
+};
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+std::int64_t at(const char *timestamp) {
+    return *core::parse_timestamp_ns(timestamp);
+}
+} // namespace
+
+int main() {
+    // One-minute bars closed by the event-time watermark.
+    std::vector<data::Bar> bars;
+    std::vector<data::Bar> revisions;
+    data::BarAggregator minute(
+        data::BarSpec::time(data::TimeFrame::Minute()),
+        [&](const data::Bar &bar) { bars.push_back(bar); },
+        [&](const data::Bar &bar) { revisions.push_back(bar); });
+    const auto aapl = minute.symbol_id("AAPL");
+    assert(minute.symbol_id("AAPL") == aapl);
+
+    minute.on_trade(aapl, at("2024-01-02T09:30:10Z"), 100.0, 10, "1");
+    minute.on_trade(aapl, at("2024-01-02T09:30:05Z"), 99.0, 30, "2"); // out of order, same bar
+    minute.on_trade(aapl, at("2024-01-02T09:30:50Z"), 101.0, 10, "3");
+    assert(bars.empty());
+    minute.on_trade(aapl, at("2024-01-02T09:31:00Z"), 102.0, 5, "4");
+    assert(bars.size() == 1);
+    const auto &first = bars[0];
+    assert(first.symbol == "AAPL");
+    assert(core::parse_timestamp_ns(first.timestamp) == at("2024-01-02T09:30:00Z"));
+    assert(near(first.open, 99.0) && near(first.close, 101.0));
+    assert(near(first.high, 101.0) && near(first.low, 99.0));
+    assert(near(first.volume, 50.0) && near(*first.trade_count, 3.0));
+    assert(near(*first.vwap, (100.0 * 10 + 99.0 * 30 + 101.0 * 10) / 50.0));
+
+    // A late trade and a cancel revise the emitted bar.
+    minute.on_trade(aapl, at("2024-01-02T09:30:59Z"), 105.0, 10, "5");
+    assert(revisions.size() == 1 && near(revisions[0].high, 105.0));
+    data::TradeCancel cancel;
+    cancel.symbol = "AAPL";
+    cancel.id = "2";
+    minute.on_cancel(cancel);
+    assert(revisions.size() == 2);
+    assert(near(revisions[1].open, 100.0) && near(revisions[1].volume, 30.0));
+
+    // A correction to a trade in the open bar updates it without a revision.
+    data::TradeCorrection correction;
+    correction.symbol = "AAPL";
+    correction.original_id = "4";
+    correction.corrected_price = 102.5;
+    correction.corrected_size = 7;
+    minute.on_correction(correction);
+    assert(revisions.size() == 2);
+    minute.advance_watermark(at("2024-01-02T09:32:00Z"));
+    assert(bars.size() == 2 && near(bars[1].close, 102.5) && near(bars[1].volume, 7.0));
+
+    // Trades for bars that fell out of the revision window are dropped.
+    data::BarAggregator shallow(data::BarSpec::seconds(1), {}, {},
+                                data::BarAggregator::Options{std::chrono::nanoseconds(0), 0});
+    const auto msft = shallow.symbol_id("MSFT");
+    shallow.on_trade(msft, at("2024-01-02T09:30:02Z"), 1.0, 1);
+    shallow.on_trade(msft, at("2024-01-02T09:30:00Z"), 1.0, 1);
+    assert(shallow.late_trades_dropped() == 1);
+
+    // Allowed lateness keeps several bars open.
+    std::vector<data::Bar> lagged;
+    data::BarAggregator lenient(
+        data::BarSpec::seconds(10), [&](const data::Bar &bar) { lagged.push_back(bar); }, {},
+        data::BarAggregator::Options{std::chrono::seconds(15), 8});
+    const auto spy = lenient.symbol_id("SPY");
+    lenient.on_trade(spy, at("2024-01-02T09:30:01Z"), 1.0, 1);
+    lenient.on_trade(spy, at("2024-01-02T09:30:21Z"), 2.0, 1);
+    lenient.on_trade(spy, at("2024-01-02T09:30:02Z"), 3.0, 1);
+    assert(lagged.empty());
+    lenient.on_trade(spy, at("2024-01-02T09:30:26Z"), 4.0, 1);
+    assert(lagged.size() == 1 && near(lagged[0].volume, 2.0) && near(lagged[0].close, 3.0));
+    lenient.flush();
+    assert(lagged.size() == 2 && near(lagged[1].volume, 2.0));
+
+    // Tick and volume bars.
+    std::vector<data::Bar> ticks;
+    data::BarAggregator tick_bars(data::BarSpec::tick_count(2),
+                                  [&](const data::Bar &bar) { ticks.push_back(bar); });
+    const auto btc = tick_bars.symbol_id("BTC/USD");
+    for (int i = 0; i < 5; ++i) {
+        tick_bars.on_trade(btc, at("2024-01-02T00:00:00Z") + i, 10.0 + i, 1);
+    }
+    assert(ticks.size() == 2 && near(ticks[1].open, 12.0) && near(ticks[1].close, 13.0));
+
+    std::vector<data::Bar> volume;
+    data::BarAggregator volume_bars(data::BarSpec::traded_volume(100),
+                                    [&](const data::Bar &bar) { volume.push_back(bar); });
+    const auto eth = volume_bars.symbol_id("ETH/USD");
+    volume_bars.on_trade(eth, 1, 1.0, 60);
+    volume_bars.on_trade(eth, 2, 1.0, 60);
+    volume_bars.on_trade(eth, 3, 1.0, 60);
+    assert(volume.size() == 1 && near(volume[0].volume, 120.0));
+
+    // Corrections and cancels are parsed off the stock stream and reach the aggregator.
+    std::vector<data::Bar> streamed;
+    std::vector<data::Bar> stream_revisions;
+    data::BarAggregator live(
+        data::BarSpec::seconds(1), [&](const data::Bar &bar) { streamed.push_back(bar); },
+        [&](const data::Bar &bar) { stream_revisions.push_back(bar); });
+    DispatchProbe stream("key", "secret");
+    stream.subscribe_trades(live.trade_handler(), {"AAPL"});
+    stream.register_trade_corrections(live.correction_handler());
+    stream.register_trade_cancels(live.cancel_handler());
+    stream.dispatch_message_impl(
+        R"([{"T":"t","S":"AAPL","i":11,"x":"V","p":100.0,"s":10,"t":"2024-01-02T09:30:00.1Z"},)"
+        R"({"T":"t","S":"AAPL","i":12,"x":"V","p":101.0,"s":20,"t":"2024-01-02T09:30:00.2Z"},)"
+        R"({"T":"t","S":"AAPL","i":13,"x":"V","p":102.0,"s":5,"t":"2024-01-02T09:30:01.5Z"},)"
+        R"({"T":"c","S":"AAPL","x":"V","oi":12,"op":101.0,"os":20,"oc":["@"],"ci":14,"cp":100.5,"cs":20,"cc":["@"],"z":"C","t":"2024-01-02T09:30:00.2Z"},)"
+        R"({"T":"x","S":"AAPL","i":11,"x":"V","p":100.0,"s":10,"a":"C","z":"C","t":"2024-01-02T09:30:00.1Z"}])");
+    assert(streamed.size() == 1 && near(streamed[0].high, 101.0));
+    assert(stream_revisions.size() == 2);
+    assert(near(stream_revisions[0].high, 100.5));
+    assert(near(stream_revisions[1].volume, 20.0) && near(stream_revisions[1].open, 100.5));
+
+    std::cout << "Bar aggregator tests passed\n";
+    return 0;
+}
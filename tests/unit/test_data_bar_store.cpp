@@ -0,0 +1,265 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/bar_store.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace alpaca;
+using Field = data::BarStore::Field;
+
+namespace {
+constexpr std::int64_t kMinute = 60'000'000'000;
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-7;
+}
+
+data::Bar make_bar(const char *symbol, int minute, double shift = 0.0) {
+    const double wave = std::sin(minute * 0.37) * 3.0 + std::cos(minute * 0.11) * 5.0;
+    data::Bar bar;
+    bar.symbol = symbol;
+    bar.timestamp = core::format_timestamp_ns(*core::parse_timestamp_ns("2024-01-02T14:30:00Z") +
+                                              minute * kMinute);
+    bar.close = 100.0 + shift + wave;
+    bar.open = bar.close - 0.4;
+    bar.high = bar.close + 0.8 + (minute % 3) * 0.1;
+    bar.low = bar.open - 0.6;
+    bar.volume = 1000.0 + (minute % 7) * 150.0;
+    if (minute % 4 != 0) {
+        bar.vwap = (bar.high + bar.low) / 2.0;
+    }
+    return bar;
+}
+
+// Straightforward recomputation of every indicator from the full bar list.
+data::BarIndicators reference(const std::vector<data::Bar> &bars,
+                              const data::BarStore::Options &o) {
+    const std::size_t n = bars.size();
+    const auto mean_close = [&](std::size_t period) {
+        double sum = 0.0;
+        for (std::size_t i = n - period; i < n; ++i) {
+            sum += bars[i].close;
+        }
+        return sum / static_cast<double>(period);
+    };
+    data::BarIndicators out;
+    out.sma = mean_close(o.sma_period);
+
+    double ema = 0.0;
+    for (std::size_t i = 0; i < o.ema_period; ++i) {
+        ema += bars[i].close / static_cast<double>(o.ema_period);
+    }
+    for (std::size_t i = o.ema_period; i < n; ++i) {
+        ema += 2.0 / (static_cast<double>(o.ema_period) + 1.0) * (bars[i].close - ema);
+    }
+    out.ema = ema;
+
+    const auto rp = static_cast<double>(o.rsi_period);
+    double gain = 0.0;
+    double loss = 0.0;
+    for (std::size_t i = 1; i < n; ++i) {
+        const double change = bars[i].close - bars[i - 1].close;
+        const double g = std::max(change, 0.0);
+        const double l = std::max(-change, 0.0);
+        if (i <= o.rsi_period) {
+            gain += g / rp;
+            loss += l / rp;
+        } else {
+            gain = (gain * (rp - 1.0) + g) / rp;
+            loss = (loss * (rp - 1.0) + l) / rp;
+        }
+    }
+    out.rsi = 100.0 - 100.0 / (1.0 + gain / loss);
+
+    const auto ap = static_cast<double>(o.atr_period);
+    double atr = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double tr = bars[i].high - bars[i].low;
+        if (i > 0) {
+            tr = std::max({tr, std::fabs(bars[i].high - bars[i - 1].close),
+                           std::fabs(bars[i].low - bars[i - 1].close)});
+        }
+        atr = i < o.atr_period ? atr + tr / ap : (atr * (ap - 1.0) + tr) / ap;
+    }
+    out.atr = atr;
+
+    const double middle = mean_close(o.bollinger_period);
+    double variance = 0.0;
+    for (std::size_t i = n - o.bollinger_period; i < n; ++i) {
+        variance += (bars[i].close - middle) * (bars[i].close - middle);
+    }
+    const double width =
+        o.bollinger_width * std::sqrt(variance / static_cast<double>(o.bollinger_period));
+    out.bollinger_middle = middle;
+    out.bollinger_upper = middle + width;
+    out.bollinger_lower = middle - width;
+
+    double pv = 0.0;
+    double volume = 0.0;
+    for (std::size_t i = n - o.vwap_period; i < n; ++i) {
+        const auto &b = bars[i];
+        pv += b.vwap.value_or((b.high + b.low + b.close) / 3.0) * b.volume;
+        volume += b.volume;
+    }
+    out.vwap = pv / volume;
+    return out;
+}
+
+void assert_matches(const data::BarIndicators &got, const data::BarIndicators &want) {
+    assert(got.sma && near(*got.sma, *want.sma));
+    assert(got.ema && near(*got.ema, *want.ema));
+    assert(got.rsi && near(*got.rsi, *want.rsi));
+    assert(got.atr && near(*got.atr, *want.atr));
+    assert(got.bollinger_middle && near(*got.bollinger_middle, *want.bollinger_middle));
+    assert(got.bollinger_upper && near(*got.bollinger_upper, *want.bollinger_upper));
+    assert(got.bollinger_lower && near(*got.bollinger_lower, *want.bollinger_lower));
+    assert(got.vwap && near(*got.vwap, *want.vwap));
+}
+} // namespace
+
+int main() {
+    data::BarStore::Options options;
+    options.capacity = 30; // rounded to 32, so the rings wrap and are re-summed
+    options.sma_period = 10;
+    options.ema_period = 12;
+    options.rsi_period = 14;
+    options.atr_period = 14;
+    options.bollinger_period = 32;
+    options.vwap_period = 7;
+
+    // Indicators track a full recomputation bar after bar, through many ring wraps.
+    {
+        data::BarStore store(options);
+        assert(store.capacity() == 32);
+        std::vector<data::Bar> bars;
+        for (int m = 0; m < 200; ++m) {
+            bars.push_back(make_bar("AAPL", m));
+            assert(store.on_bar(bars.back()));
+            const auto got = store.indicators(0);
+            if (bars.size() < options.bollinger_period + 1) {
+                assert(!got.bollinger_middle || bars.size() == options.bollinger_period);
+                assert(got.rsi.has_value() == (bars.size() > options.rsi_period));
+                assert(got.sma.has_value() == (bars.size() >= options.sma_period));
+                continue;
+            }
+            assert_matches(got, reference(bars, options));
+        }
+
+        assert(store.size(0) == 32);
+        assert(store.value(0, Field::Close) == bars.back().close);
+        assert(store.value(0, Field::High, 31) == bars[200 - 32].high);
+        assert(store.value(0, Field::Vwap, 3) ==
+               (bars[196].high + bars[196].low + bars[196].close) / 3.0);
+        assert(store.value(0, Field::Vwap, 4) == *bars[195].vwap);
+        assert(store.timestamp_ns(0, 1) == *core::parse_timestamp_ns(bars[198].timestamp));
+        bool threw = false;
+        try {
+            (void)store.value(0, Field::Open, 32);
+        } catch (const std::out_of_range &) {
+            threw = true;
+        }
+        assert(threw);
+
+        const auto history = store.history(0);
+        assert(history.symbol == "AAPL" && history.size() == 32);
+        assert(history.close.front() == bars[168].close && history.close.back() == bars[199].close);
+        assert(std::is_sorted(history.timestamp_ns.begin(), history.timestamp_ns.end()));
+
+        // Bars that are not newer than the latest are rejected.
+        assert(!store.on_bar(bars[150]) && store.rejected_bars() == 1);
+    }
+
+    // REST warm-up and the stream may overlap; batched minute closes match per-bar updates.
+    {
+        std::vector<data::Bar> history;
+        for (int m = 0; m < 60; ++m) {
+            history.push_back(make_bar("AAPL", m));
+            history.push_back(make_bar("MSFT", m, 50.0));
+        }
+        data::BarStore batched(options);
+        data::BarStore single(options);
+        assert(batched.warm_up(history) == 120 && single.warm_up(history) == 120);
+        assert(batched.warm_up({history.back()}) == 0);
+
+        const auto spy = batched.symbol_id("SPY");
+        single.symbol_id("SPY");
+        for (int m = 60; m < 100; ++m) {
+            const auto a = make_bar("AAPL", m);
+            const auto b = make_bar("MSFT", m, 50.0);
+            auto batch = batched.make_batch(*core::parse_timestamp_ns(a.timestamp));
+            const auto aapl = *batched.find("AAPL");
+            batch.open[aapl] = a.open;
+            batch.high[aapl] = a.high;
+            batch.low[aapl] = a.low;
+            batch.close[aapl] = a.close;
+            batch.volume[aapl] = a.volume;
+            batch.vwap[aapl] = a.vwap.value_or(std::nan(""));
+            if (m % 2 == 0) {
+                const auto msft = *batched.find("MSFT");
+                batch.open[msft] = b.open;
+                batch.high[msft] = b.high;
+                batch.low[msft] = b.low;
+                batch.close[msft] = b.close;
+                batch.volume[msft] = b.volume;
+                batch.vwap[msft] = b.vwap.value_or(std::nan(""));
+                single.on_bar(b);
+            }
+            assert(batched.update_all(batch) == (m % 2 == 0 ? 2u : 1u));
+            single.on_bar(a);
+        }
+        for (const char *symbol : {"AAPL", "MSFT"}) {
+            const auto id = *batched.find(symbol);
+            assert_matches(batched.indicators(id), single.indicators(*single.find(symbol)));
+        }
+        assert(batched.size(spy) == 0 && !batched.indicators(spy).sma);
+
+        auto short_batch = batched.make_batch(0);
+        short_batch.close.pop_back();
+        bool threw = false;
+        try {
+            batched.update_all(short_batch);
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Many symbols grow the columns without disturbing stored rings: every ring row is
+    // widened, so each symbol keeps several bars across the growth.
+    {
+        data::BarStore store(options);
+        for (int s = 0; s < 100; ++s) {
+            const auto id = store.symbol_id("S" + std::to_string(s));
+            for (int m = 0; m < 3; ++m) {
+                store.append(id, (m + 1) * kMinute, 1.0, 2.0, 0.5, 1.0 + s + 1000.0 * m, 10.0,
+                             1.5);
+            }
+        }
+        for (std::uint32_t id = 0; id < 100; ++id) {
+            assert(store.size(id) == 3 && store.timestamp_ns(id, 2) == kMinute);
+            for (std::size_t ago = 0; ago < 3; ++ago) {
+                assert(store.value(id, Field::Close, ago) ==
+                       1.0 + id + 1000.0 * static_cast<double>(2 - ago));
+            }
+        }
+        store.bar_handler()(make_bar("S5", 4));
+        assert(store.size(5) == 4);
+    }
+
+    bool threw = false;
+    try {
+        options.sma_period = 64;
+        data::BarStore invalid(options);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Bar store tests passed\n";
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/covariance.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+using Mode = data::CovarianceOptions::Mode;
+
+namespace {
+constexpr std::int64_t kMinute = 60'000'000'000;
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-12;
+}
+
+// Deterministic returns for `n` symbols; symbol 1 mirrors symbol 0 and symbol 2 doubles it.
+std::vector<std::vector<double>> make_returns(std::size_t n, std::size_t count) {
+    std::vector<std::vector<double>> rows;
+    for (std::size_t t = 0; t < count; ++t) {
+        std::vector<double> row(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto phase = static_cast<double>(t * (i + 3)) * 0.71 + static_cast<double>(i);
+            row[i] = 0.001 * std::sin(phase);
+        }
+        row[1] = -row[0];
+        row[2] = 2.0 * row[0];
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+std::vector<std::string> universe(std::size_t n) {
+    std::vector<std::string> symbols;
+    for (std::size_t i = 0; i < n; ++i) {
+        symbols.push_back("S" + std::to_string(i));
+    }
+    return symbols;
+}
+} // namespace
+
+int main() {
+    constexpr std::size_t kSymbols = 23;
+    const auto rows = make_returns(kSymbols, 120);
+
+    // Window mode matches the sample covariance of the last `window` observations.
+    {
+        data::CovarianceOptions options;
+        options.mode = Mode::Window;
+        options.window = 50;
+        options.max_concurrency = 4;
+        options.block_rows = 3;
+        data::CovarianceEngine engine(universe(kSymbols), options);
+        assert(std::isnan(engine.covariance(0, 1)));
+        for (const auto &row : rows) {
+            engine.update(row);
+        }
+        assert(engine.observations() == 120);
+
+        for (std::size_t i = 0; i < kSymbols; ++i) {
+            for (std::size_t j = 0; j < kSymbols; ++j) {
+                double mi = 0.0;
+                double mj = 0.0;
+                for (std::size_t t = 70; t < 120; ++t) {
+                    mi += rows[t][i] / 50.0;
+                    mj += rows[t][j] / 50.0;
+                }
+                double cov = 0.0;
+                for (std::size_t t = 70; t < 120; ++t) {
+                    cov += (rows[t][i] - mi) * (rows[t][j] - mj) / 49.0;
+                }
+                assert(near(engine.covariance(i, j), cov));
+                assert(near(engine.mean(i), mi));
+            }
+        }
+        assert(std::fabs(engine.correlation(0, 1) + 1.0) < 1e-9);
+        assert(std::fabs(engine.correlation(0, 2) - 1.0) < 1e-9);
+
+        const auto corr = engine.correlation_matrix();
+        const auto cov = engine.covariance_matrix();
+        for (std::size_t i = 0; i < kSymbols; ++i) {
+            assert(std::fabs(corr[i * kSymbols + i] - 1.0) < 1e-9);
+            for (std::size_t j = 0; j < kSymbols; ++j) {
+                assert(cov[i * kSymbols + j] == cov[j * kSymbols + i]);
+                assert(near(corr[i * kSymbols + j], engine.correlation(i, j)));
+            }
+        }
+    }
+
+    // Exponential mode follows the weighted recursion pair by pair, whatever the threading.
+    {
+        data::CovarianceOptions options;
+        options.decay = 0.9;
+        options.max_concurrency = 3;
+        options.block_rows = 4;
+        data::CovarianceEngine threaded(universe(kSymbols), options);
+        options.max_concurrency = 1;
+        options.block_rows = 64;
+        data::CovarianceEngine serial(universe(kSymbols), options);
+        for (const auto &row : rows) {
+            threaded.update(row);
+            serial.update(row);
+        }
+        for (std::size_t i = 0; i < kSymbols; ++i) {
+            for (std::size_t j = i; j < kSymbols; ++j) {
+                double mi = rows[0][i];
+                double mj = rows[0][j];
+                double cov = 0.0;
+                for (std::size_t t = 1; t < rows.size(); ++t) {
+                    const double di = rows[t][i] - mi;
+                    const double dj = rows[t][j] - mj;
+                    cov = 0.9 * (cov + 0.1 * di * dj);
+                    mi += 0.1 * di;
+                    mj += 0.1 * dj;
+                }
+                assert(near(threaded.covariance(i, j), cov));
+                assert(threaded.covariance(j, i) == serial.covariance(i, j));
+            }
+        }
+        assert(std::fabs(threaded.correlation(0, 1) + 1.0) < 1e-9);
+    }
+
+    // Observations straight from a bar store; symbols without a bar at the close count as flat.
+    {
+        data::BarStore::Options store_options;
+        store_options.capacity = 8;
+        store_options.sma_period = store_options.ema_period = store_options.rsi_period = 2;
+        store_options.atr_period = store_options.bollinger_period = 2;
+        store_options.vwap_period = 2;
+        data::BarStore store(store_options);
+        data::CovarianceOptions options;
+        options.mode = Mode::Window;
+        options.window = 4;
+        data::CovarianceEngine engine({"AAPL", "MSFT", "IDLE"}, options);
+
+        const double aapl[] = {100.0, 101.0, 99.0, 102.0, 103.0};
+        const double msft[] = {200.0, 202.0, 198.0, 204.0, 206.0};
+        for (int m = 0; m < 5; ++m) {
+            const std::int64_t t = (m + 1) * kMinute;
+            store.append(store.symbol_id("AAPL"), t, aapl[m], aapl[m], aapl[m], aapl[m], 1.0,
+                         aapl[m]);
+            store.append(store.symbol_id("MSFT"), t, msft[m], msft[m], msft[m], msft[m], 1.0,
+                         msft[m]);
+            engine.update(store, t);
+        }
+        assert(engine.observations() == 5);
+        // The first minute had no previous bar, so the window holds four real returns.
+        assert(std::fabs(engine.correlation(0, 1) - 1.0) < 1e-9);
+        assert(engine.variance(2) == 0.0 && std::isnan(engine.correlation(0, 2)));
+        assert(*engine.index("MSFT") == 1 && !engine.index("SPY"));
+    }
+
+    bool threw = false;
+    try {
+        data::CovarianceEngine duplicate({"AAPL", "AAPL"});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        data::CovarianceEngine engine(universe(3));
+        engine.update({0.1, 0.2});
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Covariance tests passed\n";
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "alpaca/data/live/crypto.hpp"
+#include "alpaca/data/live/event_bus.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace alpaca;
+using data::live::Delivery;
+
+namespace {
+class StreamProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::dispatch_message_impl;
+    using StockDataStream::StockDataStream;
+};
+
+class CryptoProbe : public data::live::CryptoDataStream {
+  public:
+    using CryptoDataStream::CryptoDataStream;
+    using CryptoDataStream::dispatch_message_impl;
+};
+
+// Counts how often the bus changes the stream's own subscriptions.
+class CountingProbe : public StreamProbe {
+  public:
+    using StreamProbe::StreamProbe;
+    void subscribe_trades(data::live::TradeHandler handler,
+                          const std::vector<std::string> &symbols) override {
+        ++stream_changes;
+        StreamProbe::subscribe_trades(std::move(handler), symbols);
+    }
+    void unsubscribe_trades(const std::vector<std::string> &symbols) override {
+        ++stream_changes;
+        StreamProbe::unsubscribe_trades(symbols);
+    }
+
+    std::atomic<int> stream_changes{0};
+};
+
+std::string trade_frame(const std::string &symbol, double price) {
+    return R"([{"T":"t","S":")" + symbol + R"(","i":1,"x":"V","p":)" + std::to_string(price) +
+           R"(,"s":10,"t":"2024-01-02T14:30:00Z"}])";
+}
+} // namespace
+
+int main() {
+    // Several inline subscribers share the stream's parsed event; "*" sees every symbol.
+    {
+        StreamProbe stream("key", "secret");
+        data::live::EventBus bus(stream);
+
+        std::vector<const data::Trade *> seen;
+        std::vector<std::string> wildcard;
+        const auto first = bus.subscribe_trades(
+            [&](const data::Trade &trade) { seen.push_back(&trade); }, {"AAPL"});
+        bus.subscribe_trades([&](const data::Trade &trade) { seen.push_back(&trade); },
+                             {"AAPL", "AAPL"});
+        bus.subscribe_trades([&](const data::Trade &trade) { wildcard.push_back(trade.symbol); },
+                             {"*"});
+        assert(bus.subscriber_count() == 3);
+
+        stream.dispatch_message_impl(trade_frame("AAPL", 190.5));
+        assert(seen.size() == 2 && seen[0] == seen[1]);
+        stream.dispatch_message_impl(trade_frame("MSFT", 370.0));
+        assert(seen.size() == 2);
+        assert((wildcard == std::vector<std::string>{"AAPL", "MSFT"}));
+
+        bus.unsubscribe(first);
+        bus.unsubscribe(first);
+        assert(bus.subscriber_count() == 2);
+        stream.dispatch_message_impl(trade_frame("AAPL", 191.0));
+        assert(seen.size() == 3 && wildcard.size() == 3);
+
+        // Channels the stream does not offer are rejected.
+        bool threw = false;
+        try {
+            bus.subscribe_orderbooks([](const data::Orderbook &) {}, {"AAPL"});
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // A dedicated subscriber runs on its own thread and receives its own copy of the event.
+    {
+        StreamProbe stream("key", "secret");
+        data::live::EventBus bus(stream);
+
+        std::mutex mutex;
+        std::condition_variable done;
+        std::vector<double> prices;
+        std::thread::id worker_thread;
+        const auto id = bus.subscribe_trades(
+            [&](const data::Trade &trade) {
+                std::lock_guard<std::mutex> lock(mutex);
+                worker_thread = std::this_thread::get_id();
+                prices.push_back(trade.price);
+                done.notify_one();
+            },
+            {"AAPL"}, Delivery::Dedicated);
+        int inline_calls = 0;
+        bus.subscribe_trades([&](const data::Trade &) { ++inline_calls; }, {"AAPL"});
+
+        stream.dispatch_message_impl(trade_frame("AAPL", 100.0));
+        stream.dispatch_message_impl(trade_frame("AAPL", 101.0));
+        assert(inline_calls == 2);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const bool delivered = done.wait_for(lock, std::chrono::seconds(5),
+                                                 [&] { return prices.size() == 2; });
+            assert(delivered);
+            assert(prices[0] == 100.0 && prices[1] == 101.0);
+            assert(worker_thread != std::this_thread::get_id());
+        }
+        bus.unsubscribe(id);
+        stream.dispatch_message_impl(trade_frame("AAPL", 102.0));
+        assert(inline_calls == 3);
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(prices.size() == 2);
+    }
+
+    // A full dedicated queue drops its oldest events instead of holding up the reader.
+    {
+        StreamProbe stream("key", "secret");
+        data::live::EventBus bus(stream, 4);
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool started = false;
+        bool release = false;
+        std::vector<double> prices;
+        bus.subscribe_trades(
+            [&](const data::Trade &trade) {
+                std::unique_lock<std::mutex> lock(mutex);
+                prices.push_back(trade.price);
+                started = true;
+                changed.notify_all();
+                changed.wait_for(lock, std::chrono::seconds(5), [&] { return release; });
+            },
+            {"AAPL"}, Delivery::Dedicated);
+
+        stream.dispatch_message_impl(trade_frame("AAPL", 0.0));
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            assert(changed.wait_for(lock, std::chrono::seconds(5), [&] { return started; }));
+        }
+        for (int i = 1; i <= 10; ++i) {
+            stream.dispatch_message_impl(trade_frame("AAPL", i));
+        }
+        assert(bus.dropped() == 6);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            release = true;
+            changed.notify_all();
+            assert(changed.wait_for(lock, std::chrono::seconds(5),
+                                    [&] { return prices.size() == 5; }));
+            assert((prices == std::vector<double>{0.0, 7.0, 8.0, 9.0, 10.0}));
+        }
+    }
+
+    // While events flow on the reader thread, subscribers can come and go for symbols the bus
+    // already carries; the stream's own tables are left alone.
+    {
+        CountingProbe stream("key", "secret");
+        data::live::EventBus bus(stream);
+        std::atomic<int> anchor_calls{0};
+        bus.subscribe_trades([&](const data::Trade &) { ++anchor_calls; }, {"AAPL"});
+        assert(stream.stream_changes == 1);
+
+        std::atomic<bool> stop{false};
+        std::thread reader([&] {
+            while (!stop) {
+                stream.dispatch_message_impl(trade_frame("AAPL", 1.0));
+            }
+        });
+        std::atomic<int> extra_calls{0};
+        for (int i = 0; i < 2000; ++i) {
+            const auto delivery = i % 2 ? Delivery::Dedicated : Delivery::Inline;
+            const auto id = bus.subscribe_trades([&](const data::Trade &) { ++extra_calls; },
+                                                 {"AAPL"}, delivery);
+            bus.unsubscribe(id);
+        }
+        stop = true;
+        reader.join();
+        assert(stream.stream_changes == 1 && bus.subscriber_count() == 1);
+        assert(anchor_calls > 0);
+    }
+
+    // Crypto streams expose orderbooks through the bus.
+    {
+        CryptoProbe stream("key", "secret");
+        data::live::EventBus bus(stream);
+        int books = 0;
+        bus.subscribe_orderbooks(
+            [&](const data::Orderbook &book) {
+                assert(book.symbol == "BTC/USD" && book.bids.size() == 1);
+                ++books;
+            },
+            {"BTC/USD"});
+        bus.subscribe_orderbooks([&](const data::Orderbook &) { ++books; }, {"*"});
+        stream.dispatch_message_impl(
+            R"([{"T":"o","S":"BTC/USD","t":"2024-01-02T00:00:00Z",)"
+            R"("b":[{"p":45000.0,"s":1.2}],"a":[{"p":45010.0,"s":0.8}]}])");
+        assert(books == 2);
+    }
+
+    std::cout << "Event bus tests passed\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "alpaca/data/greeks.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace alpaca;
+
+namespace {
+constexpr std::int64_t kNanosPerDay = 86'400'000'000'000;
+
+bool near(double a, double b, double tolerance) { return std::abs(a - b) <= tolerance; }
+
+double bs_price(double spot, double strike, double years, double rate, double vol, bool call) {
+    const double vol_t = vol * std::sqrt(years);
+    const double d1 = (std::log(spot / strike) + rate * years) / vol_t + 0.5 * vol_t;
+    const double d2 = d1 - vol_t;
+    const auto cdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+    const double df = std::exp(-rate * years);
+    return call ? spot * cdf(d1) - strike * df * cdf(d2)
+                : strike * df * cdf(-d2) - spot * cdf(-d1);
+}
+
+std::string occ(const char *root, const char *date, char side, double strike) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%s%s%c%08lld", root, date, side,
+                  static_cast<long long>(std::llround(strike * 1000)));
+    return buffer;
+}
+
+data::Quote quote(const std::string &symbol, double bid, double ask) {
+    data::Quote q;
+    q.symbol = symbol;
+    q.bid_price = bid;
+    q.ask_price = ask;
+    q.contract_key = trading::option_key(symbol);
+    return q;
+}
+} // namespace
+
+int main() {
+    data::GreeksEngine::Options options;
+    options.rate = 0.05;
+    data::GreeksEngine engine(options);
+
+    // Expiry 2025-01-17 at 21:00 UTC, valued exactly one year earlier.
+    const std::int64_t expiry_ns = core::days_from_civil(2025, 1, 17) * kNanosPerDay +
+                                   21LL * 3600 * 1'000'000'000;
+    const std::int64_t now_ns = expiry_ns - 365 * kNanosPerDay;
+
+    const auto call = engine.add_contract("XYZ250117C00100000", "XYZ");
+    const auto put = engine.add_contract("XYZ250117P00100000", "XYZ");
+    const auto deep = engine.add_contract("XYZ250117C00050000", "XYZ");
+    assert(engine.add_contract("XYZ250117C00100000", "XYZ") == call);
+    assert(engine.size() == 3 && *engine.find("XYZ250117P00100000") == put);
+    bool threw = false;
+    try {
+        (void)engine.add_contract("XYZ", "XYZ");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Quotes arrive through the stream handlers; prices are Black-Scholes at 20% vol.
+    auto on_option = engine.option_quote_handler();
+    auto on_underlying = engine.underlying_quote_handler();
+    on_option(quote("XYZ250117C00100000", 10.4406, 10.4606));
+    on_option(quote("XYZ250117P00100000", 5.5635, 5.5835));
+    on_option(quote("XYZ250117C00050000", 40.0, 40.5)); // below intrinsic: no solution
+    on_option(quote("ABC250117C00100000", 1.0, 1.1));   // unknown contract: ignored
+    assert(engine.recompute(now_ns) == 3);
+    assert(std::isnan(engine.implied_volatility()[call])); // no spot yet
+
+    on_underlying(quote("XYZ", 99.99, 100.01));
+    assert(engine.recompute(now_ns) == 3);
+    assert(engine.recompute(now_ns) == 0);
+
+    assert(near(engine.implied_volatility()[call], 0.2, 1e-4));
+    assert(near(engine.delta()[call], 0.6368, 1e-4));
+    assert(near(engine.gamma()[call], 0.018762, 1e-5));
+    assert(near(engine.vega()[call], 0.37524, 1e-4));
+    assert(near(engine.theta()[call], -6.4140 / 365.0, 1e-5));
+    assert(near(engine.rho()[call], 0.53232, 1e-4));
+    assert(near(engine.implied_volatility()[put], 0.2, 1e-4));
+    assert(near(engine.delta()[put], 0.6368 - 1.0, 1e-4));
+    assert(near(engine.gamma()[put], engine.gamma()[call], 1e-5));
+    assert(std::isnan(engine.implied_volatility()[deep]) && std::isnan(engine.delta()[deep]));
+
+    // Only contracts whose inputs changed are recomputed.
+    engine.set_option_quote(call, 11.0, 11.1);
+    assert(engine.recompute(now_ns) == 1);
+    assert(engine.implied_volatility()[call] > 0.2);
+    assert(near(engine.implied_volatility()[put], 0.2, 1e-4));
+    engine.mark_all_dirty();
+    assert(engine.recompute(now_ns + kNanosPerDay) == 3);
+    assert(engine.recompute(expiry_ns) == 0);
+    engine.mark_all_dirty();
+    engine.recompute(expiry_ns);
+    assert(std::isnan(engine.implied_volatility()[put])); // expired
+
+    // A one-day contract priced at half the spot needs more than the 1000% vol cap: the solve
+    // stops at the cap without matching the price, so it reports NaN rather than 10.0.
+    data::GreeksEngine capped(options);
+    const auto overnight = capped.add_contract("XYZ240119C00100000", "XYZ");
+    capped.set_underlying_price("XYZ", 100.0);
+    capped.set_option_quote(overnight, 50.0, 50.2);
+    assert(capped.recompute(now_ns) == 1);
+    assert(std::isnan(capped.implied_volatility()[overnight]));
+    assert(std::isnan(capped.delta()[overnight]));
+    capped.set_option_quote(overnight, 1.1, 1.2);
+    assert(capped.recompute(now_ns) == 1);
+    assert(std::isfinite(capped.implied_volatility()[overnight]));
+
+    // A whole chain round-trips: IVs recovered from prices across strikes, sides and expiries.
+    data::GreeksEngine chain;
+    const double spot = 450.0;
+    std::size_t expected = 0;
+    for (const char *date : {"250117", "250321", "250620", "251219"}) {
+        const auto parsed = trading::parse_occ_symbol(std::string("SPY") + date + "C00450000");
+        const std::int64_t expiry =
+            parsed->expiry_days * kNanosPerDay + 21LL * 3600 * 1'000'000'000;
+        const double years = static_cast<double>(expiry - now_ns) / (365.0 * kNanosPerDay);
+        for (double strike = 300.0; strike <= 600.0; strike += 2.5) {
+            for (char side : {'C', 'P'}) {
+                const double vol = 0.15 + 0.2 * std::abs(std::log(strike / spot));
+                const double price = bs_price(spot, strike, years, 0.0, vol, side == 'C');
+                if (price < 0.05) {
+                    continue;
+                }
+                const auto row = chain.add_contract(occ("SPY", date, side, strike), "SPY");
+                chain.set_option_quote(row, price, price);
+                ++expected;
+            }
+        }
+    }
+    chain.set_underlying_price("SPY", spot);
+    assert(chain.recompute(now_ns) == expected);
+    for (std::uint32_t row = 0; row < chain.size(); ++row) {
+        const auto parsed = trading::parse_occ_symbol(chain.symbol(row));
+        const double vol = 0.15 + 0.2 * std::abs(std::log(parsed->strike() / spot));
+        assert(near(chain.implied_volatility()[row], vol, 1e-6));
+    }
+
+    std::cout << "Greeks engine tests passed\n";
+    return 0;
+}
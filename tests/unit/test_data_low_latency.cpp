@@ -0,0 +1,109 @@
+#include "alpaca/core/thread.hpp"
+#include "low_latency.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace alpaca;
+
+namespace {
+namespace net = boost::asio;
+namespace websocket = boost::beast::websocket;
+using tcp = net::ip::tcp;
+
+// Accepts one websocket client, sends `count` numbered messages, then holds the connection
+// open without sending anything until `release` is set.
+void server(tcp::acceptor &acceptor, int count, const std::atomic<bool> &release) {
+    net::io_context ioc;
+    tcp::socket socket(ioc);
+    acceptor.accept(socket);
+    websocket::stream<tcp::socket> ws(std::move(socket));
+    ws.accept();
+    for (int i = 0; i < count; ++i) {
+        ws.write(net::buffer("m" + std::to_string(i)));
+    }
+    while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+} // namespace
+
+int main() {
+    // Pinning rejects invalid CPUs and, on Linux, restricts the thread to the one asked for.
+    assert(!core::pin_current_thread_to_cpu(-1));
+    assert(!core::pin_current_thread_to_cpu(1 << 20));
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    assert(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    int first = 0;
+    while (!CPU_ISSET(static_cast<std::size_t>(first), &allowed)) {
+        ++first;
+    }
+    std::thread pinned([first] {
+        assert(core::pin_current_thread_to_cpu(first));
+        cpu_set_t now;
+        CPU_ZERO(&now);
+        assert(sched_getaffinity(0, sizeof(now), &now) == 0);
+        assert(CPU_COUNT(&now) == 1 && CPU_ISSET(static_cast<std::size_t>(first), &now));
+    });
+    pinned.join();
+#endif
+
+    // The busy-poll reader delivers every message in order and stops promptly when asked.
+    net::io_context ioc;
+    tcp::acceptor acceptor(ioc, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0));
+    std::atomic<bool> release{false};
+    std::thread feed(server, std::ref(acceptor), 50, std::cref(release));
+
+    websocket::stream<tcp::socket> ws(ioc);
+    ws.next_layer().connect(acceptor.local_endpoint());
+    data::live::LowLatencyOptions options;
+    options.receive_buffer_bytes = 1 << 20;
+    data::live::apply_socket_options(ws.next_layer(), options);
+    net::ip::tcp::no_delay no_delay;
+    ws.next_layer().get_option(no_delay);
+    assert(no_delay.value());
+    ws.handshake("127.0.0.1", "/");
+
+    std::atomic<bool> keep_running{true};
+    std::mutex write_mutex;
+    const std::optional<data::live::LowLatencyOptions> low_latency = options;
+    for (int i = 0; i < 50; ++i) {
+        boost::beast::flat_buffer buffer;
+        boost::system::error_code ec;
+        data::live::read_frame(ws, ioc, buffer, ec, nullptr, write_mutex, low_latency,
+                               keep_running);
+        assert(!ec && boost::beast::buffers_to_string(buffer.data()) == "m" + std::to_string(i));
+    }
+
+    std::thread stopper([&keep_running] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        keep_running = false;
+    });
+    boost::beast::flat_buffer buffer;
+    boost::system::error_code ec;
+    const auto start = std::chrono::steady_clock::now();
+    data::live::read_frame(ws, ioc, buffer, ec, nullptr, write_mutex, low_latency, keep_running);
+    assert(ec == net::error::operation_aborted);
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+    stopper.join();
+    release = true;
+    feed.join();
+
+    std::cout << "Low-latency reader tests passed\n";
+    return 0;
+}
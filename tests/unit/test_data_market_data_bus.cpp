@@ -0,0 +1,177 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/live/market_data_bus.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace alpaca;
+using data::live::BusEvent;
+using data::live::BusEventType;
+
+namespace {
+class StreamProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::dispatch_message_impl;
+    using StockDataStream::StockDataStream;
+};
+
+data::Trade make_trade(const std::string &symbol, double price, int id) {
+    data::Trade trade;
+    trade.symbol = symbol;
+    trade.timestamp = "2024-01-02T14:30:00.123456789Z";
+    trade.price = price;
+    trade.size = 100;
+    trade.exchange = "V";
+    trade.id = std::to_string(id);
+    return trade;
+}
+} // namespace
+
+int main() {
+    const std::string name = "alpaca_bus_test_" + std::to_string(::getpid());
+
+    // Events round-trip through the ring in order, with their type-specific fields.
+    {
+        data::live::MarketDataBusPublisher publisher(name, 1000);
+        assert(publisher.capacity() == 1024);
+        data::live::MarketDataBusSubscriber subscriber(name);
+        assert(subscriber.capacity() == 1024);
+
+        BusEvent event;
+        assert(!subscriber.poll(event));
+
+        publisher.publish(make_trade("AAPL", 190.5, 42));
+        data::Quote quote;
+        quote.symbol = "MSFT";
+        quote.bid_price = 370.1;
+        quote.bid_size = 2;
+        quote.ask_price = 370.2;
+        quote.ask_size = 3;
+        quote.bid_exchange = "Q";
+        quote.ask_exchange = "Z";
+        publisher.publish(quote);
+        data::Bar bar;
+        bar.symbol = "SPY";
+        bar.timestamp = "2024-01-02T14:31:00Z";
+        bar.open = 470.0;
+        bar.high = 471.0;
+        bar.low = 469.5;
+        bar.close = 470.5;
+        bar.volume = 12000;
+        bar.trade_count = 310;
+        bar.vwap = 470.25;
+        assert(publisher.publish(bar) == 3 && publisher.sequence() == 3);
+        assert(subscriber.backlog() == 3);
+
+        assert(subscriber.poll(event) && event.sequence == 1 && event.type == BusEventType::Trade);
+        assert(event.published_ns > 0);
+        const data::Trade trade = data::live::to_trade(event);
+        assert(trade.symbol == "AAPL" && trade.price == 190.5 && trade.size == 100);
+        assert(trade.exchange == "V" && trade.id == "42");
+        assert(trade.timestamp == "2024-01-02T14:30:00.123456789Z");
+
+        assert(subscriber.poll(event) && event.type == BusEventType::Quote);
+        const data::Quote got_quote = data::live::to_quote(event);
+        assert(got_quote.symbol == "MSFT" && got_quote.bid_price == 370.1);
+        assert(got_quote.ask_size == 3 && got_quote.ask_exchange == "Z");
+
+        assert(subscriber.poll(event) && event.type == BusEventType::Bar);
+        const data::Bar got_bar = data::live::to_bar(event);
+        assert(got_bar.close == 470.5 && got_bar.trade_count == 310.0 && got_bar.vwap == 470.25);
+        assert(!subscriber.poll(event) && subscriber.lost() == 0 && subscriber.backlog() == 0);
+
+        // A late subscriber starts with the next event unless it asks for the oldest.
+        data::live::MarketDataBusSubscriber late(name);
+        data::live::MarketDataBusSubscriber replaying(name, true);
+        assert(late.next_sequence() == 4 && replaying.next_sequence() == 1);
+    }
+
+    // An overrun subscriber counts what it missed and resumes at the oldest retained event.
+    {
+        data::live::MarketDataBusPublisher publisher(name, 8);
+        data::live::MarketDataBusSubscriber subscriber(name);
+        subscriber.enable_latency_stats();
+        for (int i = 1; i <= 20; ++i) {
+            publisher.publish(make_trade("AAPL", 100.0 + i, i));
+        }
+        std::uint64_t expected = 13;
+        const std::size_t drained = subscriber.drain([&](const BusEvent &event) {
+            assert(event.sequence == expected++);
+        });
+        assert(drained == 8 && subscriber.lost() == 12);
+        assert(subscriber.latency_stats()->count() == 8);
+    }
+
+    // A subscriber in another process sees every event in order.
+    {
+        constexpr int kEvents = 50000;
+        data::live::MarketDataBusPublisher publisher(name, 1 << 16);
+        const pid_t child = ::fork();
+        assert(child >= 0);
+        if (child == 0) {
+            data::live::MarketDataBusSubscriber subscriber(name, true);
+            BusEvent event;
+            std::uint64_t expected = 1;
+            while (expected <= kEvents) {
+                if (subscriber.poll(event)) {
+                    const auto id = static_cast<double>(event.extra);
+                    if (event.sequence != expected++ || event.values[0] != 100.0 + id) {
+                        ::_exit(1);
+                    }
+                }
+            }
+            ::_exit(subscriber.lost() == 0 ? 0 : 2);
+        }
+        for (int i = 1; i <= kEvents; ++i) {
+            publisher.publish(make_trade("AAPL", 100.0 + i, i));
+        }
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // An attached stream publishes what its reader thread parses.
+    {
+        data::live::MarketDataBusPublisher publisher(name, 64);
+        StreamProbe stream("key", "secret");
+        publisher.attach(stream, {"AAPL"});
+        bool threw = false;
+        try {
+            publisher.attach(stream, {"MSFT"});
+        } catch (const std::logic_error &) {
+            threw = true;
+        }
+        assert(threw);
+
+        data::live::MarketDataBusSubscriber subscriber(name);
+        stream.dispatch_message_impl(
+            R"([{"T":"t","S":"AAPL","i":7,"x":"V","p":191.25,"s":50,"t":"2024-01-02T14:30:01Z"},)"
+            R"({"T":"q","S":"AAPL","bp":191.2,"bs":1,"ap":191.3,"as":2,)"
+            R"("t":"2024-01-02T14:30:01Z"}])");
+        BusEvent event;
+        assert(subscriber.poll(event) && event.type == BusEventType::Trade);
+        assert(event.symbol_view() == "AAPL" && event.values[0] == 191.25 && event.extra == 7);
+        assert(event.timestamp_ns == *core::parse_timestamp_ns("2024-01-02T14:30:01Z"));
+        assert(subscriber.poll(event) && event.type == BusEventType::Quote);
+        assert(!subscriber.poll(event));
+    }
+
+    // The bus disappears with its publisher.
+    bool threw = false;
+    try {
+        data::live::MarketDataBusSubscriber missing(name);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Market data bus tests passed\n";
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/option_chain.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+std::string occ(const std::string &root, const char *date, char side, int strike) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%s%s%c%08d", root.c_str(), date, side, strike * 1000);
+    return buffer;
+}
+
+// Serves each underlying's chain in pages of one expiry: 240119 first, then 240216. Puts are
+// not listed at strike 110. Safe for concurrent send() calls.
+class ChainTransport final : public core::IHttpTransport {
+  public:
+    core::HttpResponse send(const core::HttpRequest &request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            urls_.push_back(request.url);
+        }
+        const auto begin = request.url.find("/snapshots/") + 11;
+        const auto root = request.url.substr(begin, request.url.find('?') - begin);
+        const bool second_page = request.url.find("page_token=next") != std::string::npos;
+        const char *date = second_page ? "240216" : "240119";
+
+        std::string body = "{\"snapshots\":{";
+        bool first = true;
+        for (int strike = 90; strike <= 110; strike += 5) {
+            for (char side : {'C', 'P'}) {
+                if (side == 'P' && strike == 110) {
+                    continue;
+                }
+                if (!first) {
+                    body += ',';
+                }
+                first = false;
+                const double delta = side == 'C' ? 0.5 - (strike - 100) / 40.0 : -0.5;
+                body += "\"" + occ(root, date, side, strike) +
+                        "\":{\"latestQuote\":{\"t\":\"2024-01-02T15:00:00Z\",\"bp\":1.0,\"bs\":1,"
+                        "\"ap\":1.2,\"as\":1},\"impliedVolatility\":0.25,\"greeks\":{\"delta\":" +
+                        std::to_string(delta) + ",\"gamma\":0.05}}";
+            }
+        }
+        body += "}";
+        body += second_page ? ",\"next_page_token\":null}" : ",\"next_page_token\":\"next\"}";
+        return {200, {}, body};
+    }
+
+    std::vector<std::string> urls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return urls_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::string> urls_;
+};
+} // namespace
+
+int main() {
+    const auto jan19 = static_cast<std::int32_t>(core::days_from_civil(2024, 1, 19));
+    const auto feb16 = static_cast<std::int32_t>(core::days_from_civil(2024, 2, 16));
+
+    // Unsorted input, a duplicate and a non-OCC symbol.
+    data::OptionChain manual("AAPL");
+    data::OptionsSnapshotResponse page;
+    for (auto [symbol, iv] : std::vector<std::pair<std::string, double>>{
+             {occ("AAPL", "240216", 'P', 190), 0.3},
+             {occ("AAPL", "240119", 'C', 195), 0.2},
+             {occ("AAPL", "240119", 'C', 190), 0.1},
+             {occ("AAPL", "240119", 'P', 190), 0.4},
+             {occ("AAPL", "240119", 'C', 190), 0.15},
+             {"AAPL", 0.9}}) {
+        data::OptionsSnapshot snapshot;
+        snapshot.symbol = symbol;
+        snapshot.implied_volatility = iv;
+        page.snapshots.push_back(snapshot);
+    }
+    manual.add(page);
+    manual.build_index();
+    assert(manual.size() == 4);
+    assert(manual.expiries().size() == 2);
+    assert(manual.expiries()[0].days == jan19 && manual.expiries()[1].days == feb16);
+    const auto *front = manual.find_expiry(jan19);
+    assert(front && manual.strikes(*front).size() == 2);
+    const auto pair = manual.strikes(*front)[0];
+    assert(pair.strike == 190.0 && pair.call != data::OptionChain::npos);
+    assert(manual.implied_volatility[pair.call] == 0.15);
+    assert(manual.implied_volatility[pair.put] == 0.4);
+    assert(manual.strikes(*front)[1].put == data::OptionChain::npos);
+    assert(std::isnan(manual.delta[pair.call]) && std::isnan(manual.bid[pair.put]));
+    assert(manual.symbol[*manual.find(feb16, 190.0, trading::ContractType::Put)] ==
+           occ("AAPL", "240216", 'P', 190));
+    assert(!manual.find(feb16, 190.0, trading::ContractType::Call));
+    assert(!manual.find(jan19 + 1, 190.0, trading::ContractType::Call));
+    assert(manual.nearest_expiry(jan19 + 10)->days == jan19);
+    assert(manual.nearest_expiry(jan19 + 14)->days == feb16);
+    assert(manual.nearest_expiry(feb16 + 100)->days == feb16);
+
+    // Paginated, parallel fetch across underlyings.
+    auto transport = std::make_shared<ChainTransport>();
+    data::DataClient client(core::ClientConfig::WithPaperKeys("key", "secret"), transport);
+    std::vector<data::OptionChainRequest> requests(3);
+    requests[0].underlying_symbol = "SPY";
+    requests[1].underlying_symbol = "QQQ";
+    requests[2].underlying_symbol = "IWM";
+    data::OptionChainFetchOptions options;
+    options.page_limit = 250;
+    const auto chains = data::fetch_option_chains(client, requests, options);
+
+    const auto urls = transport->urls();
+    assert(urls.size() == 6);
+    for (const auto &url : urls) {
+        assert(url.find("limit=250") != std::string::npos);
+    }
+    assert(chains.size() == 3 && chains[1].underlying() == "QQQ");
+    for (const auto &chain : chains) {
+        assert(chain.size() == 18 && chain.expiries().size() == 2);
+    }
+
+    // All strikes within 5% of spot at the expiry closest to 30 days out.
+    const auto &spy = chains[0];
+    const double spot = 100.0;
+    const auto *expiry = spy.nearest_expiry(jan19 - 2 + 30);
+    assert(expiry && expiry->days == feb16);
+    const auto near = spy.strikes_between(*expiry, spot * 0.95, spot * 1.05);
+    assert(near.size() == 3 && near.front().strike == 95.0 && near.back().strike == 105.0);
+    for (const auto &row : near) {
+        assert(spy.symbol[row.call].rfind("SPY240216C", 0) == 0);
+        assert(spy.type[row.put] == trading::ContractType::Put);
+        assert(spy.gamma[row.call] == 0.05 && spy.implied_volatility[row.put] == 0.25);
+    }
+    assert(std::abs(spy.delta[near[1].call] - 0.5) < 1e-9);
+    assert(spy.contract_key[near[1].put] == trading::option_key("SPY240216P00100000"));
+    assert(spy.bid[near[1].call] == 1.0 && spy.ask[near[1].call] == 1.2);
+    assert(spy.strikes_between(*expiry, 111.0, 120.0).empty());
+
+    std::cout << "Option chain tests passed\n";
+    return 0;
+}
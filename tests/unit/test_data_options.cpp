@@ -3,6 +3,7 @@
 #include "alpaca/data/client.hpp"
 #include "alpaca/data/timeframe.hpp"
 #include "alpaca/trading/enums.hpp"
+#include "alpaca/trading/option_symbol.hpp"
 
 #include <cassert>
 #include <iostream>
@@ -142,6 +143,7 @@ int main() {
     chain_request.updated_since = std::string("2023-08-31T00:00:00Z");
     const auto option_chain = client.get_option_chain(chain_request);
     assert(option_chain.snapshots.size() == 1);
+    assert(option_chain.snapshots[0].contract_key == trading::option_key("AAPL230915C00150000"));
     const auto &chain_req = transport->requests().back();
     if (chain_req.url.find("/v1beta1/options/snapshots/AAPL") == std::string::npos ||
         chain_req.url.find("feed=indicative") == std::string::npos ||
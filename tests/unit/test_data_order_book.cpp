@@ -0,0 +1,92 @@
+#include "alpaca/core/mock_http_transport.hpp"
+#include "alpaca/data/order_book.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace alpaca;
+
+namespace {
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+} // namespace
+
+int main() {
+    data::OrderBook book("BTC/USD");
+    assert(book.empty());
+    assert(!book.mid());
+
+    data::Orderbook snapshot;
+    snapshot.symbol = "BTC/USD";
+    snapshot.timestamp = "2024-01-02T00:00:00Z";
+    snapshot.reset = true;
+    snapshot.bids = {{99.0, 2.0}, {100.0, 1.0}, {98.0, 5.0}, {97.0, 0.0}};
+    snapshot.asks = {{102.0, 4.0}, {101.0, 3.0}};
+    book.apply(snapshot);
+
+    assert(book.bid_depth() == 3 && book.ask_depth() == 2);
+    assert(near(book.bid()->price, 100.0) && near(book.bid(2)->price, 98.0));
+    assert(!book.bid(3));
+    assert(near(book.ask()->price, 101.0) && near(book.ask(1)->price, 102.0));
+    assert(near(*book.mid(), 100.5));
+    assert(near(*book.spread(), 1.0));
+    // Best bid 100 x 1, best ask 101 x 3: the thin bid pulls the microprice towards it.
+    assert(near(*book.microprice(), (100.0 * 3.0 + 101.0 * 1.0) / 4.0));
+    assert(near(*book.imbalance(), (1.0 - 3.0) / 4.0));
+    assert(near(book.bid_size(2), 3.0));
+
+    // Deltas: new best bid, size change, level removal.
+    data::Orderbook delta;
+    delta.symbol = "BTC/USD";
+    delta.bids = {{100.5, 1.5}, {99.0, 0.0}};
+    delta.asks = {{101.0, 1.0}};
+    book.apply(delta);
+    assert(book.bid_depth() == 3);
+    assert(near(book.bid()->price, 100.5) && near(book.bid(1)->price, 100.0));
+    assert(near(book.bid(2)->price, 98.0));
+    assert(near(book.ask()->size, 1.0));
+    assert(book.timestamp() == "2024-01-02T00:00:00Z");
+
+    // A reset drops every level not in the snapshot.
+    data::Orderbook reset;
+    reset.symbol = "BTC/USD";
+    reset.reset = true;
+    reset.bids = {{90.0, 1.0}};
+    book.apply(reset);
+    assert(book.bid_depth() == 1 && book.ask_depth() == 0);
+    assert(!book.microprice());
+
+    // Seeding from REST and keeping the set current through the stream handler.
+    auto config = core::ClientConfig::WithPaperKeys("key", "secret");
+    auto transport = std::make_shared<core::MockHttpTransport>();
+    transport->enqueue_response(
+        {200,
+         {},
+         R"({"orderbooks":{"ETH/USD":{"t":"2024-01-02T00:00:00Z","b":[{"p":2000.0,"s":1.0}],"a":[{"p":2001.0,"s":2.0}]}}})"});
+    data::DataClient client(config, transport);
+
+    data::OrderBookSet books;
+    books.seed(client, {"ETH/USD"});
+    assert(books.size() == 1);
+    const auto *eth = books.find("ETH/USD");
+    assert(eth && near(*eth->mid(), 2000.5));
+    assert(transport->requests()[0].url.find("/latest/orderbooks") != std::string::npos);
+
+    int updates = 0;
+    auto handler = books.updater([&](const data::OrderBook &updated) {
+        ++updates;
+        assert(updated.symbol() == "ETH/USD");
+    });
+    data::Orderbook eth_delta;
+    eth_delta.symbol = "ETH/USD";
+    eth_delta.asks = {{2000.75, 0.5}};
+    handler(eth_delta);
+    assert(updates == 1);
+    assert(near(books.find("ETH/USD")->ask()->price, 2000.75));
+    assert(books.find("SOL/USD") == nullptr);
+
+    std::cout << "Order book tests passed\n";
+    return 0;
+}
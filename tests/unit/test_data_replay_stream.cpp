@@ -0,0 +1,167 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/live/replay.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+constexpr std::int64_t kBase = 1'704'207'600'000'000'000; // 2024-01-02T15:00:00Z
+
+std::string at(std::int64_t offset_ns) { return core::format_timestamp_ns(kBase + offset_ns); }
+
+data::Trade trade(const char *symbol, std::int64_t offset_ns, double price) {
+    data::Trade t;
+    t.symbol = symbol;
+    t.timestamp = at(offset_ns);
+    t.price = price;
+    return t;
+}
+
+data::Quote quote(const char *symbol, std::int64_t offset_ns, double bid) {
+    data::Quote q;
+    q.symbol = symbol;
+    q.timestamp = at(offset_ns);
+    q.bid_price = bid;
+    return q;
+}
+
+data::Bar bar(const char *symbol, std::int64_t offset_ns, double close) {
+    data::Bar b;
+    b.symbol = symbol;
+    b.timestamp = at(offset_ns);
+    b.close = close;
+    return b;
+}
+
+// Serves AAPL trades in two pages by token.
+class TradePages final : public core::IHttpTransport {
+  public:
+    core::HttpResponse send(const core::HttpRequest &request) override {
+        urls.push_back(request.url);
+        if (request.url.find("page_token=p2") != std::string::npos) {
+            return {200, {}, R"({"trades":{"AAPL":[{"t":")" + at(30) +
+                                 R"(","p":3,"s":1}]},"next_page_token":null})"};
+        }
+        return {200, {}, R"({"trades":{"AAPL":[{"t":")" + at(10) + R"(","p":1,"s":1},{"t":")" +
+                             at(20) + R"(","p":2,"s":1}]},"next_page_token":"p2"})"};
+    }
+    std::vector<std::string> urls;
+};
+} // namespace
+
+int main() {
+    // Cached trades, quotes and bars across symbols are merged by time; bars are delivered when
+    // their minute closes.
+    {
+        data::live::ReplayDataStream stream;
+        stream.add_trades({trade("AAPL", 5, 1.0), trade("AAPL", 30, 2.0), trade("MSFT", 10, 3.0)});
+        stream.add_quotes({quote("AAPL", 10, 0.5), quote("MSFT", 1, 2.5)});
+        stream.add_bars({bar("AAPL", -60'000'000'000 + 20, 9.0)});
+
+        std::vector<std::string> log;
+        stream.subscribe_trades(
+            [&](const data::Trade &t) { log.push_back("T " + t.symbol + " " + t.timestamp); },
+            {"AAPL", "MSFT"});
+        stream.subscribe_quotes(
+            [&](const data::Quote &q) { log.push_back("Q " + q.symbol + " " + q.timestamp); },
+            {"*"});
+        stream.subscribe_bars([&](const data::Bar &b) { log.push_back("B " + b.symbol); },
+                              {"AAPL", "IBM"});
+
+        assert(stream.advance_to(kBase + 10) == 4);
+        assert(stream.clock_ns() == kBase + 10);
+        assert(log[0] == "Q MSFT " + at(1) && log[1] == "T AAPL " + at(5));
+        assert(log[2] == "T MSFT " + at(10) && log[3] == "Q AAPL " + at(10)); // trades first
+        bool threw = false;
+        try {
+            stream.add_trades({trade("AAPL", 40, 1.0)});
+        } catch (const std::logic_error &) {
+            threw = true;
+        }
+        assert(threw);
+
+        assert(!stream.finished());
+        assert(stream.replay() == 2 && stream.finished());
+        assert(log[4] == "B AAPL" && log[5] == "T AAPL " + at(30));
+        assert(stream.clock_ns() == kBase + 30);
+
+        // reset() replays from the start with the current subscriptions.
+        stream.unsubscribe_quotes({"*"});
+        stream.reset();
+        log.clear();
+        assert(stream.replay() == 4 && log.size() == 4);
+    }
+
+    // History fetched page by page from the REST API.
+    {
+        auto transport = std::make_shared<TradePages>();
+        auto client = std::make_shared<data::DataClient>(
+            core::ClientConfig::WithPaperKeys("key", "secret"), transport);
+        data::live::ReplayOptions options;
+        options.start = "2024-01-02T15:00:00Z";
+        options.feed = data::DataFeed::Sip;
+        data::live::ReplayDataStream stream(client, options);
+        std::vector<double> prices;
+        stream.subscribe_trades([&](const data::Trade &t) { prices.push_back(t.price); }, {"AAPL"});
+        assert(stream.advance_to(kBase + 15) == 1 && transport->urls.size() == 1);
+        assert(stream.replay() == 2 && transport->urls.size() == 2);
+        assert((prices == std::vector<double>{1.0, 2.0, 3.0}));
+        assert(transport->urls[0].find("symbols=AAPL") != std::string::npos);
+        assert(transport->urls[0].find("feed=sip") != std::string::npos);
+    }
+
+    // run() replays on the worker thread and ends by itself; paced replay follows the clock.
+    {
+        data::live::ReplayOptions options;
+        options.speed = 1000.0; // 50 ms of history in about 50 us
+        data::live::ReplayDataStream stream(options);
+        std::vector<data::Trade> trades;
+        for (int i = 0; i < 50; ++i) {
+            trades.push_back(trade("SPY", i * 1'000'000LL, i));
+        }
+        stream.add_trades(trades);
+        std::atomic<int> count{0};
+        stream.subscribe_trades([&](const data::Trade &) { ++count; }, {"SPY"});
+        stream.run();
+        for (int i = 0; i < 2000 && count < 50; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(count == 50);
+        stream.stop();
+    }
+
+    // Throughput at maximum speed.
+    {
+        data::live::ReplayDataStream stream;
+        std::vector<data::Trade> trades;
+        std::vector<data::Quote> quotes;
+        for (const char *symbol : {"AAPL", "MSFT", "NVDA", "SPY"}) {
+            for (std::int64_t i = 0; i < 50'000; ++i) {
+                trades.push_back(trade(symbol, i * 1000, 1.0));
+                quotes.push_back(quote(symbol, i * 1000 + 500, 1.0));
+            }
+        }
+        stream.add_trades(trades);
+        stream.add_quotes(quotes);
+        std::size_t seen = 0;
+        stream.subscribe_trades([&](const data::Trade &) { ++seen; }, {"*"});
+        stream.subscribe_quotes([&](const data::Quote &) { ++seen; }, {"*"});
+        const auto start = std::chrono::steady_clock::now();
+        assert(stream.replay() == 400'000 && seen == 400'000);
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Replayed " << seen << " events at "
+                  << static_cast<double>(seen) / seconds / 1e6 << " M/s\n";
+    }
+
+    std::cout << "Replay stream tests passed\n";
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/resample.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace alpaca;
+
+namespace {
+constexpr std::int64_t kMinute = 60'000'000'000;
+
+std::int64_t at(const char *timestamp) {
+    return *core::parse_timestamp_ns(timestamp);
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+// Minute bars from 09:00 to 16:29 Eastern; the close rises by one per minute.
+void add_day(data::BarColumns &bars, std::int64_t nine_am) {
+    for (int m = 0; m < 450; ++m) {
+        data::Bar bar;
+        bar.symbol = "AAPL";
+        bar.timestamp = core::format_timestamp_ns(nine_am + m * kMinute);
+        bar.open = m;
+        bar.high = m + 0.5;
+        bar.low = m - 0.5;
+        bar.close = m + 1;
+        bar.volume = 10;
+        bar.vwap = m + 0.25;
+        bar.trade_count = 2;
+        bars.push_back(bar);
+    }
+}
+} // namespace
+
+int main() {
+    // Eastern standard and daylight time.
+    const auto winter = data::TradingSession::from_calendar("2024-01-02", "09:30", "16:00");
+    assert(winter.day_ns == at("2024-01-02T05:00:00Z"));
+    assert(winter.open_ns == at("2024-01-02T14:30:00Z"));
+    assert(winter.close_ns == at("2024-01-02T21:00:00Z"));
+    assert(winter.extended_open_ns == at("2024-01-02T09:00:00Z"));
+    const auto summer = data::TradingSession::from_calendar("2024-07-03", "0930", "1300");
+    assert(summer.open_ns == at("2024-07-03T13:30:00Z"));
+    assert(summer.close_ns == at("2024-07-03T17:00:00Z"));
+    // DST starts 2024-03-10 and ends 2024-11-03.
+    assert(data::TradingSession::from_calendar("2024-03-08", "09:30", "16:00").open_ns ==
+           at("2024-03-08T14:30:00Z"));
+    assert(data::TradingSession::from_calendar("2024-03-11", "09:30", "16:00").open_ns ==
+           at("2024-03-11T13:30:00Z"));
+    assert(data::TradingSession::from_calendar("2024-11-04", "09:30", "16:00").open_ns ==
+           at("2024-11-04T14:30:00Z"));
+
+    bool threw = false;
+    try {
+        (void)data::TradingSession::from_calendar("2024-01-02", "9am", "16:00");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    data::BarColumns minutes;
+    minutes.symbol = "AAPL";
+    add_day(minutes, at("2024-01-02T14:00:00Z"));
+    add_day(minutes, at("2024-01-03T14:00:00Z"));
+    assert(minutes.size() == 900);
+
+    data::ResampleOptions regular;
+    regular.sessions = {winter, data::TradingSession::from_calendar("2024-01-03", "09:30", "16:00")};
+
+    // Hour buckets are clock hours like the bars endpoint's: the first holds 09:30-09:59.
+    auto hours = data::resample(minutes, data::TimeFrame::Hour(), regular);
+    assert(hours.size() == 14);
+    assert(hours.timestamp_ns[0] == at("2024-01-02T14:00:00Z"));
+    assert(hours.timestamp_ns[6] == at("2024-01-02T20:00:00Z"));
+    assert(near(hours.volume[0], 300.0) && near(hours.volume[6], 600.0));
+    assert(near(hours.open[0], 30.0) && near(hours.close[0], 60.0));
+    assert(near(hours.high[0], 59.5) && near(hours.low[0], 29.5));
+    assert(near(hours.trade_count[0], 60.0));
+    assert(near(hours.vwap[0], (30.25 + 59.25) / 2.0));
+
+    // Anchored at the open on request; the last bucket is the half hour up to the close.
+    data::ResampleOptions anchored = regular;
+    anchored.align_to_session_open = true;
+    auto from_open = data::resample(minutes, data::TimeFrame::Hour(), anchored);
+    assert(from_open.size() == 14);
+    assert(from_open.timestamp_ns[0] == at("2024-01-02T14:30:00Z"));
+    assert(from_open.timestamp_ns[6] == at("2024-01-02T20:30:00Z"));
+    assert(near(from_open.volume[0], 600.0) && near(from_open.volume[6], 300.0));
+    assert(near(from_open.open[0], 30.0) && near(from_open.close[0], 90.0));
+    assert(near(from_open.vwap[0], (30.25 + 89.25) / 2.0));
+
+    // Bars without a vwap are left out of the bucket's vwap rather than counted as 0.
+    data::BarColumns partial = minutes;
+    for (std::size_t i = 30; i < 45; ++i) {
+        partial.vwap[i] = std::nan("");
+    }
+    const auto partial_hours = data::resample(partial, data::TimeFrame::Hour(), regular);
+    assert(near(partial_hours.vwap[0], (45.25 + 59.25) / 2.0));
+    assert(near(partial_hours.volume[0], 300.0));
+    data::Bar no_vwap;
+    no_vwap.symbol = "AAPL";
+    no_vwap.timestamp = "2024-01-02T14:30:00Z";
+    no_vwap.volume = 5;
+    data::BarColumns unpriced;
+    unpriced.push_back(no_vwap);
+    assert(std::isnan(unpriced.vwap[0]));
+    const auto unpriced_bars = data::resample(unpriced, data::TimeFrame::Hour()).to_bars();
+    assert(unpriced_bars.size() == 1 && !unpriced_bars[0].vwap);
+
+    auto five = data::resample(minutes, data::TimeFrame::Minute(5), regular);
+    assert(five.size() == 2 * 78);
+
+    auto days = data::resample(minutes, data::TimeFrame::Day(), regular);
+    assert(days.size() == 2);
+    assert(days.timestamp_ns[1] == at("2024-01-03T05:00:00Z"));
+    assert(near(days.volume[0], 3900.0) && near(days.open[0], 30.0) && near(days.close[0], 420.0));
+
+    auto weeks = data::resample(minutes, data::TimeFrame::Week(), regular);
+    assert(weeks.size() == 1 && weeks.timestamp_ns[0] == winter.day_ns);
+    assert(near(weeks.volume[0], 7800.0));
+
+    // Multi-day and multi-week targets are rejected rather than silently treated as 1.
+    for (const auto unit : {data::TimeFrameUnit::Day, data::TimeFrameUnit::Week}) {
+        data::TimeFrame two;
+        two.amount = 2;
+        two.unit = unit;
+        threw = false;
+        try {
+            (void)data::resample(minutes, two, regular);
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Extended hours keep the pre-market minutes and align to 04:00.
+    data::ResampleOptions extended = regular;
+    extended.hours = data::SessionHours::Extended;
+    auto extended_hours = data::resample(minutes, data::TimeFrame::Hour(), extended);
+    assert(extended_hours.timestamp_ns[0] == at("2024-01-02T14:00:00Z"));
+    assert(near(extended_hours.volume[0], 600.0));
+
+    // Without sessions buckets follow UTC.
+    auto utc_days = data::resample(minutes, data::TimeFrame::Day());
+    assert(utc_days.size() == 2 && utc_days.timestamp_ns[0] == at("2024-01-02T00:00:00Z"));
+    auto utc_month = data::resample(minutes, data::TimeFrame::Month(3));
+    assert(utc_month.size() == 1 && utc_month.timestamp_ns[0] == at("2024-01-01T00:00:00Z"));
+
+    // Round trip through the row representation.
+    auto rows = hours.to_bars();
+    auto back = data::BarColumns::from_bars(rows, "AAPL");
+    assert(back.size() == hours.size() && back.timestamp_ns == hours.timestamp_ns);
+    assert(data::BarColumns::from_bars(rows, "MSFT").size() == 0);
+
+    std::cout << "Resample tests passed\n";
+    return 0;
+}
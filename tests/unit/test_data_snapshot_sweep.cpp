@@ -0,0 +1,112 @@
+#include "alpaca/data/snapshot_sweep.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+// Answers every snapshot request with one entry per requested symbol, except symbols ending
+// in 'X'. Safe for concurrent send() calls.
+class SnapshotTransport final : public core::IHttpTransport {
+  public:
+    core::HttpResponse send(const core::HttpRequest &request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            urls_.push_back(request.url);
+        }
+        const int now = ++in_flight_;
+        int seen = peak_.load();
+        while (now > seen && !peak_.compare_exchange_weak(seen, now)) {
+        }
+
+        const auto begin = request.url.find("symbols=") + 8;
+        const auto end = request.url.find('&', begin);
+        std::stringstream symbols(request.url.substr(begin, end - begin));
+        std::string body = "{";
+        bool first = true;
+        for (std::string symbol; std::getline(symbols, symbol, ',');) {
+            if (symbol.back() == 'X') {
+                continue;
+            }
+            if (!first) {
+                body += ',';
+            }
+            first = false;
+            const auto price = std::to_string(symbol.size());
+            body += "\"" + symbol + "\":{\"latestTrade\":{\"t\":\"2024-01-02T14:30:00Z\",\"p\":" +
+                    price + ",\"s\":1},\"dailyBar\":{\"t\":\"2024-01-02\",\"o\":1,\"h\":2,\"l\":0.5,\"c\":" +
+                    price + ",\"v\":100}}";
+        }
+        body += "}";
+        --in_flight_;
+        return {200, {}, body};
+    }
+
+    std::vector<std::string> urls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return urls_;
+    }
+    int peak() const { return peak_.load(); }
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::string> urls_;
+    std::atomic<int> in_flight_{0};
+    std::atomic<int> peak_{0};
+};
+} // namespace
+
+int main() {
+    // Payloads wrapped in "snapshots" (as in the row-oriented parser) are accepted too.
+    data::SnapshotTable wrapped;
+    wrapped.append_json(
+        R"({"snapshots":{"AAPL":{"latestTrade":{"t":"2024-01-02T09:30:00Z","p":190.5,"s":5},"latestQuote":{"t":"2024-01-02T09:30:00Z","bp":190.4,"bs":10,"ap":190.6,"as":8},"minuteBar":{"c":190.8,"v":1500},"dailyBar":{"t":"2024-01-02","o":188.0,"h":192.0,"l":187.5,"c":190.0,"v":100000},"prevDailyBar":{"c":188.5,"v":90000}},"MSFT":{}}})");
+    assert(wrapped.size() == 2);
+    const auto aapl = *wrapped.index_of("AAPL");
+    assert(wrapped.trade_price[aapl] == 190.5 && wrapped.ask_size[aapl] == 8);
+    assert(wrapped.quote_ns[aapl] == 1704187800000000000LL);
+    assert(wrapped.minute_volume[aapl] == 1500 && wrapped.prev_close[aapl] == 188.5);
+    const auto msft = *wrapped.index_of("MSFT");
+    assert(std::isnan(wrapped.trade_price[msft]) && wrapped.trade_ns[msft] == 0);
+    assert(!wrapped.index_of("TSLA"));
+
+    std::vector<std::string> universe;
+    for (int i = 0; i < 2345; ++i) {
+        universe.push_back("S" + std::to_string(i) + (i % 100 == 99 ? "X" : ""));
+    }
+
+    auto transport = std::make_shared<SnapshotTransport>();
+    data::DataClient client(core::ClientConfig::WithPaperKeys("key", "secret"), transport);
+    data::SnapshotSweepOptions options;
+    options.chunk_size = 100;
+    options.max_concurrency = 4;
+    options.feed = data::DataFeed::Sip;
+    auto table = data::sweep_stock_snapshots(client, universe, options);
+
+    const auto urls = transport->urls();
+    assert(urls.size() == 24);
+    assert(transport->peak() <= 4);
+    for (const auto &url : urls) {
+        assert(url.find("/v2/stocks/snapshots?symbols=") != std::string::npos);
+        assert(url.find("feed=sip") != std::string::npos);
+    }
+
+    assert(table.size() == 2345 - 23);
+    assert(table.symbol.front() == "S0" && table.symbol.back() == "S2344");
+    const auto row = *table.index_of("S1234");
+    assert(table.trade_price[row] == 5.0 && table.daily_close[row] == 5.0);
+    assert(table.daily_volume[row] == 100 && std::isnan(table.bid_price[row]));
+    assert(!table.index_of("S99X"));
+
+    assert(data::sweep_stock_snapshots(client, {}, options).size() == 0);
+
+    std::cout << "Snapshot sweep tests passed\n";
+    return 0;
+}
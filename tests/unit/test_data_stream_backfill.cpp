@@ -0,0 +1,75 @@
+#include "alpaca/core/mock_http_transport.hpp"
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+class BackfillProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::StockDataStream;
+    using StockDataStream::backfill_impl;
+};
+} // namespace
+
+int main() {
+    auto config = core::ClientConfig::WithPaperKeys("key", "secret");
+    auto transport = std::make_shared<core::MockHttpTransport>();
+
+    // Two trade pages followed by one bar page; the 09:30 bar closes at 09:31:00.
+    transport->enqueue_response(
+        {200,
+         {},
+         R"({"trades":{"AAPL":[{"t":"2024-01-02T09:30:59.5Z","p":190.5,"s":10},{"t":"2024-01-02T09:31:30Z","p":191.0,"s":5}]},"next_page_token":"page2"})"});
+    transport->enqueue_response(
+        {200, {}, R"({"trades":{"AAPL":[{"t":"2024-01-02T09:31:00.25Z","p":190.75,"s":1}]}})"});
+    transport->enqueue_response(
+        {200,
+         {},
+         R"({"bars":{"AAPL":[{"t":"2024-01-02T09:30:00Z","o":190.0,"h":191.0,"l":189.5,"c":190.5,"v":1200},{"t":"2024-01-02T09:31:00Z","o":190.5,"h":191.0,"l":190.5,"c":191.0,"v":600}]}})"});
+
+    auto client = std::make_shared<data::DataClient>(config, transport);
+
+    BackfillProbe stream("key", "secret", false, data::DataFeed::Sip);
+    stream.enable_backfill(client);
+
+    std::vector<std::string> delivered;
+    stream.subscribe_trades(
+        [&](const data::Trade &trade) { delivered.push_back("t@" + trade.timestamp); }, {"AAPL"});
+    stream.subscribe_bars([&](const data::Bar &bar) { delivered.push_back("b@" + bar.timestamp); },
+                          {"AAPL"});
+
+    const auto start = *core::parse_timestamp_ns("2024-01-02T09:30:30Z");
+    const auto end = *core::parse_timestamp_ns("2024-01-02T09:31:45Z");
+    stream.backfill_impl(start, end);
+
+    // Events are merged by time; the 09:31 bar has not closed by the end of the window.
+    const std::vector<std::string> expected{
+        "t@2024-01-02T09:30:59.5Z", "b@2024-01-02T09:30:00Z", "t@2024-01-02T09:31:00.25Z",
+        "t@2024-01-02T09:31:30Z"};
+    if (delivered != expected) {
+        std::cerr << "Unexpected backfill order:";
+        for (const auto &item : delivered) {
+            std::cerr << ' ' << item;
+        }
+        std::cerr << '\n';
+        return 1;
+    }
+
+    const auto &requests = transport->requests();
+    assert(requests.size() == 3);
+    assert(requests[0].url.find("/v2/stocks/trades") != std::string::npos);
+    assert(requests[0].url.find("feed=sip") != std::string::npos);
+    assert(requests[0].url.find("start=2024-01-02T09:30:30.000000000Z") != std::string::npos);
+    assert(requests[1].url.find("page_token=page2") != std::string::npos);
+    assert(requests[2].url.find("/v2/stocks/bars") != std::string::npos);
+    assert(requests[2].url.find("start=2024-01-02T09:29:30.000000000Z") != std::string::npos);
+
+    std::cout << "Data stream backfill tests passed\n";
+    return 0;
+}
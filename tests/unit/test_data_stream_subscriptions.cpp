@@ -0,0 +1,67 @@
+#include "alpaca/data/live/stock.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+
+namespace {
+class SubscriptionProbe : public data::live::StockDataStream {
+  public:
+    using StockDataStream::StockDataStream;
+    using StockDataStream::add_handlers;
+    using StockDataStream::build_subscription_message;
+    using StockDataStream::dispatch_message_impl;
+    using StockDataStream::remove_handlers;
+};
+} // namespace
+
+int main() {
+    assert(SubscriptionProbe::build_subscription_message("subscribe", "bars", {"AAPL", "MSFT"}) ==
+           R"({"action":"subscribe","bars":["AAPL","MSFT"]})");
+    assert(SubscriptionProbe::build_subscription_message("unsubscribe", "trades", {}) ==
+           R"({"action":"unsubscribe","trades":[]})");
+
+    // Only symbols that change state make it into the delta.
+    std::unordered_map<std::string, data::live::TradeHandler> handlers;
+    data::live::TradeHandler noop = [](const data::Trade &) {};
+    auto added = SubscriptionProbe::add_handlers(handlers, noop, {"AAPL", "MSFT"});
+    assert((added == std::vector<std::string>{"AAPL", "MSFT"}));
+    added = SubscriptionProbe::add_handlers(handlers, noop, {"MSFT", "TSLA"});
+    assert((added == std::vector<std::string>{"TSLA"}));
+    auto removed = SubscriptionProbe::remove_handlers(handlers, {"AAPL", "NVDA"});
+    assert((removed == std::vector<std::string>{"AAPL"}));
+    assert(handlers.size() == 2);
+
+    // Bar, updated-bar and daily-bar messages each reach only their own channel's handler.
+    SubscriptionProbe stream("key", "secret");
+    std::vector<std::string> delivered;
+    stream.subscribe_bars([&](const data::Bar &bar) { delivered.push_back("b:" + bar.symbol); },
+                          {"AAPL"});
+    stream.subscribe_updated_bars(
+        [&](const data::Bar &bar) { delivered.push_back("u:" + bar.symbol); }, {"*"});
+    stream.subscribe_daily_bars(
+        [&](const data::Bar &bar) { delivered.push_back("d:" + bar.symbol); }, {"MSFT"});
+
+    stream.dispatch_message_impl(
+        R"([{"T":"b","S":"AAPL","t":"2024-01-02T09:30:00Z","o":1,"h":1,"l":1,"c":1,"v":1},)"
+        R"({"T":"u","S":"AAPL","t":"2024-01-02T09:30:00Z","o":1,"h":1,"l":1,"c":1,"v":2},)"
+        R"({"T":"d","S":"AAPL","t":"2024-01-02T05:00:00Z","o":1,"h":1,"l":1,"c":1,"v":3},)"
+        R"({"T":"d","S":"MSFT","t":"2024-01-02T05:00:00Z","o":1,"h":1,"l":1,"c":1,"v":3},)"
+        R"({"T":"b","S":"MSFT","t":"2024-01-02T09:30:00Z","o":1,"h":1,"l":1,"c":1,"v":1}])");
+
+    const std::vector<std::string> expected{"b:AAPL", "u:AAPL", "d:MSFT"};
+    if (delivered != expected) {
+        std::cerr << "Unexpected bar routing:";
+        for (const auto &item : delivered) {
+            std::cerr << ' ' << item;
+        }
+        std::cerr << '\n';
+        return 1;
+    }
+
+    std::cout << "Data stream subscription tests passed\n";
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "alpaca/data/live/crypto.hpp"
+#include "alpaca/data/live/news.hpp"
+#include "alpaca/data/live/option.hpp"
+#include "alpaca/data/live/stock.hpp"
+
+#include <simdjson.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+using namespace alpaca::data::live;
+
+namespace {
+// The streams build their reconnect message without a connection; these expose it.
+struct StockProbe : StockDataStream {
+    StockProbe() : StockDataStream("key", "secret") {}
+    using StockDataStream::subscription_message;
+};
+struct CryptoProbe : CryptoDataStream {
+    CryptoProbe() : CryptoDataStream("key", "secret") {}
+    using CryptoDataStream::subscription_message;
+};
+struct OptionProbe : OptionDataStream {
+    OptionProbe() : OptionDataStream("key", "secret") {}
+    using OptionDataStream::subscription_message;
+};
+struct NewsProbe : NewsDataStream {
+    NewsProbe() : NewsDataStream("key", "secret") {}
+    using NewsDataStream::subscription_message;
+    // NewsDataStream does not implement DataStream's trade channel.
+    void subscribe_trades(TradeHandler, const std::vector<std::string> &) override {}
+    void unsubscribe_trades(const std::vector<std::string> &) override {}
+};
+
+using Channels = std::map<std::string, std::vector<std::string>>;
+
+// Parses a subscribe message (asserting it is valid JSON) into its channels, symbols sorted.
+Channels parse(const std::string &message) {
+    simdjson::dom::parser parser;
+    simdjson::dom::object root;
+    assert(parser.parse(message).get(root) == simdjson::SUCCESS);
+    Channels channels;
+    bool saw_action = false;
+    for (auto [key, value] : root) {
+        if (key == "action") {
+            std::string_view action;
+            assert(value.get(action) == simdjson::SUCCESS && action == "subscribe");
+            saw_action = true;
+            continue;
+        }
+        simdjson::dom::array symbols;
+        assert(value.get(symbols) == simdjson::SUCCESS);
+        auto &out = channels[std::string(key)];
+        for (auto symbol : symbols) {
+            std::string_view text;
+            assert(symbol.get(text) == simdjson::SUCCESS);
+            out.emplace_back(text);
+        }
+        std::sort(out.begin(), out.end());
+    }
+    assert(saw_action);
+    return channels;
+}
+} // namespace
+
+int main() {
+    {
+        StockProbe stock;
+        assert(parse(stock.subscription_message()).empty());
+
+        stock.subscribe_trades([](const data::Trade &) {}, {"AAPL", "MSFT"});
+        stock.subscribe_quotes([](const data::Quote &) {}, {"AAPL"});
+        stock.subscribe_bars([](const data::Bar &) {}, {"SPY"});
+        stock.subscribe_updated_bars([](const data::Bar &) {}, {"QQQ"});
+        stock.subscribe_daily_bars([](const data::Bar &) {}, {"*"});
+        stock.subscribe_trading_statuses([](const data::TradingStatus &) {}, {"TSLA", "NVDA"});
+        const Channels expected{{"trades", {"AAPL", "MSFT"}}, {"quotes", {"AAPL"}},
+                                {"bars", {"SPY"}},            {"updatedBars", {"QQQ"}},
+                                {"dailyBars", {"*"}},         {"statuses", {"NVDA", "TSLA"}}};
+        assert(parse(stock.subscription_message()) == expected);
+
+        // Channels emptied by unsubscribing are left out rather than sent as [].
+        stock.unsubscribe_quotes({"AAPL"});
+        const auto after = parse(stock.subscription_message());
+        assert(after.size() == 5 && after.count("quotes") == 0);
+    }
+    {
+        CryptoProbe crypto;
+        crypto.subscribe_trades([](const data::Trade &) {}, {"BTC/USD"});
+        crypto.subscribe_quotes([](const data::Quote &) {}, {"ETH/USD"});
+        crypto.subscribe_bars([](const data::Bar &) {}, {"BTC/USD"});
+        crypto.subscribe_updated_bars([](const data::Bar &) {}, {"BTC/USD"});
+        crypto.subscribe_daily_bars([](const data::Bar &) {}, {"ETH/USD"});
+        crypto.subscribe_orderbooks([](const data::Orderbook &) {}, {"BTC/USD", "ETH/USD"});
+        const Channels expected{{"trades", {"BTC/USD"}},      {"quotes", {"ETH/USD"}},
+                                {"bars", {"BTC/USD"}},        {"updatedBars", {"BTC/USD"}},
+                                {"dailyBars", {"ETH/USD"}},
+                                {"orderbooks", {"BTC/USD", "ETH/USD"}}};
+        assert(parse(crypto.subscription_message()) == expected);
+    }
+    {
+        OptionProbe option;
+        option.subscribe_trades([](const data::Trade &) {}, {"AAPL240119C00190000"});
+        option.subscribe_quotes([](const data::Quote &) {}, {"AAPL240119P00180000"});
+        const Channels expected{{"trades", {"AAPL240119C00190000"}},
+                                {"quotes", {"AAPL240119P00180000"}}};
+        assert(parse(option.subscription_message()) == expected);
+    }
+    {
+        NewsProbe news;
+        news.subscribe_news([](const data::News &) {}, {"*"});
+        assert((parse(news.subscription_message()) == Channels{{"news", {"*"}}}));
+    }
+
+    std::cout << "Subscription message tests passed\n";
+    return 0;
+}
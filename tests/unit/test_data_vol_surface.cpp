@@ -0,0 +1,99 @@
+#include "alpaca/data/vol_surface.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace alpaca;
+
+namespace {
+constexpr std::int64_t kNanosPerDay = 86'400'000'000'000;
+
+bool near(double a, double b, double tolerance = 1e-9) { return std::abs(a - b) <= tolerance; }
+
+data::OptionsSnapshot snapshot(const std::string &root, const char *date, char side, int strike,
+                               double iv, double bid = 1.0, double ask = 1.1) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%s%s%c%08d", root.c_str(), date, side, strike * 1000);
+    data::OptionsSnapshot s;
+    s.symbol = buffer;
+    s.implied_volatility = iv;
+    data::Quote quote;
+    quote.bid_price = bid;
+    quote.ask_price = ask;
+    s.latest_quote = quote;
+    return s;
+}
+
+// Two expiries: a linear smile 0.2 - 0.1 k at 2024-02-16 and a flat 0.3 at 2024-05-17, with
+// strikes 70-130 on both sides plus a few quotes the filters must drop.
+data::OptionChain make_chain(const std::string &root, double shift = 0.0) {
+    data::OptionsSnapshotResponse response;
+    for (int strike = 70; strike <= 130; strike += 5) {
+        const double k = std::log(strike / 100.0);
+        for (char side : {'C', 'P'}) {
+            response.snapshots.push_back(snapshot(root, "240216", side, strike, 0.2 - 0.1 * k));
+            response.snapshots.push_back(snapshot(root, "240517", side, strike, 0.3 + shift));
+        }
+    }
+    response.snapshots.push_back(snapshot(root, "240216", 'C', 102, 0.9, 0.1, 1.0)); // wide
+    response.snapshots.push_back(snapshot(root, "240216", 'P', 103, 0.9, 0.0, 0.0)); // no bid
+    response.snapshots.push_back(snapshot(root, "240216", 'C', 104, 9.0));           // bad IV
+    response.snapshots.push_back(snapshot(root, "240105", 'C', 100, 0.5));           // expired
+    data::OptionChain chain(root);
+    chain.add(response);
+    chain.build_index();
+    return chain;
+}
+} // namespace
+
+int main() {
+    const std::int64_t now_ns = core::days_from_civil(2024, 1, 17) * kNanosPerDay;
+    const double t0 = (30.0 * kNanosPerDay + 21.0 * 3600e9) / (365.0 * kNanosPerDay);
+    const double t1 = (121.0 * kNanosPerDay + 21.0 * 3600e9) / (365.0 * kNanosPerDay);
+
+    data::VolSurfaceOptions options;
+    options.moneyness = {-0.5, -0.1, 0.0, 0.1, 0.5};
+    options.tenors = {7 / 365.0, t0, (t0 + t1) / 2, t1, 2.0};
+    const auto chain = make_chain("SPY");
+    const auto surface = data::build_vol_surface(chain, 100.0, now_ns, options);
+
+    assert(surface.underlying == "SPY" && surface.iv.size() == 25);
+    // Front expiry: exact on the smile inside the quoted range, flat outside it.
+    assert(near(surface.at(1, 1), 0.2 + 0.01, 1e-3)); // k = -0.1 between quoted strikes
+    assert(near(surface.at(1, 2), 0.2));
+    assert(near(surface.at(1, 3), 0.2 - 0.1 * 0.1, 1e-3));
+    assert(near(surface.at(1, 0), 0.2 - 0.1 * std::log(0.7)));
+    assert(near(surface.at(1, 4), 0.2 - 0.1 * std::log(1.3)));
+    // Before the first and after the last expiry the nearest smile is used.
+    assert(near(surface.at(0, 2), 0.2) && near(surface.at(4, 2), 0.3));
+    assert(near(surface.at(3, 2), 0.3));
+    // Between expiries total variance is linear in time.
+    const double mid = (t0 + t1) / 2;
+    const double variance = 0.04 * t0 + (mid - t0) / (t1 - t0) * (0.09 * t1 - 0.04 * t0);
+    const double expected = std::sqrt(variance / mid);
+    assert(near(surface.at(2, 2), expected));
+    assert(near(surface.interpolate(t0, 0.0), 0.2));
+    assert(near(surface.interpolate(t0, 0.05), (surface.at(1, 2) + surface.at(1, 3)) / 2));
+    assert(near(surface.interpolate(10.0, 9.0), surface.at(4, 4)));
+
+    // Incremental refresh across underlyings: unchanged smiles are not refitted.
+    data::VolSurfaceBuilder builder(options);
+    const auto qqq = make_chain("QQQ");
+    builder.update({{&chain, 100.0}, {&qqq, 100.0}}, now_ns);
+    assert(builder.refitted() == 4);
+    builder.update({{&chain, 100.0}, {&qqq, 100.0}}, now_ns + 1'000'000'000);
+    assert(builder.refitted() == 0);
+    const auto qqq_moved = make_chain("QQQ", 0.05);
+    builder.update({{&chain, 100.0}, {&qqq_moved, 100.0}}, now_ns);
+    assert(builder.refitted() == 1);
+    assert(near(builder.surface("QQQ")->at(4, 2), 0.35));
+    builder.update(chain, 101.0, now_ns);
+    assert(builder.refitted() == 2);
+    assert(builder.surface("SPY")->spot == 101.0 && !builder.surface("IWM"));
+
+    std::cout << "Vol surface tests passed\n";
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "alpaca/trading/option_symbol.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace alpaca;
+using trading::ContractType;
+
+// The codec is usable at compile time.
+static_assert(trading::parse_occ_symbol("AAPL240119C00150000")->strike_thousandths == 150000);
+static_assert(trading::format_occ_symbol(*trading::parse_occ_symbol("SPY250321P00412500")).view() ==
+              "SPY250321P00412500");
+static_assert(trading::decode_option_key(trading::option_key("QQQ240621C00450500")) ==
+              *trading::parse_occ_symbol("QQQ240621C00450500"));
+static_assert(trading::option_key("AAPL") == 0);
+
+int main() {
+    const auto aapl = trading::parse_occ_symbol("AAPL240119C00190000");
+    assert(aapl);
+    assert(aapl->root_view() == "AAPL");
+    assert(aapl->expiry_days == core::days_from_civil(2024, 1, 19));
+    assert(aapl->type == ContractType::Call);
+    assert(aapl->strike() == 190.0);
+
+    // Six-character roots and sub-cent strikes parse but do not fit a key.
+    const auto adjusted = trading::parse_occ_symbol("GOOGL1240119P00033333");
+    assert(adjusted && adjusted->root_view() == "GOOGL1" && adjusted->strike_thousandths == 33333);
+    assert(trading::format_occ_symbol(*adjusted).view() == "GOOGL1240119P00033333");
+    assert(trading::option_key("GOOGL1240119P00033330") == 0);
+    assert(trading::option_key("AAPL240119C00033333") == 0);
+
+    for (const char *bad : {"", "AAPL", "AAPL240119X00190000", "AAPL241319C00190000",
+                            "AAPL240100C00190000", "AAPL24011AC00190000", "aapl240119C00190000",
+                            "AAPL240119C0019000O", "TOOLONGROOT240119C00190000"}) {
+        assert(!trading::parse_occ_symbol(bad));
+        assert(trading::option_key(bad) == 0);
+    }
+
+    // Round trip through the key, including digits in the root and the largest strike.
+    for (const char *symbol : {"AAPL240119C00190000", "F240119P00012500", "SPXW241231C41943030",
+                               "AMC1240119P00005000", "BRKB440101C00000010"}) {
+        const auto key = trading::option_key(symbol);
+        assert(key != 0);
+        assert(trading::format_occ_symbol(trading::decode_option_key(key)).view() == symbol);
+    }
+    assert(trading::option_key("SPXW241231C41943040") == 0);
+    assert(trading::option_key("SPY450101C00100000") == 0);
+
+    // Keys sort in chain order: root, expiry, strike, call before put.
+    std::vector<std::string> chain{"SPY240119C00100000", "AAPL240216C00100000",
+                                   "AAPL240119P00100000", "AAPL240119C00105000",
+                                   "AAPL240119C00100000", "A240119C00100000"};
+    std::vector<trading::OptionKey> keys;
+    for (const auto &symbol : chain) {
+        keys.push_back(trading::option_key(symbol));
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::string> sorted;
+    for (auto key : keys) {
+        sorted.emplace_back(trading::format_occ_symbol(trading::decode_option_key(key)).view());
+    }
+    assert((sorted == std::vector<std::string>{"A240119C00100000", "AAPL240119C00100000",
+                                               "AAPL240119P00100000", "AAPL240119C00105000",
+                                               "AAPL240216C00100000", "SPY240119C00100000"}));
+
+    std::cout << "Option symbol tests passed\n";
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "alpaca/core/frame_log.hpp"
+#include "alpaca/core/mock_http_transport.hpp"
+#include "alpaca/core/timestamp.hpp"
+#include "alpaca/trading/client.hpp"
+#include "alpaca/trading/order_cache.hpp"
+#include "alpaca/trading/stream.hpp"
+
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace alpaca;
+
+namespace {
+std::string order_json(const std::string& id, const std::string& status,
+                       const std::string& filled_qty, const std::string& avg,
+                       const std::string& updated_at) {
+    return R"({"id":")" + id + R"(","client_order_id":"c-)" + id +
+           R"(","symbol":"AAPL","status":")" + status + R"(","qty":"100","filled_qty":")" +
+           filled_qty + R"(","filled_avg_price":)" + avg + R"(,"submitted_at":")" + updated_at +
+           R"(","updated_at":")" + updated_at + R"(","type":"limit","side":"buy"})";
+}
+
+std::string trade_update(const std::string& event, const std::string& order,
+                         const std::string& timestamp, const std::string& extra = "") {
+    return R"({"stream":"trade_updates","data":{"event":")" + event + R"(",)" + extra +
+           R"("timestamp":")" + timestamp + R"(","order":)" + order + "}}";
+}
+}  // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() /
+                     ("alpaca_order_cache_" + std::to_string(core::now_ns()));
+    std::filesystem::create_directories(dir);
+    const std::string path = (dir / "trading.frames").string();
+
+    // Trade updates from the stream keep the cache current, nested order and string numbers
+    // included; an older update does not roll the order back.
+    {
+        core::FrameLogWriter writer(path);
+        writer.append(trade_update("new", order_json("o1", "new", "0", "null",
+                                                     "2024-01-02T14:30:00Z"),
+                                   "2024-01-02T14:30:00Z"));
+        writer.append(trade_update(
+            "partial_fill", order_json("o1", "partially_filled", "40", R"("190.5")",
+                                       "2024-01-02T14:30:01Z"),
+            "2024-01-02T14:30:01Z", R"("price":"190.5","qty":"40","position_qty":"40",)"));
+        writer.append(trade_update(
+            "fill", order_json("o1", "filled", "100", R"("190.8")", "2024-01-02T14:30:02Z"),
+            "2024-01-02T14:30:02Z", R"("price":"191","qty":"60","position_qty":"100",)"));
+        writer.append(trade_update("partial_fill", order_json("o1", "partially_filled", "40",
+                                                              R"("190.5")",
+                                                              "2024-01-02T14:30:01Z"),
+                                   "2024-01-02T14:30:01Z"));
+        writer.append(trade_update("new", order_json("o2", "new", "0", "null",
+                                                     "2024-01-02T14:31:00Z"),
+                                   "2024-01-02T14:31:00Z"));
+    }
+
+    trading::OrderCache cache;
+    trading::TradingStream stream("key", "secret");
+    std::optional<double> fill_price;
+    std::optional<double> position_qty;
+    stream.subscribe_trade_updates([&](const trading::TradeUpdate& update) {
+        cache.apply(update);
+        if (update.event == "fill") {
+            fill_price = update.price;
+            position_qty = update.position_qty;
+        }
+    });
+    assert(stream.replay_frames(core::FrameLogReader(path)) == 5);
+    assert(fill_price == 191.0 && position_qty == 100.0);
+
+    assert(cache.size() == 2 && cache.stale_updates() == 1);
+    const auto filled = cache.find("o1");
+    assert(filled && !filled->is_open() && filled->last_event == "fill");
+    assert(filled->filled_qty == 100.0 && filled->qty == 100.0);
+    assert(filled->filled_avg_price == 190.8 && filled->order.filled_avg_price == "190.8");
+    assert(filled->updated_ns == *core::parse_timestamp_ns("2024-01-02T14:30:02Z"));
+    const auto by_client = cache.find_by_client_order_id("c-o2");
+    assert(by_client && by_client->order.id == "o2" && by_client->is_open());
+    double seen_qty = -1.0;
+    assert(cache.visit("o1", [&](const trading::OrderState& state) {
+        seen_qty = state.filled_qty;
+    }));
+    assert(seen_qty == 100.0 && !cache.visit("missing", [](const auto&) {}));
+
+    // Without an average price on the order, executions are folded into one.
+    {
+        trading::OrderCache local;
+        trading::TradeUpdate update;
+        update.event = "partial_fill";
+        update.timestamp = "2024-01-02T14:30:00Z";
+        update.order.id = "x";
+        update.order.status = "partially_filled";
+        update.price = 10.0;
+        update.qty = 1.0;
+        assert(local.apply(update));
+        update.event = "fill";
+        update.order.status = "filled";
+        update.timestamp = "2024-01-02T14:30:01Z";
+        update.price = 13.0;
+        update.qty = 2.0;
+        assert(local.apply(update));
+        const auto state = local.find("x");
+        assert(state && state->filled_qty == 3.0 && state->filled_avg_price == 12.0);
+    }
+
+    // Reconciling: REST brings a new order, and o2 left the open list, so it is looked up.
+    auto transport = std::make_shared<core::MockHttpTransport>();
+    transport->enqueue_response(
+        {200, {}, "[" + order_json("o3", "accepted", "0", "null", "2024-01-02T14:32:00Z") + "]"});
+    transport->enqueue_response(
+        {200, {}, order_json("o2", "canceled", "0", "null", "2024-01-02T14:33:00Z")});
+    trading::TradingClient client(core::ClientConfig::WithPaperKeys("key", "secret"),
+                                  transport);
+    const auto report = cache.reconcile(client);
+    assert(report.added == 1 && report.updated == 0 && report.resolved == 1);
+    assert(transport->requests().size() == 2);
+    assert(transport->requests()[0].url.find("status=open") != std::string::npos);
+    assert(transport->requests()[1].url.find("/v2/orders/o2") != std::string::npos);
+    assert(!cache.find("o2")->is_open() && cache.find("o3")->is_open());
+    assert(cache.open_orders().size() == 1);
+
+    // More open orders than one page: the listing pages on by submission time, so orders
+    // past the first page are not mistaken for closed ones and fetched one by one.
+    {
+        const std::int64_t start = *core::parse_timestamp_ns("2024-01-03T14:30:00Z");
+        const auto page = [&](int first, int count) {
+            std::string body = "[";
+            for (int i = first; i < first + count; ++i) {
+                body += (i == first ? "" : ",") +
+                        order_json("p" + std::to_string(i), "new", "0", "null",
+                                   core::format_timestamp_ns(start + i * 1'000'000'000LL));
+            }
+            return body + "]";
+        };
+        trading::OrderCache paged;
+        trading::Order held;
+        held.id = "p501";
+        held.status = "new";
+        held.updated_at = "2024-01-03T14:00:00Z";
+        paged.load({held});
+
+        auto pages = std::make_shared<core::MockHttpTransport>();
+        pages->enqueue_response({200, {}, page(0, 500)});
+        pages->enqueue_response({200, {}, page(500, 2)});
+        trading::TradingClient paging_client(core::ClientConfig::WithPaperKeys("key", "secret"),
+                                             pages);
+        const auto paged_report = paged.reconcile(paging_client);
+        assert(paged_report.added == 501 && paged_report.updated == 1);
+        assert(paged_report.resolved == 0 && pages->requests().size() == 2);
+        assert(pages->requests()[0].url.find("direction=asc") != std::string::npos);
+        assert(pages->requests()[1].url.find("after=") != std::string::npos);
+        assert(paged.open_orders().size() == 502);
+
+        // A full page that does not advance stops the listing, and then nothing is looked up.
+        trading::OrderCache stuck;
+        stuck.load({held});
+        auto repeated = std::make_shared<core::MockHttpTransport>();
+        repeated->enqueue_response({200, {}, page(0, 500)});
+        repeated->enqueue_response({200, {}, page(0, 500)});
+        trading::TradingClient repeated_client(
+            core::ClientConfig::WithPaperKeys("key", "secret"), repeated);
+        const auto stuck_report = stuck.reconcile(repeated_client);
+        assert(stuck_report.added == 500 && stuck_report.resolved == 0);
+        assert(repeated->requests().size() == 2 && stuck.find("p501")->is_open());
+    }
+
+    // Stale REST data never overwrites a newer stream state.
+    trading::Order stale;
+    stale.id = "o1";
+    stale.status = "new";
+    stale.updated_at = "2024-01-02T14:29:00Z";
+    assert(cache.load({stale}) == 0);
+    assert(cache.find("o1")->order.status == "filled");
+
+    assert(cache.prune_closed(*core::parse_timestamp_ns("2024-01-02T14:32:30Z")) == 1);
+    assert(!cache.find("o1") && !cache.find_by_client_order_id("c-o1") && cache.size() == 2);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "Order cache tests passed\n";
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include "alpaca/core/decimal.hpp"
+#include "alpaca/core/mock_http_transport.hpp"
+#include "alpaca/data/models.hpp"
+#include "alpaca/trading/client.hpp"
+#include "alpaca/trading/position_engine.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace alpaca;
+using core::Decimal;
+
+namespace {
+Decimal dec(const char* text) {
+    return *Decimal::parse(text);
+}
+
+// A fill as TradingStream delivers it: amounts as sent plus their double values.
+trading::TradeUpdate fill(const std::string& execution_id, const std::string& symbol,
+                          const std::string& side, const std::string& qty,
+                          const std::string& price, std::optional<std::string> position_qty) {
+    trading::TradeUpdate update;
+    update.event = "fill";
+    update.execution_id = execution_id;
+    update.timestamp = "2024-01-02T14:30:00Z";
+    update.order.symbol = symbol;
+    update.order.side = side;
+    update.qty_text = qty;
+    update.price_text = price;
+    update.position_qty_text = position_qty;
+    update.qty = std::stod(qty);
+    update.price = std::stod(price);
+    if (position_qty) {
+        update.position_qty = std::stod(*position_qty);
+    }
+    return update;
+}
+
+data::Quote quote(const std::string& symbol, double bid, double ask) {
+    data::Quote q;
+    q.symbol = symbol;
+    q.timestamp = "2024-01-02T14:31:00Z";
+    q.bid_price = bid;
+    q.ask_price = ask;
+    return q;
+}
+
+std::string position_json(const std::string& symbol, const std::string& qty,
+                          const std::string& avg, const std::string& current,
+                          const std::string& asset_class = "us_equity") {
+    return R"({"symbol":")" + symbol + R"(","asset_class":")" + asset_class + R"(","qty":")" +
+           qty + R"(","avg_entry_price":")" + avg + R"(","current_price":")" + current +
+           R"("})";
+}
+}  // namespace
+
+int main() {
+    // Fixed-point decimals parse API strings exactly and round products half away from zero.
+    assert(dec("190.5").raw == 19'050'000'000 && dec("-3").raw == -300'000'000);
+    assert(dec("0.000000015").raw == 2 && dec("-0.000000014").raw == -1);
+    assert(dec("+.5") == dec("0.5") && dec("7.") == Decimal::from_int(7));
+    assert(!Decimal::parse("") && !Decimal::parse("1.2.3") && !Decimal::parse("12a") &&
+           !Decimal::parse("-") && !Decimal::parse("99999999999"));
+    assert(dec("190.50").to_string() == "190.5" && dec("-0.00000001").to_string() == "-0.00000001");
+    assert(Decimal{}.to_string() == "0" && dec("-12").to_string() == "-12");
+    assert(dec("0.00012345") * dec("65000.5") == dec("8.02431173"));
+    assert(dec("10") / dec("3") == dec("3.33333333") && dec("-2") / dec("3") == dec("-0.66666667"));
+    assert(Decimal::from_double(0.1) + Decimal::from_double(0.2) == dec("0.3"));
+    assert(dec("1.25").to_double() == 1.25);
+
+    trading::PositionEngine engine;
+    auto on_trade = engine.trade_update_handler();
+    auto on_quote = engine.quote_handler<data::Quote>();
+
+    // Buys average into the cost basis; a repeated execution is applied once.
+    assert(engine.apply(fill("e1", "AAPL", "buy", "100", "190", "100")));
+    assert(engine.apply(fill("e2", "AAPL", "buy", "50", "193", "150")));
+    assert(!engine.apply(fill("e2", "AAPL", "buy", "50", "193", "150")));
+    trading::TradeUpdate accepted;
+    accepted.event = "new";
+    accepted.order.symbol = "AAPL";
+    assert(!engine.apply(accepted));
+    auto aapl = *engine.find("AAPL");
+    assert(aapl.qty == dec("150") && aapl.avg_entry_price == dec("191"));
+    assert(aapl.unrealized_pnl.is_zero() && aapl.market_value == dec("28650"));
+
+    // Quotes mark to the mid; quotes for symbols without a position are ignored.
+    on_quote(quote("AAPL", 194.0, 196.0));
+    on_quote(quote("SPY", 470.0, 470.1));
+    assert(!engine.find("SPY"));
+    aapl = *engine.find("AAPL");
+    assert(aapl.mark_price == dec("195") && aapl.unrealized_pnl == dec("600"));
+    assert(engine.mark_quote("AAPL", 0.0, 195.5, 1) && !engine.mark_quote("AAPL", 0.0, 0.0, 1));
+
+    // Selling through the position realizes against the average and opens a short.
+    on_trade(fill("e3", "AAPL", "sell", "200", "196", "-50"));
+    aapl = *engine.find("AAPL");
+    assert(aapl.realized_pnl == dec("750") && aapl.qty == dec("-50"));
+    assert(aapl.avg_entry_price == dec("196") && aapl.cost_basis == dec("-9800"));
+    assert(engine.mark("AAPL", dec("195"), 2));
+    aapl = *engine.find("AAPL");
+    assert(aapl.unrealized_pnl == dec("50") && aapl.market_value == dec("-9750"));
+
+    // Fractional crypto quantities stay exact; account totals follow every change.
+    engine.apply_fill("BTC/USD", dec("0.00012345"), dec("65000.5"), 3);
+    on_quote(quote("BTC/USD", 66000.0, 66001.0));
+    const auto btc = *engine.find("BTC/USD");
+    assert(btc.cost_basis == dec("8.02431173") && btc.mark_price == dec("66000.5"));
+    assert(btc.unrealized_pnl == dec("0.12345"));
+    auto account = engine.account();
+    assert(account.realized_pnl == dec("750") && account.unrealized_pnl == dec("50.12345"));
+    assert(account.cost_basis == dec("-9800") + btc.cost_basis);
+    assert(account.total_pnl() == dec("800.12345"));
+
+    // The broker's position_qty wins when it disagrees with the local quantity.
+    assert(engine.apply(fill("e4", "TSLA", "buy", "10", "250", "12")));
+    assert(engine.find("TSLA")->qty == dec("12") && engine.quantity_corrections() == 1);
+    assert(engine.find("TSLA")->avg_entry_price == dec("250"));
+    assert(engine.fill_count() == 5);
+
+    // Amounts are taken from their text: this quantity has more digits than a double holds.
+    assert(engine.apply(fill("e5", "SHIB/USD", "buy", "1000000000.00000001", "0.00001",
+                             std::nullopt)));
+    assert(engine.find("SHIB/USD")->qty == dec("1000000000.00000001"));
+    assert(engine.find("SHIB/USD")->cost_basis == dec("10000"));
+    on_trade(fill("e6", "SHIB/USD", "sell", "1000000000.00000001", "0.00001", "0"));
+    assert(engine.find("SHIB/USD")->qty.is_zero() && engine.quantity_corrections() == 1);
+
+    // Reconciling with list_positions: AAPL and BTC agree, MSFT is new and TSLA was closed away.
+    auto transport = std::make_shared<core::MockHttpTransport>();
+    transport->enqueue_response({200, {},
+                                 "[" + position_json("AAPL", "-50", "196.000000001", "195.2") +
+                                     "," + position_json("MSFT", "10", "300.5", "301") + "," +
+                                     position_json("BTCUSD", "0.00012345", "65000.5", "1",
+                                                   "crypto") +
+                                     "]"});
+    trading::TradingClient client(core::ClientConfig::WithPaperKeys("key", "secret"),
+                                  transport);
+    auto report = engine.reconcile(client);
+    assert(report.matched == 2 && report.added == 1 && report.closed == 1);
+    assert(report.adjusted == 0 && report.skipped == 0);
+    // The crypto position listed as "BTCUSD" matched the "BTC/USD" book.
+    assert(!engine.find("BTCUSD") && engine.find("BTC/USD")->qty == dec("0.00012345"));
+    assert(transport->requests().front().url.find("/v2/positions") != std::string::npos);
+    const auto msft = *engine.find("MSFT");
+    assert(msft.qty == dec("10") && msft.mark_price == dec("301") &&
+           msft.unrealized_pnl == dec("5"));
+    assert(engine.find("TSLA")->qty.is_zero() && engine.find("AAPL")->realized_pnl == dec("750"));
+    account = engine.account();
+    assert(account.unrealized_pnl == dec("55.12345"));
+
+    // A snapshot taken before a fill does not undo it.
+    const std::uint64_t fills_before = engine.fill_count();
+    engine.apply_fill("MSFT", dec("5"), dec("302"), 4);
+    trading::Position stale;
+    stale.symbol = "MSFT";
+    stale.qty = "10";
+    stale.avg_entry_price = "300.5";
+    trading::Position adjusted;
+    adjusted.symbol = "AAPL";
+    adjusted.qty = "-40";
+    adjusted.avg_entry_price = "196";
+    report = engine.reconcile({stale, adjusted}, fills_before);
+    assert(report.skipped == 1 && report.adjusted == 1 && report.closed == 1);
+    assert(engine.find("MSFT")->qty == dec("15") && engine.find("AAPL")->qty == dec("-40"));
+    assert(engine.find("BTC/USD")->qty.is_zero() && engine.positions().size() == 5);
+
+    // Only the most recent execution ids are remembered, so memory stays bounded.
+    {
+        trading::PositionEngine windowed(2);
+        assert(windowed.apply(fill("w1", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(windowed.apply(fill("w2", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(!windowed.apply(fill("w1", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(windowed.apply(fill("w3", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(!windowed.apply(fill("w2", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(windowed.apply(fill("w1", "AAPL", "buy", "1", "100", std::nullopt)));
+        assert(windowed.find("AAPL")->qty == dec("4") && windowed.fill_count() == 4);
+    }
+
+    std::cout << "Position engine tests passed\n";
+    return 0;
+}